@@ -107,6 +107,24 @@ namespace utils
 
 
 
+/*-----------------------------------------------------------------------------
+ * Free-List Statistics
+-----------------------------------------------------------------------------*/
+struct FreeListStats
+{
+    // Number of distinct free blocks or ranges
+    unsigned long long numFreeBlocks;
+
+    // Total bytes held in free blocks
+    unsigned long long numFreeBytes;
+
+    // Size of the largest allocation which could be served without
+    // requesting more memory from a memory source
+    unsigned long long largestFreeBlock;
+};
+
+
+
 /*-----------------------------------------------------------------------------
  * IAllocator
 -----------------------------------------------------------------------------*/
@@ -134,6 +152,10 @@ class IAllocator : public MemorySource
     virtual void free(void* p) noexcept override;
 
     virtual void free(void* p, size_type n) noexcept override;
+
+    // Walks the allocator's free list(s). Returns false if the allocator does
+    // not track free memory. Not thread-safe unless noted by the allocator.
+    virtual bool free_list_stats(FreeListStats& outStats) const noexcept;
 };
 
 
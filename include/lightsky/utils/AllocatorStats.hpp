@@ -0,0 +1,340 @@
+/*
+ * File:   AllocatorStats.hpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 2:20 PM
+ */
+
+#ifndef LS_UTILS_ALLOCATOR_STATS_HPP
+#define LS_UTILS_ALLOCATOR_STATS_HPP
+
+#include <atomic>
+#include <string>
+
+#include "lightsky/utils/Allocator.hpp"
+#include "lightsky/utils/Pointer.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A point-in-time view of an allocator's statistics.
+-----------------------------------------------------------------------------*/
+struct AllocatorStatsSnapshot
+{
+    typedef unsigned long long size_type;
+
+    enum : size_type
+    {
+        // Bucket 0 holds allocations of up to 16 bytes, bucket "i" holds
+        // allocations in (2^(i+3), 2^(i+4)], and the last bucket holds
+        // everything larger.
+        num_size_buckets = 32
+    };
+
+    // Nanoseconds since an unspecified, monotonic epoch
+    size_type timestampNs;
+
+    size_type bytesInUse;
+    size_type peakBytesInUse;
+    size_type numAllocations;
+    size_type numFrees;
+    size_type numFailedAllocations;
+
+    // Total number of allocations made in each size bucket
+    size_type sizeBuckets[num_size_buckets];
+
+    // Requests made to the underlying memory source, and the time spent in
+    // them. Only available when a StatsMemorySource is attached.
+    size_type numRefills;
+    size_type numRefillBytes;
+    size_type refillTimeNs;
+    size_type numReleases;
+    size_type numReleaseBytes;
+
+    // Free-list statistics, if the wrapped allocator supports them
+    bool hasFreeList;
+    FreeListStats freeList;
+
+    /**
+     * @brief Retrieve the size bucket for an allocation of "numBytes."
+     */
+    static size_type size_bucket(size_type numBytes) noexcept;
+
+    /**
+     * @brief Retrieve the fraction of free memory which is not part of the
+     * largest free block, from 0 (contiguous) to 1 (fully fragmented).
+     */
+    double fragmentation() const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief StatsMemorySource records every request made to another memory
+ * source, along with the time spent serving it.
+ *
+ * Place one between an allocator and its memory source to measure how often
+ * the allocator refills its internal caches. This class is thread-safe if
+ * the wrapped memory source is.
+-----------------------------------------------------------------------------*/
+class StatsMemorySource final : public MemorySource
+{
+  private:
+    MemorySource* mSource;
+
+    std::atomic<size_type> mNumRefills;
+    std::atomic<size_type> mNumRefillBytes;
+    std::atomic<size_type> mRefillTimeNs;
+    std::atomic<size_type> mNumReleases;
+    std::atomic<size_type> mNumReleaseBytes;
+
+  public:
+    virtual ~StatsMemorySource() noexcept override;
+
+    StatsMemorySource() noexcept = delete;
+
+    StatsMemorySource(MemorySource& src) noexcept;
+
+    StatsMemorySource(const StatsMemorySource&) = delete;
+
+    StatsMemorySource(StatsMemorySource&&) = delete;
+
+    StatsMemorySource& operator=(const StatsMemorySource&) = delete;
+
+    StatsMemorySource& operator=(StatsMemorySource&&) = delete;
+
+    /**
+     * @brief Write the refill and release counters into a snapshot.
+     */
+    void fill_snapshot(AllocatorStatsSnapshot& outStats) const noexcept;
+
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void* allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void free(void* pData) noexcept override;
+
+    virtual void free(void* pData, size_type numBytes) noexcept override;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief StatsAllocator is an opt-in wrapper which tracks usage statistics of
+ * another allocator.
+ *
+ * By default, requests are forwarded to the wrapped allocator unchanged, so
+ * the statistics describe the same workload it would see on its own. Sizes
+ * are taken from the sized overloads of free() and reallocate(). Unsized
+ * calls are counted, but can't reduce the number of bytes in use.
+ *
+ * Callers which rely on unsized frees can opt into a 16-byte header holding
+ * each allocation's size. Be aware that the header moves every request into
+ * a larger size class of the wrapped allocator (e.g. a 48-byte request lands
+ * in a slab allocator's 64-byte class), so its memory use and free lists no
+ * longer match the un-instrumented workload. Allocations with a header are
+ * aligned to 16 bytes, regardless of the wrapped allocator's alignment.
+ *
+ * Counters are updated atomically, so *this is thread-safe if the wrapped
+ * allocator is. Free-list statistics are only gathered when a snapshot is
+ * taken, and follow the wrapped allocator's thread-safety rules.
+-----------------------------------------------------------------------------*/
+class StatsAllocator final : public IAllocator
+{
+  private:
+    enum : size_type
+    {
+        header_size = 16
+    };
+
+    IAllocator* mAllocator;
+
+    StatsMemorySource* mRefillSource;
+
+    const bool mUseSizeHeaders;
+
+    std::atomic<size_type> mBytesInUse;
+    std::atomic<size_type> mPeakBytesInUse;
+    std::atomic<size_type> mNumAllocations;
+    std::atomic<size_type> mNumFrees;
+    std::atomic<size_type> mNumFailedAllocations;
+    std::atomic<size_type> mSizeBuckets[AllocatorStatsSnapshot::num_size_buckets];
+
+    void* _track_allocation(void* pRaw, size_type numBytes, size_type* pOutNumBytes) noexcept;
+
+    void _track_free(size_type numBytes) noexcept;
+
+  protected:
+    virtual const MemorySource& memory_source() const noexcept override;
+
+    virtual MemorySource& memory_source() noexcept override;
+
+  public:
+    virtual ~StatsAllocator() noexcept override;
+
+    StatsAllocator() noexcept = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param allocator
+     * The allocator to track. It must outlive *this.
+     *
+     * @param pRefillSource
+     * Optional memory source used by "allocator," which provides refill
+     * statistics.
+     *
+     * @param useSizeHeaders
+     * Prefix each allocation with its size so unsized frees can be tracked.
+     * This changes the sizes requested from "allocator."
+     */
+    StatsAllocator(IAllocator& allocator, StatsMemorySource* pRefillSource = nullptr, bool useSizeHeaders = false) noexcept;
+
+    StatsAllocator(const StatsAllocator&) = delete;
+
+    StatsAllocator(StatsAllocator&&) = delete;
+
+    StatsAllocator& operator=(const StatsAllocator&) = delete;
+
+    StatsAllocator& operator=(StatsAllocator&&) = delete;
+
+    /**
+     * @brief Retrieve the current statistics.
+     */
+    AllocatorStatsSnapshot snapshot() const noexcept;
+
+    /**
+     * @brief Reset the peak usage to the current usage.
+     */
+    void reset_peak() noexcept;
+
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void* allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void free(void* p) noexcept override;
+
+    virtual void free(void* p, size_type n) noexcept override;
+
+    virtual bool free_list_stats(FreeListStats& outStats) const noexcept override;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief AllocatorStatsHistory keeps the most recent snapshots of a
+ * StatsAllocator, taken no more often than a fixed interval.
+ *
+ * Call poll() regularly (once per frame, per request, or from a timer). Once
+ * the history is full, the oldest snapshot is overwritten.
+-----------------------------------------------------------------------------*/
+class AllocatorStatsHistory
+{
+  public:
+    typedef unsigned long long size_type;
+
+  private:
+    UniqueArray<AllocatorStatsSnapshot> mSnapshots;
+
+    size_type mCapacity;
+
+    size_type mCount;
+
+    size_type mNext;
+
+    size_type mIntervalNs;
+
+    size_type mLastTimestampNs;
+
+  public:
+    ~AllocatorStatsHistory() noexcept = default;
+
+    AllocatorStatsHistory(size_type maxSnapshots, size_type intervalNs) noexcept;
+
+    AllocatorStatsHistory(const AllocatorStatsHistory&) = delete;
+
+    AllocatorStatsHistory(AllocatorStatsHistory&&) noexcept = default;
+
+    AllocatorStatsHistory& operator=(const AllocatorStatsHistory&) = delete;
+
+    AllocatorStatsHistory& operator=(AllocatorStatsHistory&&) noexcept = default;
+
+    /**
+     * @brief Record a snapshot if at least one interval has passed since the
+     * last one.
+     *
+     * @return TRUE if a snapshot was recorded, FALSE otherwise.
+     */
+    bool poll(const StatsAllocator& allocator) noexcept;
+
+    /**
+     * @brief Record a snapshot unconditionally.
+     */
+    void record(const AllocatorStatsSnapshot& snapshot) noexcept;
+
+    size_type size() const noexcept;
+
+    size_type capacity() const noexcept;
+
+    /**
+     * @brief Retrieve a snapshot, where index 0 is the oldest.
+     */
+    const AllocatorStatsSnapshot& operator[](size_type index) const noexcept;
+
+    void clear() noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Serialization
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Maximum number of bytes needed to encode a snapshot in binary.
+ */
+constexpr unsigned long long allocator_stats_max_binary_size() noexcept
+{
+    // Magic, version, flags, then every counter as a LEB128 varint
+    return 4ull + 1ull + 1ull + (14ull + AllocatorStatsSnapshot::num_size_buckets) * 10ull;
+}
+
+/**
+ * @brief Encode a snapshot in a compact binary form. All counters are stored
+ * as variable-length integers, so idle buckets cost a single byte.
+ *
+ * @return The number of bytes written, or 0 if "maxBytes" is too small.
+ */
+unsigned long long allocator_stats_to_binary(const AllocatorStatsSnapshot& stats, unsigned char* pOut, unsigned long long maxBytes) noexcept;
+
+/**
+ * @brief Decode a snapshot written by allocator_stats_to_binary().
+ *
+ * @return The number of bytes read, or 0 if the data is invalid.
+ */
+unsigned long long allocator_stats_from_binary(const unsigned char* pIn, unsigned long long numBytes, AllocatorStatsSnapshot& outStats) noexcept;
+
+/**
+ * @brief Encode a snapshot as a single-line JSON object.
+ */
+std::string allocator_stats_to_json(const AllocatorStatsSnapshot& stats) noexcept;
+
+/**
+ * @brief Encode a history of snapshots as a JSON array, oldest first.
+ */
+std::string allocator_stats_to_json(const AllocatorStatsHistory& history) noexcept;
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_ALLOCATOR_STATS_HPP */
@@ -12,6 +12,8 @@
 #include "lightsky/setup/Api.h"
 #include "lightsky/setup/OS.h"
 
+#include "lightsky/utils/Pointer.h"
+
 #ifndef LS_UTILS_USE_PTHREAD_BARRIER
     #if defined(LS_OS_UNIX) || defined(LS_OS_LINUX) || defined(LS_OS_MINGW)
         #define LS_UTILS_USE_PTHREAD_BARRIER 1
@@ -58,6 +60,8 @@ namespace utils
  * Forward Declarations
 -----------------------------------------------------------------------------*/
 class Barrier;
+class SenseBarrier;
+class DisseminationBarrier;
 
 #if LS_UTILS_USE_PTHREAD_BARRIER
     class SystemBarrierPThread;
@@ -131,6 +135,150 @@ public:
 
 
 
+/**----------------------------------------------------------------------------
+ * @brief Reusable, sense-reversing barrier.
+ *
+ * Each arriving thread decrements a shared counter. The last thread to arrive
+ * resets the counter and flips the barrier's phase, releasing all others.
+ * Waiting threads spin on the phase for a limited number of iterations, then
+ * sleep in the OS (a futex on Linux) until the phase changes. Unlike the
+ * common Barrier, a SenseBarrier can be waited on any number of times by the
+ * same group of threads.
+-----------------------------------------------------------------------------*/
+class SenseBarrier
+{
+public:
+    typedef std::atomic_uint32_t native_handle_type;
+
+    enum : uint32_t
+    {
+        DEFAULT_SPIN_COUNT = 4096
+    };
+
+private:
+    alignas(64) std::atomic_uint32_t mBarrierCount;
+
+    alignas(64) std::atomic_uint32_t mPhase;
+
+    std::atomic_uint32_t mNumSleepers;
+
+    const uint32_t mThreadCount;
+
+    const uint32_t mSpinCount;
+
+public:
+    ~SenseBarrier() noexcept = default;
+
+    SenseBarrier() noexcept = delete;
+
+    SenseBarrier(uint32_t numThreads, uint32_t spinCount = DEFAULT_SPIN_COUNT) noexcept;
+
+    SenseBarrier(const SenseBarrier&) noexcept = delete;
+
+    SenseBarrier(SenseBarrier&&) noexcept = delete;
+
+    SenseBarrier& operator=(const SenseBarrier&) noexcept = delete;
+
+    SenseBarrier& operator=(SenseBarrier&&) noexcept = delete;
+
+    /**
+     * @brief Wait until all required threads have arrived.
+     *
+     * @return TRUE for exactly one thread of each phase (the last to arrive),
+     * FALSE for all others.
+     */
+    bool wait() noexcept;
+
+    /**
+     * @brief Retrieve the number of times all threads have passed through
+     * the barrier.
+     */
+    uint32_t phase() const noexcept;
+
+    uint32_t num_waiting_threads() const noexcept;
+
+    uint32_t num_required_threads() const noexcept;
+
+    const native_handle_type& native_handle() const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Reusable dissemination barrier for large thread counts.
+ *
+ * Threads synchronize over ceil(log2(N)) rounds. In round "r", thread "i"
+ * signals thread "(i + 2^r) % N" and waits for a signal from thread
+ * "(i - 2^r) % N". Every thread only ever spins on flags within its own
+ * cache line, and each flag has exactly one writer, so no cache line is
+ * contended by more than two threads. Waiting threads sleep in the OS after
+ * a limited number of spins, as with the SenseBarrier.
+ *
+ * Each thread must pass its own, unique ID in [0, N) to wait().
+-----------------------------------------------------------------------------*/
+class DisseminationBarrier
+{
+public:
+    enum : uint32_t
+    {
+        MAX_ROUNDS = 32,
+        DEFAULT_SPIN_COUNT = SenseBarrier::DEFAULT_SPIN_COUNT
+    };
+
+private:
+    struct alignas(64) Node
+    {
+        // Holds the last episode signaled by this thread's partner in each
+        // round.
+        std::atomic_uint32_t flags[MAX_ROUNDS];
+
+        std::atomic_uint32_t sleeping;
+
+        // Only accessed by the owning thread
+        uint32_t episode;
+    };
+
+    const uint32_t mThreadCount;
+
+    const uint32_t mNumRounds;
+
+    const uint32_t mSpinCount;
+
+    utils::UniqueArray<Node> mNodes;
+
+    void _wait_for_signal(Node& node, uint32_t round, uint32_t episode) noexcept;
+
+public:
+    ~DisseminationBarrier() noexcept = default;
+
+    DisseminationBarrier() noexcept = delete;
+
+    DisseminationBarrier(uint32_t numThreads, uint32_t spinCount = DEFAULT_SPIN_COUNT) noexcept;
+
+    DisseminationBarrier(const DisseminationBarrier&) noexcept = delete;
+
+    DisseminationBarrier(DisseminationBarrier&&) noexcept = delete;
+
+    DisseminationBarrier& operator=(const DisseminationBarrier&) noexcept = delete;
+
+    DisseminationBarrier& operator=(DisseminationBarrier&&) noexcept = delete;
+
+    /**
+     * @brief Wait until all required threads have arrived.
+     *
+     * @param threadId
+     * The calling thread's index, unique among all threads using the
+     * barrier. IDs out of range return immediately.
+     */
+    void wait(uint32_t threadId) noexcept;
+
+    uint32_t num_rounds() const noexcept;
+
+    uint32_t num_required_threads() const noexcept;
+};
+
+
+
 /*-----------------------------------------------------------------------------
  * Pthread-based R/W Lock
 -----------------------------------------------------------------------------*/
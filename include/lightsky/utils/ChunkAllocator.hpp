@@ -2,6 +2,11 @@
 #ifndef LS_UTILS_CHUNK_ALLOCATOR_HPP
 #define LS_UTILS_CHUNK_ALLOCATOR_HPP
 
+#include <atomic>
+#include <cstdint> // uint32_t, uint64_t
+
+#include "lightsky/utils/Allocator.hpp" // FreeListStats
+
 namespace ls
 {
 namespace utils
@@ -158,6 +163,205 @@ class ChunkAllocator
      * the "n" parameter to allocate(size_type n).
      */
     void free(void* p, size_type n) noexcept;
+
+    /**
+     * @brief Count the number of chunks available for allocation.
+     */
+    bool free_list_stats(FreeListStats& outStats) const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief LockFreeChunkAllocator is a thread-safe variant of the
+ * ChunkAllocator. Any number of threads may allocate and free chunks
+ * concurrently without taking a lock.
+ *
+ * Free chunks are kept in a Treiber stack. The head of the stack packs the
+ * index of the first free chunk together with a modification counter into a
+ * single 64-bit word, so a chunk which is popped and pushed back between
+ * another thread's load and compare-exchange of the head is detected (ABA).
+ *
+ * Threads which allocate and free frequently can create a ThreadCache to
+ * batch their operations. Each cache holds up to "cache_size" chunks which
+ * only its owning thread may access, and exchanges them with the shared
+ * stack in batches of "cache_size/2."
+ *
+ * @tparam block_size
+ * The number of bytes to be allocated per chunk.
+ *
+ * @tparam total_size
+ * The total amount of bytes contained required by this allocator.
+ *
+ * @tparam cache_size
+ * The maximum number of chunks kept by each ThreadCache.
+-----------------------------------------------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size = 32>
+class LockFreeChunkAllocator
+{
+  public:
+    typedef unsigned long long size_type;
+
+    static_assert(block_size >= sizeof(size_type), "Allocation sizes must not be less than sizeof(unsigned long long).");
+    static_assert(total_size % block_size == 0,    "Cannot fit the current block size within an allocation table.");
+    static_assert(block_size < total_size,         "Block size must be less than the total byte size.");
+    static_assert(total_size / block_size < 0xFFFFFFFFull, "Too many chunks to index with 32 bits.");
+    static_assert(cache_size >= 2, "Thread caches must hold at least two chunks.");
+
+    class ThreadCache;
+
+  private:
+    /**
+     * @brief Chunk indices are offset by one so zero can mark the end of a
+     * list.
+     */
+    static constexpr uint32_t null_index = 0;
+
+    union alignas(alignof(size_type)) AllocationEntry
+    {
+        uint32_t nextIndex;
+        char memBlock[block_size];
+    };
+
+    static_assert(sizeof(AllocationEntry) == block_size, "Allocation entry meta data contains invalid padding.");
+
+    static constexpr uint64_t _pack_head(uint64_t tag, uint32_t index) noexcept;
+
+    static constexpr uint32_t _head_index(uint64_t head) noexcept;
+
+    static constexpr uint64_t _head_tag(uint64_t head) noexcept;
+
+    AllocationEntry* mAllocTable;
+
+    /**
+     * @brief Upper 32 bits contain the modification counter, the lower 32
+     * bits contain the (1-based) index of the first free chunk.
+     */
+    alignas(64) std::atomic<uint64_t> mHead;
+
+    AllocationEntry* _entry(uint32_t index) const noexcept;
+
+    uint32_t _index_of(const void* p) const noexcept;
+
+    /**
+     * @brief Push a pre-linked list of chunks onto the free stack with a
+     * single compare-and-swap.
+     */
+    void _push_list(uint32_t firstIndex, uint32_t lastIndex) noexcept;
+
+    uint32_t _pop() noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Returns all memory back to the OS. All ThreadCaches must be destroyed
+     * before their allocator.
+     */
+    ~LockFreeChunkAllocator() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Retrieves "total_size" bytes from the OS and links every chunk into
+     * the free stack.
+     */
+    LockFreeChunkAllocator() noexcept;
+
+    LockFreeChunkAllocator(const LockFreeChunkAllocator&) = delete;
+
+    LockFreeChunkAllocator(LockFreeChunkAllocator&&) = delete;
+
+    LockFreeChunkAllocator& operator=(const LockFreeChunkAllocator&) = delete;
+
+    LockFreeChunkAllocator& operator=(LockFreeChunkAllocator&&) = delete;
+
+    /**
+     * @brief Retrieve a contiguous block of memory from *this.
+     *
+     * @return A pointer to a block of "block_size" bytes, or NULL if all
+     * chunks are in use (including those held by ThreadCaches).
+     */
+    void* allocate() noexcept;
+
+    /**
+     * @brief Allocate a contiguous block of memory which is at least "n" bytes
+     * in size.
+     *
+     * @return A pointer to a block of "block_size" bytes, or NULL if "n" is
+     * greater than "block_size" or no chunks are available.
+     */
+    void* allocate(size_type n) noexcept;
+
+    /**
+     * @brief Return an allocated block of memory back to *this allocator.
+     *
+     * This function does nothing if the input pointer is NULL.
+     */
+    void free(void* p) noexcept;
+
+    /**
+     * @brief Return an allocated block of memory back to *this allocator.
+     *
+     * This function does nothing if the input pointer is NULL.
+     */
+    void free(void* p, size_type n) noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A single-threaded cache of chunks from a LockFreeChunkAllocator.
+ *
+ * Chunks may be freed through any cache, or through the allocator directly,
+ * regardless of where they were allocated. Cached chunks are returned to the
+ * allocator when the cache is destroyed.
+-----------------------------------------------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+class LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache
+{
+  private:
+    LockFreeChunkAllocator* mAllocator;
+
+    uint32_t mHead;
+
+    uint32_t mNumCached;
+
+    void _flush(uint32_t numChunks) noexcept;
+
+  public:
+    ~ThreadCache() noexcept;
+
+    ThreadCache(LockFreeChunkAllocator& allocator) noexcept;
+
+    ThreadCache(const ThreadCache&) = delete;
+
+    ThreadCache(ThreadCache&&) = delete;
+
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    ThreadCache& operator=(ThreadCache&&) = delete;
+
+    /**
+     * @brief Retrieve a chunk from the cache, refilling it from the
+     * allocator if empty.
+     */
+    void* allocate() noexcept;
+
+    void* allocate(size_type n) noexcept;
+
+    /**
+     * @brief Place a chunk into the cache, returning half of the cache to
+     * the allocator if full.
+     */
+    void free(void* p) noexcept;
+
+    void free(void* p, size_type n) noexcept;
+
+    /**
+     * @brief Return all cached chunks to the allocator.
+     */
+    void flush() noexcept;
 };
 
 
@@ -0,0 +1,428 @@
+/*
+ * File:   Coroutine.hpp
+ * Author: miles
+ * Created on October 18, 2026, at 10:15 a.m.
+ */
+
+#ifndef LS_UTILS_COROUTINE_HPP
+#define LS_UTILS_COROUTINE_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef> // std::size_t
+#include <cstdint> // uint32_t
+#include <tuple>
+#include <type_traits> // std::add_lvalue_reference_t
+
+#include "lightsky/utils/Futex.hpp"
+#include "lightsky/utils/Future.hpp" // FutureValue
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Forward Declarations
+-----------------------------------------------------------------------------*/
+template <typename T>
+class Task;
+
+class AsyncEvent;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Scheduling
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief Awaiting a ScheduleAwaitable suspends the current coroutine and
+ * resumes it on one of a thread pool's threads.
+ *
+ * PoolType may be a WorkerPool, WorkerThread, or WorkStealingPool with a
+ * task type which is constructible from a lambda, such as
+ * ls::utils::Function<void()>.
+-----------------------------------------------------------------------------*/
+template <class PoolType>
+class ScheduleAwaitable
+{
+  private:
+    PoolType* mPool;
+
+  public:
+    explicit ScheduleAwaitable(PoolType& pool) noexcept;
+
+    bool await_ready() const noexcept;
+
+    void await_suspend(std::coroutine_handle<> h) const noexcept;
+
+    void await_resume() const noexcept;
+};
+
+
+
+/**
+ * @brief Resume the calling coroutine on a thread pool.
+ *
+ * @code
+ * co_await ls::utils::schedule(pool);
+ * // now running on one of the pool's threads
+ * @endcode
+ */
+template <class PoolType>
+ScheduleAwaitable<PoolType> schedule(PoolType& pool) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tasks
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief Promise state common to all Task types. A finished Task resumes
+ * whichever coroutine awaited it, counts down a when_all() join, or signals
+ * sync_wait().
+-----------------------------------------------------------------------------*/
+class TaskPromiseBase
+{
+  public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename PromiseType>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseType> h) const noexcept;
+
+        void await_resume() const noexcept {}
+    };
+
+  private:
+    std::coroutine_handle<> mContinuation;
+
+    std::atomic<std::size_t>* mJoinCount;
+
+    AsyncEvent* mCompletionEvent;
+
+  public:
+    TaskPromiseBase() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept;
+
+    FinalAwaiter final_suspend() const noexcept;
+
+    void unhandled_exception() const noexcept;
+
+    /**
+     * @brief Set what happens once the Task finishes.
+     *
+     * @param continuation
+     * A coroutine to resume when finished, or an empty handle.
+     *
+     * @param pJoinCount
+     * Optional counter which is decremented when finished. The continuation
+     * only runs if this Task brings the count to zero.
+     *
+     * @param pEvent
+     * Optional event to set once finished, after the Task has suspended.
+     */
+    void continue_with(std::coroutine_handle<> continuation, std::atomic<std::size_t>* pJoinCount = nullptr, AsyncEvent* pEvent = nullptr) noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Promise type of a Task<T>.
+-----------------------------------------------------------------------------*/
+template <typename T>
+class TaskPromise : public TaskPromiseBase
+{
+  private:
+    FutureValue<T> mValue;
+
+    bool mHaveValue;
+
+  public:
+    ~TaskPromise() noexcept;
+
+    TaskPromise() noexcept;
+
+    Task<T> get_return_object() noexcept;
+
+    static Task<T> get_return_object_on_allocation_failure() noexcept;
+
+    template <typename U>
+    void return_value(U&& value) noexcept;
+
+    T& result() noexcept;
+};
+
+
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+  public:
+    Task<void> get_return_object() noexcept;
+
+    static Task<void> get_return_object_on_allocation_failure() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() const noexcept {}
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Task is a lazily-started coroutine which produces a value of type
+ * T.
+ *
+ * A Task does not run until it is awaited, passed to when_all(), or passed
+ * to sync_wait(). Awaiting a Task runs it on the awaiting thread until it
+ * suspends; combine it with schedule() to move work onto a thread pool.
+ *
+ * Coroutine frames are allocated with a non-throwing operator new. If the
+ * allocation fails, the returned Task is invalid. Exceptions escaping a
+ * Task terminate the program.
+-----------------------------------------------------------------------------*/
+template <typename T>
+class Task
+{
+  public:
+    typedef T value_type;
+
+    typedef TaskPromise<T> promise_type;
+
+    class Awaiter
+    {
+      private:
+        std::coroutine_handle<promise_type> mHandle;
+
+      public:
+        explicit Awaiter(std::coroutine_handle<promise_type> h) noexcept;
+
+        bool await_ready() const noexcept;
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept;
+
+        std::add_lvalue_reference_t<T> await_resume() const noexcept;
+    };
+
+  private:
+    std::coroutine_handle<promise_type> mHandle;
+
+  public:
+    ~Task() noexcept;
+
+    Task() noexcept;
+
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept;
+
+    Task(const Task&) = delete;
+
+    Task(Task&&) noexcept;
+
+    Task& operator=(const Task&) = delete;
+
+    Task& operator=(Task&&) noexcept;
+
+    bool valid() const noexcept;
+
+    /**
+     * @brief Determine if the Task has run to completion.
+     */
+    bool done() const noexcept;
+
+    /**
+     * @brief Retrieve the result of a completed Task.
+     */
+    std::add_lvalue_reference_t<T> result() noexcept;
+
+    std::coroutine_handle<promise_type> handle() const noexcept;
+
+    /**
+     * @brief Start the Task from within another coroutine and retrieve its
+     * result once it completes.
+     */
+    Awaiter operator co_await() const noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Joining
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief Awaitable which starts a set of Tasks and resumes the awaiting
+ * coroutine once all of them have completed.
+ *
+ * The count starts at one more than the number of Tasks so the awaiting
+ * coroutine cannot be resumed before every Task has been started.
+-----------------------------------------------------------------------------*/
+template <typename... TaskTypes>
+class WhenAllAwaitable
+{
+  private:
+    std::atomic<std::size_t> mRemaining;
+
+    std::tuple<TaskTypes&...> mTasks;
+
+  public:
+    explicit WhenAllAwaitable(TaskTypes&... tasks) noexcept;
+
+    bool await_ready() const noexcept;
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+    void await_resume() const noexcept {}
+};
+
+
+
+template <typename T>
+class WhenAllRangeAwaitable
+{
+  private:
+    std::atomic<std::size_t> mRemaining;
+
+    Task<T>* mTasks;
+
+    std::size_t mNumTasks;
+
+  public:
+    WhenAllRangeAwaitable(Task<T>* pTasks, std::size_t numTasks) noexcept;
+
+    bool await_ready() const noexcept;
+
+    bool await_suspend(std::coroutine_handle<> awaiting) noexcept;
+
+    void await_resume() const noexcept {}
+};
+
+
+
+/**
+ * @brief Run several Tasks concurrently and wait for all of them.
+ *
+ * The Tasks are started in order on the awaiting thread and run until they
+ * first suspend. The awaiting coroutine resumes on whichever thread
+ * finishes the last Task. Results are retrieved from each Task afterwards,
+ * using Task::result().
+ */
+template <typename... Ts>
+WhenAllAwaitable<Task<Ts>...> when_all(Task<Ts>&... tasks) noexcept;
+
+template <typename T>
+WhenAllRangeAwaitable<T> when_all(Task<T>* pTasks, std::size_t numTasks) noexcept;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Events
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief AsyncEvent is a manual-reset event which can be awaited by
+ * coroutines or waited on by threads.
+ *
+ * Suspended coroutines are kept in an intrusive list, protected by a
+ * Futex, so awaiting an event never allocates. Once set, an event stays set
+ * until reset() is called.
+-----------------------------------------------------------------------------*/
+class AsyncEvent
+{
+  public:
+    class Awaiter
+    {
+        friend class AsyncEvent;
+
+      private:
+        AsyncEvent* mEvent;
+
+        Awaiter* mNext;
+
+        std::coroutine_handle<> mHandle;
+
+      public:
+        explicit Awaiter(AsyncEvent& event) noexcept;
+
+        bool await_ready() const noexcept;
+
+        bool await_suspend(std::coroutine_handle<> h) noexcept;
+
+        void await_resume() const noexcept {}
+    };
+
+  private:
+    mutable Futex mLock;
+
+    std::atomic<uint32_t> mIsSet;
+
+    Awaiter* mWaiters;
+
+    /**
+     * @brief Mark the event as set and detach the list of suspended
+     * coroutines.
+     */
+    Awaiter* _signal() noexcept;
+
+  public:
+    ~AsyncEvent() noexcept;
+
+    AsyncEvent(bool initiallySet = false) noexcept;
+
+    AsyncEvent(const AsyncEvent&) = delete;
+
+    AsyncEvent(AsyncEvent&&) = delete;
+
+    AsyncEvent& operator=(const AsyncEvent&) = delete;
+
+    AsyncEvent& operator=(AsyncEvent&&) = delete;
+
+    bool is_set() const noexcept;
+
+    /**
+     * @brief Set the event, resuming all suspended coroutines on the calling
+     * thread and waking all blocked threads.
+     */
+    void set() noexcept;
+
+    /**
+     * @brief Set the event, resuming all suspended coroutines on a thread
+     * pool.
+     */
+    template <class PoolType>
+    void set(PoolType& pool) noexcept;
+
+    void reset() noexcept;
+
+    /**
+     * @brief Block the calling thread until the event is set.
+     */
+    void wait() const noexcept;
+
+    Awaiter operator co_await() noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Blocking
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Run a Task from outside of a coroutine, blocking the calling thread
+ * until it completes.
+ *
+ * @return The Task's result. The Task must be valid.
+ */
+template <typename T>
+std::add_lvalue_reference_t<T> sync_wait(Task<T>& task) noexcept;
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/CoroutineImpl.hpp"
+
+#endif /* LS_UTILS_COROUTINE_HPP */
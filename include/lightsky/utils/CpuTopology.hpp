@@ -0,0 +1,273 @@
+/*
+ * File:   CpuTopology.hpp
+ * Author: miles
+ * Created on October 19, 2026, at 4:10 p.m.
+ */
+
+#ifndef LS_UTILS_CPU_TOPOLOGY_HPP
+#define LS_UTILS_CPU_TOPOLOGY_HPP
+
+#include <cstddef> // std::size_t
+#include <thread>
+#include <vector>
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Enums
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Policies for pinning the threads of a pool to CPUs.
+ */
+enum class CpuPlacement : unsigned
+{
+    // Let the OS schedule threads on any CPU.
+    NONE,
+
+    // Fill the SMT siblings of a core, then neighboring cores which share a
+    // cache. Best for threads which share data.
+    COMPACT,
+
+    // Spread threads across packages, then caches, then cores, using SMT
+    // siblings last. Best for memory bandwidth-bound work.
+    SCATTER,
+
+    // One thread per physical core, never sharing a core with another
+    // thread until every core is in use.
+    PHYSICAL_CORES,
+
+    // Let each thread float across all CPUs of a NUMA node rather than
+    // pinning it to one CPU.
+    NUMA_NODE
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Location of a logical CPU within the system.
+ *
+ * All IDs other than "id" are dense, starting from 0, and are only
+ * meaningful within the topology they came from.
+-----------------------------------------------------------------------------*/
+struct CpuInfo
+{
+    // Logical CPU number used by the OS
+    unsigned id;
+
+    // Physical core this CPU belongs to
+    unsigned core;
+
+    // Position of this CPU among the SMT siblings of its core
+    unsigned smtIndex;
+
+    unsigned package;
+
+    unsigned numaNode;
+
+    // Groups of CPUs sharing a unified L2 or L3 cache
+    unsigned l2Cache;
+
+    unsigned l3Cache;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief CpuTopology describes how the logical CPUs of a system are grouped
+ * into cores, caches, packages, and NUMA nodes.
+ *
+ * On Linux the topology is read from /sys/devices/system. Elsewhere, or if
+ * sysfs is unavailable, every CPU reported by the standard library is
+ * treated as its own core in a single package and NUMA node.
+-----------------------------------------------------------------------------*/
+class CpuTopology
+{
+  private:
+    std::vector<CpuInfo> mCpus;
+
+    unsigned mNumCores;
+
+    unsigned mNumPackages;
+
+    unsigned mNumNodes;
+
+    unsigned mNumL2Caches;
+
+    unsigned mNumL3Caches;
+
+  public:
+    ~CpuTopology() noexcept = default;
+
+    CpuTopology() noexcept;
+
+    CpuTopology(const CpuTopology&) = default;
+
+    CpuTopology(CpuTopology&&) noexcept = default;
+
+    CpuTopology& operator=(const CpuTopology&) = default;
+
+    CpuTopology& operator=(CpuTopology&&) noexcept = default;
+
+    /**
+     * @brief Retrieve the topology of the running system. It is discovered
+     * once, on first use.
+     */
+    static const CpuTopology& system() noexcept;
+
+    /**
+     * @brief Read a topology from a sysfs tree.
+     *
+     * @param sysfsRoot
+     * The directory containing the "cpu" and "node" directories.
+     *
+     * @return TRUE if the topology was read, FALSE if it could not be and a
+     * flat topology was loaded instead.
+     */
+    bool load(const char* sysfsRoot = "/sys/devices/system") noexcept;
+
+    /**
+     * @brief Load a topology of "numCpus" independent cores.
+     */
+    void load_flat(unsigned numCpus) noexcept;
+
+    const std::vector<CpuInfo>& cpus() const noexcept;
+
+    std::size_t num_cpus() const noexcept;
+
+    unsigned num_cores() const noexcept;
+
+    unsigned num_packages() const noexcept;
+
+    unsigned num_numa_nodes() const noexcept;
+
+    unsigned num_l2_caches() const noexcept;
+
+    unsigned num_l3_caches() const noexcept;
+
+    /**
+     * @brief Retrieve the logical CPU numbers belonging to a NUMA node, or
+     * all CPUs if "numaNode" is negative.
+     */
+    std::vector<unsigned> node_cpus(int numaNode = -1) const noexcept;
+
+    /**
+     * @brief Retrieve the order in which threads should be assigned to
+     * logical CPUs for a placement policy. Thread "i" of a pool belongs on
+     * CPU "order[i % order.size()]".
+     *
+     * @param numaNode
+     * Restrict the placement to one NUMA node, or use all nodes if
+     * negative.
+     */
+    std::vector<unsigned> placement_order(CpuPlacement policy, int numaNode = -1) const noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Thread Placement
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Pin a thread according to a placement policy, using the system
+ * topology.
+ *
+ * @param threadIndex
+ * The index of the thread within its pool. Threads with consecutive
+ * indices are placed according to the policy.
+ *
+ * @param numaNode
+ * Keep the thread within one NUMA node, or use all nodes if negative. For
+ * CpuPlacement::NUMA_NODE with a negative node, threads are distributed
+ * round-robin across all nodes.
+ *
+ * @return TRUE if the thread's affinity was set, FALSE otherwise.
+ */
+bool place_thread(std::thread& t, CpuPlacement policy, std::size_t threadIndex, int numaNode = -1) noexcept;
+
+/**
+ * @brief Pin all threads of a pool according to a placement policy. See
+ * place_thread().
+ */
+bool place_threads(std::vector<std::thread>& threads, CpuPlacement policy, int numaNode = -1) noexcept;
+
+
+
+/*-------------------------------------
+ * CPU list
+-------------------------------------*/
+inline const std::vector<CpuInfo>& CpuTopology::cpus() const noexcept
+{
+    return mCpus;
+}
+
+
+
+/*-------------------------------------
+ * Logical CPU count
+-------------------------------------*/
+inline std::size_t CpuTopology::num_cpus() const noexcept
+{
+    return mCpus.size();
+}
+
+
+
+/*-------------------------------------
+ * Physical core count
+-------------------------------------*/
+inline unsigned CpuTopology::num_cores() const noexcept
+{
+    return mNumCores;
+}
+
+
+
+/*-------------------------------------
+ * Package count
+-------------------------------------*/
+inline unsigned CpuTopology::num_packages() const noexcept
+{
+    return mNumPackages;
+}
+
+
+
+/*-------------------------------------
+ * NUMA node count
+-------------------------------------*/
+inline unsigned CpuTopology::num_numa_nodes() const noexcept
+{
+    return mNumNodes;
+}
+
+
+
+/*-------------------------------------
+ * L2 cache count
+-------------------------------------*/
+inline unsigned CpuTopology::num_l2_caches() const noexcept
+{
+    return mNumL2Caches;
+}
+
+
+
+/*-------------------------------------
+ * L3 cache count
+-------------------------------------*/
+inline unsigned CpuTopology::num_l3_caches() const noexcept
+{
+    return mNumL3Caches;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_CPU_TOPOLOGY_HPP */
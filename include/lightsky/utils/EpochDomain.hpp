@@ -0,0 +1,267 @@
+/*
+ * File:   EpochDomain.hpp
+ * Author: miles
+ * Created on October 20, 2026, at 6:30 p.m.
+ */
+
+#ifndef LS_UTILS_EPOCH_DOMAIN_HPP
+#define LS_UTILS_EPOCH_DOMAIN_HPP
+
+#include <atomic>
+#include <cstddef> // std::size_t
+#include <cstdint> // uint64_t
+#include <mutex>
+#include <vector>
+
+#include "lightsky/utils/Allocator.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Memory retired to an EpochDomain, waiting to be freed.
+-----------------------------------------------------------------------------*/
+struct EpochRetired
+{
+    void* pData;
+
+    // Passed to IAllocator::free() if non-zero
+    IAllocator::size_type numBytes;
+
+    IAllocator* pAllocator;
+
+    // Optional, run before the memory is freed
+    void (*destroy)(void*) noexcept;
+
+    // Global epoch at the time of retirement
+    uint64_t epoch;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A thread's registration with an EpochDomain.
+ *
+ * Records are owned by their domain and re-used after a thread unregisters.
+ * All members other than "epoch" are private to the registered thread.
+-----------------------------------------------------------------------------*/
+struct alignas(64) EpochRecord
+{
+    // (epoch << 1) | 1 while online, 0 while offline
+    std::atomic<uint64_t> epoch;
+
+    std::atomic_bool inUse;
+
+    // Immutable once the record is published
+    EpochRecord* pNext;
+
+    // Retired memory, bucketed by the epoch it was retired in. At most three
+    // epochs can be pending at once.
+    std::vector<EpochRetired> limbo[3];
+
+    std::size_t numRetired;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief EpochDomain provides epoch-based memory reclamation (EBR) for
+ * lock-free data structures.
+ *
+ * A global epoch advances once every online thread has announced the
+ * current one. Memory unlinked from a shared structure is retired, tagged
+ * with the epoch at the time, and handed back to its IAllocator once the
+ * global epoch is two ahead. By then, every thread which could have seen
+ * it has passed through a quiescent state.
+ *
+ * Threads register once, then mark quiescent states (points where they hold
+ * no references into shared structures) through quiescent(). Threads which
+ * block or idle for long periods should go offline() so they don't hold back
+ * reclamation. Retired memory is kept per-thread and freed in batches, so
+ * retiring does not touch shared state until a batch fills up.
+ *
+ * A record must only be used by the thread which registered it.
+-----------------------------------------------------------------------------*/
+class EpochDomain
+{
+  public:
+    enum : std::size_t
+    {
+        DEFAULT_BATCH_SIZE = 64
+    };
+
+  private:
+    alignas(64) std::atomic<uint64_t> mEpoch;
+
+    // Records are only ever prepended, and never removed until destruction
+    alignas(64) std::atomic<EpochRecord*> mRecords;
+
+    const std::size_t mBatchSize;
+
+    // Memory left behind by unregistered threads
+    std::mutex mOrphanLock;
+
+    std::atomic_size_t mNumOrphans;
+
+    std::vector<EpochRetired> mOrphans;
+
+    void _announce(EpochRecord* pRecord) noexcept;
+
+    void _retire(EpochRecord* pRecord, void* pData, IAllocator& allocator, IAllocator::size_type numBytes, void (*destroy)(void*) noexcept) noexcept;
+
+    void _reclaim(EpochRecord* pRecord) noexcept;
+
+    void _reclaim_orphans() noexcept;
+
+  public:
+    ~EpochDomain() noexcept;
+
+    EpochDomain(std::size_t batchSize = DEFAULT_BATCH_SIZE) noexcept;
+
+    EpochDomain(const EpochDomain&) = delete;
+
+    EpochDomain(EpochDomain&&) = delete;
+
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    EpochDomain& operator=(EpochDomain&&) = delete;
+
+    /**
+     * @brief Retrieve the current global epoch.
+     */
+    uint64_t epoch() const noexcept;
+
+    std::size_t batch_size() const noexcept;
+
+    /**
+     * @brief Register the calling thread. The thread starts online, at the
+     * current epoch.
+     */
+    EpochRecord* register_thread() noexcept;
+
+    /**
+     * @brief Unregister a thread. Its pending memory is handed to the domain
+     * and freed by other threads, or on destruction.
+     */
+    void unregister_thread(EpochRecord* pRecord) noexcept;
+
+    /**
+     * @brief Mark a quiescent state, where the thread holds no references
+     * into structures protected by this domain. Also frees any of the
+     * thread's retired memory, or memory left by unregistered threads,
+     * which has become safe.
+     */
+    void quiescent(EpochRecord* pRecord) noexcept;
+
+    /**
+     * @brief Stop holding back reclamation while the thread does not touch
+     * any protected structures.
+     */
+    void offline(EpochRecord* pRecord) noexcept;
+
+    /**
+     * @brief Resume accessing protected structures after going offline.
+     */
+    void online(EpochRecord* pRecord) noexcept;
+
+    /**
+     * @brief Attempt to advance the global epoch.
+     *
+     * @return TRUE if every online thread had announced the current epoch
+     * and the epoch was advanced, FALSE otherwise.
+     */
+    bool try_advance() noexcept;
+
+    /**
+     * @brief Defer freeing memory until no thread can be referencing it.
+     *
+     * @param numBytes
+     * The allocation's size, passed to IAllocator::free() if non-zero.
+     */
+    void retire(EpochRecord* pRecord, void* pData, IAllocator& allocator, IAllocator::size_type numBytes = 0) noexcept;
+
+    /**
+     * @brief Defer destroying and freeing an object until no thread can be
+     * referencing it.
+     */
+    template <typename T>
+    void retire_object(EpochRecord* pRecord, T* pObject, IAllocator& allocator) noexcept;
+
+    /**
+     * @brief Wait until all memory retired by the calling thread has been
+     * freed. This marks a quiescent state, and every other online thread
+     * must continue to mark quiescent states for this to return.
+     */
+    void synchronize(EpochRecord* pRecord) noexcept;
+
+    /**
+     * @brief Retrieve the number of retired allocations the calling thread
+     * has yet to free.
+     */
+    std::size_t num_pending(const EpochRecord* pRecord) const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Global epoch
+-------------------------------------*/
+inline uint64_t EpochDomain::epoch() const noexcept
+{
+    return mEpoch.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Reclamation batch size
+-------------------------------------*/
+inline std::size_t EpochDomain::batch_size() const noexcept
+{
+    return mBatchSize;
+}
+
+
+
+/*-------------------------------------
+ * Pending frees
+-------------------------------------*/
+inline std::size_t EpochDomain::num_pending(const EpochRecord* pRecord) const noexcept
+{
+    return pRecord->numRetired;
+}
+
+
+
+/*-------------------------------------
+ * Retire memory
+-------------------------------------*/
+inline void EpochDomain::retire(EpochRecord* pRecord, void* pData, IAllocator& allocator, IAllocator::size_type numBytes) noexcept
+{
+    _retire(pRecord, pData, allocator, numBytes, nullptr);
+}
+
+
+
+/*-------------------------------------
+ * Retire an object
+-------------------------------------*/
+template <typename T>
+inline void EpochDomain::retire_object(EpochRecord* pRecord, T* pObject, IAllocator& allocator) noexcept
+{
+    _retire(pRecord, static_cast<void*>(pObject), allocator, sizeof(T), [](void* p) noexcept -> void
+    {
+        static_cast<T*>(p)->~T();
+    });
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_EPOCH_DOMAIN_HPP */
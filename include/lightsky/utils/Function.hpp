@@ -7,6 +7,8 @@
 #ifndef LS_UTILS_FUNCTION_HPP
 #define LS_UTILS_FUNCTION_HPP
 
+#include <type_traits> // std::decay_t
+
 #include "lightsky/utils/Copy.h" // fast_memcpy(), fast_memset()
 
 namespace ls
@@ -303,12 +305,14 @@ public:
     ~Function();
     Function() noexcept;
     Function(const Function&) noexcept;
+    Function(Function&) noexcept;
     Function(Function&&) noexcept;
 
     template <typename Callable>
     Function(Callable&&) noexcept;
 
     Function& operator=(const Function&) noexcept;
+    Function& operator=(Function&) noexcept;
     Function& operator=(Function&&) noexcept;
 
     template <typename Callable>
@@ -344,12 +348,14 @@ public:
     ~Function();
     Function() noexcept;
     Function(const Function&) noexcept;
+    Function(Function&) noexcept;
     Function(Function&&) noexcept;
 
     template <typename Callable>
     Function(Callable&&) noexcept;
 
     Function& operator=(const Function&) noexcept;
+    Function& operator=(Function&) noexcept;
     Function& operator=(Function&&) noexcept;
 
     template <typename Callable>
@@ -0,0 +1,350 @@
+/*
+ * File:   Future.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 5:10 p.m.
+ */
+
+#ifndef LS_UTILS_FUTURE_HPP
+#define LS_UTILS_FUTURE_HPP
+
+#include <atomic>
+#include <cstdint> // uint32_t
+#include <type_traits> // std::invoke_result_t, std::decay_t
+
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Forward Declarations
+-----------------------------------------------------------------------------*/
+template <typename T>
+class Future;
+
+template <typename T>
+class Promise;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Future Result Storage
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Uninitialized storage for a result
+-------------------------------------*/
+template <typename T>
+class FutureValue
+{
+  private:
+    alignas(T) unsigned char mData[sizeof(T)];
+
+  public:
+    template <typename... ArgsType>
+    void construct(ArgsType&&... args) noexcept;
+
+    void destroy() noexcept;
+
+    T& get() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Empty storage for void results
+-------------------------------------*/
+template <>
+class FutureValue<void>
+{
+  public:
+    void construct() noexcept {}
+
+    void destroy() noexcept {}
+
+    void get() noexcept {}
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Shared state between a Future and its Promises
+-----------------------------------------------------------------------------*/
+enum FutureStatus : uint32_t
+{
+    FUTURE_STATUS_PENDING,
+    FUTURE_STATUS_SETTING,
+    FUTURE_STATUS_READY,
+    FUTURE_STATUS_BROKEN
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief FutureState is the single allocation shared by a Future and its
+ * Promises. It holds the result, a reference count, and at most one
+ * continuation.
+ *
+ * This is an implementation detail of Future and Promise.
+-----------------------------------------------------------------------------*/
+template <typename T>
+class FutureState
+{
+  public:
+    typedef ls::utils::Function<void(FutureState<T>*)> continuation_type;
+
+  private:
+    std::atomic<uint32_t> mRefs;
+
+    std::atomic<uint32_t> mNumPromises;
+
+    std::atomic<uint32_t> mStatus;
+
+    utils::SpinLock mLock;
+
+    bool mHaveContinuation;
+
+    continuation_type mContinuation;
+
+    FutureValue<T> mValue;
+
+    /**
+     * @brief Publish the final status and run the continuation, if any.
+     */
+    void _finish(FutureStatus status) noexcept;
+
+  public:
+    ~FutureState() noexcept;
+
+    FutureState() noexcept;
+
+    FutureState(const FutureState&) = delete;
+
+    FutureState(FutureState&&) = delete;
+
+    FutureState& operator=(const FutureState&) = delete;
+
+    FutureState& operator=(FutureState&&) = delete;
+
+    void retain() noexcept;
+
+    void release() noexcept;
+
+    void retain_promise() noexcept;
+
+    /**
+     * @brief Release a reference held by a Promise. The state becomes broken
+     * if the last Promise goes away without setting a value.
+     */
+    void release_promise() noexcept;
+
+    FutureStatus status() const noexcept;
+
+    /**
+     * @brief Block until a value has been set or the state was broken.
+     */
+    void wait() const noexcept;
+
+    /**
+     * @brief Construct the result. Only the first call succeeds.
+     */
+    template <typename... ArgsType>
+    bool set_value(ArgsType&&... args) noexcept;
+
+    /**
+     * @brief Attach a continuation, taking over one reference to *this.
+     *
+     * If a value is already available, the continuation is run immediately
+     * on the calling thread. Otherwise, it runs on the thread which sets the
+     * value.
+     */
+    void attach(continuation_type&& continuation) noexcept;
+
+    FutureValue<T>& value() noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Future
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Type of the Future returned by a continuation which accepts the
+ * result of a Future<T>.
+ */
+template <typename T, typename Func>
+struct FutureContinuationResult
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&, T&&> type;
+};
+
+template <typename Func>
+struct FutureContinuationResult<void, Func>
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&> type;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Future is the consumer side of an asynchronous result.
+ *
+ * Unlike std::future, a Future and all of its Promises share a single,
+ * reference-counted allocation, and continuations are stored using
+ * ls::utils::Function rather than a separate heap-allocated callable.
+ *
+ * Futures are move-only. Calling then() consumes the Future, leaving it
+ * invalid.
+-----------------------------------------------------------------------------*/
+template <typename T>
+class Future
+{
+    friend class Promise<T>;
+
+  public:
+    typedef T value_type;
+
+  private:
+    FutureState<T>* mState;
+
+    explicit Future(FutureState<T>* pState) noexcept;
+
+  public:
+    ~Future() noexcept;
+
+    Future() noexcept;
+
+    Future(const Future&) = delete;
+
+    Future(Future&&) noexcept;
+
+    Future& operator=(const Future&) = delete;
+
+    Future& operator=(Future&&) noexcept;
+
+    /**
+     * @brief Determine if *this refers to a shared state.
+     */
+    bool valid() const noexcept;
+
+    /**
+     * @brief Determine if a value has been set, or if every Promise was
+     * destroyed without setting one.
+     */
+    bool ready() const noexcept;
+
+    /**
+     * @brief Determine if *this holds a value. Only meaningful once ready()
+     * returns true.
+     */
+    bool has_value() const noexcept;
+
+    /**
+     * @brief Block until ready() returns true.
+     */
+    void wait() const noexcept;
+
+    /**
+     * @brief Wait for, then retrieve, the result. The result must exist
+     * (see has_value()).
+     */
+    std::add_lvalue_reference_t<T> get() noexcept;
+
+    /**
+     * @brief Attach a continuation which receives the result of *this.
+     *
+     * The continuation runs on whichever thread completes *this, or
+     * immediately on the calling thread if *this is already complete. If
+     * *this completes without a value, the continuation is dropped and the
+     * returned Future completes without a value as well.
+     *
+     * @param func
+     * A copyable callable accepting "T&&" (or nothing, if T is void).
+     *
+     * @return A Future holding the result of "func". An invalid Future is
+     * returned if *this is invalid, or if memory could not be allocated.
+     */
+    template <typename Func>
+    Future<typename FutureContinuationResult<T, Func>::type> then(Func&& func) noexcept;
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Promise
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief Promise is the producer side of an asynchronous result.
+ *
+ * Promises are copyable handles so they can be captured by tasks stored in
+ * an ls::utils::Function. Only the first value set through any copy takes
+ * effect. When every copy is destroyed without setting a value, the
+ * associated Future becomes ready without holding a value.
+ *
+ * Setting a value does not modify the Promise itself, so all setters are
+ * const.
+-----------------------------------------------------------------------------*/
+template <typename T>
+class Promise
+{
+  public:
+    typedef T value_type;
+
+  private:
+    FutureState<T>* mState;
+
+  public:
+    ~Promise() noexcept;
+
+    /**
+     * @brief Constructor
+     *
+     * Allocates the shared state. Check valid() to determine if the
+     * allocation succeeded.
+     */
+    Promise() noexcept;
+
+    Promise(const Promise&) noexcept;
+
+    Promise(Promise&&) noexcept;
+
+    Promise& operator=(const Promise&) noexcept;
+
+    Promise& operator=(Promise&&) noexcept;
+
+    bool valid() const noexcept;
+
+    /**
+     * @brief Retrieve a Future referencing the same shared state.
+     */
+    Future<T> get_future() const noexcept;
+
+    /**
+     * @brief Set the result.
+     *
+     * @return TRUE if the value was set, FALSE if a value was already set.
+     */
+    template <typename... ArgsType>
+    bool set_value(ArgsType&&... args) const noexcept;
+
+    /**
+     * @brief Invoke a callable and set the result to its return value.
+     */
+    template <typename Func, typename... ArgsType>
+    bool set_value_from(const Func& func, ArgsType&&... args) const noexcept;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/FutureImpl.hpp"
+
+#endif /* LS_UTILS_FUTURE_HPP */
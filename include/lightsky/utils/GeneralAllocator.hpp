@@ -273,6 +273,12 @@ class GeneralAllocator final : public Allocator
      * the "n" parameter to allocate() or allocate_contiguous().
      */
     virtual void free(void* p, size_type n) noexcept override;
+
+    /**
+     * @brief Walk the free list to determine how much memory is available
+     * and how fragmented it is.
+     */
+    virtual bool free_list_stats(FreeListStats& outStats) const noexcept override;
 };
 
 
@@ -0,0 +1,251 @@
+/*
+ * File:   LinearAllocator.hpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 10:10 AM
+ */
+
+#ifndef LS_UTILS_LINEAR_ALLOCATOR_HPP
+#define LS_UTILS_LINEAR_ALLOCATOR_HPP
+
+#include "lightsky/utils/Allocator.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief LinearAllocator is a region ("bump") allocator for short-lived
+ * scratch memory.
+ *
+ * Each allocation advances a pointer through the current block, so the cost
+ * of an allocation is a single add and compare. Individual allocations are
+ * not freed. Instead, a marker can be taken at any point and every
+ * allocation made after it can be released at once with rewind(), or by
+ * letting a LinearAllocator::Scope go out of scope. Only the most recent
+ * allocation can be freed, or resized in-place, on its own.
+ *
+ * When the current block is exhausted, a new block is retrieved from the
+ * memory source and chained to the previous one, unless growth was disabled
+ * at construction. Blocks released by a rewind are returned to the memory
+ * source, except for one spare block which is kept to avoid repeatedly
+ * allocating and freeing a block across a boundary.
+ *
+ * All allocations are aligned to "alignment" bytes. This allocator is not
+ * thread-safe.
+-----------------------------------------------------------------------------*/
+class LinearAllocator final : public Allocator
+{
+  public:
+    enum : size_type
+    {
+        alignment = 16ull,
+        default_block_size = 64ull * 1024ull
+    };
+
+    /**
+     * @brief A position in the allocator which can be rewound to. Markers
+     * are invalidated by rewinding to an earlier marker.
+     */
+    struct Marker
+    {
+        void* pBlock;
+        char* pHead;
+    };
+
+    class Scope;
+
+  private:
+    struct alignas(alignment) Block
+    {
+        Block* pPrev;
+        char* pEnd;
+
+        // Position of the bump pointer when the next block was chained
+        char* pUsed;
+
+        size_type rawBytes;
+    };
+
+    static_assert(sizeof(Block) % alignment == 0, "Linear allocator block header breaks alignment.");
+
+    size_type mBlockSize;
+
+    bool mCanGrow;
+
+    char* mHead;
+
+    char* mEnd;
+
+    char* mLastAlloc;
+
+    Block* mBlocks;
+
+    Block* mSpare;
+
+    static char* _block_begin(Block* pBlock) noexcept;
+
+    /**
+     * @brief Chain a new block capable of holding at least "numBytes" and
+     * allocate from it.
+     */
+    void* _allocate_from_new_block(size_type numBytes) noexcept;
+
+    void _release_block(Block* pBlock) noexcept;
+
+    void _release_all() noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Returns all blocks back to the memory source.
+     */
+    virtual ~LinearAllocator() noexcept override;
+
+    /**
+     * @brief Default Constructor
+     *
+     * Deleted so a memory source is always provided.
+     */
+    LinearAllocator() noexcept = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * No memory is requested from the memory source until the first
+     * allocation.
+     *
+     * @param memorySource
+     * The memory source which provides each block.
+     *
+     * @param blockSize
+     * The size of each block, including its header. Allocations which do not
+     * fit in a block of this size are given a block of their own.
+     *
+     * @param canGrow
+     * If false, only a single block is ever requested and allocations fail
+     * once it is exhausted.
+     */
+    LinearAllocator(MemorySource& memorySource, size_type blockSize = default_block_size, bool canGrow = true) noexcept;
+
+    LinearAllocator(const LinearAllocator&) = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all blocks from the input allocator into *this. Markers taken
+     * from the input allocator remain valid for *this.
+     */
+    LinearAllocator(LinearAllocator&&) noexcept;
+
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Returns all memory in *this to the memory source, then moves all data
+     * from the input allocator into *this.
+     */
+    LinearAllocator& operator=(LinearAllocator&&) noexcept;
+
+    /**
+     * @brief Retrieve a marker for the current allocation position.
+     */
+    Marker mark() const noexcept;
+
+    /**
+     * @brief Release every allocation made after a marker was taken.
+     */
+    void rewind(const Marker& marker) noexcept;
+
+    /**
+     * @brief Release all allocations. The oldest block is kept for reuse.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes currently allocated, including
+     * alignment padding.
+     */
+    size_type bytes_used() const noexcept;
+
+    /**
+     * @brief Retrieve the total number of bytes retrieved from the memory
+     * source, including the spare block.
+     */
+    size_type capacity() const noexcept;
+
+    /**
+     * @brief Allocate a block of memory which is at least "numBytes" in size.
+     */
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Allocate an array of elements and zero-initialize the
+     * allocation.
+     */
+    virtual void* allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Reallocate a prior allocation, following the rules of
+     * std::realloc(). The most recent allocation is resized in-place when
+     * possible.
+     */
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Free an allocation. Only the most recent allocation is
+     * reclaimed, all others are released by rewind() or reset().
+     */
+    virtual void free(void* p) noexcept override;
+
+    virtual void free(void* p, size_type n) noexcept override;
+
+    /**
+     * @brief Report the unused remainder of the current block, and the spare
+     * block, as free memory.
+     */
+    virtual bool free_list_stats(FreeListStats& outStats) const noexcept override;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief RAII guard which rewinds a LinearAllocator to the position it was
+ * at when the guard was constructed.
+-----------------------------------------------------------------------------*/
+class LinearAllocator::Scope
+{
+  private:
+    LinearAllocator& mAllocator;
+
+    Marker mMarker;
+
+  public:
+    ~Scope() noexcept;
+
+    Scope(LinearAllocator& allocator) noexcept;
+
+    Scope(const Scope&) = delete;
+
+    Scope(Scope&&) = delete;
+
+    Scope& operator=(const Scope&) = delete;
+
+    Scope& operator=(Scope&&) = delete;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/LinearAllocatorImpl.hpp"
+
+#endif /* LS_UTILS_LINEAR_ALLOCATOR_HPP */
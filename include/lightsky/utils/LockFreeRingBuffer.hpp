@@ -0,0 +1,161 @@
+/*
+ * File:   LockFreeRingBuffer.hpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 1:40 PM
+ */
+
+#ifndef LS_UTILS_LOCK_FREE_RING_BUFFER_HPP
+#define LS_UTILS_LOCK_FREE_RING_BUFFER_HPP
+
+#include <atomic>
+
+#include "lightsky/utils/Pointer.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**
+ * Bounded, wait-free ring buffer for exactly one producer thread and one
+ * consumer thread.
+ *
+ * The capacity is fixed at construction and rounded up to the next power of
+ * two. Each side keeps a private copy of the other side's counter so the
+ * shared cache line is only read when the buffer appears full or empty.
+ */
+template <typename T>
+class SpscRingBuffer
+{
+public:
+    typedef T value_type;
+    typedef unsigned long long size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+private:
+    // Consumer-owned
+    alignas(64) std::atomic<unsigned long long> mHead;
+    unsigned long long mCachedTail;
+
+    // Producer-owned
+    alignas(64) std::atomic<unsigned long long> mTail;
+    unsigned long long mCachedHead;
+
+    // Read-only after construction
+    alignas(64) unsigned long long mCapacity;
+    unsigned long long mMask;
+    ls::utils::Pointer<T[]> mData;
+
+    bool _reserve_slot(unsigned long long tail) noexcept;
+
+public:
+    ~SpscRingBuffer() noexcept = default;
+
+    SpscRingBuffer(size_type requestedCapacity = 0) noexcept;
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+
+    SpscRingBuffer(SpscRingBuffer&&) = delete;
+
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+    bool empty() const noexcept;
+
+    bool full() const noexcept;
+
+    size_type size() const noexcept;
+
+    size_type capacity() const noexcept;
+
+    bool push(const_reference val) noexcept;
+
+    bool push(T&& val) noexcept;
+
+    template <typename... ArgsType>
+    bool emplace(ArgsType&&... args) noexcept;
+
+    bool pop(reference result) noexcept;
+};
+
+
+
+/**
+ * Bounded, lock-free ring buffer for any number of producer and consumer
+ * threads.
+ *
+ * Each slot carries a sequence number which tells producers and consumers
+ * whether the slot is free for the current lap of the buffer, so threads only
+ * contend on the head or tail counter they need to advance. The capacity is
+ * fixed at construction and rounded up to the next power of two (minimum 2).
+ */
+template <typename T>
+class MpmcRingBuffer
+{
+public:
+    typedef T value_type;
+    typedef unsigned long long size_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+private:
+    struct Slot
+    {
+        std::atomic<unsigned long long> sequence;
+        T value;
+    };
+
+    alignas(64) std::atomic<unsigned long long> mHead;
+
+    alignas(64) std::atomic<unsigned long long> mTail;
+
+    alignas(64) unsigned long long mCapacity;
+    unsigned long long mMask;
+    ls::utils::Pointer<Slot[]> mData;
+
+    Slot* _acquire_push_slot(unsigned long long& outPos) noexcept;
+
+public:
+    ~MpmcRingBuffer() noexcept = default;
+
+    MpmcRingBuffer(size_type requestedCapacity = 0) noexcept;
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+
+    MpmcRingBuffer(MpmcRingBuffer&&) = delete;
+
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    MpmcRingBuffer& operator=(MpmcRingBuffer&&) = delete;
+
+    bool empty() const noexcept;
+
+    bool full() const noexcept;
+
+    size_type size() const noexcept;
+
+    size_type capacity() const noexcept;
+
+    bool push(const_reference val) noexcept;
+
+    bool push(T&& val) noexcept;
+
+    template <typename... ArgsType>
+    bool emplace(ArgsType&&... args) noexcept;
+
+    bool pop(reference result) noexcept;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/LockFreeRingBufferImpl.hpp"
+
+#endif /* LS_UTILS_LOCK_FREE_RING_BUFFER_HPP */
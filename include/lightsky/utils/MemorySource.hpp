@@ -8,6 +8,7 @@
 #ifndef LS_UTILS_MEMORY_SOURCE_HPP
 #define LS_UTILS_MEMORY_SOURCE_HPP
 
+#include <cstdint> // uint32_t
 
 namespace ls
 {
@@ -36,6 +37,14 @@ class MemorySource
 
     virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept = 0;
 
+    /**
+     * @brief Allocate memory aligned to "alignment" bytes, a power of two.
+     *
+     * The memory is released through free(), like any other allocation.
+     * Sources which can't align their memory return NULL.
+     */
+    virtual void* allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes = nullptr) noexcept;
+
     virtual void free(void* pData) noexcept = 0;
     virtual void free(void* pData, size_type numBytes) noexcept = 0;
 };
@@ -61,12 +70,34 @@ class MallocMemorySource final : public MemorySource
 
     virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
 
+    virtual void* allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes = nullptr) noexcept override;
+
     virtual void free(void* pData) noexcept override;
     virtual void free(void* pData, size_type numBytes) noexcept override;
 };
 
 
 
+/*-----------------------------------------------------------------------------
+ * System Memory Page Modes
+-----------------------------------------------------------------------------*/
+enum class SystemPageMode : uint32_t
+{
+    // Regular pages
+    SYSTEM_PAGES_DEFAULT,
+
+    // Regular pages, aligned and sized so the OS may back them with
+    // transparent huge pages (madvise(MADV_HUGEPAGE) on Linux).
+    SYSTEM_PAGES_TRANSPARENT_HUGE,
+
+    // Explicit huge pages (MAP_HUGETLB on Linux, MEM_LARGE_PAGES on
+    // Windows). Falls back to SYSTEM_PAGES_TRANSPARENT_HUGE if the system
+    // has no huge pages reserved.
+    SYSTEM_PAGES_HUGE
+};
+
+
+
 /*-----------------------------------------------------------------------------
  * System-based Memory Source (currently mmap on posix systems)
 -----------------------------------------------------------------------------*/
@@ -75,11 +106,28 @@ class SystemMemorySource final : public MemorySource
   public:
     static size_type page_size() noexcept;
 
+    static size_type huge_page_size() noexcept;
+
+  private:
+    SystemPageMode mPageMode;
+
+    // NUMA node to bind allocations to, or -1 for the default (first-touch)
+    // policy.
+    int mNumaNode;
+
+    // Allocation granularity for the page mode. Queried once on construction
+    // since reading the huge page size touches the filesystem.
+    size_type mPageGranularity;
+
+    static size_type _page_granularity(SystemPageMode pageMode) noexcept;
+
   public:
     virtual ~SystemMemorySource() noexcept override;
 
     SystemMemorySource() noexcept;
 
+    SystemMemorySource(SystemPageMode pageMode, int numaNode = -1) noexcept;
+
     SystemMemorySource(const SystemMemorySource&) noexcept;
 
     SystemMemorySource(SystemMemorySource&& allocator) noexcept;
@@ -88,8 +136,14 @@ class SystemMemorySource final : public MemorySource
 
     SystemMemorySource& operator=(SystemMemorySource&& allocator) noexcept;
 
+    SystemPageMode page_mode() const noexcept;
+
+    int numa_node() const noexcept;
+
     virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
 
+    virtual void* allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes = nullptr) noexcept override;
+
     virtual void free(void* pData) noexcept override;
     virtual void free(void* pData, size_type numBytes) noexcept override;
 };
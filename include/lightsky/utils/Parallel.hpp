@@ -0,0 +1,171 @@
+/*
+ * File:   Parallel.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 7:40 p.m.
+ */
+
+#ifndef LS_UTILS_PARALLEL_HPP
+#define LS_UTILS_PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef> // std::size_t
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Data-Parallel Algorithms
+ *
+ * These helpers split an index range into chunks and run them across a
+ * thread pool (WorkerPool, WorkerThread, or WorkStealingPool), with the
+ * calling thread processing chunks as well. The pool's task type must be
+ * constructible from a lambda, such as ls::utils::Function<void()>.
+ *
+ * A grain size of 0 picks a chunk size automatically, giving each thread
+ * several chunks so uneven work is balanced out. Each call blocks until the
+ * entire range has been processed. Calls may be nested from within a pool's
+ * tasks, since the calling thread never waits on a chunk which no thread
+ * has started.
+-----------------------------------------------------------------------------*/
+/**----------------------------------------------------------------------------
+ * @brief ParallelJob holds the state shared between the calling thread and
+ * the pool's threads while running a set of chunks. Chunks are claimed from
+ * an atomic cursor, so whichever thread is free takes the next chunk.
+ *
+ * Jobs are reference-counted, letting pool tasks which start after all
+ * chunks have finished exit without touching the caller's stack.
+ *
+ * This is an implementation detail of the parallel algorithms.
+-----------------------------------------------------------------------------*/
+template <typename ChunkFunc>
+class ParallelJob
+{
+  private:
+    std::atomic<unsigned> mRefs;
+
+    std::atomic<std::size_t> mNextChunk;
+
+    std::atomic<std::size_t> mNumDone;
+
+    const std::size_t mNumChunks;
+
+    const ChunkFunc* const mFunc;
+
+  public:
+    ~ParallelJob() noexcept = default;
+
+    ParallelJob(std::size_t numChunks, unsigned numRefs, const ChunkFunc& func) noexcept;
+
+    ParallelJob(const ParallelJob&) = delete;
+
+    ParallelJob(ParallelJob&&) = delete;
+
+    ParallelJob& operator=(const ParallelJob&) = delete;
+
+    ParallelJob& operator=(ParallelJob&&) = delete;
+
+    /**
+     * @brief Process chunks until none are left to claim.
+     */
+    void run() noexcept;
+
+    /**
+     * @brief Block until every chunk has been processed.
+     */
+    void wait() const noexcept;
+
+    void release() noexcept;
+};
+
+
+
+/**
+ * @brief Run "func(chunkIndex)" for every chunk in [0, numChunks) across a
+ * thread pool and the calling thread.
+ */
+template <class PoolType, typename ChunkFunc>
+void parallel_chunks(PoolType& pool, std::size_t numChunks, const ChunkFunc& func) noexcept;
+
+
+
+/**
+ * @brief Determine the number of items per chunk for a range of "count"
+ * items. A grain size of 0 selects one automatically.
+ */
+template <class PoolType>
+std::size_t parallel_grain_size(const PoolType& pool, std::size_t count, std::size_t grain) noexcept;
+
+
+
+/**
+ * @brief Parallel loop over the range [first, last).
+ *
+ * @param func
+ * A callable accepting "(IndexType chunkBegin, IndexType chunkEnd)", which
+ * is called once per chunk from any thread.
+ */
+template <class PoolType, typename IndexType, typename Func>
+void parallel_for(PoolType& pool, IndexType first, IndexType last, std::size_t grain, const Func& func) noexcept;
+
+
+
+/**
+ * @brief Parallel reduction over the range [first, last).
+ *
+ * Partial results are combined in index order, so the result is
+ * deterministic even for operations which are not associative in practice,
+ * such as floating-point addition. "T" must be default-constructible.
+ *
+ * @param identity
+ * The initial value of each chunk's partial result, and of the final
+ * result.
+ *
+ * @param mapFunc
+ * A callable accepting "(IndexType chunkBegin, IndexType chunkEnd, T init)"
+ * which returns the chunk's partial result.
+ *
+ * @param reduceFunc
+ * A callable accepting "(T a, T b)" which combines two partial results.
+ */
+template <class PoolType, typename IndexType, typename T, typename MapFunc, typename ReduceFunc>
+T parallel_reduce(
+    PoolType& pool,
+    IndexType first,
+    IndexType last,
+    std::size_t grain,
+    const T& identity,
+    const MapFunc& mapFunc,
+    const ReduceFunc& reduceFunc) noexcept;
+
+
+
+/**
+ * @brief Parallel inclusive prefix scan, writing
+ * "out[i] = in[0] op in[1] op ... op in[i]".
+ *
+ * Runs in two passes: each chunk's total is computed in parallel, the
+ * totals are scanned on the calling thread, then each chunk is scanned in
+ * parallel starting from its offset. "in" and "out" may be the same array.
+ */
+template <class PoolType, typename T, typename ScanFunc>
+void parallel_scan(
+    PoolType& pool,
+    const T* in,
+    T* out,
+    std::size_t count,
+    std::size_t grain,
+    const T& identity,
+    const ScanFunc& scanFunc) noexcept;
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/ParallelImpl.hpp"
+
+#endif /* LS_UTILS_PARALLEL_HPP */
@@ -0,0 +1,285 @@
+/*
+ * File:   PriorityWorkerPool.hpp
+ * Author: miles
+ * Created on October 19, 2026, at 9:05 a.m.
+ */
+
+#ifndef LS_UTILS_PRIORITY_WORKER_POOL_HPP
+#define LS_UTILS_PRIORITY_WORKER_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint> // uint64_t
+#include <mutex> // std::mutex, std::lock_guard
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86
+#include "lightsky/setup/Macros.h" // LS_DECLARE_CLASS_TYPE()
+
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/Future.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+#include "lightsky/utils/WorkerIdle.hpp"
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Enums
+-----------------------------------------------------------------------------*/
+/**
+ * @brief Priority lanes available in a PriorityWorkerPool, from most to
+ * least urgent.
+ */
+enum class WorkerPriority : uint32_t
+{
+    HIGH,
+    NORMAL,
+    LOW,
+
+    COUNT
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief PriorityWorkerPool is a drop-in replacement for a WorkerPool which
+ * sorts pending tasks into priority lanes.
+ *
+ * Workers always take the most urgent task available:
+ *
+ * 1. Every task has a deadline. Tasks pushed without one are given a
+ *    deadline of "time pushed + lane_max_wait()" for their lane. Within a
+ *    lane, tasks run earliest-deadline-first (FIFO for equal deadlines).
+ *
+ * 2. A task whose deadline has passed is considered overdue and runs before
+ *    any task which is not, regardless of its lane. This bounds how long a
+ *    flood of high-priority work can starve the lower lanes.
+ *
+ * 3. Otherwise, the highest priority lane with pending tasks wins.
+ *
+ * Lanes may also be limited to a number of concurrently running tasks so
+ * background work can't occupy every thread. A lane at its limit is skipped
+ * until one of its tasks completes.
+ *
+ * As with a WorkerPool, tasks pushed while the pool is paused do not run
+ * until the next call to flush(). Tasks pushed while the pool is running
+ * (including from within other tasks) will wake an idle thread.
+-----------------------------------------------------------------------------*/
+template <class WorkerTaskType>
+class PriorityWorkerPool
+{
+  public:
+    typedef WorkerTaskType value_type;
+
+    typedef std::chrono::steady_clock clock_type;
+
+    static constexpr std::size_t NUM_LANES = (std::size_t)WorkerPriority::COUNT;
+
+  private:
+    struct LaneTask
+    {
+        uint64_t deadline;
+        uint64_t sequence;
+        WorkerTaskType task;
+    };
+
+    struct Lane
+    {
+        // Binary min-heap, ordered by deadline then sequence
+        std::vector<LaneTask> tasks;
+        std::size_t maxConcurrency;
+        std::size_t numRunning;
+        uint64_t maxWaitNs;
+    };
+
+    static bool _is_later(const LaneTask& a, const LaneTask& b) noexcept;
+
+    static uint64_t _now_ns() noexcept;
+
+    // Out-of-range priorities are treated as LOW
+    static std::size_t _lane_index(WorkerPriority priority) noexcept;
+
+    std::atomic_bool mBusyWait;
+
+    std::atomic_bool mAdaptiveWait;
+
+    std::atomic_bool mIsPaused;
+
+    std::atomic_bool mIsStopped;
+
+    WorkerWakeSignal mWakeSignal;
+
+    std::atomic<std::size_t> mThreadsRunning;
+
+    std::atomic<std::size_t> mThreadsSleeping;
+
+    mutable utils::SpinLock mPushLock;
+
+    std::size_t mNumPending;
+
+    uint64_t mNextSequence;
+
+    Lane mLanes[NUM_LANES];
+
+    mutable std::mutex mWaitMtx;
+
+    mutable std::condition_variable mWaitCond;
+
+    std::mutex mExecMtx;
+
+    std::condition_variable mExecCond;
+
+    std::vector<std::thread> mThreads;
+
+    void _enqueue(WorkerTaskType&& task, WorkerPriority priority, uint64_t deadline, bool useLaneDeadline) noexcept;
+
+    void _notify_sleeper() noexcept;
+
+    bool _have_runnable() const noexcept;
+
+    bool _pop_runnable(WorkerTaskType& outTask, std::size_t& outLane) noexcept;
+
+    void execute_tasks() noexcept;
+
+    void thread_loop() noexcept;
+
+    void start_threads(std::size_t numThreads) noexcept;
+
+    void stop_threads() noexcept;
+
+  public:
+    ~PriorityWorkerPool() noexcept;
+
+    PriorityWorkerPool(std::size_t numThreads = 1);
+
+    PriorityWorkerPool(const PriorityWorkerPool&) noexcept;
+
+    PriorityWorkerPool(PriorityWorkerPool&&) noexcept;
+
+    PriorityWorkerPool& operator=(const PriorityWorkerPool&) noexcept;
+
+    PriorityWorkerPool& operator=(PriorityWorkerPool&&) noexcept;
+
+    std::size_t num_pending() const noexcept;
+
+    std::size_t num_pending(WorkerPriority priority) const noexcept;
+
+    bool have_pending() const noexcept;
+
+    void clear_pending() noexcept;
+
+    /**
+     * @brief Queue a task in the NORMAL lane.
+     */
+    void push(const WorkerTaskType& task) noexcept;
+
+    void push(const WorkerTaskType& task, WorkerPriority priority) noexcept;
+
+    /**
+     * @brief Queue a task in the NORMAL lane.
+     */
+    void emplace(WorkerTaskType&& task) noexcept;
+
+    void emplace(WorkerTaskType&& task, WorkerPriority priority) noexcept;
+
+    /**
+     * @brief Queue a task with an explicit deadline rather than the lane's
+     * default. Tasks which miss their deadline run ahead of all other
+     * tasks which have not.
+     */
+    void emplace_deadline(WorkerTaskType&& task, clock_type::time_point deadline, WorkerPriority priority = WorkerPriority::NORMAL) noexcept;
+
+    /**
+     * @brief Queue a callable in the NORMAL lane and retrieve a Future for
+     * its result. See WorkerPool::submit().
+     */
+    template <typename Func>
+    Future<std::invoke_result_t<const std::decay_t<Func>&>> submit(Func&& func) noexcept;
+
+    template <typename Func>
+    Future<std::invoke_result_t<const std::decay_t<Func>&>> submit(Func&& func, WorkerPriority priority) noexcept;
+
+    /**
+     * @brief Retrieve the maximum number of tasks from a lane which may run
+     * at the same time.
+     */
+    std::size_t lane_concurrency(WorkerPriority priority) const noexcept;
+
+    /**
+     * @brief Limit how many tasks from a lane may run at the same time.
+     * Limits are clamped to at least 1. Lanes are unlimited by default.
+     */
+    void lane_concurrency(WorkerPriority priority, std::size_t maxTasks) noexcept;
+
+    /**
+     * @brief Retrieve the time a task may wait in a lane before it is
+     * considered overdue.
+     */
+    std::chrono::nanoseconds lane_max_wait(WorkerPriority priority) const noexcept;
+
+    /**
+     * @brief Set the time a task may wait in a lane before it runs ahead of
+     * tasks from higher priority lanes. Only affects tasks pushed after the
+     * call. The defaults are 1ms, 10ms, and 100ms for the HIGH, NORMAL, and
+     * LOW lanes.
+     */
+    void lane_max_wait(WorkerPriority priority, std::chrono::nanoseconds maxWait) noexcept;
+
+    bool ready() const noexcept;
+
+    void flush() noexcept;
+
+    void wait() const noexcept;
+
+    bool busy_waiting() const noexcept;
+
+    void busy_waiting(bool useBusyWait) noexcept;
+
+    /**
+     * @brief Determine if idle threads spin, yield, then park rather than
+     * sleeping on a condition variable.
+     */
+    bool adaptive_waiting() const noexcept;
+
+    /**
+     * @brief Toggle the adaptive idle strategy (see WorkerIdleStrategy).
+     * Busy waiting takes precedence when both are enabled.
+     */
+    void adaptive_waiting(bool useAdaptiveWait) noexcept;
+
+    std::size_t concurrency(std::size_t inNumThreads) noexcept;
+
+    std::size_t concurrency() const noexcept;
+
+    const std::vector<std::thread>& threads() const noexcept;
+
+    std::vector<std::thread>& threads() noexcept;
+};
+
+
+/*-------------------------------------
+ * Convenience Types
+-------------------------------------*/
+LS_DECLARE_CLASS_TYPE(DefaultPriorityWorkerPool, PriorityWorkerPool, void (*)());
+LS_DECLARE_CLASS_TYPE(FunctionPriorityWorkerPool, PriorityWorkerPool, ls::utils::Function<void()>);
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+
+
+#include "lightsky/utils/generic/PriorityWorkerPoolImpl.hpp"
+
+#endif /* LS_UTILS_PRIORITY_WORKER_POOL_HPP */
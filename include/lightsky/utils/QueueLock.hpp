@@ -0,0 +1,193 @@
+/*
+ * File:   QueueLock.hpp
+ * Author: miles
+ * Created on October 20, 2026, at 4:05 p.m.
+ */
+
+#ifndef LS_UTILS_QUEUE_LOCK_HPP
+#define LS_UTILS_QUEUE_LOCK_HPP
+
+#include <atomic>
+#include <cstdint> // uint32_t, uintptr_t
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A waiting thread's place in a queue lock.
+ *
+ * Nodes are taken from a per-thread cache when locking and handed back when
+ * unlocking. They are never freed, only recycled, so a node may always be
+ * read by a thread which saw it in a queue.
+-----------------------------------------------------------------------------*/
+struct alignas(64) QueueLockNode
+{
+    enum : uint32_t
+    {
+        NODE_RELEASED = 0,
+        NODE_LOCKED   = 1,
+        NODE_SLEEPING = 2
+    };
+
+    std::atomic<QueueLockNode*> next;
+
+    // One of the values above. Only the thread waiting on a node sets it to
+    // NODE_SLEEPING.
+    std::atomic_uint32_t state;
+
+    // Links nodes within a cache
+    QueueLockNode* nextFree;
+
+    // Incremented each time the node is taken from a cache. Tags the node
+    // while it sits at the tail of a ClhLock.
+    uint32_t generation;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief An MCS queue lock.
+ *
+ * Threads enqueue themselves with a single atomic exchange on the tail of
+ * the queue, then spin on a flag within their own node until the previous
+ * owner hands the lock over. Each waiter touches only its own cache line,
+ * and the lock is granted in FIFO order. After spinning for "spinCount"
+ * iterations, a waiter sleeps in the OS (a futex on Linux) until woken by
+ * its predecessor.
+ *
+ * Like std::mutex, a McsLock must be unlocked by the thread which locked it.
+-----------------------------------------------------------------------------*/
+class McsLock
+{
+  public:
+    enum : uint32_t
+    {
+        DEFAULT_SPIN_COUNT = 4096,
+
+        // Never sleep in the OS
+        SPIN_ONLY = 0xFFFFFFFFu
+    };
+
+  private:
+    alignas(64) std::atomic<QueueLockNode*> mTail;
+
+    // Only accessed by the thread holding the lock
+    alignas(64) QueueLockNode* mHolder;
+
+    const uint32_t mSpinCount;
+
+  public:
+    ~McsLock() noexcept = default;
+
+    McsLock(uint32_t spinCount = DEFAULT_SPIN_COUNT) noexcept;
+
+    McsLock(const McsLock&) = delete;
+
+    McsLock(McsLock&&) = delete;
+
+    McsLock& operator=(const McsLock&) = delete;
+
+    McsLock& operator=(McsLock&&) = delete;
+
+    uint32_t spin_count() const noexcept;
+
+    void lock() noexcept;
+
+    bool try_lock() noexcept;
+
+    void unlock() noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A CLH queue lock.
+ *
+ * Threads enqueue a node with a single atomic exchange on the tail of the
+ * queue and spin on their predecessor's node until it is released. The
+ * releasing thread only writes to its own node, and takes over its
+ * predecessor's node in return. The lock is granted in FIFO order and
+ * waiters sleep in the OS after "spinCount" iterations, as with the
+ * McsLock.
+ *
+ * Like std::mutex, a ClhLock must be unlocked by the thread which locked it.
+-----------------------------------------------------------------------------*/
+class ClhLock
+{
+  public:
+    enum : uint32_t
+    {
+        DEFAULT_SPIN_COUNT = McsLock::DEFAULT_SPIN_COUNT,
+        SPIN_ONLY = McsLock::SPIN_ONLY
+    };
+
+  private:
+    // A node pointer, tagged with the node's generation in its unused bits
+    alignas(64) std::atomic<uintptr_t> mTail;
+
+    // Only accessed by the thread holding the lock
+    alignas(64) QueueLockNode* mHolder;
+
+    QueueLockNode* mHolderPred;
+
+    const uint32_t mSpinCount;
+
+  public:
+    ~ClhLock() noexcept;
+
+    ClhLock(uint32_t spinCount = DEFAULT_SPIN_COUNT) noexcept;
+
+    ClhLock(const ClhLock&) = delete;
+
+    ClhLock(ClhLock&&) = delete;
+
+    ClhLock& operator=(const ClhLock&) = delete;
+
+    ClhLock& operator=(ClhLock&&) = delete;
+
+    uint32_t spin_count() const noexcept;
+
+    void lock() noexcept;
+
+    /**
+     * @brief Attempt to lock without waiting in the queue.
+     *
+     * The tail of the queue is tagged with a generation count, so a tail
+     * node which is released and re-used between checking and claiming it
+     * makes this fail rather than wait for the new holder.
+     */
+    bool try_lock() noexcept;
+
+    void unlock() noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Spin iterations before sleeping
+-------------------------------------*/
+inline uint32_t McsLock::spin_count() const noexcept
+{
+    return mSpinCount;
+}
+
+
+
+/*-------------------------------------
+ * Spin iterations before sleeping
+-------------------------------------*/
+inline uint32_t ClhLock::spin_count() const noexcept
+{
+    return mSpinCount;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_QUEUE_LOCK_HPP */
@@ -295,6 +295,95 @@ class alignas(alignof(uint64_t)) FairRWLock
 
 
 
+/**----------------------------------------------------------------------------
+ * @brief Reader-biased R/W lock for read-mostly data (BRAVO).
+ *
+ * While the lock is biased towards readers, lock_shared() only increments a
+ * counter in one of several cache-aligned slots, chosen per-thread, so
+ * readers on different cores do not contend on a single cache line. Writers
+ * take an underlying RWLock, revoke the reader bias, then wait for every
+ * slot to drain. Readers which find the bias revoked fall back to the
+ * underlying RWLock.
+ *
+ * Revoking the bias costs a writer one pass over all slots. To keep
+ * write-heavy workloads from paying it repeatedly, the bias is only
+ * restored by a reader once INHIBIT_MULTIPLIER times the last revocation's
+ * duration has passed.
+ *
+ * Each thread tracks its reader-biased locks in a small thread-local table,
+ * so unlock_shared() must be called by the thread which locked it. A thread
+ * holding more than MAX_BIASED_READS of these locks at once takes the
+ * slower path for the extras.
+-----------------------------------------------------------------------------*/
+class BiasedRWLock
+{
+  public:
+    typedef RWLock native_handle_type;
+
+    enum : uint32_t
+    {
+        NUM_READER_SLOTS = 32,
+        MAX_BIASED_READS = 8,
+        INHIBIT_MULTIPLIER = 9
+    };
+
+  private:
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic_uint32_t count;
+    };
+
+    static_assert((NUM_READER_SLOTS & (NUM_READER_SLOTS-1)) == 0, "Reader slot count must be a power of 2.");
+
+    alignas(64) std::atomic_bool mReaderBias;
+
+    // Steady-clock time, in nanoseconds, before which readers may not
+    // restore the reader bias.
+    std::atomic<uint64_t> mInhibitUntil;
+
+    RWLock mLock;
+
+    ReaderSlot mReaderSlots[NUM_READER_SLOTS];
+
+    bool _try_lock_biased() noexcept;
+
+    void _restore_bias() noexcept;
+
+  public:
+    ~BiasedRWLock() noexcept = default;
+
+    BiasedRWLock() noexcept;
+
+    BiasedRWLock(const BiasedRWLock&) noexcept = delete;
+
+    BiasedRWLock(BiasedRWLock&&) noexcept = delete;
+
+    BiasedRWLock& operator=(const BiasedRWLock&) noexcept = delete;
+
+    BiasedRWLock& operator=(BiasedRWLock&&) noexcept = delete;
+
+    /**
+     * @brief Determine if readers currently bypass the underlying RWLock.
+     */
+    bool reader_biased() const noexcept;
+
+    void lock_shared() noexcept;
+
+    void lock() noexcept;
+
+    bool try_lock_shared() noexcept;
+
+    bool try_lock() noexcept;
+
+    void unlock_shared() noexcept;
+
+    void unlock() noexcept;
+
+    const native_handle_type& native_handle() const noexcept;
+};
+
+
+
 /*-----------------------------------------------------------------------------
  * Shared Lock Guard
 -----------------------------------------------------------------------------*/
@@ -80,6 +80,12 @@ public:
 
     value_type pop_unchecked() noexcept;
 
+    /**
+     * Remove the most recently pushed element, treating the buffer as a
+     * stack.
+     */
+    value_type pop_back_unchecked() noexcept;
+
     bool push(const_reference val) noexcept;
 
     bool push(T&& val) noexcept;
@@ -89,6 +95,16 @@ public:
     template <typename... ArgsType>
     bool emplace(ArgsType&&... args) noexcept;
 
+    /**
+     * Push a range of elements, growing the buffer at most once. Use
+     * std::make_move_iterator() to move elements rather than copy them.
+     *
+     * Returns the number of elements pushed, which is less than the size of
+     * the range only if memory could not be allocated.
+     */
+    template <typename IterType>
+    size_type push_range(IterType first, IterType last) noexcept;
+
     bool pop(reference& result) noexcept;
 
     const_reference front() const noexcept;
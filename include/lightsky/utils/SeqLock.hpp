@@ -0,0 +1,118 @@
+/*
+ * File:   SeqLock.hpp
+ * Author: miles
+ * Created on October 20, 2026, at 5:20 p.m.
+ */
+
+#ifndef LS_UTILS_SEQ_LOCK_HPP
+#define LS_UTILS_SEQ_LOCK_HPP
+
+#include <atomic>
+#include <cstdint> // uint32_t, uint64_t
+#include <type_traits> // std::is_trivially_copyable
+
+#include "lightsky/utils/SpinLock.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A sequence lock for small, trivially-copyable data which is read far
+ * more often than it is written.
+ *
+ * Readers never write to shared memory. They copy the data optimistically
+ * and retry if a writer changed it in the meantime, which is detected
+ * through a sequence number that is odd while a write is in progress.
+ * Writers are serialized by "WriterLockType", which may be any type with
+ * lock() and unlock() methods (SpinLock, Futex, McsLock, std::mutex, etc.).
+ *
+ * Data is stored as relaxed atomic words so concurrent reads and writes are
+ * well-defined. Readers may spin while a write is in progress, so writers
+ * should keep their critical sections short.
+-----------------------------------------------------------------------------*/
+template <typename T, class WriterLockType = ls::utils::SpinLock>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock data must be trivially copyable.");
+
+  public:
+    typedef T value_type;
+
+    typedef WriterLockType lock_type;
+
+  private:
+    enum : uint32_t
+    {
+        NUM_WORDS = (uint32_t)((sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+    };
+
+    alignas(64) std::atomic<uint64_t> mSequence;
+
+    std::atomic<uint64_t> mWords[NUM_WORDS];
+
+    WriterLockType mWriterLock;
+
+    void _read_words(uint64_t* pOut) const noexcept;
+
+    void _write_words(const uint64_t* pIn) noexcept;
+
+  public:
+    ~SeqLock() noexcept = default;
+
+    SeqLock() noexcept;
+
+    explicit SeqLock(const T& initialValue) noexcept;
+
+    SeqLock(const SeqLock&) = delete;
+
+    SeqLock(SeqLock&&) = delete;
+
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    SeqLock& operator=(SeqLock&&) = delete;
+
+    /**
+     * @brief Retrieve a consistent copy of the data, retrying while writers
+     * are active.
+     */
+    T load() const noexcept;
+
+    /**
+     * @brief Make a single attempt to copy the data.
+     *
+     * @return TRUE if "outValue" holds a consistent copy, FALSE if a write
+     * was in progress and "outValue" is unchanged.
+     */
+    bool try_load(T& outValue) const noexcept;
+
+    /**
+     * @brief Replace the data.
+     */
+    void store(const T& value) noexcept;
+
+    /**
+     * @brief Modify the data in place with "updateFunc(T&)", while holding
+     * the writer lock.
+     */
+    template <typename UpdateFunc>
+    void update(UpdateFunc&& updateFunc) noexcept;
+
+    /**
+     * @brief Retrieve the number of writes since construction, times two.
+     * The value is odd while a write is in progress.
+     */
+    uint64_t sequence() const noexcept;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/SeqLockImpl.hpp"
+
+#endif /* LS_UTILS_SEQ_LOCK_HPP */
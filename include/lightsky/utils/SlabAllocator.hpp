@@ -0,0 +1,265 @@
+/*
+ * File:   SlabAllocator.hpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 9:15 AM
+ */
+
+#ifndef LS_UTILS_SLAB_ALLOCATOR_HPP
+#define LS_UTILS_SLAB_ALLOCATOR_HPP
+
+#include "lightsky/utils/Allocator.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief SlabAllocator serves small allocations from size-segregated slabs,
+ * giving constant-time allocation and deallocation regardless of
+ * fragmentation.
+ *
+ * Requests are rounded up to one of 32 size classes: 16-byte steps up to 128
+ * bytes, then four steps per power-of-two (1.25x, 1.5x, 1.75x, 2x) up to
+ * 8KiB. Each class keeps a list of partially-used slabs, and each slab keeps
+ * an intrusive free list of its blocks, so allocation and deallocation only
+ * ever touch the head of a list.
+ *
+ * Slabs are carved out of larger segments retrieved from the MemorySource.
+ * Every slab is aligned to its size, which lets free() locate the owning slab
+ * by masking the pointer. Allocations larger than the biggest size class are
+ * made directly from the MemorySource with a slab-aligned header. Sources
+ * which don't support MemorySource::allocate_aligned() are over-allocated by
+ * one slab to align the header.
+ *
+ * This allocator is not thread-safe.
+-----------------------------------------------------------------------------*/
+class SlabAllocator final : public Allocator
+{
+  public:
+    typedef unsigned long long size_type;
+
+    enum : size_type
+    {
+        slab_size = 64ull * 1024ull,
+        slabs_per_segment = 16ull,
+        num_size_classes = 32ull,
+        max_slab_alloc_size = 8192ull
+    };
+
+  private:
+    struct Segment;
+
+    struct alignas(alignof(size_type)*2) SlabHeader
+    {
+        SlabHeader* pNext;
+        SlabHeader* pPrev;
+        Segment* pSegment;
+        void* pFreeList;
+        char* pBump;
+        char* pEnd;
+        size_type sizeClass;
+        size_type numUsed;
+        size_type numBytes;
+        bool isListed;
+    };
+
+    struct Segment
+    {
+        Segment* pNext;
+        Segment* pPrev;
+        Segment* pNextAvail;
+        Segment* pPrevAvail;
+        void* pRaw;
+        size_type rawBytes;
+        SlabHeader* pFreeSlabs;
+        char* pNextUnused;
+        char* pSlabsEnd;
+        size_type numSlabs;
+        size_type numFreeSlabs;
+    };
+
+    enum : size_type
+    {
+        slab_mask = ~(slab_size - 1ull),
+        slab_header_size = (sizeof(SlabHeader) + 15ull) & ~15ull,
+        large_size_class = num_size_classes
+    };
+
+    static_assert((slab_size & (slab_size - 1ull)) == 0, "Slab size must be a power of two.");
+    static_assert(max_slab_alloc_size * 4ull <= (size_type)slab_size - (size_type)slab_header_size, "Slabs are too small for the largest size class.");
+
+    /**
+     * @brief Slabs with at least one free block, per size class.
+     */
+    SlabHeader* mPartialSlabs[num_size_classes];
+
+    /**
+     * @brief All segments retrieved from the memory source.
+     */
+    Segment* mSegments;
+
+    /**
+     * @brief Segments which contain at least one unused slab.
+     */
+    Segment* mAvailSegments;
+
+    /**
+     * @brief All allocations too large for a slab.
+     */
+    SlabHeader* mLargeAllocs;
+
+    static size_type _size_class(size_type numBytes) noexcept;
+
+    static size_type _class_size(size_type sizeClass) noexcept;
+
+    static SlabHeader* _slab_of(const void* p) noexcept;
+
+    void _link_avail(Segment* pSegment) noexcept;
+
+    void _unlink_avail(Segment* pSegment) noexcept;
+
+    void _link_partial(SlabHeader* pSlab) noexcept;
+
+    void _unlink_partial(SlabHeader* pSlab) noexcept;
+
+    /**
+     * @brief Retrieve a new segment from the memory source.
+     */
+    Segment* _allocate_segment() noexcept;
+
+    /**
+     * @brief Return a segment, and all of its slabs, to the memory source.
+     */
+    void _free_segment(Segment* pSegment) noexcept;
+
+    /**
+     * @brief Retrieve an unused slab and prepare it for a size class.
+     */
+    SlabHeader* _acquire_slab(size_type sizeClass) noexcept;
+
+    /**
+     * @brief Return an empty slab to its segment.
+     */
+    void _release_slab(SlabHeader* pSlab) noexcept;
+
+    void* _allocate_large(size_type numBytes) noexcept;
+
+    void _free_large(SlabHeader* pHeader) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Returns all memory back to the memory source.
+     */
+    virtual ~SlabAllocator() noexcept override;
+
+    /**
+     * @brief Default Constructor
+     *
+     * Deleted so a memory source is always provided.
+     */
+    SlabAllocator() noexcept = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * No memory is requested from the memory source until the first
+     * allocation.
+     */
+    SlabAllocator(MemorySource& memorySource) noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted to avoid requests for additional memory from the memory source.
+     */
+    SlabAllocator(const SlabAllocator&) = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Moves all data from the input allocator into *this.
+     */
+    SlabAllocator(SlabAllocator&&) noexcept;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted to prevent invalidation of memory currently allocated to others.
+     */
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Returns all memory in *this to the memory source, then moves all data
+     * from the input allocator into *this.
+     */
+    SlabAllocator& operator=(SlabAllocator&&) noexcept;
+
+    /**
+     * @brief Allocate a block of memory which is at least "numBytes" in size.
+     *
+     * @param numBytes
+     * The minimum number of bytes to allocate.
+     *
+     * @param pOutNumBytes
+     * Optional output parameter containing the usable size of the allocation.
+     *
+     * @return A pointer to the allocation, or NULL if the memory source is
+     * exhausted.
+     */
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Allocate an array of elements and zero-initialize the
+     * allocation.
+     */
+    virtual void* allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Reallocate a prior allocation, following the rules of
+     * std::realloc(). The allocation is returned as-is if its size class can
+     * already hold "numNewBytes."
+     */
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Reallocate a prior allocation, following the rules of
+     * std::realloc(). Allocation sizes are tracked internally, so
+     * "numPrevBytes" is ignored.
+     */
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Return an allocated block of memory back to *this allocator.
+     *
+     * This function does nothing if the input pointer is NULL.
+     */
+    virtual void free(void* p) noexcept override;
+
+    /**
+     * @brief Return an allocated block of memory back to *this allocator.
+     *
+     * Allocation sizes are tracked internally, so "n" is ignored.
+     */
+    virtual void free(void* p, size_type n) noexcept override;
+
+    /**
+     * @brief Count the free blocks of every partially-used slab, along with
+     * every unused slab. Each unused slab is reported as a single free block.
+     */
+    virtual bool free_list_stats(FreeListStats& outStats) const noexcept override;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_SLAB_ALLOCATOR_HPP */
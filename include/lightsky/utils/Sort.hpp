@@ -7,6 +7,7 @@
 
 #include "lightsky/setup/Types.h"
 #include "lightsky/utils/Algorithm.hpp" // utils::IsLess
+#include "lightsky/utils/Barrier.hpp" // utils::SenseBarrier, utils::DisseminationBarrier
 
 namespace ls
 {
@@ -222,7 +223,33 @@ void sort_bitonic(
 
 
 /*-------------------------------------
-    Bitonic Sort (parallel, only for arrays that are powers of 2 in size).
+    Bitonic Sort (parallel), synchronizing threads between phases with a
+    reusable barrier rather than a shared counter. All threads must use the
+    same barrier, created for "numThreads" threads. A DisseminationBarrier
+    scales best for high thread counts.
+-------------------------------------*/
+template <typename data_type, class Comparator = ls::utils::IsLess<data_type>>
+void sort_bitonic(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    SenseBarrier* barrier,
+    Comparator cmp = Comparator{}) noexcept;
+
+template <typename data_type, class Comparator = ls::utils::IsLess<data_type>>
+void sort_bitonic(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    DisseminationBarrier* barrier,
+    Comparator cmp = Comparator{}) noexcept;
+
+
+
+/*-------------------------------------
+    Odd-Even Merge Sort (parallel, only for arrays that are powers of 2 in size).
 -------------------------------------*/
 template <typename data_type, class Comparator = ls::utils::IsLess<data_type>>
 void sort_odd_even(
@@ -235,6 +262,30 @@ void sort_odd_even(
 
 
 
+/*-------------------------------------
+    Odd-Even Merge Sort (parallel), synchronized with a reusable barrier.
+    See sort_bitonic().
+-------------------------------------*/
+template <typename data_type, class Comparator = ls::utils::IsLess<data_type>>
+void sort_odd_even(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    SenseBarrier* barrier,
+    Comparator cmp = Comparator{}) noexcept;
+
+template <typename data_type, class Comparator = ls::utils::IsLess<data_type>>
+void sort_odd_even(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    DisseminationBarrier* barrier,
+    Comparator cmp = Comparator{}) noexcept;
+
+
+
 } // end utils namespace
 } // end ls namespace
 
@@ -0,0 +1,194 @@
+/*
+ * File:   TaskGraph.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 9:20 p.m.
+ */
+
+#ifndef LS_UTILS_TASK_GRAPH_HPP
+#define LS_UTILS_TASK_GRAPH_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // std::size_t
+#include <cstdint> // uint32_t
+#include <mutex>
+#include <vector>
+
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/Pointer.h" // UniqueArray
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief TaskGraph runs a directed acyclic graph of tasks on a thread pool.
+ *
+ * Each node counts the dependencies which have yet to finish. When a node
+ * completes, it decrements the counters of its successors, and any which
+ * reach zero are released to the pool immediately rather than waiting for
+ * the rest of the current "stage" to complete. The thread which finishes a
+ * node keeps one of the released successors for itself, so simple chains
+ * run without a round-trip through the pool's queue.
+ *
+ * Graphs are built once, then run as many times as needed. Modifying a
+ * graph requires another call to finalize() before it can run again. A
+ * graph must not be modified, or destroyed, while it is running.
+ *
+ * The pool used to run a graph (WorkerPool, WorkerThread, or
+ * WorkStealingPool) must have a task type which is constructible from a
+ * lambda, such as ls::utils::Function<void()>. Pools without any threads
+ * run the graph serially on the calling thread.
+-----------------------------------------------------------------------------*/
+class TaskGraph
+{
+  public:
+    typedef ls::utils::Function<void()> task_type;
+
+    typedef std::size_t node_id;
+
+    static constexpr node_id INVALID_NODE = ~(node_id)0;
+
+  private:
+    typedef void (*dispatch_func_type)(void* pPool, TaskGraph* pGraph, const node_id* pNodes, std::size_t numNodes);
+
+    struct Node
+    {
+        task_type task;
+
+        std::vector<node_id> successors;
+
+        uint32_t numDependencies;
+    };
+
+    std::vector<Node> mNodes;
+
+    // Topological order from finalize(), starting with all nodes which
+    // have no dependencies
+    std::vector<node_id> mOrder;
+
+    std::size_t mNumRoots;
+
+    // Per-node counts of unfinished dependencies, reset on every run
+    UniqueArray<std::atomic<uint32_t>> mPending;
+
+    std::atomic<std::size_t> mNumRemaining;
+
+    bool mIsFinalized;
+
+    bool mIsRunning;
+
+    void* mPool;
+
+    dispatch_func_type mDispatch;
+
+    std::mutex mWaitMtx;
+
+    std::condition_variable mWaitCond;
+
+    /**
+     * @brief Push a set of released nodes to a pool, then flush it.
+     */
+    template <class PoolType>
+    static void _dispatch(void* pPool, TaskGraph* pGraph, const node_id* pNodes, std::size_t numNodes) noexcept;
+
+    /**
+     * @brief Run a node, then any successor it releases which no other
+     * thread has been handed.
+     */
+    void _execute(node_id nodeId) noexcept;
+
+    /**
+     * @brief Reset the per-node dependency counters before a run.
+     */
+    void _reset_counters() noexcept;
+
+    /**
+     * @brief Run every node on the calling thread, in dependency order.
+     */
+    void _run_serial() noexcept;
+
+  public:
+    ~TaskGraph() noexcept;
+
+    TaskGraph() noexcept;
+
+    TaskGraph(const TaskGraph&) = delete;
+
+    TaskGraph(TaskGraph&&) = delete;
+
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    TaskGraph& operator=(TaskGraph&&) = delete;
+
+    /**
+     * @brief Add a node to the graph.
+     *
+     * @return The ID of the new node, or INVALID_NODE if the task was empty
+     * or the graph is running.
+     */
+    node_id add(task_type&& task) noexcept;
+
+    /**
+     * @brief Require a node to wait for another node to finish.
+     *
+     * @return FALSE if either ID is invalid, if a node would depend on
+     * itself, or if the graph is running.
+     */
+    bool add_dependency(node_id node, node_id dependsOn) noexcept;
+
+    /**
+     * @brief Remove all nodes.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Validate the graph and prepare it for running.
+     *
+     * @return FALSE if the graph contains a cycle, or if memory could not be
+     * allocated.
+     */
+    bool finalize() noexcept;
+
+    std::size_t size() const noexcept;
+
+    bool finalized() const noexcept;
+
+    /**
+     * @brief Determine if the graph has been started but not yet waited on.
+     */
+    bool running() const noexcept;
+
+    /**
+     * @brief Start running the graph on a thread pool without waiting for
+     * it to complete.
+     *
+     * @return FALSE if the graph has not been finalized or is already
+     * running.
+     */
+    template <class PoolType>
+    bool start(PoolType& pool) noexcept;
+
+    /**
+     * @brief Block until a started graph has finished running.
+     */
+    void wait() noexcept;
+
+    /**
+     * @brief Run the graph on a thread pool and wait for it to finish.
+     */
+    template <class PoolType>
+    bool run(PoolType& pool) noexcept;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/TaskGraphImpl.hpp"
+
+#endif /* LS_UTILS_TASK_GRAPH_HPP */
@@ -0,0 +1,284 @@
+/*
+ * File:   ThreadCachedAllocator.hpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 3:05 PM
+ */
+
+#ifndef LS_UTILS_THREAD_CACHED_ALLOCATOR_HPP
+#define LS_UTILS_THREAD_CACHED_ALLOCATOR_HPP
+
+#include "lightsky/utils/Allocator.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Configuration
+-----------------------------------------------------------------------------*/
+/**
+ * @brief The maximum number of ThreadCachedAllocators a single thread may
+ * hold a cache for. Allocations from any additional allocators will bypass
+ * the thread cache and lock the central heap.
+ */
+#ifndef LS_UTILS_MAX_THREAD_CACHES
+    #define LS_UTILS_MAX_THREAD_CACHES 4
+#endif
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief ThreadCachedAllocator places a per-thread cache of small,
+ * size-classed memory blocks in front of a shared (thread-unsafe) central
+ * heap, such as a GeneralAllocator.
+ *
+ * Small allocations are served from the calling thread's cache without any
+ * locking. When a cache runs empty, a batch of blocks is pulled from the
+ * central heap under a single lock hold. When a cache grows past its limit,
+ * a batch of blocks is returned in the same way.
+ *
+ * Memory may be freed from any thread. Blocks freed by a thread other than
+ * the one which allocated them are placed in the freeing thread's cache,
+ * since every block originates from the same central heap. A thread's cache
+ * is returned to the central heap when the thread exits.
+ *
+ * Allocations larger than the biggest size class go straight to the central
+ * heap.
+-----------------------------------------------------------------------------*/
+class ThreadCachedAllocator : public IAllocator
+{
+  public:
+    typedef unsigned long long size_type;
+
+    struct ThreadCache;
+
+    enum : size_type
+    {
+        num_size_classes = 28,
+        max_cached_size = 4096
+    };
+
+  private:
+    struct alignas(alignof(size_type)*2) BlockHeader
+    {
+        size_type sizeClass;
+        size_type numBytes;
+    };
+
+    static_assert(sizeof(BlockHeader) == sizeof(size_type)*2, "Unexpected BlockHeader size.");
+
+    /**
+     * @brief Size class marking an over-aligned block. The block's offset
+     * from its central heap allocation is stored just before its header.
+     */
+    static constexpr size_type aligned_size_class = num_size_classes + 1;
+
+    /**
+     * @brief Lock guarding all access to mCentral and mCaches.
+     */
+    SpinLock mLock;
+
+    /**
+     * @brief The shared heap which all thread caches pull from.
+     */
+    IAllocator* mCentral;
+
+    /**
+     * @brief Linked list of every live thread cache referencing *this.
+     */
+    ThreadCache* mCaches;
+
+    /**
+     * @brief Retrieve the size class which can hold \p numBytes.
+     */
+    static size_type _size_class(size_type numBytes) noexcept;
+
+    /**
+     * @brief Retrieve the number of blocks moved between a thread cache and
+     * the central heap at once.
+     */
+    static size_type _batch_size(size_type sizeClass) noexcept;
+
+    /**
+     * @brief Retrieve the calling thread's cache for *this, creating it if
+     * necessary.
+     *
+     * @return A pointer to the calling thread's cache, or NULL if the thread
+     * already holds LS_UTILS_MAX_THREAD_CACHES caches for other allocators.
+     */
+    ThreadCache* _thread_cache() noexcept;
+
+    /**
+     * @brief Allocate directly from the central heap, bypassing all thread
+     * caches.
+     */
+    void* _allocate_central(size_type sizeClass, size_type numBytes) noexcept;
+
+    /**
+     * @brief Pull a batch of blocks from the central heap into a cache.
+     *
+     * @return TRUE if at least one block was retrieved, FALSE if the central
+     * heap is exhausted.
+     */
+    bool _refill(ThreadCache& cache, size_type sizeClass) noexcept;
+
+    /**
+     * @brief Return up to \p numBlocks from a cache to the central heap.
+     */
+    void _flush(ThreadCache& cache, size_type sizeClass, size_type numBlocks) noexcept;
+
+    /**
+     * @brief Return all blocks in a cache to the central heap.
+     *
+     * @note This function assumes mLock is held.
+     */
+    void _release_all(ThreadCache& cache) noexcept;
+
+    /**
+     * @brief Return all blocks in a cache to the central heap and detach the
+     * cache from *this.
+     */
+    void _retire(ThreadCache& cache) noexcept;
+
+    /**
+     * @brief Called once per thread at exit to return every cache it holds.
+     */
+    static void _release_thread_caches(void* pCacheSet) noexcept;
+
+  protected:
+    virtual const MemorySource& memory_source() const noexcept override;
+
+    virtual MemorySource& memory_source() noexcept override;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Returns the contents of every thread's cache to the central heap. No
+     * other thread may allocate from *this while it is being destroyed.
+     */
+    virtual ~ThreadCachedAllocator() noexcept override;
+
+    /**
+     * @brief Default Constructor
+     *
+     * Deleted so a central heap is always provided.
+     */
+    ThreadCachedAllocator() noexcept = delete;
+
+    /**
+     * @brief Constructor
+     *
+     * @param centralHeap
+     * The allocator all thread caches will pull from. This allocator does
+     * not need to be thread-safe and must outlive *this.
+     */
+    ThreadCachedAllocator(IAllocator& centralHeap) noexcept;
+
+    /**
+     * @brief Copy Constructor
+     *
+     * Deleted as thread caches reference *this directly.
+     */
+    ThreadCachedAllocator(const ThreadCachedAllocator&) = delete;
+
+    /**
+     * @brief Move Constructor
+     *
+     * Deleted as thread caches reference *this directly.
+     */
+    ThreadCachedAllocator(ThreadCachedAllocator&&) = delete;
+
+    /**
+     * @brief Copy Operator
+     *
+     * Deleted as thread caches reference *this directly.
+     */
+    ThreadCachedAllocator& operator=(const ThreadCachedAllocator&) = delete;
+
+    /**
+     * @brief Move Operator
+     *
+     * Deleted as thread caches reference *this directly.
+     */
+    ThreadCachedAllocator& operator=(ThreadCachedAllocator&&) = delete;
+
+    /**
+     * @brief Allocate a block of memory which is at least \p numBytes in size.
+     *
+     * @param numBytes
+     * The minimum number of bytes to allocate.
+     *
+     * @param pOutNumBytes
+     * Optional output parameter which will contain the usable size of the
+     * allocation.
+     *
+     * @return A pointer to a block of memory, or NULL if the central heap is
+     * exhausted.
+     */
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Allocate an array of elements and zero-initialize the
+     * allocation.
+     */
+    virtual void* allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Allocate a block of memory aligned to \p alignment bytes, a
+     * power of two.
+     *
+     * Alignments of 16 bytes or less are served like any other allocation.
+     * Larger alignments bypass the thread cache. The block is released
+     * through free().
+     */
+    virtual void* allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Resize an allocation, preserving its contents. The allocation is
+     * returned as-is if it is already large enough.
+     */
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Resize an allocation, preserving its contents. The previous size
+     * is tracked internally so \p numPrevBytes is ignored.
+     */
+    virtual void* reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Return a block of memory to the calling thread's cache.
+     */
+    virtual void free(void* p) noexcept override;
+
+    /**
+     * @brief Return a block of memory to the calling thread's cache.
+     */
+    virtual void free(void* p, size_type numBytes) noexcept override;
+
+    /**
+     * @brief Retrieve the number of usable bytes in an allocation made by
+     * *this, or 0 if \p p is NULL.
+     */
+    size_type usable_size(const void* p) const noexcept;
+
+    /**
+     * @brief Return all memory held in the calling thread's cache to the
+     * central heap.
+     */
+    void flush_thread_cache() noexcept;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_THREAD_CACHED_ALLOCATOR_HPP */
@@ -0,0 +1,253 @@
+/*
+ * File:   TimerWheel.hpp
+ * Author: miles
+ * Created on October 19, 2026, at 1:20 p.m.
+ */
+
+#ifndef LS_UTILS_TIMER_WHEEL_HPP
+#define LS_UTILS_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstdint> // uint32_t, uint64_t
+#include <mutex>
+#include <utility> // std::move
+#include <vector>
+
+#include "lightsky/utils/Function.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief TimerWheel is a hierarchical timing wheel which schedules callbacks
+ * to run after a delay, or periodically.
+ *
+ * Time is divided into ticks of a fixed length. The wheel has four levels
+ * of 256 slots, each level covering 256 times the range of the one below
+ * it, for a total range of 2^32 ticks (about 49 days at the default 1ms
+ * tick). Longer delays are allowed and are re-filed as the wheel turns.
+ *
+ * Inserting and cancelling a timer are O(1). Timers are moved to a lower
+ * level only when the wheel turns past their slot in the level above, so
+ * each timer is touched at most once per level.
+ *
+ * The wheel does not own a thread. Call advance() periodically (from a
+ * network loop, a frame loop, or a dedicated thread) to push every expired
+ * callback into a worker pool as a single batch. All member functions may
+ * be called from any thread, including from within a timer's callback.
+-----------------------------------------------------------------------------*/
+class TimerWheel
+{
+  public:
+    typedef std::chrono::steady_clock clock_type;
+
+    typedef uint64_t timer_id;
+
+    static constexpr timer_id INVALID_TIMER = 0;
+
+    static constexpr uint32_t NUM_LEVELS = 4;
+
+    static constexpr uint32_t SLOT_BITS = 8;
+
+    static constexpr uint32_t NUM_SLOTS = 1u << SLOT_BITS;
+
+  private:
+    static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    struct TimerNode
+    {
+        uint64_t expiry; // tick
+        uint64_t period; // ticks, 0 for one-shot timers
+        uint32_t prev;
+        uint32_t next;
+        uint32_t slot; // level*NUM_SLOTS + slot, or INVALID_INDEX when free
+        uint32_t generation;
+        utils::Function<void()> callback;
+    };
+
+    mutable std::mutex mLock;
+
+    std::chrono::nanoseconds mTickLength;
+
+    clock_type::time_point mStartTime;
+
+    // Next tick to be processed
+    uint64_t mCurrentTick;
+
+    std::size_t mNumTimers;
+
+    uint32_t mFreeList;
+
+    std::vector<TimerNode> mNodes;
+
+    uint32_t mSlots[NUM_LEVELS * NUM_SLOTS];
+
+    // Timers filed in each level, used to skip over empty stretches
+    std::size_t mLevelCounts[NUM_LEVELS];
+
+    uint64_t _to_ticks(std::chrono::nanoseconds duration) const noexcept;
+
+    timer_id _make_id(uint32_t index) const noexcept;
+
+    uint32_t _find(timer_id id) const noexcept;
+
+    void _link(uint32_t index) noexcept;
+
+    void _unlink(uint32_t index) noexcept;
+
+    void _release(uint32_t index) noexcept;
+
+    void _cascade(uint32_t level, uint32_t slot) noexcept;
+
+    timer_id _insert(utils::Function<void()>&& callback, uint64_t delayTicks, uint64_t periodTicks) noexcept;
+
+  public:
+    ~TimerWheel() noexcept = default;
+
+    /**
+     * @brief Construct a timer wheel.
+     *
+     * @param tickLength
+     * The resolution of all timers. Delays are rounded up to a whole
+     * number of ticks. Values less than 1ns are clamped to 1ns.
+     *
+     * @param startTime
+     * The time corresponding to tick 0.
+     */
+    TimerWheel(std::chrono::nanoseconds tickLength = std::chrono::milliseconds{1}, clock_type::time_point startTime = clock_type::now()) noexcept;
+
+    TimerWheel(const TimerWheel&) = delete;
+
+    TimerWheel(TimerWheel&&) = delete;
+
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    /**
+     * @brief Schedule a callback to run once after a delay.
+     *
+     * @return An ID which can be used to cancel the timer, or
+     * INVALID_TIMER if the callback is empty.
+     */
+    timer_id schedule(utils::Function<void()>&& callback, std::chrono::nanoseconds delay) noexcept;
+
+    /**
+     * @brief Schedule a callback to run every "period", starting after
+     * "initialDelay". A copy of the callback is dispatched each time it
+     * fires, so it must be copyable. Periodic timers never skip a run: if
+     * advance() is called late, every missed period is dispatched.
+     *
+     * @return An ID which can be used to cancel the timer, or
+     * INVALID_TIMER if the callback is empty.
+     */
+    timer_id schedule_periodic(utils::Function<void()>&& callback, std::chrono::nanoseconds period, std::chrono::nanoseconds initialDelay) noexcept;
+
+    /**
+     * @brief Schedule a callback to run every "period", starting one period
+     * from now.
+     */
+    timer_id schedule_periodic(utils::Function<void()>&& callback, std::chrono::nanoseconds period) noexcept;
+
+    /**
+     * @brief Cancel a pending timer.
+     *
+     * @return TRUE if the timer was cancelled, FALSE if it has already
+     * fired (one-shot timers) or was already cancelled. Callbacks already
+     * handed to a pool are unaffected.
+     */
+    bool cancel(timer_id id) noexcept;
+
+    /**
+     * @brief Determine if a timer is still scheduled.
+     */
+    bool pending(timer_id id) const noexcept;
+
+    /**
+     * @brief Retrieve the number of scheduled timers.
+     */
+    std::size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    /**
+     * @brief Cancel all timers.
+     */
+    void clear() noexcept;
+
+    std::chrono::nanoseconds tick_length() const noexcept;
+
+    /**
+     * @brief Turn the wheel up to a point in time and collect the callbacks
+     * of every timer which expired, in order of expiry.
+     *
+     * @return The number of callbacks appended to "outCallbacks".
+     */
+    std::size_t expire(clock_type::time_point now, std::vector<utils::Function<void()>>& outCallbacks) noexcept;
+
+    /**
+     * @brief Turn the wheel up to a point in time and push every expired
+     * callback into a worker pool, then flush the pool once.
+     *
+     * The pool's value_type must be constructible from an
+     * ls::utils::Function<void()>.
+     *
+     * @return The number of callbacks dispatched.
+     */
+    template <class PoolType>
+    std::size_t advance(PoolType& pool, clock_type::time_point now = clock_type::now()) noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Schedule a periodic timer
+-------------------------------------*/
+inline TimerWheel::timer_id TimerWheel::schedule_periodic(utils::Function<void()>&& callback, std::chrono::nanoseconds period) noexcept
+{
+    return schedule_periodic(std::move(callback), period, period);
+}
+
+
+
+/*-------------------------------------
+ * Timer count
+-------------------------------------*/
+inline std::size_t TimerWheel::size() const noexcept
+{
+    std::lock_guard<std::mutex> lock{mLock};
+    return mNumTimers;
+}
+
+
+
+/*-------------------------------------
+ * Check for timers
+-------------------------------------*/
+inline bool TimerWheel::empty() const noexcept
+{
+    return size() == 0;
+}
+
+
+
+/*-------------------------------------
+ * Tick length
+-------------------------------------*/
+inline std::chrono::nanoseconds TimerWheel::tick_length() const noexcept
+{
+    return mTickLength;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#include "lightsky/utils/generic/TimerWheelImpl.hpp"
+
+#endif /* LS_UTILS_TIMER_WHEEL_HPP */
@@ -0,0 +1,221 @@
+/*
+ * File:   VirtualArenaMemorySource.hpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 3:05 PM
+ */
+
+#ifndef LS_UTILS_VIRTUAL_ARENA_MEMORY_SOURCE_HPP
+#define LS_UTILS_VIRTUAL_ARENA_MEMORY_SOURCE_HPP
+
+#include <cstdint> // uint32_t
+
+#include "lightsky/utils/MemorySource.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Virtual Arena Page Release Modes
+-----------------------------------------------------------------------------*/
+enum class VirtualArenaReleaseMode : uint32_t
+{
+    // Freed pages are returned to the OS immediately (MADV_DONTNEED on
+    // posix systems, MEM_DECOMMIT on Windows). Reused pages are always
+    // zero-filled.
+    VIRTUAL_ARENA_RELEASE_EAGER,
+
+    // Freed pages are reclaimed by the OS only under memory pressure
+    // (MADV_FREE on posix systems, MEM_RESET on Windows). Reused pages may
+    // retain their previous contents. Falls back to
+    // VIRTUAL_ARENA_RELEASE_EAGER if the OS does not support lazy release.
+    VIRTUAL_ARENA_RELEASE_LAZY
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief The VirtualArenaMemorySource reserves a single large range of
+ * address space up-front and serves page-granular allocations from it.
+ *
+ * Pages are committed lazily as the arena's high-water mark grows, and are
+ * released back to the OS when freed without giving up the address range.
+ * Since every allocation lives in the same contiguous range, reallocate()
+ * can grow an allocation in place whenever the pages following it are
+ * unused, avoiding both a copy and a new mapping.
+ *
+ * Allocation sizes are tracked in a page map stored at the beginning of the
+ * reservation, so free() does not require the size of an allocation. Freed
+ * ranges are coalesced with their neighbors.
+ *
+ * This memory source is thread-safe.
+-----------------------------------------------------------------------------*/
+class VirtualArenaMemorySource final : public MemorySource
+{
+  public:
+    enum : size_type
+    {
+        default_reserve_size = (sizeof(void*) >= 8) ? (4ull * 1024ull * 1024ull * 1024ull) : (256ull * 1024ull * 1024ull),
+        commit_granularity = 1024ull * 1024ull
+    };
+
+  private:
+    static constexpr uint32_t invalid_page = ~(uint32_t)0;
+
+    enum PageState : uint32_t
+    {
+        PAGE_STATE_USED,
+        PAGE_STATE_FREE
+    };
+
+    /**
+     * @brief Boundary tag for the first and last page of each range.
+     */
+    struct PageInfo
+    {
+        uint32_t numPages;
+        uint32_t state;
+        uint32_t nextFree;
+        uint32_t prevFree;
+    };
+
+    mutable SpinLock mLock;
+
+    VirtualArenaReleaseMode mReleaseMode;
+
+    size_type mPageSize;
+
+    /**
+     * @brief Start of the reserved address range (including the page map).
+     */
+    char* mReservation;
+
+    size_type mReservedBytes;
+
+    PageInfo* mPageMap;
+
+    char* mData;
+
+    uint32_t mNumPages;
+
+    /**
+     * @brief Index of the first page which has never been allocated.
+     */
+    uint32_t mTopPage;
+
+    /**
+     * @brief Number of data pages, from the start of the arena, which are
+     * currently committed.
+     */
+    uint32_t mCommittedPages;
+
+    uint32_t mFreeRanges;
+
+    size_type _num_pages_for(size_type numBytes) const noexcept;
+
+    uint32_t _page_index(const void* p) const noexcept;
+
+    bool _commit_top(uint32_t newTopPage) noexcept;
+
+    bool _commit_range(uint32_t page, uint32_t numPages) noexcept;
+
+    void _release_range(uint32_t page, uint32_t numPages) noexcept;
+
+    void _mark_range(uint32_t page, uint32_t numPages, PageState state) noexcept;
+
+    void _link_free(uint32_t page) noexcept;
+
+    void _unlink_free(uint32_t page) noexcept;
+
+    /**
+     * @brief Mark a range as free, coalescing it with neighboring free
+     * ranges or with the unused top of the arena. Must be called with
+     * mLock held.
+     */
+    void _free_range(uint32_t page, uint32_t numPages) noexcept;
+
+    /**
+     * @brief Find and claim a free range of "numPages" pages. Must be called
+     * with mLock held.
+     */
+    uint32_t _claim_range(uint32_t numPages) noexcept;
+
+  public:
+    /**
+     * @brief Destructor
+     *
+     * Releases the entire address range back to the OS.
+     */
+    virtual ~VirtualArenaMemorySource() noexcept override;
+
+    /**
+     * @brief Constructor
+     *
+     * Reserves (but does not commit) "reserveBytes" of address space, rounded
+     * up to the system page size.
+     */
+    VirtualArenaMemorySource(
+        size_type reserveBytes = default_reserve_size,
+        VirtualArenaReleaseMode releaseMode = VirtualArenaReleaseMode::VIRTUAL_ARENA_RELEASE_EAGER
+    ) noexcept;
+
+    VirtualArenaMemorySource(const VirtualArenaMemorySource&) = delete;
+
+    VirtualArenaMemorySource(VirtualArenaMemorySource&&) = delete;
+
+    VirtualArenaMemorySource& operator=(const VirtualArenaMemorySource&) = delete;
+
+    VirtualArenaMemorySource& operator=(VirtualArenaMemorySource&&) = delete;
+
+    /**
+     * @brief Determine if the initial address range was reserved.
+     */
+    bool valid() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes available for allocations.
+     */
+    size_type reserved_bytes() const noexcept;
+
+    /**
+     * @brief Retrieve the number of bytes which have been committed to the
+     * arena's high-water mark.
+     */
+    size_type committed_bytes() const noexcept;
+
+    /**
+     * @brief Determine if a pointer was allocated from *this.
+     */
+    bool contains(const void* p) const noexcept;
+
+    virtual void* allocate(size_type numBytes, size_type* pOutNumBytes = nullptr) noexcept override;
+
+    /**
+     * @brief Resize an allocation, following the rules of std::realloc().
+     *
+     * Allocations are grown in place if the pages following them are unused,
+     * and shrunk in place by releasing their trailing pages. The data is only
+     * moved if no adjacent space is available.
+     */
+    void* reallocate(void* pData, size_type numNewBytes, size_type* pOutNumBytes = nullptr) noexcept;
+
+    virtual void free(void* pData) noexcept override;
+
+    /**
+     * @brief Return an allocation to the arena. Allocation sizes are tracked
+     * internally, so "numBytes" is ignored.
+     */
+    virtual void free(void* pData, size_type numBytes) noexcept override;
+};
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_VIRTUAL_ARENA_MEMORY_SOURCE_HPP */
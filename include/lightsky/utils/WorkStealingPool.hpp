@@ -0,0 +1,247 @@
+/*
+ * File:   WorkStealingPool.hpp
+ * Author: miles
+ * Created on October 15, 2026, at 10:12 a.m.
+ */
+
+#ifndef LS_UTILS_WORK_STEALING_POOL_HPP
+#define LS_UTILS_WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <iterator> // std::distance, std::make_move_iterator
+#include <mutex> // std::mutex, std::lock_guard
+#include <thread>
+#include <utility> // std::move
+#include <vector>
+
+#include "lightsky/setup/Arch.h" // LS_ARCH_X86
+#include "lightsky/setup/Macros.h" // LS_DECLARE_CLASS_TYPE()
+
+#include "lightsky/utils/Pointer.h"
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/Future.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+#include "lightsky/utils/RingBuffer.hpp"
+#include "lightsky/utils/WorkerIdle.hpp"
+#include "lightsky/utils/WorkerMetrics.hpp"
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief WorkStealingPool is a drop-in replacement for a WorkerPool which
+ * gives each worker thread its own task queue.
+ *
+ * Tasks pushed from outside of the pool are distributed round-robin across
+ * all worker queues. Tasks pushed from within a running task are placed in
+ * the calling worker's queue. Workers run their own tasks newest-first.
+ * Once a worker has drained its own queue, it will attempt to steal the
+ * oldest tasks from other workers, starting at a random victim, before
+ * pausing.
+ *
+ * Each queue is guarded by its own cache-aligned lock so producers and
+ * consumers only contend when they touch the same queue.
+-----------------------------------------------------------------------------*/
+template <class WorkerTaskType>
+class WorkStealingPool
+{
+  public:
+    typedef WorkerTaskType value_type;
+
+  private:
+    struct alignas(64) WorkQueue
+    {
+        mutable utils::SpinLock lock;
+        utils::RingBuffer<WorkerTaskType> tasks;
+
+        // Time each task was queued, while metrics are enabled
+        utils::RingBuffer<uint64_t> enqueueTimes;
+    };
+
+    /**
+     * @brief Pointer to the pool which owns the current thread, if any.
+     * Used to route pushes from within a task to the local queue.
+     */
+    static thread_local const WorkStealingPool* tCurrentPool;
+
+    /**
+     * @brief Index of the queue owned by the current worker thread.
+     */
+    static thread_local std::size_t tCurrentQueue;
+
+    std::atomic_bool mBusyWait;
+
+    std::atomic_bool mAdaptiveWait;
+
+    std::atomic_bool mIsPaused;
+
+    std::atomic_bool mIsStopped;
+
+    WorkerWakeSignal mWakeSignal;
+
+    std::atomic<std::size_t> mThreadsRunning;
+
+    std::atomic<std::size_t> mThreadsSleeping;
+
+    alignas(64) std::atomic<std::size_t> mNumPending;
+
+    alignas(64) std::atomic<std::size_t> mNextQueue;
+
+    std::size_t mNumQueues;
+
+    utils::UniqueArray<WorkQueue> mQueues;
+
+    mutable std::mutex mWaitMtx;
+
+    mutable std::condition_variable mWaitCond;
+
+    std::mutex mExecMtx;
+
+    std::condition_variable mExecCond;
+
+    std::vector<std::thread> mThreads;
+
+    WorkerMetrics mMetrics;
+
+    std::size_t _select_queue() noexcept;
+
+    // Not inlined so member templates never touch the thread-local
+    // variables of an extern template directly.
+    std::size_t _select_queues(std::size_t numTasks, std::size_t& outNumQueues) noexcept;
+
+    void _notify_sleeper(std::size_t numTasks) noexcept;
+
+    void _record_push(WorkQueue& q, std::size_t numTasks) noexcept;
+
+    bool pop_local(std::size_t queueId, WorkerTaskType& outTask, uint64_t& outEnqueueNs) noexcept;
+
+    bool steal(std::size_t thiefId, uint32_t seed, WorkerTaskType& outTask, uint64_t& outEnqueueNs) noexcept;
+
+    void run_task(std::size_t threadId, WorkerTaskType& task, uint64_t enqueueNs) noexcept;
+
+    void execute_tasks(std::size_t threadId, uint32_t& seed) noexcept;
+
+    void thread_loop(std::size_t threadId) noexcept;
+
+    void start_threads(std::size_t numThreads) noexcept;
+
+    void stop_threads() noexcept;
+
+  public:
+    ~WorkStealingPool() noexcept;
+
+    WorkStealingPool(std::size_t numThreads = 1);
+
+    WorkStealingPool(const WorkStealingPool&) noexcept;
+
+    WorkStealingPool(WorkStealingPool&&) noexcept;
+
+    WorkStealingPool& operator=(const WorkStealingPool&) noexcept;
+
+    WorkStealingPool& operator=(WorkStealingPool&&) noexcept;
+
+    std::size_t num_pending() const noexcept;
+
+    bool have_pending() const noexcept;
+
+    void clear_pending() noexcept;
+
+    void push(const WorkerTaskType& task) noexcept;
+
+    void emplace(WorkerTaskType&& task) noexcept;
+
+    /**
+     * @brief Queue a range of tasks by copy, taking the queue's lock once
+     * and growing it at most once.
+     */
+    template <typename IterType>
+    void push_range(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a range of tasks by moving them out of the range.
+     */
+    template <typename IterType>
+    void emplace_bulk(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a callable and retrieve a Future for its result. See
+     * WorkerPool::submit().
+     */
+    template <typename Func>
+    Future<std::invoke_result_t<const std::decay_t<Func>&>> submit(Func&& func) noexcept;
+
+    bool ready() const noexcept;
+
+    void flush() noexcept;
+
+    void wait() const noexcept;
+
+    bool busy_waiting() const noexcept;
+
+    void busy_waiting(bool useBusyWait) noexcept;
+
+    /**
+     * @brief Determine if idle threads spin, yield, then park rather than
+     * sleeping on a condition variable.
+     */
+    bool adaptive_waiting() const noexcept;
+
+    /**
+     * @brief Toggle the adaptive idle strategy (see WorkerIdleStrategy).
+     * Busy waiting takes precedence when both are enabled.
+     */
+    void adaptive_waiting(bool useAdaptiveWait) noexcept;
+
+    /**
+     * @brief Determine if runtime metrics are being collected.
+     */
+    bool collect_metrics() const noexcept;
+
+    /**
+     * @brief Toggle the collection of runtime metrics (see WorkerMetrics).
+     * Metrics are disabled by default.
+     */
+    void collect_metrics(bool enableMetrics) noexcept;
+
+    /**
+     * @brief Retrieve a snapshot of the pool's metrics, including the
+     * number of tasks each thread stole. This may be called from any
+     * thread.
+     */
+    WorkerPoolStats metrics() const noexcept;
+
+    void reset_metrics() noexcept;
+
+    std::size_t concurrency(std::size_t inNumThreads) noexcept;
+
+    std::size_t concurrency() const noexcept;
+
+    const std::vector<std::thread>& threads() const noexcept;
+
+    std::vector<std::thread>& threads() noexcept;
+};
+
+
+/*-------------------------------------
+ * Convenience Types
+-------------------------------------*/
+LS_DECLARE_CLASS_TYPE(DefaultWorkStealingPool, WorkStealingPool, void (*)());
+LS_DECLARE_CLASS_TYPE(FunctionWorkStealingPool, WorkStealingPool, ls::utils::Function<void()>);
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+
+
+#include "lightsky/utils/generic/WorkStealingPoolImpl.hpp"
+
+#endif /* LS_UTILS_WORK_STEALING_POOL_HPP */
@@ -0,0 +1,178 @@
+/*
+ * File:   WorkerIdle.hpp
+ * Author: miles
+ * Created on October 18, 2026, at 2:40 p.m.
+ */
+
+#ifndef LS_UTILS_WORKER_IDLE_HPP
+#define LS_UTILS_WORKER_IDLE_HPP
+
+#include <atomic>
+#include <cstdint> // uint32_t, uint64_t
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief WorkerWakeSignal is a sequence counter which idle worker threads
+ * watch for new work.
+ *
+ * Every call to notify() advances the sequence. Threads which have parked
+ * on the sequence (a futex on Linux, via std::atomic::wait()) are only
+ * woken if at least one is parked, so notifying is a single atomic
+ * increment when all workers are spinning or busy.
+-----------------------------------------------------------------------------*/
+class WorkerWakeSignal
+{
+  private:
+    std::atomic<uint32_t> mSequence;
+
+    std::atomic<uint32_t> mNumParked;
+
+  public:
+    ~WorkerWakeSignal() noexcept = default;
+
+    WorkerWakeSignal() noexcept;
+
+    WorkerWakeSignal(const WorkerWakeSignal&) = delete;
+
+    WorkerWakeSignal(WorkerWakeSignal&&) = delete;
+
+    WorkerWakeSignal& operator=(const WorkerWakeSignal&) = delete;
+
+    WorkerWakeSignal& operator=(WorkerWakeSignal&&) = delete;
+
+    /**
+     * @brief Retrieve the current sequence. Workers should read this before
+     * checking for work, then wait until it changes.
+     */
+    uint32_t sequence() const noexcept;
+
+    /**
+     * @brief Advance the sequence and wake all parked threads.
+     */
+    void notify() noexcept;
+
+    /**
+     * @brief Block the calling thread until the sequence differs from
+     * "seq".
+     */
+    void park(uint32_t seq) noexcept;
+
+    uint32_t num_parked() const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief WorkerIdleStrategy implements an adaptive spin-then-park policy for
+ * idle worker threads.
+ *
+ * An idle thread first spins with ls::setup::cpu_yield(), then yields to the
+ * OS a few times, then parks on a WorkerWakeSignal. Each thread keeps its
+ * own instance and the spin budget is tuned from a moving average of how
+ * long the thread recently sat idle: when work arrives at short intervals
+ * the budget grows to cover them, and when it arrives rarely the budget
+ * shrinks so an idle worker doesn't hold onto a core.
+-----------------------------------------------------------------------------*/
+class WorkerIdleStrategy
+{
+  public:
+    static constexpr uint64_t MIN_SPIN_NS = 1000ull;
+
+    static constexpr uint64_t MAX_SPIN_NS = 100000ull;
+
+    static constexpr uint32_t MAX_YIELDS = 8u;
+
+  private:
+    // Moving average of the time spent idle, in nanoseconds
+    uint64_t mAvgIdleNs;
+
+    uint64_t mSpinNs;
+
+  public:
+    ~WorkerIdleStrategy() noexcept = default;
+
+    WorkerIdleStrategy() noexcept;
+
+    WorkerIdleStrategy(const WorkerIdleStrategy&) noexcept = default;
+
+    WorkerIdleStrategy(WorkerIdleStrategy&&) noexcept = default;
+
+    WorkerIdleStrategy& operator=(const WorkerIdleStrategy&) noexcept = default;
+
+    WorkerIdleStrategy& operator=(WorkerIdleStrategy&&) noexcept = default;
+
+    /**
+     * @brief Idle until the sequence of a WakeSignal differs from "seq".
+     *
+     * This may return early; callers should re-check for work and call
+     * wait() again if there is none.
+     *
+     * @return TRUE if the thread parked in the OS, FALSE if it was woken
+     * while spinning or yielding.
+     */
+    bool wait(WorkerWakeSignal& signal, uint32_t seq) noexcept;
+
+    /**
+     * @brief Current time spent spinning before yielding, in nanoseconds.
+     */
+    uint64_t spin_budget() const noexcept;
+
+    /**
+     * @brief Moving average of the time between a thread running out of
+     * work and receiving more, in nanoseconds.
+     */
+    uint64_t average_idle_time() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Current sequence
+-------------------------------------*/
+inline uint32_t WorkerWakeSignal::sequence() const noexcept
+{
+    return mSequence.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Number of parked threads
+-------------------------------------*/
+inline uint32_t WorkerWakeSignal::num_parked() const noexcept
+{
+    return mNumParked.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Spin budget
+-------------------------------------*/
+inline uint64_t WorkerIdleStrategy::spin_budget() const noexcept
+{
+    return mSpinNs;
+}
+
+
+
+/*-------------------------------------
+ * Average idle time
+-------------------------------------*/
+inline uint64_t WorkerIdleStrategy::average_idle_time() const noexcept
+{
+    return mAvgIdleNs;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_WORKER_IDLE_HPP */
@@ -0,0 +1,304 @@
+/*
+ * File:   WorkerMetrics.hpp
+ * Author: miles
+ * Created on October 20, 2026, at 10:05 a.m.
+ */
+
+#ifndef LS_UTILS_WORKER_METRICS_HPP
+#define LS_UTILS_WORKER_METRICS_HPP
+
+#include <atomic>
+#include <cstdint> // uint32_t, uint64_t
+#include <mutex>
+#include <vector>
+
+#include "lightsky/utils/Pointer.h"
+#include "lightsky/utils/RingBuffer.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A histogram of durations with power-of-two buckets.
+ *
+ * Bucket 0 holds durations below 2ns, bucket "i" holds durations in
+ * [2^i, 2^(i+1)) nanoseconds, and the last bucket holds everything longer.
+-----------------------------------------------------------------------------*/
+struct WorkerHistogram
+{
+    enum : uint32_t
+    {
+        num_buckets = 40
+    };
+
+    uint64_t count;
+
+    uint64_t totalNs;
+
+    uint64_t maxNs;
+
+    uint64_t buckets[num_buckets];
+
+    /**
+     * @brief Retrieve the bucket for a duration of "ns" nanoseconds.
+     */
+    static uint32_t bucket(uint64_t ns) noexcept;
+
+    /**
+     * @brief Retrieve the average duration, in nanoseconds.
+     */
+    uint64_t mean() const noexcept;
+
+    /**
+     * @brief Estimate a percentile, from 0 to 1, of all durations.
+     *
+     * @return The upper bound of the bucket containing the percentile,
+     * clamped to the longest recorded duration.
+     */
+    uint64_t percentile(double p) const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief Counters for a single worker thread.
+-----------------------------------------------------------------------------*/
+struct WorkerThreadStats
+{
+    uint64_t tasksRun;
+
+    // Time spent running tasks
+    uint64_t busyNs;
+
+    // Time spent waiting for tasks. An idle stretch is only counted once
+    // the thread wakes up from it.
+    uint64_t idleNs;
+
+    // Number of times the thread slept in the OS while waiting for tasks
+    uint64_t numParks;
+
+    // Number of tasks taken from another thread's queue
+    uint64_t numSteals;
+
+    /**
+     * @brief Retrieve the fraction of measured time spent running tasks.
+     */
+    double utilization() const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief A point-in-time view of a worker pool's metrics.
+-----------------------------------------------------------------------------*/
+struct WorkerPoolStats
+{
+    // Nanoseconds since an unspecified, monotonic epoch
+    uint64_t timestampNs;
+
+    uint64_t tasksQueued;
+
+    // Largest number of tasks waiting in the pool's queues at once
+    uint64_t maxQueueDepth;
+
+    // Time between a task being queued and a thread starting it
+    WorkerHistogram queueLatency;
+
+    // Time spent running each task
+    WorkerHistogram runTime;
+
+    std::vector<WorkerThreadStats> threads;
+
+    /**
+     * @brief Sum the counters of all threads.
+     */
+    WorkerThreadStats total() const noexcept;
+
+    /**
+     * @brief Retrieve the fraction of measured time all threads spent
+     * running tasks.
+     */
+    double utilization() const noexcept;
+};
+
+
+
+/**----------------------------------------------------------------------------
+ * @brief WorkerMetrics collects runtime statistics for a worker pool.
+ *
+ * Collection is disabled by default. When disabled, pools skip all timing
+ * and the only cost is checking a flag. When enabled, each task costs two
+ * clock reads and a few uncontended atomic additions on the counters of
+ * the thread which ran it. Counters are kept per-thread, in their own cache
+ * lines, and merged into a WorkerPoolStats only when a snapshot is taken,
+ * which may happen from any thread.
+-----------------------------------------------------------------------------*/
+class WorkerMetrics
+{
+  private:
+    struct alignas(64) ThreadCounters
+    {
+        std::atomic<uint64_t> tasksRun;
+        std::atomic<uint64_t> busyNs;
+        std::atomic<uint64_t> idleNs;
+        std::atomic<uint64_t> numParks;
+        std::atomic<uint64_t> numSteals;
+
+        std::atomic<uint64_t> latencyTotalNs;
+        std::atomic<uint64_t> latencyMaxNs;
+        std::atomic<uint64_t> latencyBuckets[WorkerHistogram::num_buckets];
+
+        std::atomic<uint64_t> runMaxNs;
+        std::atomic<uint64_t> runBuckets[WorkerHistogram::num_buckets];
+    };
+
+    std::atomic_bool mEnabled;
+
+    alignas(64) std::atomic<uint64_t> mTasksQueued;
+
+    std::atomic<uint64_t> mMaxQueueDepth;
+
+    // Guards the thread counters against being resized during a snapshot
+    mutable std::mutex mThreadLock;
+
+    std::size_t mNumThreads;
+
+    utils::UniqueArray<ThreadCounters> mThreads;
+
+  public:
+    ~WorkerMetrics() noexcept = default;
+
+    WorkerMetrics() noexcept;
+
+    WorkerMetrics(const WorkerMetrics&) = delete;
+
+    WorkerMetrics(WorkerMetrics&&) = delete;
+
+    WorkerMetrics& operator=(const WorkerMetrics&) = delete;
+
+    WorkerMetrics& operator=(WorkerMetrics&&) = delete;
+
+    /**
+     * @brief Read the clock used for all metrics, in nanoseconds.
+     */
+    static uint64_t now_ns() noexcept;
+
+    /**
+     * @brief Timestamp tasks which were just added to a queue.
+     *
+     * Pools keep a ring buffer of timestamps alongside each task queue,
+     * which lines up with the front of the queue. Tasks queued while
+     * metrics were disabled are given a timestamp of 0.
+     *
+     * @param queueSize
+     * The number of tasks in the queue, including the new ones.
+     *
+     * @param numTasks
+     * The number of tasks just added.
+     */
+    static void push_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize, std::size_t numTasks = 1) noexcept;
+
+    /**
+     * @brief Retrieve the timestamp of the task at the front of a queue,
+     * before popping it.
+     *
+     * @return The time the task was queued, or 0 if unknown.
+     */
+    static uint64_t pop_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize) noexcept;
+
+    /**
+     * @brief Retrieve the timestamp of the task at the back of a queue,
+     * before popping it.
+     *
+     * @return The time the task was queued, or 0 if unknown.
+     */
+    static uint64_t pop_back_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize) noexcept;
+
+    bool enabled() const noexcept;
+
+    void enabled(bool collectMetrics) noexcept;
+
+    /**
+     * @brief Resize the per-thread counters, resetting them.
+     *
+     * This must not be called while a worker is recording metrics.
+     */
+    void resize(std::size_t numThreads) noexcept;
+
+    /**
+     * @brief Reset all counters to 0.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Record tasks being queued.
+     *
+     * @param queueDepth
+     * The number of tasks waiting, including the new ones.
+     */
+    void record_push(std::size_t queueDepth, std::size_t numTasks = 1) noexcept;
+
+    /**
+     * @brief Record a task run by a thread.
+     *
+     * @param enqueueNs
+     * The time the task was queued, or 0 if unknown.
+     */
+    void record_task(std::size_t threadId, uint64_t enqueueNs, uint64_t startNs, uint64_t endNs) noexcept;
+
+    void record_idle(std::size_t threadId, uint64_t idleNs) noexcept;
+
+    void record_park(std::size_t threadId) noexcept;
+
+    void record_steal(std::size_t threadId) noexcept;
+
+    /**
+     * @brief Merge all counters into a snapshot.
+     */
+    void snapshot(WorkerPoolStats& outStats) const noexcept;
+
+    WorkerPoolStats snapshot() const noexcept;
+};
+
+
+
+/*-------------------------------------
+ * Check if metrics are collected
+-------------------------------------*/
+inline bool WorkerMetrics::enabled() const noexcept
+{
+    return mEnabled.load(std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Toggle metrics collection
+-------------------------------------*/
+inline void WorkerMetrics::enabled(bool collectMetrics) noexcept
+{
+    mEnabled.store(collectMetrics, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a snapshot
+-------------------------------------*/
+inline WorkerPoolStats WorkerMetrics::snapshot() const noexcept
+{
+    WorkerPoolStats stats;
+    snapshot(stats);
+    return stats;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_WORKER_METRICS_HPP */
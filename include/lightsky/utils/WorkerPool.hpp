@@ -9,6 +9,7 @@
 #define LS_UTILS_WORKER_POOL_HPP
 
 #include <condition_variable>
+#include <iterator> // std::make_move_iterator
 #include <mutex> // std::mutex, std::lock_guard
 #include <thread>
 #include <utility> // std::move
@@ -18,8 +19,13 @@
 #include "lightsky/setup/Macros.h" // LS_DECLARE_CLASS_TYPE()
 #include "lightsky/setup/OS.h" // LS_OS_WINDOWS
 
+#include "lightsky/utils/CpuTopology.hpp"
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/Future.hpp"
 #include "lightsky/utils/SpinLock.hpp"
 #include "lightsky/utils/RingBuffer.hpp"
+#include "lightsky/utils/WorkerIdle.hpp"
+#include "lightsky/utils/WorkerMetrics.hpp"
 
 
 
@@ -43,14 +49,27 @@ class WorkerPool
   private:
     std::atomic_bool mBusyWait;
 
+    std::atomic_bool mAdaptiveWait;
+
     std::atomic_bool mIsPaused;
 
+    WorkerWakeSignal mWakeSignal;
+
     std::atomic<size_t> mThreadsRunning;
 
+    CpuPlacement mPlacement;
+
+    int mPlacementNode;
+
     mutable utils::SpinLock mPushLock;
 
     utils::RingBuffer<WorkerTaskType> mTasks;
 
+    // Time each task was queued, while metrics are enabled
+    utils::RingBuffer<uint64_t> mEnqueueTimes;
+
+    WorkerMetrics mMetrics;
+
     mutable std::mutex mWaitMtx;
 
     mutable std::condition_variable mWaitCond;
@@ -61,9 +80,13 @@ class WorkerPool
 
     std::vector<std::thread> mThreads;
 
-    void execute_tasks() noexcept;
+    void _record_push(std::size_t numTasks) noexcept;
 
-    void thread_loop() noexcept;
+    void start_threads(size_t numThreads) noexcept;
+
+    void execute_tasks(size_t threadId) noexcept;
+
+    void thread_loop(size_t threadId) noexcept;
 
     void stop_threads() noexcept;
 
@@ -72,6 +95,13 @@ class WorkerPool
 
     WorkerPool(size_t numThreads = 1);
 
+    /**
+     * @brief Construct a pool with threads placed according to the system
+     * CPU topology. Use a non-negative "numaNode" to keep a pool's threads
+     * on a single NUMA node.
+     */
+    WorkerPool(size_t numThreads, CpuPlacement policy, int numaNode = -1);
+
     WorkerPool(const WorkerPool&) noexcept;
 
     WorkerPool(WorkerPool&&) noexcept;
@@ -94,6 +124,33 @@ class WorkerPool
 
     void emplace(WorkerTaskType&& task) noexcept;
 
+    /**
+     * @brief Queue a range of tasks by copy, taking the queue's lock once
+     * and growing it at most once.
+     */
+    template <typename IterType>
+    void push_range(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a range of tasks by moving them out of the range.
+     */
+    template <typename IterType>
+    void emplace_bulk(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a callable and retrieve a Future for its result.
+     *
+     * WorkerTaskType must be constructible from a lambda, such as
+     * ls::utils::Function<void()>. As with push() and emplace(), the task
+     * will not run until the next call to flush().
+     *
+     * @return A Future which becomes ready once the task has run. The
+     * Future is invalid, and nothing is queued, if memory for its shared
+     * state could not be allocated.
+     */
+    template <typename Func>
+    Future<std::invoke_result_t<const std::decay_t<Func>&>> submit(Func&& func) noexcept;
+
     bool ready() const noexcept;
 
     void flush() noexcept;
@@ -104,6 +161,50 @@ class WorkerPool
 
     void busy_waiting(bool useBusyWait) noexcept;
 
+    /**
+     * @brief Determine if idle threads spin, yield, then park rather than
+     * sleeping on a condition variable.
+     */
+    bool adaptive_waiting() const noexcept;
+
+    /**
+     * @brief Toggle the adaptive idle strategy (see WorkerIdleStrategy).
+     * Each thread tunes its own spin budget. Busy waiting takes precedence
+     * when both are enabled.
+     */
+    void adaptive_waiting(bool useAdaptiveWait) noexcept;
+
+    /**
+     * @brief Pin all threads using a placement policy (see place_threads()).
+     * The policy is re-applied whenever the thread count changes.
+     *
+     * @return TRUE if every thread was placed, FALSE otherwise.
+     */
+    bool placement(CpuPlacement policy, int numaNode = -1) noexcept;
+
+    CpuPlacement placement() const noexcept;
+
+    int placement_node() const noexcept;
+
+    /**
+     * @brief Determine if runtime metrics are being collected.
+     */
+    bool collect_metrics() const noexcept;
+
+    /**
+     * @brief Toggle the collection of runtime metrics (see WorkerMetrics).
+     * Metrics are disabled by default.
+     */
+    void collect_metrics(bool enableMetrics) noexcept;
+
+    /**
+     * @brief Retrieve a snapshot of the pool's metrics. This may be called
+     * from any thread.
+     */
+    WorkerPoolStats metrics() const noexcept;
+
+    void reset_metrics() noexcept;
+
     size_t concurrency(size_t inNumThreads) noexcept;
 
     size_t concurrency() const noexcept;
@@ -118,6 +219,7 @@ class WorkerPool
  * Convenience Types
 -------------------------------------*/
 LS_DECLARE_CLASS_TYPE(DefaultWorkerPool, WorkerPool, void (*)());
+LS_DECLARE_CLASS_TYPE(FunctionWorkerPool, WorkerPool, ls::utils::Function<void()>);
 
 
 
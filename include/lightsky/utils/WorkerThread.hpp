@@ -9,6 +9,7 @@
 #define LS_UTILS_WORKER_THREAD_HPP
 
 #include <condition_variable>
+#include <iterator> // std::make_move_iterator
 #include <mutex> // std::mutex, std::lock_guard
 #include <thread>
 #include <utility> // std::move
@@ -37,8 +38,12 @@
     #include <synchapi.h>
 #endif /* LS_UTILS_USE_WINDOWS_THREADS */
 
+#include "lightsky/utils/CpuTopology.hpp"
+#include "lightsky/utils/Function.hpp"
+#include "lightsky/utils/Future.hpp"
 #include "lightsky/utils/SpinLock.hpp"
 #include "lightsky/utils/RingBuffer.hpp"
+#include "lightsky/utils/WorkerIdle.hpp"
 
 
 
@@ -58,6 +63,16 @@ bool set_thread_affinity(size_t threadId, unsigned affinity) noexcept;
 
 bool set_thread_affinity(std::thread& t, unsigned affinity) noexcept;
 
+/**
+ * @brief Allow a thread to run on any of a set of logical CPUs.
+ *
+ * @return TRUE if the affinity was set, FALSE on error or on platforms other
+ * than Linux, where CPU sets are not supported.
+ */
+bool set_thread_affinity(size_t threadId, const unsigned* pCpus, size_t numCpus) noexcept;
+
+bool set_thread_affinity(std::thread& t, const unsigned* pCpus, size_t numCpus) noexcept;
+
 
 
 /**----------------------------------------------------------------------------
@@ -73,8 +88,12 @@ class WorkerThread
   private:
     std::atomic_bool mBusyWait;
 
+    std::atomic_bool mAdaptiveWait;
+
     std::atomic_bool mIsPaused;
 
+    WorkerWakeSignal mWakeSignal;
+
     mutable utils::SpinLock mPushLock;
 
     utils::RingBuffer<WorkerTaskType> mTasks;
@@ -130,6 +149,26 @@ class WorkerThread
 
     void emplace(WorkerTaskType&& task) noexcept;
 
+    /**
+     * @brief Queue a range of tasks by copy, taking the queue's lock once
+     * and growing it at most once.
+     */
+    template <typename IterType>
+    void push_range(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a range of tasks by moving them out of the range.
+     */
+    template <typename IterType>
+    void emplace_bulk(IterType first, IterType last) noexcept;
+
+    /**
+     * @brief Queue a callable and retrieve a Future for its result. See
+     * WorkerPool::submit().
+     */
+    template <typename Func>
+    Future<std::invoke_result_t<const std::decay_t<Func>&>> submit(Func&& func) noexcept;
+
     bool ready() const noexcept;
 
     void flush() noexcept;
@@ -140,6 +179,24 @@ class WorkerThread
 
     void busy_waiting(bool useBusyWait) noexcept;
 
+    /**
+     * @brief Determine if the thread spins, yields, then parks while idle,
+     * rather than sleeping on a condition variable.
+     */
+    bool adaptive_waiting() const noexcept;
+
+    /**
+     * @brief Toggle the adaptive idle strategy (see WorkerIdleStrategy).
+     * Busy waiting takes precedence when both are enabled.
+     */
+    void adaptive_waiting(bool useAdaptiveWait) noexcept;
+
+    /**
+     * @brief Pin the thread to a CPU using the system topology, as if it
+     * were thread number "threadIndex" of a pool. See place_thread().
+     */
+    bool placement(CpuPlacement policy, size_t threadIndex = 0, int numaNode = -1) noexcept;
+
     size_t concurrency(size_t inNumThreads) noexcept;
 
     size_t concurrency() const noexcept;
@@ -150,6 +207,7 @@ class WorkerThread
  * Convenience Types
 -------------------------------------*/
 LS_DECLARE_CLASS_TYPE(DefaultWorkerThread, WorkerThread, void (*)());
+LS_DECLARE_CLASS_TYPE(FunctionWorkerThread, WorkerThread, ls::utils::Function<void()>);
 
 
 
@@ -49,6 +49,72 @@ inline const Barrier::native_handle_type& Barrier::native_handle() const noexcep
 
 
 
+/*-----------------------------------------------------------------------------
+ * Sense-Reversing Barrier
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Completed Phases
+-------------------------------------*/
+inline uint32_t SenseBarrier::phase() const noexcept
+{
+    return mPhase.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Current Thread Count
+-------------------------------------*/
+inline uint32_t SenseBarrier::num_waiting_threads() const noexcept
+{
+    return mThreadCount - mBarrierCount.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Required Thread Count
+-------------------------------------*/
+inline uint32_t SenseBarrier::num_required_threads() const noexcept
+{
+    return mThreadCount;
+}
+
+
+
+/*-------------------------------------
+ * Native Handle (const)
+-------------------------------------*/
+inline const SenseBarrier::native_handle_type& SenseBarrier::native_handle() const noexcept
+{
+    return mPhase;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Dissemination Barrier
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Rounds per Wait
+-------------------------------------*/
+inline uint32_t DisseminationBarrier::num_rounds() const noexcept
+{
+    return mNumRounds;
+}
+
+
+
+/*-------------------------------------
+ * Required Thread Count
+-------------------------------------*/
+inline uint32_t DisseminationBarrier::num_required_threads() const noexcept
+{
+    return mThreadCount;
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * PThreads R/W Semaphore
 -----------------------------------------------------------------------------*/
@@ -132,6 +132,385 @@ inline void ChunkAllocator<block_size, total_size>::free(void* p, size_type n) n
 
 
 
+/*-------------------------------------
+ * Free-list statistics
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size>
+bool ChunkAllocator<block_size, total_size>::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    outStats = FreeListStats{0, 0, 0};
+
+    for (const AllocationEntry* iter = mHead; iter; iter = iter->pNext)
+    {
+        ++outStats.numFreeBlocks;
+    }
+
+    outStats.numFreeBytes = outStats.numFreeBlocks * block_size;
+    outStats.largestFreeBlock = outStats.numFreeBlocks ? block_size : 0;
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Lock-Free Chunk Allocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Pack a stack head
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+constexpr uint64_t LockFreeChunkAllocator<block_size, total_size, cache_size>::_pack_head(uint64_t tag, uint32_t index) noexcept
+{
+    return (tag << 32ull) | (uint64_t)index;
+}
+
+
+
+/*-------------------------------------
+ * Unpack the index from a stack head
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+constexpr uint32_t LockFreeChunkAllocator<block_size, total_size, cache_size>::_head_index(uint64_t head) noexcept
+{
+    return (uint32_t)(head & 0xFFFFFFFFull);
+}
+
+
+
+/*-------------------------------------
+ * Unpack the tag from a stack head
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+constexpr uint64_t LockFreeChunkAllocator<block_size, total_size, cache_size>::_head_tag(uint64_t head) noexcept
+{
+    return head >> 32ull;
+}
+
+
+
+/*-------------------------------------
+ * Index to chunk
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline typename LockFreeChunkAllocator<block_size, total_size, cache_size>::AllocationEntry*
+LockFreeChunkAllocator<block_size, total_size, cache_size>::_entry(uint32_t index) const noexcept
+{
+    return mAllocTable + (index - 1u);
+}
+
+
+
+/*-------------------------------------
+ * Chunk to index
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline uint32_t LockFreeChunkAllocator<block_size, total_size, cache_size>::_index_of(const void* p) const noexcept
+{
+    return (uint32_t)(reinterpret_cast<const AllocationEntry*>(p) - mAllocTable) + 1u;
+}
+
+
+
+/*-------------------------------------
+ * Push a list of chunks
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::_push_list(uint32_t firstIndex, uint32_t lastIndex) noexcept
+{
+    // Links are accessed atomically since a concurrent _pop() may read the
+    // link of a chunk which was just pushed or popped by another thread.
+    std::atomic_ref<uint32_t> lastLink{_entry(lastIndex)->nextIndex};
+    uint64_t head = mHead.load(std::memory_order_relaxed);
+    uint64_t newHead;
+
+    do
+    {
+        lastLink.store(_head_index(head), std::memory_order_relaxed);
+        newHead = _pack_head(_head_tag(head) + 1ull, firstIndex);
+    }
+    while (!mHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+
+/*-------------------------------------
+ * Pop a single chunk
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline uint32_t LockFreeChunkAllocator<block_size, total_size, cache_size>::_pop() noexcept
+{
+    uint64_t head = mHead.load(std::memory_order_acquire);
+    uint64_t newHead;
+    uint32_t index;
+
+    do
+    {
+        index = _head_index(head);
+        if (index == null_index)
+        {
+            return null_index;
+        }
+
+        // The chunk may have been taken, and written to, by another thread
+        // already. In that case the tag will have changed and the exchange
+        // below discards the stale link. The allocation table is never
+        // released while *this is alive, so the read itself is always safe.
+        const uint32_t nextIndex = std::atomic_ref<uint32_t>{_entry(index)->nextIndex}.load(std::memory_order_relaxed);
+        newHead = _pack_head(_head_tag(head) + 1ull, nextIndex);
+    }
+    while (!mHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return index;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+LockFreeChunkAllocator<block_size, total_size, cache_size>::~LockFreeChunkAllocator() noexcept
+{
+    delete [] mAllocTable;
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+LockFreeChunkAllocator<block_size, total_size, cache_size>::LockFreeChunkAllocator() noexcept :
+    mAllocTable{new AllocationEntry[total_size/block_size]},
+    mHead{_pack_head(0, 1u)}
+{
+    constexpr uint32_t numChunks = (uint32_t)(total_size/block_size);
+
+    // setup all links in the allocation list
+    for (uint32_t i = 0; i < numChunks; ++i)
+    {
+        mAllocTable[i].nextIndex = i + 2u;
+    }
+
+    mAllocTable[numChunks - 1u].nextIndex = null_index;
+}
+
+
+
+/*-------------------------------------
+ * General Allocations
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void* LockFreeChunkAllocator<block_size, total_size, cache_size>::allocate() noexcept
+{
+    const uint32_t index = _pop();
+    return (index != null_index) ? reinterpret_cast<void*>(_entry(index)) : nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Array Allocations
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void* LockFreeChunkAllocator<block_size, total_size, cache_size>::allocate(size_type n) noexcept
+{
+    if (n <= 0 || n > block_size)
+    {
+        return nullptr;
+    }
+
+    return allocate();
+}
+
+
+
+/*-------------------------------------
+ * Free Memory
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::free(void* p) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    const uint32_t index = _index_of(p);
+    _push_list(index, index);
+}
+
+
+
+/*-------------------------------------
+ * Free Memory
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::free(void* p, size_type n) noexcept
+{
+    (void)n;
+    free(p);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Lock-Free Chunk Allocator Thread Cache
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Return chunks to the allocator
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+void LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::_flush(uint32_t numChunks) noexcept
+{
+    if (!numChunks)
+    {
+        return;
+    }
+
+    // Detach the first "numChunks" chunks and push them all at once
+    const uint32_t firstIndex = mHead;
+    uint32_t lastIndex = firstIndex;
+
+    for (uint32_t i = 1; i < numChunks; ++i)
+    {
+        lastIndex = std::atomic_ref<uint32_t>{mAllocator->_entry(lastIndex)->nextIndex}.load(std::memory_order_relaxed);
+    }
+
+    mHead = std::atomic_ref<uint32_t>{mAllocator->_entry(lastIndex)->nextIndex}.load(std::memory_order_relaxed);
+    mNumCached -= numChunks;
+
+    mAllocator->_push_list(firstIndex, lastIndex);
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::~ThreadCache() noexcept
+{
+    flush();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::ThreadCache(LockFreeChunkAllocator& allocator) noexcept :
+    mAllocator{&allocator},
+    mHead{null_index},
+    mNumCached{0}
+{}
+
+
+
+/*-------------------------------------
+ * Cached Allocations
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void* LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::allocate() noexcept
+{
+    if (mHead == null_index)
+    {
+        // Refill half of the cache so a following free() doesn't
+        // immediately overflow it.
+        for (uint32_t i = 0; i < (uint32_t)(cache_size/2u); ++i)
+        {
+            const uint32_t index = mAllocator->_pop();
+            if (index == null_index)
+            {
+                break;
+            }
+
+            std::atomic_ref<uint32_t>{mAllocator->_entry(index)->nextIndex}.store(mHead, std::memory_order_relaxed);
+            mHead = index;
+            ++mNumCached;
+        }
+
+        if (mHead == null_index)
+        {
+            return nullptr;
+        }
+    }
+
+    AllocationEntry* const pEntry = mAllocator->_entry(mHead);
+    mHead = std::atomic_ref<uint32_t>{pEntry->nextIndex}.load(std::memory_order_relaxed);
+    --mNumCached;
+
+    return reinterpret_cast<void*>(pEntry);
+}
+
+
+
+/*-------------------------------------
+ * Cached Array Allocations
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void* LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::allocate(size_type n) noexcept
+{
+    if (n <= 0 || n > block_size)
+    {
+        return nullptr;
+    }
+
+    return allocate();
+}
+
+
+
+/*-------------------------------------
+ * Cached Free
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::free(void* p) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    if (mNumCached == (uint32_t)cache_size)
+    {
+        _flush((uint32_t)(cache_size/2u));
+    }
+
+    // Chunk links are always accessed atomically, see _push_list()
+    const uint32_t index = mAllocator->_index_of(p);
+    std::atomic_ref<uint32_t>{mAllocator->_entry(index)->nextIndex}.store(mHead, std::memory_order_relaxed);
+    mHead = index;
+    ++mNumCached;
+}
+
+
+
+/*-------------------------------------
+ * Cached Free
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::free(void* p, size_type n) noexcept
+{
+    (void)n;
+    free(p);
+}
+
+
+
+/*-------------------------------------
+ * Return all cached chunks
+-------------------------------------*/
+template <unsigned long long block_size, unsigned long long total_size, unsigned long long cache_size>
+inline void LockFreeChunkAllocator<block_size, total_size, cache_size>::ThreadCache::flush() noexcept
+{
+    _flush(mNumCached);
+}
+
+
+
 } // utils namespace
 } // ls namespace
 
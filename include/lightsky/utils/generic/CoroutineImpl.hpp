@@ -0,0 +1,656 @@
+/*
+ * File:   CoroutineImpl.hpp
+ * Author: miles
+ * Created on October 18, 2026, at 10:15 a.m.
+ */
+
+#ifndef LS_UTILS_COROUTINE_IMPL_HPP
+#define LS_UTILS_COROUTINE_IMPL_HPP
+
+#include <exception> // std::terminate
+#include <utility> // std::forward, std::exchange
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * ScheduleAwaitable
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <class PoolType>
+inline ScheduleAwaitable<PoolType>::ScheduleAwaitable(PoolType& pool) noexcept :
+    mPool{&pool}
+{}
+
+
+
+/*-------------------------------------
+ * Always suspend
+-------------------------------------*/
+template <class PoolType>
+inline bool ScheduleAwaitable<PoolType>::await_ready() const noexcept
+{
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Hand the coroutine to the pool
+-------------------------------------*/
+template <class PoolType>
+inline void ScheduleAwaitable<PoolType>::await_suspend(std::coroutine_handle<> h) const noexcept
+{
+    typedef typename PoolType::value_type task_type;
+
+    mPool->emplace(task_type{[h]()->void
+    {
+        h.resume();
+    }});
+
+    mPool->flush();
+}
+
+
+
+/*-------------------------------------
+ * Resume
+-------------------------------------*/
+template <class PoolType>
+inline void ScheduleAwaitable<PoolType>::await_resume() const noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Create a ScheduleAwaitable
+-------------------------------------*/
+template <class PoolType>
+inline ScheduleAwaitable<PoolType> schedule(PoolType& pool) noexcept
+{
+    return ScheduleAwaitable<PoolType>{pool};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * TaskPromiseBase
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Task completion
+-------------------------------------*/
+template <typename PromiseType>
+std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<PromiseType> h) const noexcept
+{
+    // Another thread may destroy the Task as soon as it has been joined or
+    // signaled, so nothing in the promise can be touched afterwards.
+    TaskPromiseBase& promise = h.promise();
+    const std::coroutine_handle<> continuation = promise.mContinuation;
+    AsyncEvent* const pEvent = promise.mCompletionEvent;
+
+    if (promise.mJoinCount && promise.mJoinCount->fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return std::noop_coroutine();
+    }
+
+    if (pEvent)
+    {
+        pEvent->set();
+    }
+
+    return continuation ? continuation : std::noop_coroutine();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+inline TaskPromiseBase::TaskPromiseBase() noexcept :
+    mContinuation{},
+    mJoinCount{nullptr},
+    mCompletionEvent{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Tasks start lazily
+-------------------------------------*/
+inline std::suspend_always TaskPromiseBase::initial_suspend() const noexcept
+{
+    return std::suspend_always{};
+}
+
+
+
+/*-------------------------------------
+ * Tasks stay alive until destroyed by their owner
+-------------------------------------*/
+inline TaskPromiseBase::FinalAwaiter TaskPromiseBase::final_suspend() const noexcept
+{
+    return FinalAwaiter{};
+}
+
+
+
+/*-------------------------------------
+ * Exceptions are not supported
+-------------------------------------*/
+inline void TaskPromiseBase::unhandled_exception() const noexcept
+{
+    std::terminate();
+}
+
+
+
+/*-------------------------------------
+ * Completion handling
+-------------------------------------*/
+inline void TaskPromiseBase::continue_with(std::coroutine_handle<> continuation, std::atomic<std::size_t>* pJoinCount, AsyncEvent* pEvent) noexcept
+{
+    mContinuation = continuation;
+    mJoinCount = pJoinCount;
+    mCompletionEvent = pEvent;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * TaskPromise
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <typename T>
+inline TaskPromise<T>::~TaskPromise() noexcept
+{
+    if (mHaveValue)
+    {
+        mValue.destroy();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+inline TaskPromise<T>::TaskPromise() noexcept :
+    TaskPromiseBase{},
+    mValue{},
+    mHaveValue{false}
+{}
+
+
+
+/*-------------------------------------
+ * Create the Task
+-------------------------------------*/
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+
+
+/*-------------------------------------
+ * Allocation failure
+-------------------------------------*/
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object_on_allocation_failure() noexcept
+{
+    return Task<T>{};
+}
+
+
+
+/*-------------------------------------
+ * Store the result
+-------------------------------------*/
+template <typename T>
+template <typename U>
+inline void TaskPromise<T>::return_value(U&& value) noexcept
+{
+    mValue.construct(std::forward<U>(value));
+    mHaveValue = true;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the result
+-------------------------------------*/
+template <typename T>
+inline T& TaskPromise<T>::result() noexcept
+{
+    return mValue.get();
+}
+
+
+
+/*-------------------------------------
+ * Create the Task (void)
+-------------------------------------*/
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+
+
+/*-------------------------------------
+ * Allocation failure (void)
+-------------------------------------*/
+inline Task<void> TaskPromise<void>::get_return_object_on_allocation_failure() noexcept
+{
+    return Task<void>{};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Task Awaiter
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+inline Task<T>::Awaiter::Awaiter(std::coroutine_handle<promise_type> h) noexcept :
+    mHandle{h}
+{}
+
+
+
+/*-------------------------------------
+ * Invalid or finished Tasks don't suspend
+-------------------------------------*/
+template <typename T>
+inline bool Task<T>::Awaiter::await_ready() const noexcept
+{
+    return !mHandle || mHandle.done();
+}
+
+
+
+/*-------------------------------------
+ * Start the Task
+-------------------------------------*/
+template <typename T>
+inline std::coroutine_handle<> Task<T>::Awaiter::await_suspend(std::coroutine_handle<> awaiting) const noexcept
+{
+    mHandle.promise().continue_with(awaiting);
+    return mHandle;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the result
+-------------------------------------*/
+template <typename T>
+inline std::add_lvalue_reference_t<T> Task<T>::Awaiter::await_resume() const noexcept
+{
+    return mHandle.promise().result();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Task
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <typename T>
+inline Task<T>::~Task() noexcept
+{
+    if (mHandle)
+    {
+        mHandle.destroy();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+inline Task<T>::Task() noexcept :
+    mHandle{}
+{}
+
+
+
+/*-------------------------------------
+ * Constructor (from a promise)
+-------------------------------------*/
+template <typename T>
+inline Task<T>::Task(std::coroutine_handle<promise_type> h) noexcept :
+    mHandle{h}
+{}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+template <typename T>
+inline Task<T>::Task(Task&& t) noexcept :
+    mHandle{std::exchange(t.mHandle, std::coroutine_handle<promise_type>{})}
+{}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+template <typename T>
+inline Task<T>& Task<T>::operator=(Task&& t) noexcept
+{
+    if (this != &t)
+    {
+        if (mHandle)
+        {
+            mHandle.destroy();
+        }
+
+        mHandle = std::exchange(t.mHandle, std::coroutine_handle<promise_type>{});
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Check for a coroutine
+-------------------------------------*/
+template <typename T>
+inline bool Task<T>::valid() const noexcept
+{
+    return (bool)mHandle;
+}
+
+
+
+/*-------------------------------------
+ * Check for completion
+-------------------------------------*/
+template <typename T>
+inline bool Task<T>::done() const noexcept
+{
+    return mHandle && mHandle.done();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the result
+-------------------------------------*/
+template <typename T>
+inline std::add_lvalue_reference_t<T> Task<T>::result() noexcept
+{
+    return mHandle.promise().result();
+}
+
+
+
+/*-------------------------------------
+ * Coroutine handle
+-------------------------------------*/
+template <typename T>
+inline std::coroutine_handle<typename Task<T>::promise_type> Task<T>::handle() const noexcept
+{
+    return mHandle;
+}
+
+
+
+/*-------------------------------------
+ * Await
+-------------------------------------*/
+template <typename T>
+inline typename Task<T>::Awaiter Task<T>::operator co_await() const noexcept
+{
+    return Awaiter{mHandle};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * when_all()
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename... TaskTypes>
+inline WhenAllAwaitable<TaskTypes...>::WhenAllAwaitable(TaskTypes&... tasks) noexcept :
+    mRemaining{sizeof...(TaskTypes) + 1u},
+    mTasks{tasks...}
+{}
+
+
+
+/*-------------------------------------
+ * Nothing to wait for
+-------------------------------------*/
+template <typename... TaskTypes>
+inline bool WhenAllAwaitable<TaskTypes...>::await_ready() const noexcept
+{
+    return sizeof...(TaskTypes) == 0;
+}
+
+
+
+/*-------------------------------------
+ * Start all Tasks
+-------------------------------------*/
+template <typename... TaskTypes>
+bool WhenAllAwaitable<TaskTypes...>::await_suspend(std::coroutine_handle<> awaiting) noexcept
+{
+    std::apply([&](auto&... tasks)->void
+    {
+        ([&](auto& task)->void
+        {
+            if (!task.valid() || task.done())
+            {
+                mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+                return;
+            }
+
+            task.handle().promise().continue_with(awaiting, &mRemaining);
+            task.handle().resume();
+        }(tasks), ...);
+    }, mTasks);
+
+    // Resume immediately if every Task finished while being started
+    return mRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+
+
+/*-------------------------------------
+ * Constructor (range)
+-------------------------------------*/
+template <typename T>
+inline WhenAllRangeAwaitable<T>::WhenAllRangeAwaitable(Task<T>* pTasks, std::size_t numTasks) noexcept :
+    mRemaining{numTasks + 1u},
+    mTasks{pTasks},
+    mNumTasks{numTasks}
+{}
+
+
+
+/*-------------------------------------
+ * Nothing to wait for (range)
+-------------------------------------*/
+template <typename T>
+inline bool WhenAllRangeAwaitable<T>::await_ready() const noexcept
+{
+    return mNumTasks == 0;
+}
+
+
+
+/*-------------------------------------
+ * Start all Tasks (range)
+-------------------------------------*/
+template <typename T>
+bool WhenAllRangeAwaitable<T>::await_suspend(std::coroutine_handle<> awaiting) noexcept
+{
+    for (std::size_t i = 0; i < mNumTasks; ++i)
+    {
+        Task<T>& task = mTasks[i];
+
+        if (!task.valid() || task.done())
+        {
+            mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+            continue;
+        }
+
+        task.handle().promise().continue_with(awaiting, &mRemaining);
+        task.handle().resume();
+    }
+
+    return mRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+
+
+/*-------------------------------------
+ * Create a WhenAllAwaitable
+-------------------------------------*/
+template <typename... Ts>
+inline WhenAllAwaitable<Task<Ts>...> when_all(Task<Ts>&... tasks) noexcept
+{
+    return WhenAllAwaitable<Task<Ts>...>{tasks...};
+}
+
+
+
+/*-------------------------------------
+ * Create a WhenAllRangeAwaitable
+-------------------------------------*/
+template <typename T>
+inline WhenAllRangeAwaitable<T> when_all(Task<T>* pTasks, std::size_t numTasks) noexcept
+{
+    return WhenAllRangeAwaitable<T>{pTasks, numTasks};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * AsyncEvent
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Awaiter Constructor
+-------------------------------------*/
+inline AsyncEvent::Awaiter::Awaiter(AsyncEvent& event) noexcept :
+    mEvent{&event},
+    mNext{nullptr},
+    mHandle{}
+{}
+
+
+
+/*-------------------------------------
+ * Skip suspension if already set
+-------------------------------------*/
+inline bool AsyncEvent::Awaiter::await_ready() const noexcept
+{
+    return mEvent->is_set();
+}
+
+
+
+/*-------------------------------------
+ * Check if the event is set
+-------------------------------------*/
+inline bool AsyncEvent::is_set() const noexcept
+{
+    return mIsSet.load(std::memory_order_acquire) != 0;
+}
+
+
+
+/*-------------------------------------
+ * Set the event, resuming on a pool
+-------------------------------------*/
+template <class PoolType>
+void AsyncEvent::set(PoolType& pool) noexcept
+{
+    typedef typename PoolType::value_type task_type;
+
+    Awaiter* pWaiter = _signal();
+    if (!pWaiter)
+    {
+        return;
+    }
+
+    while (pWaiter)
+    {
+        // Read the next waiter first, resuming a coroutine can destroy its
+        // awaiter.
+        Awaiter* const pNext = pWaiter->mNext;
+        const std::coroutine_handle<> h = pWaiter->mHandle;
+
+        pool.emplace(task_type{[h]()->void
+        {
+            h.resume();
+        }});
+
+        pWaiter = pNext;
+    }
+
+    pool.flush();
+}
+
+
+
+/*-------------------------------------
+ * Await the event
+-------------------------------------*/
+inline AsyncEvent::Awaiter AsyncEvent::operator co_await() noexcept
+{
+    return Awaiter{*this};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * sync_wait()
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Run a Task to completion
+-------------------------------------*/
+template <typename T>
+std::add_lvalue_reference_t<T> sync_wait(Task<T>& task) noexcept
+{
+    if (!task.done())
+    {
+        AsyncEvent finished{false};
+        task.handle().promise().continue_with(std::coroutine_handle<>{}, nullptr, &finished);
+        task.handle().resume();
+        finished.wait();
+    }
+
+    return task.result();
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_COROUTINE_IMPL_HPP */
@@ -568,7 +568,9 @@ template <typename Callable>
 bool CallableType<ResultType(ArgsType...)>::_init(Callable&& fp) noexcept
 {
     _reset();
-    mFunction = FunctionType<Callable, ResultType(ArgsType...)>::clone_unchecked(mBuffer, ls::setup::forward<Callable>(fp));
+    // Callables are always stored by value, never as a reference
+    typedef std::decay_t<Callable> StorageType;
+    mFunction = FunctionType<StorageType, ResultType(ArgsType...)>::clone_unchecked(mBuffer, StorageType{ls::setup::forward<Callable>(fp)});
     return mFunction != nullptr;
 }
 
@@ -798,7 +800,9 @@ template <typename Callable>
 bool CallableType<ResultType()>::_init(Callable&& fp) noexcept
 {
     _reset();
-    mFunction = FunctionType<Callable, ResultType()>::clone_unchecked(mBuffer, ls::setup::forward<Callable>(fp));
+    // Callables are always stored by value, never as a reference
+    typedef std::decay_t<Callable> StorageType;
+    mFunction = FunctionType<StorageType, ResultType()>::clone_unchecked(mBuffer, StorageType{ls::setup::forward<Callable>(fp)});
     return mFunction != nullptr;
 }
 
@@ -959,6 +963,19 @@ Function<ResultType(ArgsType...)>::Function(const Function& func) noexcept :
 
 
 
+/*-------------------------------------
+ * Copy Constructor (non-const)
+ *
+ * Prevents the templated constructor from wrapping a reference to "func".
+-------------------------------------*/
+template <typename ResultType, typename... ArgsType>
+Function<ResultType(ArgsType...)>::Function(Function& func) noexcept :
+    mFunction{func.mFunction}
+{
+}
+
+
+
 /*-------------------------------------
  * Move Constructor
 -------------------------------------*/
@@ -986,6 +1003,17 @@ Function<ResultType(ArgsType...)>& Function<ResultType(ArgsType...)>::operator=(
 
 
 
+/*-------------------------------------
+ * Copy Operator (non-const)
+-------------------------------------*/
+template <typename ResultType, typename... ArgsType>
+Function<ResultType(ArgsType...)>& Function<ResultType(ArgsType...)>::operator=(Function& func) noexcept
+{
+    return *this = static_cast<const Function&>(func);
+}
+
+
+
 /*-------------------------------------
  * Move Operator
 -------------------------------------*/
@@ -1144,6 +1172,19 @@ Function<ResultType()>::Function(const Function& func) noexcept :
 
 
 
+/*-------------------------------------
+ * Copy Constructor (non-const)
+ *
+ * Prevents the templated constructor from wrapping a reference to "func".
+-------------------------------------*/
+template <typename ResultType>
+Function<ResultType()>::Function(Function& func) noexcept :
+    mFunction{func.mFunction}
+{
+}
+
+
+
 /*-------------------------------------
  * Move Constructor
 -------------------------------------*/
@@ -1171,6 +1212,17 @@ Function<ResultType()>& Function<ResultType()>::operator=(const Function& func)
 
 
 
+/*-------------------------------------
+ * Copy Operator (non-const)
+-------------------------------------*/
+template <typename ResultType>
+Function<ResultType()>& Function<ResultType()>::operator=(Function& func) noexcept
+{
+    return *this = static_cast<const Function&>(func);
+}
+
+
+
 /*-------------------------------------
  * Move Operator
 -------------------------------------*/
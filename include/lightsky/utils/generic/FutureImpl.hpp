@@ -0,0 +1,618 @@
+/*
+ * File:   FutureImpl.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 5:10 p.m.
+ */
+
+#ifndef LS_UTILS_FUTURE_IMPL_HPP
+#define LS_UTILS_FUTURE_IMPL_HPP
+
+#include <new> // placement new, std::nothrow, std::launder
+#include <utility> // std::move, std::forward
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Future Result Storage
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Construct the result
+-------------------------------------*/
+template <typename T>
+template <typename... ArgsType>
+inline void FutureValue<T>::construct(ArgsType&&... args) noexcept
+{
+    new(mData) T(std::forward<ArgsType>(args)...);
+}
+
+
+
+/*-------------------------------------
+ * Destroy the result
+-------------------------------------*/
+template <typename T>
+inline void FutureValue<T>::destroy() noexcept
+{
+    get().~T();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the result
+-------------------------------------*/
+template <typename T>
+inline T& FutureValue<T>::get() noexcept
+{
+    return *std::launder(reinterpret_cast<T*>(mData));
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Future Shared State
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Publish the result
+-------------------------------------*/
+template <typename T>
+void FutureState<T>::_finish(FutureStatus status) noexcept
+{
+    continuation_type continuation;
+    bool haveContinuation;
+
+    // The status is published under the lock so a concurrent call to
+    // attach() either sees the result or leaves its continuation for us.
+    mLock.lock();
+    mStatus.store(status, std::memory_order_release);
+    haveContinuation = mHaveContinuation;
+    mHaveContinuation = false;
+    if (haveContinuation)
+    {
+        continuation = std::move(mContinuation);
+    }
+    mLock.unlock();
+
+    mStatus.notify_all();
+
+    if (haveContinuation)
+    {
+        continuation(this);
+
+        // the continuation owned a reference to *this
+        continuation = continuation_type{};
+        release();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <typename T>
+FutureState<T>::~FutureState() noexcept
+{
+    if (mStatus.load(std::memory_order_acquire) == FUTURE_STATUS_READY)
+    {
+        mValue.destroy();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+FutureState<T>::FutureState() noexcept :
+    mRefs{1},
+    mNumPromises{1},
+    mStatus{FUTURE_STATUS_PENDING},
+    mLock{},
+    mHaveContinuation{false},
+    mContinuation{},
+    mValue{}
+{}
+
+
+
+/*-------------------------------------
+ * Add a reference
+-------------------------------------*/
+template <typename T>
+inline void FutureState<T>::retain() noexcept
+{
+    mRefs.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Remove a reference
+-------------------------------------*/
+template <typename T>
+inline void FutureState<T>::release() noexcept
+{
+    if (mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Add a Promise reference
+-------------------------------------*/
+template <typename T>
+inline void FutureState<T>::retain_promise() noexcept
+{
+    mNumPromises.fetch_add(1, std::memory_order_relaxed);
+    mRefs.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Remove a Promise reference
+-------------------------------------*/
+template <typename T>
+void FutureState<T>::release_promise() noexcept
+{
+    if (mNumPromises.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        uint32_t expected = FUTURE_STATUS_PENDING;
+        if (mStatus.compare_exchange_strong(expected, FUTURE_STATUS_SETTING, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            _finish(FUTURE_STATUS_BROKEN);
+        }
+    }
+
+    release();
+}
+
+
+
+/*-------------------------------------
+ * Current status
+-------------------------------------*/
+template <typename T>
+inline FutureStatus FutureState<T>::status() const noexcept
+{
+    return (FutureStatus)mStatus.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Wait for a result
+-------------------------------------*/
+template <typename T>
+inline void FutureState<T>::wait() const noexcept
+{
+    uint32_t status = mStatus.load(std::memory_order_acquire);
+
+    while (status < FUTURE_STATUS_READY)
+    {
+        mStatus.wait(status, std::memory_order_acquire);
+        status = mStatus.load(std::memory_order_acquire);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Set the result
+-------------------------------------*/
+template <typename T>
+template <typename... ArgsType>
+bool FutureState<T>::set_value(ArgsType&&... args) noexcept
+{
+    uint32_t expected = FUTURE_STATUS_PENDING;
+    if (!mStatus.compare_exchange_strong(expected, FUTURE_STATUS_SETTING, std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    mValue.construct(std::forward<ArgsType>(args)...);
+    _finish(FUTURE_STATUS_READY);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Attach a continuation
+-------------------------------------*/
+template <typename T>
+void FutureState<T>::attach(continuation_type&& continuation) noexcept
+{
+    mLock.lock();
+
+    if (mStatus.load(std::memory_order_acquire) < FUTURE_STATUS_READY)
+    {
+        mContinuation = std::move(continuation);
+        mHaveContinuation = true;
+        mLock.unlock();
+        return;
+    }
+
+    mLock.unlock();
+
+    continuation(this);
+    release();
+}
+
+
+
+/*-------------------------------------
+ * Result access
+-------------------------------------*/
+template <typename T>
+inline FutureValue<T>& FutureState<T>::value() noexcept
+{
+    return mValue;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Future
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor (from a Promise)
+-------------------------------------*/
+template <typename T>
+inline Future<T>::Future(FutureState<T>* pState) noexcept :
+    mState{pState}
+{}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <typename T>
+inline Future<T>::~Future() noexcept
+{
+    if (mState)
+    {
+        mState->release();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+inline Future<T>::Future() noexcept :
+    mState{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+template <typename T>
+inline Future<T>::Future(Future&& f) noexcept :
+    mState{f.mState}
+{
+    f.mState = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+template <typename T>
+inline Future<T>& Future<T>::operator=(Future&& f) noexcept
+{
+    if (this != &f)
+    {
+        if (mState)
+        {
+            mState->release();
+        }
+
+        mState = f.mState;
+        f.mState = nullptr;
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Check for a shared state
+-------------------------------------*/
+template <typename T>
+inline bool Future<T>::valid() const noexcept
+{
+    return mState != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Check for completion
+-------------------------------------*/
+template <typename T>
+inline bool Future<T>::ready() const noexcept
+{
+    return mState && mState->status() >= FUTURE_STATUS_READY;
+}
+
+
+
+/*-------------------------------------
+ * Check for a result
+-------------------------------------*/
+template <typename T>
+inline bool Future<T>::has_value() const noexcept
+{
+    return mState && mState->status() == FUTURE_STATUS_READY;
+}
+
+
+
+/*-------------------------------------
+ * Wait for completion
+-------------------------------------*/
+template <typename T>
+inline void Future<T>::wait() const noexcept
+{
+    if (mState)
+    {
+        mState->wait();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the result
+-------------------------------------*/
+template <typename T>
+inline std::add_lvalue_reference_t<T> Future<T>::get() noexcept
+{
+    mState->wait();
+    return mState->value().get();
+}
+
+
+
+/*-------------------------------------
+ * Attach a continuation
+-------------------------------------*/
+template <typename T>
+template <typename Func>
+Future<typename FutureContinuationResult<T, Func>::type> Future<T>::then(Func&& func) noexcept
+{
+    typedef typename FutureContinuationResult<T, Func>::type result_type;
+    typedef std::decay_t<Func> func_type;
+
+    if (!mState)
+    {
+        return Future<result_type>{};
+    }
+
+    Promise<result_type> promise;
+    if (!promise.valid())
+    {
+        return Future<result_type>{};
+    }
+
+    Future<result_type> result = promise.get_future();
+
+    // If *this completes without a value, the promise is destroyed along
+    // with the continuation, which breaks the returned future as well.
+    typename FutureState<T>::continuation_type continuation{[promise, fn = func_type{std::forward<Func>(func)}](FutureState<T>* pPrev)->void
+    {
+        if (pPrev->status() != FUTURE_STATUS_READY)
+        {
+            return;
+        }
+
+        if constexpr (std::is_void_v<T>)
+        {
+            promise.set_value_from(fn);
+        }
+        else
+        {
+            promise.set_value_from(fn, std::move(pPrev->value().get()));
+        }
+    }};
+
+    if (!continuation)
+    {
+        return Future<result_type>{};
+    }
+
+    // Our reference to the shared state is handed to the continuation
+    FutureState<T>* const pState = mState;
+    mState = nullptr;
+    pState->attach(std::move(continuation));
+
+    return result;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Promise
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <typename T>
+inline Promise<T>::~Promise() noexcept
+{
+    if (mState)
+    {
+        mState->release_promise();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T>
+inline Promise<T>::Promise() noexcept :
+    mState{new(std::nothrow) FutureState<T>{}}
+{}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+template <typename T>
+inline Promise<T>::Promise(const Promise& p) noexcept :
+    mState{p.mState}
+{
+    if (mState)
+    {
+        mState->retain_promise();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+template <typename T>
+inline Promise<T>::Promise(Promise&& p) noexcept :
+    mState{p.mState}
+{
+    p.mState = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+template <typename T>
+inline Promise<T>& Promise<T>::operator=(const Promise& p) noexcept
+{
+    if (this != &p)
+    {
+        if (p.mState)
+        {
+            p.mState->retain_promise();
+        }
+
+        if (mState)
+        {
+            mState->release_promise();
+        }
+
+        mState = p.mState;
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+template <typename T>
+inline Promise<T>& Promise<T>::operator=(Promise&& p) noexcept
+{
+    if (this != &p)
+    {
+        if (mState)
+        {
+            mState->release_promise();
+        }
+
+        mState = p.mState;
+        p.mState = nullptr;
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Check for a shared state
+-------------------------------------*/
+template <typename T>
+inline bool Promise<T>::valid() const noexcept
+{
+    return mState != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the associated Future
+-------------------------------------*/
+template <typename T>
+inline Future<T> Promise<T>::get_future() const noexcept
+{
+    if (!mState)
+    {
+        return Future<T>{};
+    }
+
+    mState->retain();
+    return Future<T>{mState};
+}
+
+
+
+/*-------------------------------------
+ * Set the result
+-------------------------------------*/
+template <typename T>
+template <typename... ArgsType>
+inline bool Promise<T>::set_value(ArgsType&&... args) const noexcept
+{
+    return mState && mState->set_value(std::forward<ArgsType>(args)...);
+}
+
+
+
+/*-------------------------------------
+ * Set the result from a callable
+-------------------------------------*/
+template <typename T>
+template <typename Func, typename... ArgsType>
+inline bool Promise<T>::set_value_from(const Func& func, ArgsType&&... args) const noexcept
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        func(std::forward<ArgsType>(args)...);
+        return set_value();
+    }
+    else
+    {
+        return set_value(func(std::forward<ArgsType>(args)...));
+    }
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_FUTURE_IMPL_HPP */
@@ -695,6 +695,34 @@ inline void GeneralAllocator<CacheSize, OffsetFreeHeader>::free(void* p, size_ty
 
 
 
+/*-------------------------------------
+ * Free-list statistics
+-------------------------------------*/
+template <unsigned long long CacheSize, bool OffsetFreeHeader>
+bool GeneralAllocator<CacheSize, OffsetFreeHeader>::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    outStats = FreeListStats{0, 0, 0};
+
+    for (const AllocationEntry* iter = mHead; iter; iter = iter->pNext)
+    {
+        // Each free entry spends one block on its allocation header
+        const size_type numBytes = iter->numBlocks * block_size;
+        const size_type usableBytes = numBytes - header_size;
+
+        ++outStats.numFreeBlocks;
+        outStats.numFreeBytes += numBytes;
+
+        if (usableBytes > outStats.largestFreeBlock)
+        {
+            outStats.largestFreeBlock = usableBytes;
+        }
+    }
+
+    return true;
+}
+
+
+
 } // utils namespace
 } // ls namespace
 
@@ -0,0 +1,103 @@
+/*
+ * File:   LinearAllocatorImpl.hpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 10:10 AM
+ */
+
+#ifndef LS_UTILS_LINEAR_ALLOCATOR_IMPL_HPP
+#define LS_UTILS_LINEAR_ALLOCATOR_IMPL_HPP
+
+#include "lightsky/setup/Macros.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * LinearAllocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * First usable byte of a block
+-------------------------------------*/
+inline char* LinearAllocator::_block_begin(Block* pBlock) noexcept
+{
+    return reinterpret_cast<char*>(pBlock) + sizeof(Block);
+}
+
+
+
+/*-------------------------------------
+ * Get the current position
+-------------------------------------*/
+inline LinearAllocator::Marker LinearAllocator::mark() const noexcept
+{
+    return Marker{mBlocks, mHead};
+}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+inline void* LinearAllocator::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    // mHead is always aligned, so only the size needs rounding. Zero-sized
+    // and overflowing requests wrap around and take the slow path.
+    const size_type n = (numBytes + (alignment-1ull)) & ~(alignment-1ull);
+
+    if (LS_LIKELY(n - 1ull < (size_type)(mEnd - mHead)))
+    {
+        char* const p = mHead;
+        mHead += n;
+        mLastAlloc = p;
+
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = n;
+        }
+
+        return p;
+    }
+
+    void* const p = _allocate_from_new_block(numBytes);
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = p ? n : 0;
+    }
+
+    return p;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * LinearAllocator::Scope
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+inline LinearAllocator::Scope::~Scope() noexcept
+{
+    mAllocator.rewind(mMarker);
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+inline LinearAllocator::Scope::Scope(LinearAllocator& allocator) noexcept :
+    mAllocator{allocator},
+    mMarker{allocator.mark()}
+{}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_LINEAR_ALLOCATOR_IMPL_HPP */
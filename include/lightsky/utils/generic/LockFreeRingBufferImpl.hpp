@@ -0,0 +1,435 @@
+/*
+ * File:   LockFreeRingBufferImpl.hpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 1:40 PM
+ */
+
+#ifndef LS_UTILS_LOCK_FREE_RING_BUFFER_IMPL_HPP
+#define LS_UTILS_LOCK_FREE_RING_BUFFER_IMPL_HPP
+
+#include <bit> // std::bit_ceil
+
+#include "lightsky/setup/Macros.h" // LS_LIKELY
+
+#include "lightsky/utils/Assertions.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SPSC Ring Buffer
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Check for room to insert, refreshing the cached head if needed
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::_reserve_slot(unsigned long long tail) noexcept
+{
+    if (LS_LIKELY(tail - mCachedHead < mCapacity))
+    {
+        return true;
+    }
+
+    mCachedHead = mHead.load(std::memory_order_acquire);
+    return tail - mCachedHead < mCapacity;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+SpscRingBuffer<T>::SpscRingBuffer(size_type requestedCapacity) noexcept :
+    mHead{0},
+    mCachedTail{0},
+    mTail{0},
+    mCachedHead{0},
+    mCapacity{0},
+    mMask{0},
+    mData{nullptr}
+{
+    if (requestedCapacity)
+    {
+        const unsigned long long newCapacity = std::bit_ceil(requestedCapacity);
+        mData = ls::utils::make_unique_array<T>(newCapacity);
+
+        if (mData)
+        {
+            mCapacity = newCapacity;
+            mMask = newCapacity - 1ull;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::empty() const noexcept
+{
+    return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::full() const noexcept
+{
+    return size() == mCapacity;
+}
+
+
+
+/*-------------------------------------
+ * Approximate when called concurrently with a push or pop
+-------------------------------------*/
+template <typename T>
+inline typename SpscRingBuffer<T>::size_type SpscRingBuffer<T>::size() const noexcept
+{
+    const unsigned long long head = mHead.load(std::memory_order_acquire);
+    const unsigned long long tail = mTail.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline typename SpscRingBuffer<T>::size_type SpscRingBuffer<T>::capacity() const noexcept
+{
+    return mCapacity;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::push(const_reference val) noexcept
+{
+    const unsigned long long tail = mTail.load(std::memory_order_relaxed);
+    if (!_reserve_slot(tail))
+    {
+        return false;
+    }
+
+    mData[tail & mMask] = val;
+    mTail.store(tail + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::push(T&& val) noexcept
+{
+    const unsigned long long tail = mTail.load(std::memory_order_relaxed);
+    if (!_reserve_slot(tail))
+    {
+        return false;
+    }
+
+    mData[tail & mMask] = std::forward<T>(val);
+    mTail.store(tail + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+template <typename... ArgsType>
+inline bool SpscRingBuffer<T>::emplace(ArgsType&&... args) noexcept
+{
+    const unsigned long long tail = mTail.load(std::memory_order_relaxed);
+    if (!_reserve_slot(tail))
+    {
+        return false;
+    }
+
+    mData[tail & mMask] = T{std::forward<ArgsType>(args)...};
+    mTail.store(tail + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool SpscRingBuffer<T>::pop(reference result) noexcept
+{
+    const unsigned long long head = mHead.load(std::memory_order_relaxed);
+
+    if (head == mCachedTail)
+    {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if (head == mCachedTail)
+        {
+            return false;
+        }
+    }
+
+    result = std::move(mData[head & mMask]);
+    mHead.store(head + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * MPMC Ring Buffer
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Claim the next writable slot, or return NULL if the buffer is full
+-------------------------------------*/
+template <typename T>
+typename MpmcRingBuffer<T>::Slot* MpmcRingBuffer<T>::_acquire_push_slot(unsigned long long& outPos) noexcept
+{
+    if (LS_UNLIKELY(!mCapacity))
+    {
+        return nullptr;
+    }
+
+    unsigned long long pos = mTail.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Slot& slot = mData[pos & mMask];
+        const unsigned long long seq = slot.sequence.load(std::memory_order_acquire);
+        const long long diff = (long long)seq - (long long)pos;
+
+        if (diff == 0)
+        {
+            if (mTail.compare_exchange_weak(pos, pos + 1ull, std::memory_order_relaxed))
+            {
+                outPos = pos;
+                return &slot;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer for this slot's previous lap hasn't finished yet
+            return nullptr;
+        }
+        else
+        {
+            pos = mTail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+MpmcRingBuffer<T>::MpmcRingBuffer(size_type requestedCapacity) noexcept :
+    mHead{0},
+    mTail{0},
+    mCapacity{0},
+    mMask{0},
+    mData{nullptr}
+{
+    if (requestedCapacity)
+    {
+        // A single slot can't distinguish a full lap from an empty one
+        const unsigned long long newCapacity = std::bit_ceil(requestedCapacity < 2ull ? 2ull : requestedCapacity);
+        mData = ls::utils::make_unique_array<Slot>(newCapacity);
+
+        if (mData)
+        {
+            for (unsigned long long i = 0; i < newCapacity; ++i)
+            {
+                mData[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            mCapacity = newCapacity;
+            mMask = newCapacity - 1ull;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Approximate when called concurrently with a push or pop
+-------------------------------------*/
+template <typename T>
+inline bool MpmcRingBuffer<T>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+
+
+/*-------------------------------------
+ * Approximate when called concurrently with a push or pop
+-------------------------------------*/
+template <typename T>
+inline bool MpmcRingBuffer<T>::full() const noexcept
+{
+    return size() >= mCapacity;
+}
+
+
+
+/*-------------------------------------
+ * Approximate when called concurrently with a push or pop
+-------------------------------------*/
+template <typename T>
+inline typename MpmcRingBuffer<T>::size_type MpmcRingBuffer<T>::size() const noexcept
+{
+    const unsigned long long head = mHead.load(std::memory_order_acquire);
+    const unsigned long long tail = mTail.load(std::memory_order_acquire);
+
+    // Consumers may have claimed slots after the tail was read
+    return (tail > head) ? (tail - head) : 0ull;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline typename MpmcRingBuffer<T>::size_type MpmcRingBuffer<T>::capacity() const noexcept
+{
+    return mCapacity;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool MpmcRingBuffer<T>::push(const_reference val) noexcept
+{
+    unsigned long long pos;
+    Slot* const pSlot = _acquire_push_slot(pos);
+    if (!pSlot)
+    {
+        return false;
+    }
+
+    pSlot->value = val;
+    pSlot->sequence.store(pos + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline bool MpmcRingBuffer<T>::push(T&& val) noexcept
+{
+    unsigned long long pos;
+    Slot* const pSlot = _acquire_push_slot(pos);
+    if (!pSlot)
+    {
+        return false;
+    }
+
+    pSlot->value = std::forward<T>(val);
+    pSlot->sequence.store(pos + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+template <typename... ArgsType>
+inline bool MpmcRingBuffer<T>::emplace(ArgsType&&... args) noexcept
+{
+    unsigned long long pos;
+    Slot* const pSlot = _acquire_push_slot(pos);
+    if (!pSlot)
+    {
+        return false;
+    }
+
+    pSlot->value = T{std::forward<ArgsType>(args)...};
+    pSlot->sequence.store(pos + 1ull, std::memory_order_release);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+bool MpmcRingBuffer<T>::pop(reference result) noexcept
+{
+    if (LS_UNLIKELY(!mCapacity))
+    {
+        return false;
+    }
+
+    unsigned long long pos = mHead.load(std::memory_order_relaxed);
+    Slot* pSlot;
+
+    while (true)
+    {
+        pSlot = &mData[pos & mMask];
+        const unsigned long long seq = pSlot->sequence.load(std::memory_order_acquire);
+        const long long diff = (long long)seq - (long long)(pos + 1ull);
+
+        if (diff == 0)
+        {
+            if (mHead.compare_exchange_weak(pos, pos + 1ull, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The producer for this slot hasn't published yet
+            return false;
+        }
+        else
+        {
+            pos = mHead.load(std::memory_order_relaxed);
+        }
+    }
+
+    result = std::move(pSlot->value);
+
+    // Hand the slot to the producer one lap ahead
+    pSlot->sequence.store(pos + mCapacity, std::memory_order_release);
+    return true;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_LOCK_FREE_RING_BUFFER_IMPL_HPP */
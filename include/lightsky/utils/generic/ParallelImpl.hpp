@@ -0,0 +1,313 @@
+/*
+ * File:   ParallelImpl.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 7:40 p.m.
+ */
+
+#ifndef LS_UTILS_PARALLEL_IMPL_HPP
+#define LS_UTILS_PARALLEL_IMPL_HPP
+
+#include <new> // std::nothrow
+
+#include "lightsky/utils/Pointer.h" // UniqueArray
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Parallel Job
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename ChunkFunc>
+ParallelJob<ChunkFunc>::ParallelJob(std::size_t numChunks, unsigned numRefs, const ChunkFunc& func) noexcept :
+    mRefs{numRefs},
+    mNextChunk{0},
+    mNumDone{0},
+    mNumChunks{numChunks},
+    mFunc{&func}
+{}
+
+
+
+/*-------------------------------------
+ * Process chunks
+-------------------------------------*/
+template <typename ChunkFunc>
+void ParallelJob<ChunkFunc>::run() noexcept
+{
+    std::size_t numProcessed = 0;
+
+    for (std::size_t i = mNextChunk.fetch_add(1, std::memory_order_relaxed); i < mNumChunks; i = mNextChunk.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*mFunc)(i);
+        ++numProcessed;
+    }
+
+    // Only the thread which finishes the last chunk needs to wake the caller
+    if (numProcessed && mNumDone.fetch_add(numProcessed, std::memory_order_acq_rel) + numProcessed == mNumChunks)
+    {
+        mNumDone.notify_all();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Wait for all chunks
+-------------------------------------*/
+template <typename ChunkFunc>
+void ParallelJob<ChunkFunc>::wait() const noexcept
+{
+    std::size_t numDone = mNumDone.load(std::memory_order_acquire);
+
+    while (numDone < mNumChunks)
+    {
+        mNumDone.wait(numDone, std::memory_order_acquire);
+        numDone = mNumDone.load(std::memory_order_acquire);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Release a reference
+-------------------------------------*/
+template <typename ChunkFunc>
+inline void ParallelJob<ChunkFunc>::release() noexcept
+{
+    if (mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        delete this;
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Chunk Scheduling
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Run a set of chunks
+-------------------------------------*/
+template <class PoolType, typename ChunkFunc>
+void parallel_chunks(PoolType& pool, std::size_t numChunks, const ChunkFunc& func) noexcept
+{
+    typedef typename PoolType::value_type task_type;
+
+    const std::size_t concurrency = pool.concurrency();
+    const std::size_t numHelpers = (numChunks - 1u) < concurrency ? (numChunks - 1u) : concurrency;
+    ParallelJob<ChunkFunc>* const pJob = (numChunks > 1u && numHelpers)
+        ? new(std::nothrow) ParallelJob<ChunkFunc>{numChunks, (unsigned)numHelpers + 1u, func}
+        : nullptr;
+
+    // Run serially if there's nothing to split, or nothing to split across
+    if (!pJob)
+    {
+        for (std::size_t i = 0; i < numChunks; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < numHelpers; ++i)
+    {
+        pool.emplace(task_type{[pJob]()->void
+        {
+            pJob->run();
+            pJob->release();
+        }});
+    }
+
+    pool.flush();
+
+    pJob->run();
+    pJob->wait();
+    pJob->release();
+}
+
+
+
+/*-------------------------------------
+ * Chunk sizes
+-------------------------------------*/
+template <class PoolType>
+inline std::size_t parallel_grain_size(const PoolType& pool, std::size_t count, std::size_t grain) noexcept
+{
+    if (grain)
+    {
+        return grain;
+    }
+
+    // Several chunks per thread lets faster threads pick up the slack
+    constexpr std::size_t chunks_per_thread = 8;
+    const std::size_t numChunks = (pool.concurrency() + 1u) * chunks_per_thread;
+
+    grain = (count + numChunks - 1u) / numChunks;
+    return grain ? grain : 1u;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Parallel Algorithms
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Parallel For
+-------------------------------------*/
+template <class PoolType, typename IndexType, typename Func>
+void parallel_for(PoolType& pool, IndexType first, IndexType last, std::size_t grain, const Func& func) noexcept
+{
+    if (!(first < last))
+    {
+        return;
+    }
+
+    const std::size_t count = (std::size_t)(last - first);
+    const std::size_t chunkSize = parallel_grain_size(pool, count, grain);
+    const std::size_t numChunks = (count + chunkSize - 1u) / chunkSize;
+
+    parallel_chunks(pool, numChunks, [&](std::size_t chunkId)->void
+    {
+        const std::size_t chunkBegin = chunkId * chunkSize;
+        const std::size_t chunkEnd = (count - chunkBegin) < chunkSize ? count : (chunkBegin + chunkSize);
+
+        func((IndexType)(first + (IndexType)chunkBegin), (IndexType)(first + (IndexType)chunkEnd));
+    });
+}
+
+
+
+/*-------------------------------------
+ * Parallel Reduce
+-------------------------------------*/
+template <class PoolType, typename IndexType, typename T, typename MapFunc, typename ReduceFunc>
+T parallel_reduce(
+    PoolType& pool,
+    IndexType first,
+    IndexType last,
+    std::size_t grain,
+    const T& identity,
+    const MapFunc& mapFunc,
+    const ReduceFunc& reduceFunc) noexcept
+{
+    if (!(first < last))
+    {
+        return identity;
+    }
+
+    const std::size_t count = (std::size_t)(last - first);
+    const std::size_t chunkSize = parallel_grain_size(pool, count, grain);
+    const std::size_t numChunks = (count + chunkSize - 1u) / chunkSize;
+
+    UniqueArray<T> partials = make_unique_array<T>(numChunks);
+    if (!partials)
+    {
+        return reduceFunc(identity, mapFunc(first, last, identity));
+    }
+
+    parallel_chunks(pool, numChunks, [&](std::size_t chunkId)->void
+    {
+        const std::size_t chunkBegin = chunkId * chunkSize;
+        const std::size_t chunkEnd = (count - chunkBegin) < chunkSize ? count : (chunkBegin + chunkSize);
+
+        partials[chunkId] = mapFunc((IndexType)(first + (IndexType)chunkBegin), (IndexType)(first + (IndexType)chunkEnd), identity);
+    });
+
+    T result = identity;
+    for (std::size_t i = 0; i < numChunks; ++i)
+    {
+        result = reduceFunc(result, partials[i]);
+    }
+
+    return result;
+}
+
+
+
+/*-------------------------------------
+ * Parallel Inclusive Scan
+-------------------------------------*/
+template <class PoolType, typename T, typename ScanFunc>
+void parallel_scan(
+    PoolType& pool,
+    const T* in,
+    T* out,
+    std::size_t count,
+    std::size_t grain,
+    const T& identity,
+    const ScanFunc& scanFunc) noexcept
+{
+    if (!count)
+    {
+        return;
+    }
+
+    const std::size_t chunkSize = parallel_grain_size(pool, count, grain);
+    const std::size_t numChunks = (count + chunkSize - 1u) / chunkSize;
+
+    UniqueArray<T> offsets = (numChunks > 1u) ? make_unique_array<T>(numChunks) : UniqueArray<T>{};
+    if (!offsets)
+    {
+        T total = identity;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            total = scanFunc(total, in[i]);
+            out[i] = total;
+        }
+
+        return;
+    }
+
+    // Pass 1: the total of each chunk
+    parallel_chunks(pool, numChunks, [&](std::size_t chunkId)->void
+    {
+        const std::size_t chunkBegin = chunkId * chunkSize;
+        const std::size_t chunkEnd = (count - chunkBegin) < chunkSize ? count : (chunkBegin + chunkSize);
+        T total = identity;
+
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i)
+        {
+            total = scanFunc(total, in[i]);
+        }
+
+        offsets[chunkId] = total;
+    });
+
+    // Convert the totals into each chunk's starting value
+    T total = identity;
+    for (std::size_t i = 0; i < numChunks; ++i)
+    {
+        const T chunkTotal = offsets[i];
+        offsets[i] = total;
+        total = scanFunc(total, chunkTotal);
+    }
+
+    // Pass 2: scan each chunk from its starting value
+    parallel_chunks(pool, numChunks, [&](std::size_t chunkId)->void
+    {
+        const std::size_t chunkBegin = chunkId * chunkSize;
+        const std::size_t chunkEnd = (count - chunkBegin) < chunkSize ? count : (chunkBegin + chunkSize);
+        T value = offsets[chunkId];
+
+        for (std::size_t i = chunkBegin; i < chunkEnd; ++i)
+        {
+            value = scanFunc(value, in[i]);
+            out[i] = value;
+        }
+    });
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_PARALLEL_IMPL_HPP */
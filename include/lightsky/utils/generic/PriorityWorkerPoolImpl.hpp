@@ -0,0 +1,894 @@
+/*
+ * File:   PriorityWorkerPoolImpl.hpp
+ * Author: miles
+ * Created on October 19, 2026, at 9:05 a.m.
+ */
+
+#ifndef LS_UTILS_PRIORITY_WORKER_POOL_IMPL_HPP
+#define LS_UTILS_PRIORITY_WORKER_POOL_IMPL_HPP
+
+#include <algorithm> // std::push_heap, std::pop_heap
+#include <limits>
+
+#include "lightsky/setup/CPU.h" // cpu_yield()
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Priority Thread Pool
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Heap ordering (earliest deadline at the front)
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool PriorityWorkerPool<WorkerTaskType>::_is_later(const LaneTask& a, const LaneTask& b) noexcept
+{
+    return a.deadline > b.deadline || (a.deadline == b.deadline && a.sequence > b.sequence);
+}
+
+
+
+/*-------------------------------------
+ * Current time for deadlines
+-------------------------------------*/
+template <class WorkerTaskType>
+inline uint64_t PriorityWorkerPool<WorkerTaskType>::_now_ns() noexcept
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+
+
+/*-------------------------------------
+ * Map a priority to its lane
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t PriorityWorkerPool<WorkerTaskType>::_lane_index(WorkerPriority priority) noexcept
+{
+    return (std::size_t)priority < NUM_LANES ? (std::size_t)priority : (std::size_t)WorkerPriority::LOW;
+}
+
+
+
+/*-------------------------------------
+ * Insert a task into a lane
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::_enqueue(
+    WorkerTaskType&& task,
+    WorkerPriority priority,
+    uint64_t deadline,
+    bool useLaneDeadline) noexcept
+{
+    const std::size_t laneId = _lane_index(priority);
+
+    {
+        std::lock_guard<utils::SpinLock> lock{mPushLock};
+        Lane& lane = mLanes[laneId];
+
+        if (useLaneDeadline)
+        {
+            // Saturate rather than wrap for very long waits
+            deadline = (std::numeric_limits<uint64_t>::max() - deadline < lane.maxWaitNs)
+                ? std::numeric_limits<uint64_t>::max()
+                : deadline + lane.maxWaitNs;
+        }
+
+        lane.tasks.push_back(LaneTask{deadline, mNextSequence++, std::move(task)});
+        std::push_heap(lane.tasks.begin(), lane.tasks.end(), &PriorityWorkerPool::_is_later);
+        ++mNumPending;
+    }
+
+    _notify_sleeper();
+}
+
+
+
+/*-------------------------------------
+ * Wake a sleeping worker for new tasks
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::_notify_sleeper() noexcept
+{
+    // Only tasks pushed while the pool is running need an immediate wakeup.
+    // Everything else waits on the next flush().
+    if (mIsPaused.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    // Pairs with the increment of mThreadsSleeping in thread_loop(). Either
+    // we see the sleeper, or it sees the new task before sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (mThreadsSleeping.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+        mExecCond.notify_one();
+    }
+
+    if (mAdaptiveWait.load(std::memory_order_acquire))
+    {
+        mWakeSignal.notify();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Check for a task which can run (mPushLock must be held)
+-------------------------------------*/
+template <class WorkerTaskType>
+bool PriorityWorkerPool<WorkerTaskType>::_have_runnable() const noexcept
+{
+    for (const Lane& lane : mLanes)
+    {
+        if (!lane.tasks.empty() && lane.numRunning < lane.maxConcurrency)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Take the most urgent task (mPushLock must be held)
+-------------------------------------*/
+template <class WorkerTaskType>
+bool PriorityWorkerPool<WorkerTaskType>::_pop_runnable(WorkerTaskType& outTask, std::size_t& outLane) noexcept
+{
+    std::size_t laneId = NUM_LANES;
+    std::size_t numCandidates = 0;
+
+    for (std::size_t i = 0; i < NUM_LANES; ++i)
+    {
+        const Lane& lane = mLanes[i];
+        if (!lane.tasks.empty() && lane.numRunning < lane.maxConcurrency)
+        {
+            // Lanes are checked in order of priority
+            if (!numCandidates++)
+            {
+                laneId = i;
+            }
+        }
+    }
+
+    if (!numCandidates)
+    {
+        return false;
+    }
+
+    // Overdue tasks from any lane run before everything else. The clock is
+    // only read when there's a choice to be made.
+    if (numCandidates > 1)
+    {
+        const uint64_t now = _now_ns();
+        uint64_t earliest = std::numeric_limits<uint64_t>::max();
+
+        for (std::size_t i = 0; i < NUM_LANES; ++i)
+        {
+            const Lane& lane = mLanes[i];
+            if (lane.tasks.empty() || lane.numRunning >= lane.maxConcurrency)
+            {
+                continue;
+            }
+
+            const uint64_t deadline = lane.tasks.front().deadline;
+            if (deadline <= now && deadline < earliest)
+            {
+                earliest = deadline;
+                laneId = i;
+            }
+        }
+    }
+
+    Lane& lane = mLanes[laneId];
+    std::pop_heap(lane.tasks.begin(), lane.tasks.end(), &PriorityWorkerPool::_is_later);
+    outTask = std::move(lane.tasks.back().task);
+    lane.tasks.pop_back();
+
+    ++lane.numRunning;
+    --mNumPending;
+    outLane = laneId;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Execute the tasks in the queue.
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::execute_tasks() noexcept
+{
+    mThreadsRunning.fetch_add(1, std::memory_order_acq_rel);
+
+    while (true)
+    {
+        WorkerTaskType task;
+        std::size_t laneId;
+
+        {
+            std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+            if (!_pop_runnable(task, laneId))
+            {
+                break;
+            }
+        }
+
+        task();
+
+        bool laneWasFull;
+        {
+            std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+            Lane& lane = mLanes[laneId];
+            laneWasFull = lane.numRunning-- == lane.maxConcurrency && !lane.tasks.empty();
+        }
+
+        // Another thread may have gone idle waiting on this lane. This thread
+        // could pick up a more urgent task next, so hand the slot over.
+        if (laneWasFull)
+        {
+            _notify_sleeper();
+        }
+    }
+
+    // Pause the current thread again.
+    if (mThreadsRunning.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        std::lock_guard<std::mutex> waitLock{mWaitMtx};
+        std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+
+        if (!mNumPending)
+        {
+            mIsPaused.store(true, std::memory_order_release);
+            mWaitCond.notify_all();
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Thread loop
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::thread_loop() noexcept
+{
+    WorkerIdleStrategy idleStrategy{};
+
+    while (!mIsStopped.load(std::memory_order_acquire))
+    {
+        // Read before checking for tasks so a wakeup in between isn't lost
+        const uint32_t wakeSeq = mWakeSignal.sequence();
+
+        bool haveTasks;
+        {
+            std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+            haveTasks = _have_runnable();
+        }
+
+        if (haveTasks && !mIsPaused.load(std::memory_order_acquire))
+        {
+            execute_tasks();
+            continue;
+        }
+
+        if (mBusyWait.load(std::memory_order_acquire))
+        {
+            ls::setup::cpu_yield();
+            continue;
+        }
+
+        if (mAdaptiveWait.load(std::memory_order_acquire))
+        {
+            idleStrategy.wait(mWakeSignal, wakeSeq);
+            continue;
+        }
+
+        mThreadsSleeping.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> cvLock{mExecMtx};
+            mExecCond.wait(cvLock, [this]()->bool
+            {
+                if (mIsStopped.load(std::memory_order_acquire))
+                {
+                    return true;
+                }
+
+                std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+                return !mIsPaused.load(std::memory_order_acquire) && _have_runnable();
+            });
+        }
+        mThreadsSleeping.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Start all threads
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::start_threads(std::size_t numThreads) noexcept
+{
+    mThreads.reserve(numThreads);
+    for (std::size_t threadId = 0; threadId < numThreads; ++threadId)
+    {
+        mThreads.emplace_back(&PriorityWorkerPool::thread_loop, this);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Stop all threads
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::stop_threads() noexcept
+{
+    while (!ready())
+    {
+    }
+
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+        mIsStopped.store(true, std::memory_order_release);
+        mExecCond.notify_all();
+    }
+
+    mWakeSignal.notify();
+
+    for (std::thread& t : mThreads)
+    {
+        t.join();
+    }
+
+    mThreads.clear();
+
+    for (Lane& lane : mLanes)
+    {
+        lane.tasks.clear();
+        lane.numRunning = 0;
+    }
+
+    mNumPending = 0;
+    mThreadsRunning.store(0, std::memory_order_release);
+    mIsPaused.store(true, std::memory_order_release);
+    mIsStopped.store(false, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>::~PriorityWorkerPool() noexcept
+{
+    stop_threads();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>::PriorityWorkerPool(std::size_t inNumThreads) :
+    mBusyWait{false},
+    mAdaptiveWait{false},
+    mIsPaused{true},
+    mIsStopped{false},
+    mWakeSignal{},
+    mThreadsRunning{0},
+    mThreadsSleeping{0},
+    mPushLock{},
+    mNumPending{0},
+    mNextSequence{0},
+    mLanes{
+        {{}, std::numeric_limits<std::size_t>::max(), 0, 1000000ull},
+        {{}, std::numeric_limits<std::size_t>::max(), 0, 10000000ull},
+        {{}, std::numeric_limits<std::size_t>::max(), 0, 100000000ull}
+    },
+    mWaitMtx{},
+    mWaitCond{},
+    mExecMtx{},
+    mExecCond{},
+    mThreads{}
+{
+    start_threads(inNumThreads);
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>::PriorityWorkerPool(const PriorityWorkerPool& w) noexcept :
+    PriorityWorkerPool{0} // delegate constructor
+{
+    *this = w;
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>::PriorityWorkerPool(PriorityWorkerPool&& w) noexcept :
+    PriorityWorkerPool{0} // delegate constructor
+{
+    *this = std::move(w);
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>& PriorityWorkerPool<WorkerTaskType>::operator=(const PriorityWorkerPool& w) noexcept
+{
+    if (this == &w)
+    {
+        return *this;
+    }
+
+    w.wait();
+    wait();
+
+    stop_threads();
+
+    mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+
+    {
+        std::lock_guard<utils::SpinLock> srcLock{w.mPushLock};
+        std::lock_guard<utils::SpinLock> dstLock{mPushLock};
+
+        for (std::size_t i = 0; i < NUM_LANES; ++i)
+        {
+            mLanes[i].tasks = w.mLanes[i].tasks;
+            mLanes[i].maxConcurrency = w.mLanes[i].maxConcurrency;
+            mLanes[i].maxWaitNs = w.mLanes[i].maxWaitNs;
+        }
+
+        mNumPending = w.mNumPending;
+        mNextSequence = w.mNextSequence;
+    }
+
+    start_threads(w.mThreads.size());
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+template <class WorkerTaskType>
+PriorityWorkerPool<WorkerTaskType>& PriorityWorkerPool<WorkerTaskType>::operator=(PriorityWorkerPool&& w) noexcept
+{
+    if (this == &w)
+    {
+        return *this;
+    }
+
+    w.wait();
+    wait();
+
+    std::size_t numThreads = w.mThreads.size();
+    stop_threads();
+
+    mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mBusyWait.store(false, std::memory_order_release);
+
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mAdaptiveWait.store(false, std::memory_order_release);
+
+    {
+        std::lock_guard<utils::SpinLock> srcLock{w.mPushLock};
+        std::lock_guard<utils::SpinLock> dstLock{mPushLock};
+
+        for (std::size_t i = 0; i < NUM_LANES; ++i)
+        {
+            mLanes[i].tasks = std::move(w.mLanes[i].tasks);
+            mLanes[i].maxConcurrency = w.mLanes[i].maxConcurrency;
+            mLanes[i].maxWaitNs = w.mLanes[i].maxWaitNs;
+            w.mLanes[i].tasks.clear();
+        }
+
+        mNumPending = w.mNumPending;
+        mNextSequence = w.mNextSequence;
+        w.mNumPending = 0;
+    }
+
+    start_threads(numThreads);
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Get the number of tasks currently queued
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t PriorityWorkerPool<WorkerTaskType>::num_pending() const noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    return mNumPending;
+}
+
+
+
+/*-------------------------------------
+ * Get the number of tasks currently queued in a lane
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t PriorityWorkerPool<WorkerTaskType>::num_pending(WorkerPriority priority) const noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    return mLanes[_lane_index(priority)].tasks.size();
+}
+
+
+
+/*-------------------------------------
+ * Determine if there are tasks queued
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool PriorityWorkerPool<WorkerTaskType>::have_pending() const noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    return mNumPending > 0;
+}
+
+
+
+/*-------------------------------------
+ * Clear the currently pending tasks
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::clear_pending() noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+
+    for (Lane& lane : mLanes)
+    {
+        lane.tasks.clear();
+    }
+
+    mNumPending = 0;
+}
+
+
+
+/*-------------------------------------
+ * Push a task to the normal lane (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::push(const WorkerTaskType& task) noexcept
+{
+    _enqueue(WorkerTaskType{task}, WorkerPriority::NORMAL, _now_ns(), true);
+}
+
+
+
+/*-------------------------------------
+ * Push a task to a lane (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::push(const WorkerTaskType& task, WorkerPriority priority) noexcept
+{
+    _enqueue(WorkerTaskType{task}, priority, _now_ns(), true);
+}
+
+
+
+/*-------------------------------------
+ * Push a task to the normal lane (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::emplace(WorkerTaskType&& task) noexcept
+{
+    _enqueue(std::move(task), WorkerPriority::NORMAL, _now_ns(), true);
+}
+
+
+
+/*-------------------------------------
+ * Push a task to a lane (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::emplace(WorkerTaskType&& task, WorkerPriority priority) noexcept
+{
+    _enqueue(std::move(task), priority, _now_ns(), true);
+}
+
+
+
+/*-------------------------------------
+ * Push a task with an explicit deadline (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::emplace_deadline(
+    WorkerTaskType&& task,
+    clock_type::time_point deadline,
+    WorkerPriority priority) noexcept
+{
+    const int64_t deadlineNs = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    _enqueue(std::move(task), priority, deadlineNs > 0 ? (uint64_t)deadlineNs : 0ull, false);
+}
+
+
+
+/*-------------------------------------
+ * Push a task and retrieve a future for its result.
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename Func>
+inline Future<std::invoke_result_t<const std::decay_t<Func>&>> PriorityWorkerPool<WorkerTaskType>::submit(Func&& func) noexcept
+{
+    return submit(std::forward<Func>(func), WorkerPriority::NORMAL);
+}
+
+
+
+/*-------------------------------------
+ * Push a task to a lane and retrieve a future for its result.
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename Func>
+Future<std::invoke_result_t<const std::decay_t<Func>&>> PriorityWorkerPool<WorkerTaskType>::submit(Func&& func, WorkerPriority priority) noexcept
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&> result_type;
+    typedef std::decay_t<Func> func_type;
+
+    const Promise<result_type> promise;
+    Future<result_type> result = promise.get_future();
+
+    if (result.valid())
+    {
+        emplace(WorkerTaskType{[promise, fn = func_type{std::forward<Func>(func)}]()->void
+        {
+            promise.set_value_from(fn);
+        }}, priority);
+    }
+
+    return result;
+}
+
+
+
+/*-------------------------------------
+ * Lane concurrency limit
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t PriorityWorkerPool<WorkerTaskType>::lane_concurrency(WorkerPriority priority) const noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    return mLanes[_lane_index(priority)].maxConcurrency;
+}
+
+
+
+/*-------------------------------------
+ * Set the lane concurrency limit
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::lane_concurrency(WorkerPriority priority, std::size_t maxTasks) noexcept
+{
+    {
+        std::lock_guard<utils::SpinLock> lock{mPushLock};
+        mLanes[_lane_index(priority)].maxConcurrency = maxTasks ? maxTasks : 1;
+    }
+
+    // Raising a limit can make queued tasks runnable.
+    _notify_sleeper();
+}
+
+
+
+/*-------------------------------------
+ * Lane wait limit
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::chrono::nanoseconds PriorityWorkerPool<WorkerTaskType>::lane_max_wait(WorkerPriority priority) const noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    return std::chrono::nanoseconds{(std::chrono::nanoseconds::rep)mLanes[_lane_index(priority)].maxWaitNs};
+}
+
+
+
+/*-------------------------------------
+ * Set the lane wait limit
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::lane_max_wait(WorkerPriority priority, std::chrono::nanoseconds maxWait) noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    mLanes[_lane_index(priority)].maxWaitNs = maxWait.count() > 0 ? (uint64_t)maxWait.count() : 0ull;
+}
+
+
+
+/*-------------------------------------
+ * Check if the pool has finished all tasks and can be flushed.
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool PriorityWorkerPool<WorkerTaskType>::ready() const noexcept
+{
+    return mIsPaused.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Wake all threads to process any pending tasks.
+-------------------------------------*/
+template <class WorkerTaskType>
+void PriorityWorkerPool<WorkerTaskType>::flush() noexcept
+{
+    bool haveTasks;
+
+    {
+        std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+        haveTasks = mNumPending > 0;
+    }
+
+    // Don't bother waking up the threads if there's nothing to do.
+    if (haveTasks)
+    {
+        {
+            std::lock_guard<std::mutex> execLock{mExecMtx};
+            mIsPaused.store(false, std::memory_order_release);
+            mExecCond.notify_all();
+        }
+
+        mWakeSignal.notify();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Wait for all threads to finish execution.
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::wait() const noexcept
+{
+    if (mBusyWait.load(std::memory_order_consume))
+    {
+        while (!mIsPaused.load(std::memory_order_consume))
+        {
+            ls::setup::cpu_yield();
+        }
+    }
+    else
+    {
+        std::unique_lock<std::mutex> cvLock{mWaitMtx};
+        mWaitCond.wait(cvLock, [this]()->bool
+        {
+            return mIsPaused.load(std::memory_order_acquire);
+        });
+    }
+}
+
+
+
+/*-------------------------------------
+ * Determine if busy waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool PriorityWorkerPool<WorkerTaskType>::busy_waiting() const noexcept
+{
+    return mBusyWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle busy waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::busy_waiting(bool useBusyWait) noexcept
+{
+    mBusyWait.store(useBusyWait, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Determine if adaptive waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool PriorityWorkerPool<WorkerTaskType>::adaptive_waiting() const noexcept
+{
+    return mAdaptiveWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle adaptive waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void PriorityWorkerPool<WorkerTaskType>::adaptive_waiting(bool useAdaptiveWait) noexcept
+{
+    mAdaptiveWait.store(useAdaptiveWait, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Thread count
+-------------------------------------*/
+template <class WorkerTaskType>
+std::size_t PriorityWorkerPool<WorkerTaskType>::concurrency(std::size_t inNumThreads) noexcept
+{
+    if (inNumThreads == mThreads.size())
+    {
+        return inNumThreads;
+    }
+
+    wait();
+    stop_threads();
+    start_threads(inNumThreads);
+
+    return inNumThreads;
+}
+
+
+
+/*-------------------------------------
+ * Thread count
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t PriorityWorkerPool<WorkerTaskType>::concurrency() const noexcept
+{
+    return mThreads.size();
+}
+
+
+
+/*-------------------------------------
+ * Thread list
+-------------------------------------*/
+template <class WorkerTaskType>
+const std::vector<std::thread>& PriorityWorkerPool<WorkerTaskType>::threads() const noexcept
+{
+    return mThreads;
+}
+
+
+
+/*-------------------------------------
+ * Thread list
+-------------------------------------*/
+template <class WorkerTaskType>
+std::vector<std::thread>& PriorityWorkerPool<WorkerTaskType>::threads() noexcept
+{
+    return mThreads;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_PRIORITY_WORKER_POOL_IMPL_HPP */
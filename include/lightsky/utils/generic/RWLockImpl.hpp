@@ -385,6 +385,51 @@ inline const FairRWLock::native_handle_type& FairRWLock::native_handle() const n
 
 
 
+/*-----------------------------------------------------------------------------
+ * Reader-Biased R/W Lock
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+inline BiasedRWLock::BiasedRWLock() noexcept :
+    mReaderBias{true},
+    mInhibitUntil{0},
+    mLock{},
+    mReaderSlots{}
+{}
+
+
+
+/*-------------------------------------
+ * Check the reader bias
+-------------------------------------*/
+inline bool BiasedRWLock::reader_biased() const noexcept
+{
+    return mReaderBias.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Exclusive Unlock
+-------------------------------------*/
+inline void BiasedRWLock::unlock() noexcept
+{
+    mLock.unlock();
+}
+
+
+
+/*-------------------------------------
+ * Handle Type
+-------------------------------------*/
+inline const BiasedRWLock::native_handle_type& BiasedRWLock::native_handle() const noexcept
+{
+    return mLock;
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * Shared Lock Guard
 -----------------------------------------------------------------------------*/
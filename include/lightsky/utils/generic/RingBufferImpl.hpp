@@ -8,6 +8,9 @@
 #ifndef LS_UTILS_RING_BUFFER_IMPL_HPP
 #define LS_UTILS_RING_BUFFER_IMPL_HPP
 
+#include <iterator> // std::distance
+#include <utility> // std::move
+
 #include "lightsky/utils/Assertions.h"
 
 namespace ls
@@ -215,7 +218,7 @@ bool RingBuffer<T>::reserve(size_type requestedCapacity) noexcept
 
     for (; iter != oldEnd; iter = ((iter + 1ull) % mCapacity), ++newEnd)
     {
-        tmp[newEnd] = mData[iter];
+        tmp[newEnd] = std::move(mData[iter]);
     }
 
     mHead = 0ull;
@@ -256,7 +259,7 @@ inline bool RingBuffer<T>::full() const noexcept
 template <typename T>
 inline typename RingBuffer<T>::size_type RingBuffer<T>::size() const noexcept
 {
-    return (mTail - mHead) % mCapacity;
+    return (mTail + mCapacity - mHead) % mCapacity;
 }
 
 
@@ -361,6 +364,20 @@ inline typename RingBuffer<T>::value_type RingBuffer<T>::pop_unchecked() noexcep
 
 
 
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+inline typename RingBuffer<T>::value_type RingBuffer<T>::pop_back_unchecked() noexcept
+{
+    mTail = (mTail + mCapacity - 1ull) % mCapacity;
+    T&& result = std::move(mData[mTail]);
+
+    return result;
+}
+
+
+
 /*-------------------------------------
  *
 -------------------------------------*/
@@ -430,6 +447,42 @@ bool RingBuffer<T>::emplace(ArgsType&&... args) noexcept
 
 
 
+/*-------------------------------------
+ *
+-------------------------------------*/
+template <typename T>
+template <typename IterType>
+typename RingBuffer<T>::size_type RingBuffer<T>::push_range(IterType first, IterType last) noexcept
+{
+    const size_type count = (size_type)std::distance(first, last);
+    const size_type required = size() + count;
+
+    if (capacity() < required)
+    {
+        const size_type grown = _realloc_size();
+
+        if (!reserve(grown > required ? grown : required))
+        {
+            size_type numPushed = 0;
+            for (; first != last && push(*first); ++first)
+            {
+                ++numPushed;
+            }
+
+            return numPushed;
+        }
+    }
+
+    for (; first != last; ++first)
+    {
+        push_unchecked(*first);
+    }
+
+    return count;
+}
+
+
+
 /*-------------------------------------
  *
 -------------------------------------*/
@@ -0,0 +1,208 @@
+/*
+ * File:   SeqLockImpl.hpp
+ * Author: miles
+ * Created on October 20, 2026, at 5:20 p.m.
+ */
+
+#ifndef LS_UTILS_SEQ_LOCK_IMPL_HPP
+#define LS_UTILS_SEQ_LOCK_IMPL_HPP
+
+#include <array>
+#include <bit> // std::bit_cast
+#include <cstring> // std::memcpy
+#include <mutex> // std::lock_guard
+
+#include "lightsky/setup/CPU.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-------------------------------------
+ * Copy the data words
+-------------------------------------*/
+template <typename T, class WriterLockType>
+inline void SeqLock<T, WriterLockType>::_read_words(uint64_t* pOut) const noexcept
+{
+    for (uint32_t i = 0; i < NUM_WORDS; ++i)
+    {
+        pOut[i] = mWords[i].load(std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Replace the data words
+-------------------------------------*/
+template <typename T, class WriterLockType>
+inline void SeqLock<T, WriterLockType>::_write_words(const uint64_t* pIn) noexcept
+{
+    for (uint32_t i = 0; i < NUM_WORDS; ++i)
+    {
+        mWords[i].store(pIn[i], std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T, class WriterLockType>
+inline SeqLock<T, WriterLockType>::SeqLock() noexcept :
+    mSequence{0},
+    mWords{},
+    mWriterLock{}
+{}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <typename T, class WriterLockType>
+inline SeqLock<T, WriterLockType>::SeqLock(const T& initialValue) noexcept :
+    SeqLock{}
+{
+    uint64_t words[NUM_WORDS] = {};
+    std::memcpy(words, &initialValue, sizeof(T));
+    _write_words(words);
+}
+
+
+
+/*-------------------------------------
+ * Consistent read
+-------------------------------------*/
+template <typename T, class WriterLockType>
+T SeqLock<T, WriterLockType>::load() const noexcept
+{
+    uint64_t words[NUM_WORDS];
+
+    while (true)
+    {
+        const uint64_t seq = mSequence.load(std::memory_order_acquire);
+
+        if (!(seq & 1ull))
+        {
+            _read_words(words);
+
+            // Keep the data reads above the sequence re-check
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (mSequence.load(std::memory_order_relaxed) == seq)
+            {
+                break;
+            }
+        }
+
+        ls::setup::cpu_yield();
+    }
+
+    std::array<unsigned char, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), words, sizeof(T));
+    return std::bit_cast<T>(bytes);
+}
+
+
+
+/*-------------------------------------
+ * Single read attempt
+-------------------------------------*/
+template <typename T, class WriterLockType>
+bool SeqLock<T, WriterLockType>::try_load(T& outValue) const noexcept
+{
+    uint64_t words[NUM_WORDS];
+    const uint64_t seq = mSequence.load(std::memory_order_acquire);
+
+    if (seq & 1ull)
+    {
+        return false;
+    }
+
+    _read_words(words);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (mSequence.load(std::memory_order_relaxed) != seq)
+    {
+        return false;
+    }
+
+    std::memcpy(&outValue, words, sizeof(T));
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Replace the data
+-------------------------------------*/
+template <typename T, class WriterLockType>
+void SeqLock<T, WriterLockType>::store(const T& value) noexcept
+{
+    uint64_t words[NUM_WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+
+    std::lock_guard<WriterLockType> lock{mWriterLock};
+
+    const uint64_t seq = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(seq + 1ull, std::memory_order_relaxed);
+
+    // Keep the data writes below the odd sequence number
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _write_words(words);
+    mSequence.store(seq + 2ull, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Modify the data in place
+-------------------------------------*/
+template <typename T, class WriterLockType>
+template <typename UpdateFunc>
+void SeqLock<T, WriterLockType>::update(UpdateFunc&& updateFunc) noexcept
+{
+    uint64_t words[NUM_WORDS] = {};
+    std::array<unsigned char, sizeof(T)> bytes;
+
+    std::lock_guard<WriterLockType> lock{mWriterLock};
+
+    // Other writers are locked out, so the data can't change while copying
+    _read_words(words);
+    std::memcpy(bytes.data(), words, sizeof(T));
+
+    T value = std::bit_cast<T>(bytes);
+    updateFunc(value);
+    std::memcpy(words, &value, sizeof(T));
+
+    const uint64_t seq = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(seq + 1ull, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _write_words(words);
+    mSequence.store(seq + 2ull, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Write count
+-------------------------------------*/
+template <typename T, class WriterLockType>
+inline uint64_t SeqLock<T, WriterLockType>::sequence() const noexcept
+{
+    return mSequence.load(std::memory_order_acquire);
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_SEQ_LOCK_IMPL_HPP */
@@ -430,6 +430,64 @@ inline void shear_sort_dispatch(data_type* items, data_type* indices, long long
 
 
 
+/*-------------------------------------
+ * Wait for all threads of a parallel sort to reach a phase
+-------------------------------------*/
+inline void sort_wait_for_phase(std::atomic_llong* numSortPhases, long long phase) noexcept
+{
+    constexpr unsigned maxIters = 8;
+    unsigned currentIters = 1;
+
+    numSortPhases->fetch_add(1, std::memory_order_acq_rel);
+
+    while (numSortPhases->load(std::memory_order_consume) < phase)
+    {
+        // spin
+        switch (currentIters)
+        {
+            case 8:
+                ls::setup::cpu_yield();
+                ls::setup::cpu_yield();
+                ls::setup::cpu_yield();
+                ls::setup::cpu_yield();
+            case 4:
+                ls::setup::cpu_yield();
+                ls::setup::cpu_yield();
+            case 2:
+                ls::setup::cpu_yield();
+            default:
+                ls::setup::cpu_yield();
+                currentIters = currentIters < maxIters ? (currentIters+currentIters) : maxIters;
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Phase-synchronized sorts. "sync_phase()" is called by each thread after
+ * every phase and must not return until all threads have called it.
+-------------------------------------*/
+template <typename data_type, class PhaseSync, class Comparator>
+void sort_bitonic_phases(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    PhaseSync sync_phase,
+    Comparator cmp) noexcept;
+
+template <typename data_type, class PhaseSync, class Comparator>
+void sort_odd_even_phases(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    PhaseSync sync_phase,
+    Comparator cmp) noexcept;
+
+
+
 } // end impl namespace
 } // end utils namespace
 
@@ -1160,13 +1218,13 @@ void utils::sort_sheared(
 /*-------------------------------------
     Bitonic Sort for arrays of size 2^n
 -------------------------------------*/
-template <typename data_type, class Comparator>
-void utils::sort_bitonic(
+template <typename data_type, class PhaseSync, class Comparator>
+void utils::impl::sort_bitonic_phases(
     data_type* const items,
     long long count,
     long long numThreads,
     long long threadId,
-    std::atomic_llong* numSortPhases,
+    PhaseSync sync_phase,
     Comparator cmp) noexcept
 {
     // Can only sort powers of 2
@@ -1175,10 +1233,6 @@ void utils::sort_bitonic(
         return;
     }
 
-    long long phase = numThreads;
-    constexpr unsigned maxIters = 8;
-    unsigned currentIters;
-
     // Improved algorithm to reduce false sharing
     #if 1
         const long long chunks = (count / numThreads);
@@ -1190,7 +1244,7 @@ void utils::sort_bitonic(
         {
             long long k2 = k << 1;
 
-            for (long long j = k; j > 0; j >>= 1, phase += numThreads)
+            for (long long j = k; j > 0; j >>= 1)
             {
                 for (long long i = start; i < end; ++i)
                 {
@@ -1207,37 +1261,15 @@ void utils::sort_bitonic(
                     }
                 }
 
-                numSortPhases->fetch_add(1, std::memory_order_acq_rel);
                 LS_PREFETCH(items+start, LS_PREFETCH_ACCESS_R, LS_PREFETCH_LEVEL_L1);
-                currentIters = 1;
-
-                while (numSortPhases->load(std::memory_order_consume) < phase)
-                {
-                    // spin
-                    switch (currentIters)
-                    {
-                        case 8:
-                            ls::setup::cpu_yield();
-                            ls::setup::cpu_yield();
-                            ls::setup::cpu_yield();
-                            ls::setup::cpu_yield();
-                        case 4:
-                            ls::setup::cpu_yield();
-                            ls::setup::cpu_yield();
-                        case 2:
-                            ls::setup::cpu_yield();
-                        default:
-                            ls::setup::cpu_yield();
-                            currentIters = currentIters < maxIters ? (currentIters+currentIters) : maxIters;
-                    }
-                }
+                sync_phase();
             }
         }
 
     #else
         for (long long i = 1; i < count; i *= 2)
         {
-            for (long long j = i; j > 0; j /= 2, phase += numThreads)
+            for (long long j = i; j > 0; j /= 2)
             {
                 const long long jt0 = 2 * j * threadId;
                 const long long jt1 = 2 * j * numThreads;
@@ -1262,11 +1294,7 @@ void utils::sort_bitonic(
                     }
                 }
 
-                numSortPhases->fetch_add(1, std::memory_order_acq_rel);
-                while (numSortPhases->load(std::memory_order_consume) < phase)
-                {
-                    // spin
-                }
+                sync_phase();
             }
         }
 
@@ -1278,13 +1306,13 @@ void utils::sort_bitonic(
 /*-------------------------------------
     Odd-Even Merge Sort for arrays of size 2^n
 -------------------------------------*/
-template <typename data_type, class Comparator>
-void utils::sort_odd_even(
+template <typename data_type, class PhaseSync, class Comparator>
+void utils::impl::sort_odd_even_phases(
     data_type* const items,
     long long count,
     long long numThreads,
     long long threadId,
-    std::atomic_llong* numSortPhases,
+    PhaseSync sync_phase,
     Comparator cmp) noexcept
 {
     // Can only sort powers of 2
@@ -1293,13 +1321,9 @@ void utils::sort_odd_even(
         return;
     }
 
-    long long phase = numThreads;
-    constexpr unsigned maxIters = 8;
-    unsigned currentIters;
-
     for (long long p = 1, p2 = 1; p < count; p *= 2, p2 += 1)
     {
-        for (long long k = p; k > 0; k /= 2, phase += numThreads)
+        for (long long k = p; k > 0; k /= 2)
         {
             const long long kpmod = k & (p-1); // k % p
             const long long k2 = 2 * k;
@@ -1322,34 +1346,136 @@ void utils::sort_odd_even(
                 }
             }
 
-            numSortPhases->fetch_add(1, std::memory_order_acq_rel);
-            currentIters = 1;
-
-            while (numSortPhases->load(std::memory_order_consume) < phase)
-            {
-                // spin
-                switch (currentIters)
-                {
-                    case 8:
-                        ls::setup::cpu_yield();
-                        ls::setup::cpu_yield();
-                        ls::setup::cpu_yield();
-                        ls::setup::cpu_yield();
-                    case 4:
-                        ls::setup::cpu_yield();
-                        ls::setup::cpu_yield();
-                    case 2:
-                        ls::setup::cpu_yield();
-                    default:
-                        ls::setup::cpu_yield();
-                        currentIters = currentIters < maxIters ? (currentIters+currentIters) : maxIters;
-                }
-            }
+            sync_phase();
         }
     }
 }
 
 
+
+/*-------------------------------------
+    Bitonic Sort, synchronized with a shared counter
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_bitonic(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    std::atomic_llong* numSortPhases,
+    Comparator cmp) noexcept
+{
+    long long phase = numThreads;
+
+    impl::sort_bitonic_phases<data_type>(items, count, numThreads, threadId, [numSortPhases, numThreads, &phase]() noexcept -> void
+    {
+        impl::sort_wait_for_phase(numSortPhases, phase);
+        phase += numThreads;
+    }, cmp);
+}
+
+
+
+/*-------------------------------------
+    Bitonic Sort, synchronized with a SenseBarrier
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_bitonic(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    SenseBarrier* barrier,
+    Comparator cmp) noexcept
+{
+    impl::sort_bitonic_phases<data_type>(items, count, numThreads, threadId, [barrier]() noexcept -> void
+    {
+        barrier->wait();
+    }, cmp);
+}
+
+
+
+/*-------------------------------------
+    Bitonic Sort, synchronized with a DisseminationBarrier
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_bitonic(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    DisseminationBarrier* barrier,
+    Comparator cmp) noexcept
+{
+    impl::sort_bitonic_phases<data_type>(items, count, numThreads, threadId, [barrier, threadId]() noexcept -> void
+    {
+        barrier->wait((uint32_t)threadId);
+    }, cmp);
+}
+
+
+/*-------------------------------------
+    Odd-Even Merge Sort, synchronized with a shared counter
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_odd_even(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    std::atomic_llong* numSortPhases,
+    Comparator cmp) noexcept
+{
+    long long phase = numThreads;
+
+    impl::sort_odd_even_phases<data_type>(items, count, numThreads, threadId, [numSortPhases, numThreads, &phase]() noexcept -> void
+    {
+        impl::sort_wait_for_phase(numSortPhases, phase);
+        phase += numThreads;
+    }, cmp);
+}
+
+
+
+/*-------------------------------------
+    Odd-Even Merge Sort, synchronized with a SenseBarrier
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_odd_even(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    SenseBarrier* barrier,
+    Comparator cmp) noexcept
+{
+    impl::sort_odd_even_phases<data_type>(items, count, numThreads, threadId, [barrier]() noexcept -> void
+    {
+        barrier->wait();
+    }, cmp);
+}
+
+
+
+/*-------------------------------------
+    Odd-Even Merge Sort, synchronized with a DisseminationBarrier
+-------------------------------------*/
+template <typename data_type, class Comparator>
+inline void utils::sort_odd_even(
+    data_type* const items,
+    long long count,
+    long long numThreads,
+    long long threadId,
+    DisseminationBarrier* barrier,
+    Comparator cmp) noexcept
+{
+    impl::sort_odd_even_phases<data_type>(items, count, numThreads, threadId, [barrier, threadId]() noexcept -> void
+    {
+        barrier->wait((uint32_t)threadId);
+    }, cmp);
+}
+
 } // end ls namespace
 
 #endif /* LS_UTILS_SORT_IMPL_HPP */
@@ -0,0 +1,128 @@
+/*
+ * File:   TaskGraphImpl.hpp
+ * Author: miles
+ * Created on October 17, 2026, at 9:20 p.m.
+ */
+
+#ifndef LS_UTILS_TASK_GRAPH_IMPL_HPP
+#define LS_UTILS_TASK_GRAPH_IMPL_HPP
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * TaskGraph
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Push released nodes to a pool
+-------------------------------------*/
+template <class PoolType>
+void TaskGraph::_dispatch(void* pPool, TaskGraph* pGraph, const node_id* pNodes, std::size_t numNodes) noexcept
+{
+    typedef typename PoolType::value_type pool_task_type;
+
+    PoolType& pool = *static_cast<PoolType*>(pPool);
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        const node_id nodeId = pNodes[i];
+        pool.emplace(pool_task_type{[pGraph, nodeId]()->void
+        {
+            pGraph->_execute(nodeId);
+        }});
+    }
+
+    pool.flush();
+}
+
+
+
+/*-------------------------------------
+ * Number of nodes
+-------------------------------------*/
+inline std::size_t TaskGraph::size() const noexcept
+{
+    return mNodes.size();
+}
+
+
+
+/*-------------------------------------
+ * Check if the graph can run
+-------------------------------------*/
+inline bool TaskGraph::finalized() const noexcept
+{
+    return mIsFinalized;
+}
+
+
+
+/*-------------------------------------
+ * Check if the graph is running
+-------------------------------------*/
+inline bool TaskGraph::running() const noexcept
+{
+    return mIsRunning;
+}
+
+
+
+/*-------------------------------------
+ * Start the graph
+-------------------------------------*/
+template <class PoolType>
+bool TaskGraph::start(PoolType& pool) noexcept
+{
+    if (!mIsFinalized || mIsRunning)
+    {
+        return false;
+    }
+
+    mIsRunning = true;
+
+    if (mNodes.empty())
+    {
+        return true;
+    }
+
+    if (!pool.concurrency())
+    {
+        _run_serial();
+        return true;
+    }
+
+    _reset_counters();
+    mPool = &pool;
+    mDispatch = &TaskGraph::_dispatch<PoolType>;
+    mDispatch(mPool, this, mOrder.data(), mNumRoots);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Run the graph to completion
+-------------------------------------*/
+template <class PoolType>
+inline bool TaskGraph::run(PoolType& pool) noexcept
+{
+    if (!start(pool))
+    {
+        return false;
+    }
+
+    wait();
+    return true;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_TASK_GRAPH_IMPL_HPP */
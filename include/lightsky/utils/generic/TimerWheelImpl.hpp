@@ -0,0 +1,51 @@
+/*
+ * File:   TimerWheelImpl.hpp
+ * Author: miles
+ * Created on October 19, 2026, at 1:20 p.m.
+ */
+
+#ifndef LS_UTILS_TIMER_WHEEL_IMPL_HPP
+#define LS_UTILS_TIMER_WHEEL_IMPL_HPP
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * TimerWheel
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Dispatch expired timers to a pool
+-------------------------------------*/
+template <class PoolType>
+std::size_t TimerWheel::advance(PoolType& pool, clock_type::time_point now) noexcept
+{
+    typedef typename PoolType::value_type task_type;
+
+    // Callbacks are collected first so none of them run, or get pushed,
+    // while the wheel is locked.
+    std::vector<utils::Function<void()>> expired;
+    const std::size_t numExpired = expire(now, expired);
+
+    if (numExpired)
+    {
+        for (utils::Function<void()>& callback : expired)
+        {
+            pool.emplace(task_type{std::move(callback)});
+        }
+
+        pool.flush();
+    }
+
+    return numExpired;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_TIMER_WHEEL_IMPL_HPP */
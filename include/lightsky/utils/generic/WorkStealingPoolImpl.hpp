@@ -0,0 +1,971 @@
+/*
+ * File:   WorkStealingPoolImpl.hpp
+ * Author: miles
+ * Created on October 15, 2026, at 10:12 a.m.
+ */
+
+#ifndef LS_UTILS_WORK_STEALING_POOL_IMPL_HPP
+#define LS_UTILS_WORK_STEALING_POOL_IMPL_HPP
+
+#include "lightsky/setup/CPU.h" // cpu_yield()
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Work-Stealing Thread Pool
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Thread-local ownership
+-------------------------------------*/
+template <class WorkerTaskType>
+thread_local const WorkStealingPool<WorkerTaskType>* WorkStealingPool<WorkerTaskType>::tCurrentPool = nullptr;
+
+template <class WorkerTaskType>
+thread_local std::size_t WorkStealingPool<WorkerTaskType>::tCurrentQueue = 0;
+
+
+
+/*-------------------------------------
+ * Pick a queue for a new task
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t WorkStealingPool<WorkerTaskType>::_select_queue() noexcept
+{
+    // Tasks spawned by a worker stay local to that worker until stolen.
+    if (tCurrentPool == this)
+    {
+        return tCurrentQueue;
+    }
+
+    return mNextQueue.fetch_add(1, std::memory_order_relaxed) % mNumQueues;
+}
+
+
+
+/*-------------------------------------
+ * Pick a set of queues for a range of tasks
+-------------------------------------*/
+template <class WorkerTaskType>
+std::size_t WorkStealingPool<WorkerTaskType>::_select_queues(std::size_t numTasks, std::size_t& outNumQueues) noexcept
+{
+    // Tasks spawned by a worker stay local to that worker, as with push().
+    // Otherwise the range is split evenly across all queues, starting at
+    // the next round-robin queue.
+    if (tCurrentPool == this)
+    {
+        outNumQueues = 1;
+        return tCurrentQueue;
+    }
+
+    outNumQueues = numTasks < mNumQueues ? numTasks : mNumQueues;
+    return mNextQueue.fetch_add(outNumQueues, std::memory_order_relaxed) % mNumQueues;
+}
+
+
+
+/*-------------------------------------
+ * Wake sleeping workers for new tasks
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::_notify_sleeper(std::size_t numTasks) noexcept
+{
+    // Only tasks pushed while the pool is running need an immediate wakeup.
+    // Everything else waits on the next flush().
+    if (mIsPaused.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    const std::size_t numSleeping = mThreadsSleeping.load(std::memory_order_acquire);
+    if (numSleeping > 0)
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+
+        if (numTasks >= numSleeping)
+        {
+            mExecCond.notify_all();
+        }
+        else
+        {
+            for (std::size_t i = 0; i < numTasks; ++i)
+            {
+                mExecCond.notify_one();
+            }
+        }
+    }
+
+    if (mAdaptiveWait.load(std::memory_order_acquire))
+    {
+        mWakeSignal.notify();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record queued tasks (called with the queue's lock held).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::_record_push(WorkQueue& q, std::size_t numTasks) noexcept
+{
+    if (numTasks && mMetrics.enabled())
+    {
+        WorkerMetrics::push_enqueue_time(q.enqueueTimes, (std::size_t)q.tasks.size(), numTasks);
+        mMetrics.record_push(mNumPending.load(std::memory_order_relaxed), numTasks);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Pop a task from a worker's own queue
+ *
+ * The owner takes the newest task (LIFO) while thieves take the oldest.
+ * The owner runs whatever its previous task just spawned while the data is
+ * still in cache, and thieves take the older, typically larger, work.
+-------------------------------------*/
+template <class WorkerTaskType>
+bool WorkStealingPool<WorkerTaskType>::pop_local(std::size_t queueId, WorkerTaskType& outTask, uint64_t& outEnqueueNs) noexcept
+{
+    WorkQueue& q = mQueues[queueId];
+
+    q.lock.lock();
+    if (q.tasks.empty())
+    {
+        q.lock.unlock();
+        return false;
+    }
+
+    outEnqueueNs = WorkerMetrics::pop_back_enqueue_time(q.enqueueTimes, (std::size_t)q.tasks.size());
+    outTask = q.tasks.pop_back_unchecked();
+    q.lock.unlock();
+
+    mNumPending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Steal a task from another worker
+-------------------------------------*/
+template <class WorkerTaskType>
+bool WorkStealingPool<WorkerTaskType>::steal(std::size_t thiefId, uint32_t seed, WorkerTaskType& outTask, uint64_t& outEnqueueNs) noexcept
+{
+    const std::size_t numQueues = mNumQueues;
+    const std::size_t start = (std::size_t)seed % numQueues;
+
+    for (std::size_t i = 0; i < numQueues; ++i)
+    {
+        const std::size_t victim = (start + i) % numQueues;
+        if (victim == thiefId)
+        {
+            continue;
+        }
+
+        WorkQueue& q = mQueues[victim];
+
+        // Never queue up behind the owner or another thief. The caller will
+        // retry while tasks are still pending.
+        if (!q.lock.try_lock())
+        {
+            continue;
+        }
+
+        if (q.tasks.empty())
+        {
+            q.lock.unlock();
+            continue;
+        }
+
+        outEnqueueNs = WorkerMetrics::pop_enqueue_time(q.enqueueTimes, (std::size_t)q.tasks.size());
+        outTask = q.tasks.pop_unchecked();
+        q.lock.unlock();
+
+        mNumPending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Run a single task
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::run_task(std::size_t threadId, WorkerTaskType& task, uint64_t enqueueNs) noexcept
+{
+    if (mMetrics.enabled())
+    {
+        const uint64_t startNs = WorkerMetrics::now_ns();
+        task();
+        mMetrics.record_task(threadId, enqueueNs, startNs, WorkerMetrics::now_ns());
+    }
+    else
+    {
+        task();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Execute the tasks in the queue.
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::execute_tasks(std::size_t threadId, uint32_t& seed) noexcept
+{
+    mThreadsRunning.fetch_add(1, std::memory_order_acq_rel);
+
+    WorkerTaskType task;
+    uint64_t enqueueNs = 0;
+
+    while (true)
+    {
+        if (pop_local(threadId, task, enqueueNs))
+        {
+            run_task(threadId, task, enqueueNs);
+            continue;
+        }
+
+        // xorshift32 for victim selection
+        seed ^= seed << 13u;
+        seed ^= seed >> 17u;
+        seed ^= seed << 5u;
+
+        if (steal(threadId, seed, task, enqueueNs))
+        {
+            if (mMetrics.enabled())
+            {
+                mMetrics.record_steal(threadId);
+            }
+
+            run_task(threadId, task, enqueueNs);
+            continue;
+        }
+
+        if (!mNumPending.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        // A task is mid-push or every victim was locked
+        ls::setup::cpu_yield();
+    }
+
+    // Pause the pool once the last active worker runs dry.
+    if (mThreadsRunning.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+
+        if (!mNumPending.load(std::memory_order_acquire) && !mThreadsRunning.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> waitLock{mWaitMtx};
+            mIsPaused.store(true, std::memory_order_release);
+            mWaitCond.notify_all();
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Worker thread entry point
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::thread_loop(std::size_t threadId) noexcept
+{
+    tCurrentPool = this;
+    tCurrentQueue = threadId;
+
+    uint32_t seed = (uint32_t)(threadId * 2654435761u) | 1u;
+    WorkerIdleStrategy idleStrategy{};
+    uint64_t idleStartNs = 0;
+
+    while (!mIsStopped.load(std::memory_order_acquire))
+    {
+        // Read before checking for tasks so a wakeup in between isn't lost
+        const uint32_t wakeSeq = mWakeSignal.sequence();
+
+        if (mIsPaused.load(std::memory_order_acquire) || !mNumPending.load(std::memory_order_acquire))
+        {
+            if (!idleStartNs && mMetrics.enabled())
+            {
+                idleStartNs = WorkerMetrics::now_ns();
+            }
+
+            // Busy waiting can be disabled at any time, but waiting on the
+            // condition variable will remain in-place until the next flush.
+            if (mBusyWait.load(std::memory_order_acquire))
+            {
+                ls::setup::cpu_yield();
+                continue;
+            }
+
+            if (mAdaptiveWait.load(std::memory_order_acquire))
+            {
+                if (idleStrategy.wait(mWakeSignal, wakeSeq) && mMetrics.enabled())
+                {
+                    mMetrics.record_park(threadId);
+                }
+
+                continue;
+            }
+
+            const auto canRun = [this]()->bool
+            {
+                return mIsStopped.load(std::memory_order_acquire)
+                    || (!mIsPaused.load(std::memory_order_acquire) && mNumPending.load(std::memory_order_acquire));
+            };
+
+            std::unique_lock<std::mutex> cvLock{mExecMtx};
+            if (!canRun())
+            {
+                if (mMetrics.enabled())
+                {
+                    mMetrics.record_park(threadId);
+                }
+
+                mThreadsSleeping.fetch_add(1, std::memory_order_acq_rel);
+                mExecCond.wait(cvLock, canRun);
+                mThreadsSleeping.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+        else
+        {
+            if (idleStartNs)
+            {
+                if (mMetrics.enabled())
+                {
+                    mMetrics.record_idle(threadId, WorkerMetrics::now_ns() - idleStartNs);
+                }
+
+                idleStartNs = 0;
+            }
+
+            execute_tasks(threadId, seed);
+        }
+    }
+
+    tCurrentPool = nullptr;
+    tCurrentQueue = 0;
+}
+
+
+
+/*-------------------------------------
+ * Launch worker threads
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::start_threads(std::size_t numThreads) noexcept
+{
+    // Keep at least one queue around so tasks can still be pushed to a pool
+    // with no threads.
+    mNumQueues = numThreads ? numThreads : 1;
+    mQueues = utils::make_unique_array<WorkQueue>(mNumQueues);
+
+    for (std::size_t i = 0; i < mNumQueues; ++i)
+    {
+        mQueues[i].tasks.reserve(2);
+    }
+
+    mMetrics.resize(numThreads);
+    mThreads.reserve(numThreads);
+
+    for (std::size_t threadId = 0; threadId < numThreads; ++threadId)
+    {
+        mThreads.emplace_back(&WorkStealingPool::thread_loop, this, threadId);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Join all worker threads
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::stop_threads() noexcept
+{
+    while (!ready())
+    {
+    }
+
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+        mIsStopped.store(true, std::memory_order_release);
+        mExecCond.notify_all();
+    }
+
+    mWakeSignal.notify();
+
+    for (std::thread& t : mThreads)
+    {
+        t.join();
+    }
+
+    mThreads.clear();
+    mQueues.reset();
+    mNumQueues = 0;
+
+    mNumPending.store(0, std::memory_order_release);
+    mThreadsRunning.store(0, std::memory_order_release);
+    mIsPaused.store(true, std::memory_order_release);
+    mIsStopped.store(false, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>::~WorkStealingPool() noexcept
+{
+    stop_threads();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>::WorkStealingPool(std::size_t inNumThreads) :
+    mBusyWait{false},
+    mAdaptiveWait{false},
+    mIsPaused{true},
+    mIsStopped{false},
+    mWakeSignal{},
+    mThreadsRunning{0},
+    mThreadsSleeping{0},
+    mNumPending{0},
+    mNextQueue{0},
+    mNumQueues{0},
+    mQueues{nullptr},
+    mWaitMtx{},
+    mWaitCond{},
+    mExecMtx{},
+    mExecCond{},
+    mThreads{},
+    mMetrics{}
+{
+    start_threads(inNumThreads);
+}
+
+
+
+/*-------------------------------------
+ * Copy Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>::WorkStealingPool(const WorkStealingPool& w) noexcept :
+    WorkStealingPool{} // delegate constructor
+{
+    *this = w;
+}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>::WorkStealingPool(WorkStealingPool&& w) noexcept :
+    WorkStealingPool{} // delegate constructor
+{
+    *this = std::move(w);
+}
+
+
+
+/*-------------------------------------
+ * Copy Operator
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>& WorkStealingPool<WorkerTaskType>::operator=(const WorkStealingPool& w) noexcept
+{
+    if (this == &w)
+    {
+        return *this;
+    }
+
+    w.wait();
+    wait();
+
+    stop_threads();
+
+    mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    mMetrics.enabled(w.mMetrics.enabled());
+    start_threads(w.mThreads.size());
+
+    for (std::size_t i = 0; i < mNumQueues; ++i)
+    {
+        const WorkQueue& src = w.mQueues[i];
+        std::lock_guard<utils::SpinLock> srcLock{src.lock};
+
+        if (!src.tasks.empty())
+        {
+            std::lock_guard<utils::SpinLock> dstLock{mQueues[i].lock};
+            mQueues[i].tasks = src.tasks;
+            mNumPending.fetch_add((std::size_t)src.tasks.size(), std::memory_order_acq_rel);
+        }
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkStealingPool<WorkerTaskType>& WorkStealingPool<WorkerTaskType>::operator=(WorkStealingPool&& w) noexcept
+{
+    if (this == &w)
+    {
+        return *this;
+    }
+
+    w.wait();
+    wait();
+
+    stop_threads();
+
+    mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mBusyWait.store(false, std::memory_order_release);
+
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mAdaptiveWait.store(false, std::memory_order_release);
+
+    mMetrics.enabled(w.mMetrics.enabled());
+    w.mMetrics.enabled(false);
+
+    start_threads(w.mThreads.size());
+
+    for (std::size_t i = 0; i < mNumQueues; ++i)
+    {
+        WorkQueue& src = w.mQueues[i];
+        std::lock_guard<utils::SpinLock> srcLock{src.lock};
+
+        if (!src.tasks.empty())
+        {
+            const std::size_t numTasks = (std::size_t)src.tasks.size();
+
+            std::lock_guard<utils::SpinLock> dstLock{mQueues[i].lock};
+            mQueues[i].tasks = std::move(src.tasks);
+            src.tasks.reserve(2);
+            src.enqueueTimes.clear();
+
+            w.mNumPending.fetch_sub(numTasks, std::memory_order_acq_rel);
+            mNumPending.fetch_add(numTasks, std::memory_order_acq_rel);
+        }
+    }
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Get the number of tasks currently queued
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t WorkStealingPool<WorkerTaskType>::num_pending() const noexcept
+{
+    return mNumPending.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Determine if there are tasks queued
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkStealingPool<WorkerTaskType>::have_pending() const noexcept
+{
+    return mNumPending.load(std::memory_order_acquire) != 0;
+}
+
+
+
+/*-------------------------------------
+ * Clear the currently pending tasks
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::clear_pending() noexcept
+{
+    for (std::size_t i = 0; i < mNumQueues; ++i)
+    {
+        WorkQueue& q = mQueues[i];
+        std::lock_guard<utils::SpinLock> lock{q.lock};
+
+        const std::size_t numTasks = (std::size_t)q.tasks.size();
+        q.tasks.clear();
+        q.tasks.reserve(2);
+        q.enqueueTimes.clear();
+
+        mNumPending.fetch_sub(numTasks, std::memory_order_acq_rel);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Push a task to the pending task queue (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::push(const WorkerTaskType& task) noexcept
+{
+    WorkQueue& q = mQueues[_select_queue()];
+
+    // Count the task first so no worker sleeps while it's being inserted.
+    mNumPending.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<utils::SpinLock> lock{q.lock};
+        q.tasks.push(task);
+        _record_push(q, 1);
+    }
+
+    _notify_sleeper(1);
+}
+
+
+
+/*-------------------------------------
+ * Push a task to the pending task queue (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::emplace(WorkerTaskType&& task) noexcept
+{
+    WorkQueue& q = mQueues[_select_queue()];
+
+    mNumPending.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<utils::SpinLock> lock{q.lock};
+        q.tasks.emplace(std::forward<WorkerTaskType>(task));
+        _record_push(q, 1);
+    }
+
+    _notify_sleeper(1);
+}
+
+
+
+/*-------------------------------------
+ * Push a range of tasks (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+void WorkStealingPool<WorkerTaskType>::push_range(IterType first, IterType last) noexcept
+{
+    const std::size_t numTasks = (std::size_t)std::distance(first, last);
+    if (!numTasks)
+    {
+        return;
+    }
+
+    std::size_t numChunks;
+    const std::size_t startQueue = _select_queues(numTasks, numChunks);
+
+    mNumPending.fetch_add(numTasks, std::memory_order_acq_rel);
+
+    std::size_t numQueued = 0;
+    for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+        const std::size_t chunkSize = numTasks / numChunks + (chunk < numTasks % numChunks);
+        IterType chunkEnd = std::next(first, (std::ptrdiff_t)chunkSize);
+        WorkQueue& q = mQueues[(startQueue + chunk) % mNumQueues];
+
+        {
+            std::lock_guard<utils::SpinLock> lock{q.lock};
+            const std::size_t numPushed = (std::size_t)q.tasks.push_range(first, chunkEnd);
+
+            numQueued += numPushed;
+            _record_push(q, numPushed);
+        }
+
+        first = chunkEnd;
+    }
+
+    // Don't leave workers spinning on tasks which failed to allocate
+    if (numQueued != numTasks)
+    {
+        mNumPending.fetch_sub(numTasks - numQueued, std::memory_order_acq_rel);
+    }
+
+    _notify_sleeper(numQueued);
+}
+
+
+
+/*-------------------------------------
+ * Push a range of tasks (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+inline void WorkStealingPool<WorkerTaskType>::emplace_bulk(IterType first, IterType last) noexcept
+{
+    push_range(std::make_move_iterator(first), std::make_move_iterator(last));
+}
+
+
+
+/*-------------------------------------
+ * Push a task and retrieve a future for its result.
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename Func>
+Future<std::invoke_result_t<const std::decay_t<Func>&>> WorkStealingPool<WorkerTaskType>::submit(Func&& func) noexcept
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&> result_type;
+    typedef std::decay_t<Func> func_type;
+
+    const Promise<result_type> promise;
+    Future<result_type> result = promise.get_future();
+
+    if (result.valid())
+    {
+        emplace(WorkerTaskType{[promise, fn = func_type{std::forward<Func>(func)}]()->void
+        {
+            promise.set_value_from(fn);
+        }});
+    }
+
+    return result;
+}
+
+
+
+/*-------------------------------------
+ * Check if the pool has finished all tasks and can be flushed.
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkStealingPool<WorkerTaskType>::ready() const noexcept
+{
+    return mIsPaused.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Wake all workers to run any pending tasks.
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkStealingPool<WorkerTaskType>::flush() noexcept
+{
+    const std::size_t numTasks = mNumPending.load(std::memory_order_acquire);
+
+    // Don't bother waking up the threads if there's nothing to do.
+    if (numTasks)
+    {
+        {
+            std::lock_guard<std::mutex> execLock{mExecMtx};
+            mIsPaused.store(false, std::memory_order_release);
+
+            // Every woken worker can steal, so one thread per task is
+            // enough.
+            if (numTasks >= mThreads.size())
+            {
+                mExecCond.notify_all();
+            }
+            else
+            {
+                for (std::size_t i = 0; i < numTasks; ++i)
+                {
+                    mExecCond.notify_one();
+                }
+            }
+        }
+
+        mWakeSignal.notify();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Wait for all workers to finish execution.
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::wait() const noexcept
+{
+    if (mBusyWait.load(std::memory_order_consume))
+    {
+        while (!mIsPaused.load(std::memory_order_consume))
+        {
+            ls::setup::cpu_yield();
+        }
+    }
+    else
+    {
+        std::unique_lock<std::mutex> cvLock{mWaitMtx};
+        mWaitCond.wait(cvLock, [this]()->bool
+        {
+            return mIsPaused.load(std::memory_order_acquire);
+        });
+    }
+}
+
+
+
+/*-------------------------------------
+ * Determine if busy waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkStealingPool<WorkerTaskType>::busy_waiting() const noexcept
+{
+    return mBusyWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle busy waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::busy_waiting(bool useBusyWait) noexcept
+{
+    mBusyWait.store(useBusyWait, std::memory_order_release);
+
+    // Wake any sleeping threads so they pick up the new idle mode.
+    if (useBusyWait)
+    {
+        std::lock_guard<std::mutex> execLock{mExecMtx};
+        mExecCond.notify_all();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Determine if adaptive waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkStealingPool<WorkerTaskType>::adaptive_waiting() const noexcept
+{
+    return mAdaptiveWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle adaptive waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::adaptive_waiting(bool useAdaptiveWait) noexcept
+{
+    mAdaptiveWait.store(useAdaptiveWait, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Determine if metrics are collected
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkStealingPool<WorkerTaskType>::collect_metrics() const noexcept
+{
+    return mMetrics.enabled();
+}
+
+
+
+/*-------------------------------------
+ * Toggle metrics collection
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::collect_metrics(bool enableMetrics) noexcept
+{
+    mMetrics.enabled(enableMetrics);
+}
+
+
+
+/*-------------------------------------
+ * Metrics snapshot
+-------------------------------------*/
+template <class WorkerTaskType>
+inline WorkerPoolStats WorkStealingPool<WorkerTaskType>::metrics() const noexcept
+{
+    return mMetrics.snapshot();
+}
+
+
+
+/*-------------------------------------
+ * Reset metrics
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkStealingPool<WorkerTaskType>::reset_metrics() noexcept
+{
+    mMetrics.reset();
+}
+
+
+
+/*-------------------------------------
+ * Thread count
+-------------------------------------*/
+template <class WorkerTaskType>
+std::size_t WorkStealingPool<WorkerTaskType>::concurrency(std::size_t inNumThreads) noexcept
+{
+    if (inNumThreads == mThreads.size())
+    {
+        return inNumThreads;
+    }
+
+    wait();
+    stop_threads();
+    start_threads(inNumThreads);
+
+    return inNumThreads;
+}
+
+
+
+/*-------------------------------------
+ * Thread count
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::size_t WorkStealingPool<WorkerTaskType>::concurrency() const noexcept
+{
+    return mThreads.size();
+}
+
+
+
+/*-------------------------------------
+ * Thread list (const)
+-------------------------------------*/
+template <class WorkerTaskType>
+inline const std::vector<std::thread>& WorkStealingPool<WorkerTaskType>::threads() const noexcept
+{
+    return mThreads;
+}
+
+
+
+/*-------------------------------------
+ * Thread list
+-------------------------------------*/
+template <class WorkerTaskType>
+inline std::vector<std::thread>& WorkStealingPool<WorkerTaskType>::threads() noexcept
+{
+    return mThreads;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
+
+#endif /* LS_UTILS_WORK_STEALING_POOL_IMPL_HPP */
@@ -12,11 +12,26 @@ namespace utils
 /*-----------------------------------------------------------------------------
  * Thread Pool Object
 -----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Record queued tasks (called with the push lock held).
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkerPool<WorkerTaskType>::_record_push(std::size_t numTasks) noexcept
+{
+    if (numTasks && mMetrics.enabled())
+    {
+        WorkerMetrics::push_enqueue_time(mEnqueueTimes, (std::size_t)mTasks.size(), numTasks);
+        mMetrics.record_push((std::size_t)mTasks.size(), numTasks);
+    }
+}
+
+
+
 /*-------------------------------------
  * Execute the tasks in the queue.
 -------------------------------------*/
 template <class WorkerTaskType>
-void WorkerPool<WorkerTaskType>::execute_tasks() noexcept
+void WorkerPool<WorkerTaskType>::execute_tasks(size_t threadId) noexcept
 {
     mThreadsRunning.fetch_add(1, std::memory_order_acq_rel);
 
@@ -30,10 +45,20 @@ void WorkerPool<WorkerTaskType>::execute_tasks() noexcept
             break;
         }
 
+        const uint64_t enqueueNs = WorkerMetrics::pop_enqueue_time(mEnqueueTimes, (std::size_t)mTasks.size());
         WorkerTaskType&& task = mTasks.pop_unchecked();
         mPushLock.unlock();
 
-        task();
+        if (mMetrics.enabled())
+        {
+            const uint64_t startNs = WorkerMetrics::now_ns();
+            task();
+            mMetrics.record_task(threadId, enqueueNs, startNs, WorkerMetrics::now_ns());
+        }
+        else
+        {
+            task();
+        }
     }
 
     // Pause the current thread again.
@@ -56,13 +81,19 @@ void WorkerPool<WorkerTaskType>::execute_tasks() noexcept
  * Push a task to the pending task queue (copy).
 -------------------------------------*/
 template <class WorkerTaskType>
-void WorkerPool<WorkerTaskType>::thread_loop() noexcept
+void WorkerPool<WorkerTaskType>::thread_loop(size_t threadId) noexcept
 {
+    WorkerIdleStrategy idleStrategy{};
+    uint64_t idleStartNs = 0;
+
     while (true)
     {
         bool amDone;
         bool outOfTasks;
 
+        // Read before checking for tasks so a flush() in between isn't lost
+        const uint32_t wakeSeq = mWakeSignal.sequence();
+
         {
             std::lock_guard<utils::SpinLock> pushLock{mPushLock};
             amDone = mTasks.capacity() == 0;
@@ -76,17 +107,61 @@ void WorkerPool<WorkerTaskType>::thread_loop() noexcept
 
         if (outOfTasks || mIsPaused.load(std::memory_order_acquire))
         {
+            if (!idleStartNs && mMetrics.enabled())
+            {
+                idleStartNs = WorkerMetrics::now_ns();
+            }
+
             // Busy waiting can be disabled at any time, but waiting on the
             // condition variable will remain in-place until the next flush.
-            if (!mBusyWait.load(std::memory_order_acquire))
+            if (mBusyWait.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            if (mAdaptiveWait.load(std::memory_order_acquire))
             {
+                if (idleStrategy.wait(mWakeSignal, wakeSeq) && mMetrics.enabled())
+                {
+                    mMetrics.record_park(threadId);
+                }
+            }
+            else
+            {
+                const auto canRun = [this]()->bool
+                {
+                    std::lock_guard<utils::SpinLock> pushLock{mPushLock};
+                    return mTasks.capacity() == 0
+                        || (!mTasks.empty() && !mIsPaused.load(std::memory_order_acquire));
+                };
+
+                // Re-check under the lock used by flush() and stop_threads()
+                // so a wakeup between the checks above and here isn't lost.
                 std::unique_lock<std::mutex> cvLock{mExecMtx};
-                mExecCond.wait(cvLock);
+                if (!canRun())
+                {
+                    if (mMetrics.enabled())
+                    {
+                        mMetrics.record_park(threadId);
+                    }
+
+                    mExecCond.wait(cvLock, canRun);
+                }
             }
         }
         else
         {
-            execute_tasks();
+            if (idleStartNs)
+            {
+                if (mMetrics.enabled())
+                {
+                    mMetrics.record_idle(threadId, WorkerMetrics::now_ns() - idleStartNs);
+                }
+
+                idleStartNs = 0;
+            }
+
+            execute_tasks(threadId);
         }
     }
 }
@@ -94,7 +169,29 @@ void WorkerPool<WorkerTaskType>::thread_loop() noexcept
 
 
 /*-------------------------------------
- * Destructor
+ * Launch worker threads
+-------------------------------------*/
+template <class WorkerTaskType>
+void WorkerPool<WorkerTaskType>::start_threads(size_t numThreads) noexcept
+{
+    mMetrics.resize(numThreads);
+    mThreads.reserve(numThreads);
+
+    for (std::size_t threadId = 0; threadId < numThreads; ++threadId)
+    {
+        mThreads.emplace_back(&WorkerPool::thread_loop, this, threadId);
+    }
+
+    if (mPlacement != CpuPlacement::NONE)
+    {
+        place_threads(mThreads, mPlacement, mPlacementNode);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Join all worker threads
 -------------------------------------*/
 template <class WorkerTaskType>
 void WorkerPool<WorkerTaskType>::stop_threads() noexcept
@@ -109,12 +206,15 @@ void WorkerPool<WorkerTaskType>::stop_threads() noexcept
             std::lock_guard<utils::SpinLock> pushLock{mPushLock};
             mTasks.clear();
             mTasks.shrink_to_fit();
+            mEnqueueTimes.clear();
         }
 
         mIsPaused.store(false, std::memory_order_release);
         mExecCond.notify_all();
     }
 
+    mWakeSignal.notify();
+
     for (std::thread& t : mThreads)
     {
         t.join();
@@ -144,21 +244,35 @@ WorkerPool<WorkerTaskType>::~WorkerPool() noexcept
 template <class WorkerTaskType>
 WorkerPool<WorkerTaskType>::WorkerPool(size_t inNumThreads) :
     mBusyWait{false},
+    mAdaptiveWait{false},
     mIsPaused{true},
+    mWakeSignal{},
     mThreadsRunning{0},
+    mPlacement{CpuPlacement::NONE},
+    mPlacementNode{-1},
     mPushLock{},
     mTasks{2},
+    mEnqueueTimes{},
+    mMetrics{},
     mWaitMtx{},
     mWaitCond{},
     mExecMtx{},
     mExecCond{},
     mThreads{}
 {
-    mThreads.reserve(inNumThreads);
-    for (std::size_t threadId = 0; threadId < inNumThreads; ++threadId)
-    {
-        mThreads.emplace_back(&WorkerPool::thread_loop, this);
-    }
+    start_threads(inNumThreads);
+}
+
+
+
+/*-------------------------------------
+ * Constructor (placed threads)
+-------------------------------------*/
+template <class WorkerTaskType>
+WorkerPool<WorkerTaskType>::WorkerPool(size_t inNumThreads, CpuPlacement policy, int numaNode) :
+    WorkerPool{inNumThreads} // delegate constructor
+{
+    placement(policy, numaNode);
 }
 
 
@@ -204,15 +318,13 @@ WorkerPool<WorkerTaskType>& WorkerPool<WorkerTaskType>::operator=(const WorkerPo
     stop_threads();
 
     mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    mMetrics.enabled(w.mMetrics.enabled());
     mTasks = w.mTasks;
 
-    std::size_t numThreads = w.mThreads.size();
-    mThreads.reserve(numThreads);
-
-    for (std::size_t threadId = 0; threadId < numThreads; ++threadId)
-    {
-        mThreads.emplace_back(&WorkerPool::thread_loop, this);
-    }
+    mPlacement = w.mPlacement;
+    mPlacementNode = w.mPlacementNode;
+    start_threads(w.mThreads.size());
 
     return *this;
 }
@@ -239,14 +351,24 @@ WorkerPool<WorkerTaskType>& WorkerPool<WorkerTaskType>::operator=(WorkerPool&& w
     mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
     w.mBusyWait.store(false, std::memory_order_release);
 
-    mTasks = std::move(w.mTasks);
-    mThreads.reserve(numThreads);
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mAdaptiveWait.store(false, std::memory_order_release);
+
+    mMetrics.enabled(w.mMetrics.enabled());
+    w.mMetrics.enabled(false);
 
-    for (std::size_t threadId = 0; threadId < numThreads; ++threadId)
     {
-        mThreads.emplace_back(&WorkerPool::thread_loop, this);
+        std::lock_guard<utils::SpinLock> pushLock{w.mPushLock};
+        mTasks = std::move(w.mTasks);
+        w.mEnqueueTimes.clear();
     }
 
+    mPlacement = w.mPlacement;
+    mPlacementNode = w.mPlacementNode;
+    w.mPlacement = CpuPlacement::NONE;
+    w.mPlacementNode = -1;
+    start_threads(numThreads);
+
     return *this;
 }
 
@@ -310,6 +432,7 @@ inline void WorkerPool<WorkerTaskType>::clear_pending() noexcept
 {
     std::lock_guard<utils::SpinLock> lock{mPushLock};
     mTasks.clear();
+    mEnqueueTimes.clear();
 }
 
 
@@ -322,6 +445,7 @@ inline void WorkerPool<WorkerTaskType>::push(const WorkerTaskType& task) noexcep
 {
     std::lock_guard<utils::SpinLock> lock{mPushLock};
     mTasks.push(task);
+    _record_push(1);
 }
 
 
@@ -334,6 +458,58 @@ inline void WorkerPool<WorkerTaskType>::emplace(WorkerTaskType&& task) noexcept
 {
     std::lock_guard<utils::SpinLock> lock{mPushLock};
     mTasks.emplace(std::forward<WorkerTaskType>(task));
+    _record_push(1);
+}
+
+
+
+/*-------------------------------------
+ * Push a range of tasks (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+inline void WorkerPool<WorkerTaskType>::push_range(IterType first, IterType last) noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    _record_push((std::size_t)mTasks.push_range(first, last));
+}
+
+
+
+/*-------------------------------------
+ * Push a range of tasks (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+inline void WorkerPool<WorkerTaskType>::emplace_bulk(IterType first, IterType last) noexcept
+{
+    push_range(std::make_move_iterator(first), std::make_move_iterator(last));
+}
+
+
+
+/*-------------------------------------
+ * Push a task and retrieve a future for its result.
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename Func>
+Future<std::invoke_result_t<const std::decay_t<Func>&>> WorkerPool<WorkerTaskType>::submit(Func&& func) noexcept
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&> result_type;
+    typedef std::decay_t<Func> func_type;
+
+    const Promise<result_type> promise;
+    Future<result_type> result = promise.get_future();
+
+    if (result.valid())
+    {
+        emplace(WorkerTaskType{[promise, fn = func_type{std::forward<Func>(func)}]()->void
+        {
+            promise.set_value_from(fn);
+        }});
+    }
+
+    return result;
 }
 
 
@@ -356,19 +532,36 @@ inline bool WorkerPool<WorkerTaskType>::ready() const noexcept
 template <class WorkerTaskType>
 void WorkerPool<WorkerTaskType>::flush() noexcept
 {
-    bool haveTasks;
+    std::size_t numTasks;
 
     {
         std::lock_guard<utils::SpinLock> pushLock{mPushLock};
-        haveTasks = !mTasks.empty();
+        numTasks = (std::size_t)mTasks.size();
     }
 
     // Don't bother waking up the thread if there's nothing to do.
-    if (haveTasks)
+    if (numTasks)
     {
-        std::lock_guard<std::mutex> waitLock{mExecMtx};
-        mIsPaused.store(false, std::memory_order_release);
-        mExecCond.notify_all();
+        {
+            std::lock_guard<std::mutex> waitLock{mExecMtx};
+            mIsPaused.store(false, std::memory_order_release);
+
+            // Threads which wake up drain the whole queue, so there's no
+            // use waking more threads than there are tasks.
+            if (numTasks >= mThreads.size())
+            {
+                mExecCond.notify_all();
+            }
+            else
+            {
+                for (std::size_t i = 0; i < numTasks; ++i)
+                {
+                    mExecCond.notify_one();
+                }
+            }
+        }
+
+        mWakeSignal.notify();
     }
 }
 
@@ -425,6 +618,108 @@ inline void WorkerPool<WorkerTaskType>::busy_waiting(bool useBusyWait) noexcept
 
 
 
+/*-------------------------------------
+ * Determine if adaptive waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkerPool<WorkerTaskType>::adaptive_waiting() const noexcept
+{
+    return mAdaptiveWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle adaptive waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkerPool<WorkerTaskType>::adaptive_waiting(bool useAdaptiveWait) noexcept
+{
+    mAdaptiveWait.store(useAdaptiveWait, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Topology-aware placement
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkerPool<WorkerTaskType>::placement(CpuPlacement policy, int numaNode) noexcept
+{
+    mPlacement = policy;
+    mPlacementNode = numaNode;
+
+    return place_threads(mThreads, policy, numaNode);
+}
+
+
+
+/*-------------------------------------
+ * Current placement policy
+-------------------------------------*/
+template <class WorkerTaskType>
+inline CpuPlacement WorkerPool<WorkerTaskType>::placement() const noexcept
+{
+    return mPlacement;
+}
+
+
+
+/*-------------------------------------
+ * NUMA node for placement
+-------------------------------------*/
+template <class WorkerTaskType>
+inline int WorkerPool<WorkerTaskType>::placement_node() const noexcept
+{
+    return mPlacementNode;
+}
+
+
+
+/*-------------------------------------
+ * Determine if metrics are collected
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkerPool<WorkerTaskType>::collect_metrics() const noexcept
+{
+    return mMetrics.enabled();
+}
+
+
+
+/*-------------------------------------
+ * Toggle metrics collection
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkerPool<WorkerTaskType>::collect_metrics(bool enableMetrics) noexcept
+{
+    mMetrics.enabled(enableMetrics);
+}
+
+
+
+/*-------------------------------------
+ * Metrics snapshot
+-------------------------------------*/
+template <class WorkerTaskType>
+inline WorkerPoolStats WorkerPool<WorkerTaskType>::metrics() const noexcept
+{
+    return mMetrics.snapshot();
+}
+
+
+
+/*-------------------------------------
+ * Reset metrics
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkerPool<WorkerTaskType>::reset_metrics() noexcept
+{
+    mMetrics.reset();
+}
+
+
+
 /*-------------------------------------
  * Thread count
 -------------------------------------*/
@@ -445,12 +740,7 @@ size_t WorkerPool<WorkerTaskType>::concurrency(size_t inNumThreads) noexcept
     }
 
     mTasks.reserve(2);
-    mThreads.reserve(inNumThreads);
-
-    for (std::size_t threadId = 0; threadId < inNumThreads; ++threadId)
-    {
-        mThreads.emplace_back(&WorkerPool::thread_loop, this);
-    }
+    start_threads(inNumThreads);
 
     return inNumThreads;
 }
@@ -34,16 +34,27 @@ void WorkerThread<WorkerTaskType>::execute_tasks() noexcept
         task();
     }
 
-    // Pause the current thread again.
+    // Pause the current thread again, unless more tasks were pushed (and
+    // possibly flushed) since the queue was last checked.
     #ifndef LS_UTILS_USE_WINDOWS_THREADS
         mWaitMtx.lock();
-        mIsPaused.store(true, std::memory_order_release);
-        mWaitCond.notify_all();
+        mPushLock.lock();
+        if (mTasks.empty())
+        {
+            mIsPaused.store(true, std::memory_order_release);
+            mWaitCond.notify_all();
+        }
+        mPushLock.unlock();
         mWaitMtx.unlock();
     #else
         EnterCriticalSection(&mWaitMtx);
-        mIsPaused.store(true, std::memory_order_release);
-        WakeConditionVariable(&mWaitCond);
+        mPushLock.lock();
+        if (mTasks.empty())
+        {
+            mIsPaused.store(true, std::memory_order_release);
+            WakeConditionVariable(&mWaitCond);
+        }
+        mPushLock.unlock();
         LeaveCriticalSection(&mWaitMtx);
     #endif
 }
@@ -56,8 +67,13 @@ void WorkerThread<WorkerTaskType>::execute_tasks() noexcept
 template <class WorkerTaskType>
 void WorkerThread<WorkerTaskType>::thread_loop() noexcept
 {
+    WorkerIdleStrategy idleStrategy{};
+
     while (true)
     {
+        // Read before checking for tasks so a flush() in between isn't lost
+        const uint32_t wakeSeq = this->mWakeSignal.sequence();
+
         this->mPushLock.lock();
         bool amDone = this->mTasks.capacity() == 0;
         bool outOfTasks = this->mTasks.empty();
@@ -76,6 +92,11 @@ void WorkerThread<WorkerTaskType>::thread_loop() noexcept
             {
                 continue;
             }
+            else if (this->mAdaptiveWait.load(std::memory_order_acquire))
+            {
+                idleStrategy.wait(this->mWakeSignal, wakeSeq);
+                continue;
+            }
             else
             {
                 #ifndef LS_UTILS_USE_WINDOWS_THREADS
@@ -123,6 +144,7 @@ WorkerThread<WorkerTaskType>::~WorkerThread() noexcept
         this->mIsPaused.store(false, std::memory_order_release);
         this->mExecCond.notify_all();
         this->mExecMtx.unlock();
+        this->mWakeSignal.notify();
         this->mThread.join();
 
     #else
@@ -130,6 +152,7 @@ WorkerThread<WorkerTaskType>::~WorkerThread() noexcept
         this->mIsPaused.store(false, std::memory_order_release);
         WakeConditionVariable(&mExecCond);
         LeaveCriticalSection(&mExecMtx);
+        this->mWakeSignal.notify();
 
         this->mThread.join();
         DeleteCriticalSection(&mExecMtx);
@@ -145,7 +168,9 @@ WorkerThread<WorkerTaskType>::~WorkerThread() noexcept
 template <class WorkerTaskType>
 WorkerThread<WorkerTaskType>::WorkerThread(unsigned affinity) noexcept :
     mBusyWait{false},
+    mAdaptiveWait{false},
     mIsPaused{true},
+    mWakeSignal{},
     mPushLock{},
     mTasks{2},
     #ifndef LS_UTILS_USE_WINDOWS_THREADS
@@ -213,6 +238,7 @@ WorkerThread<WorkerTaskType>& WorkerThread<WorkerTaskType>::operator=(const Work
     this->wait();
 
     mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
     mIsPaused.store(true, std::memory_order_release);
     mTasks = w.mTasks;
 
@@ -238,6 +264,9 @@ WorkerThread<WorkerTaskType>& WorkerThread<WorkerTaskType>::operator=(WorkerThre
     mBusyWait.store(w.mBusyWait.load(std::memory_order_consume), std::memory_order_release);
     w.mBusyWait.store(false, std::memory_order_release);
 
+    mAdaptiveWait.store(w.mAdaptiveWait.load(std::memory_order_consume), std::memory_order_release);
+    w.mAdaptiveWait.store(false, std::memory_order_release);
+
     mIsPaused.store(true, std::memory_order_release);
     mTasks = std::move(w.mTasks);
 
@@ -332,6 +361,57 @@ inline void WorkerThread<WorkerTaskType>::emplace(WorkerTaskType&& task) noexcep
 
 
 
+/*-------------------------------------
+ * Push a range of tasks (copy).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+inline void WorkerThread<WorkerTaskType>::push_range(IterType first, IterType last) noexcept
+{
+    std::lock_guard<utils::SpinLock> lock{mPushLock};
+    mTasks.push_range(first, last);
+}
+
+
+
+/*-------------------------------------
+ * Push a range of tasks (move).
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename IterType>
+inline void WorkerThread<WorkerTaskType>::emplace_bulk(IterType first, IterType last) noexcept
+{
+    push_range(std::make_move_iterator(first), std::make_move_iterator(last));
+}
+
+
+
+/*-------------------------------------
+ * Push a task and retrieve a future for its result.
+-------------------------------------*/
+template <class WorkerTaskType>
+template <typename Func>
+Future<std::invoke_result_t<const std::decay_t<Func>&>> WorkerThread<WorkerTaskType>::submit(Func&& func) noexcept
+{
+    typedef std::invoke_result_t<const std::decay_t<Func>&> result_type;
+    typedef std::decay_t<Func> func_type;
+
+    const Promise<result_type> promise;
+    Future<result_type> result = promise.get_future();
+
+    if (result.valid())
+    {
+        emplace(WorkerTaskType{[promise, fn = func_type{std::forward<Func>(func)}]()->void
+        {
+            promise.set_value_from(fn);
+        }});
+    }
+
+    return result;
+}
+
+
+
 /*-------------------------------------
  * Check if the thread has finished all tasks and can be flushed.
 -------------------------------------*/
@@ -368,6 +448,8 @@ void WorkerThread<WorkerTaskType>::flush() noexcept
             WakeConditionVariable(&mExecCond);
             LeaveCriticalSection(&mExecMtx);
         #endif
+
+        this->mWakeSignal.notify();
     }
 }
 
@@ -435,6 +517,39 @@ inline void WorkerThread<WorkerTaskType>::busy_waiting(bool useBusyWait) noexcep
 
 
 
+/*-------------------------------------
+ * Determine if adaptive waiting is enabled
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkerThread<WorkerTaskType>::adaptive_waiting() const noexcept
+{
+    return mAdaptiveWait.load(std::memory_order_acquire);
+}
+
+
+
+/*-------------------------------------
+ * Toggle adaptive waiting
+-------------------------------------*/
+template <class WorkerTaskType>
+inline void WorkerThread<WorkerTaskType>::adaptive_waiting(bool useAdaptiveWait) noexcept
+{
+    mAdaptiveWait.store(useAdaptiveWait, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Topology-aware placement
+-------------------------------------*/
+template <class WorkerTaskType>
+inline bool WorkerThread<WorkerTaskType>::placement(CpuPlacement policy, size_t threadIndex, int numaNode) noexcept
+{
+    return place_thread(mThread, policy, threadIndex, numaNode);
+}
+
+
+
 /*-------------------------------------
  * Thread count
 -------------------------------------*/
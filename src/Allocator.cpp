@@ -131,6 +131,17 @@ void* IAllocator::reallocate(void* p, size_type numNewBytes, size_type numPrevBy
 
 
 
+/*-------------------------------------
+ * Free-list statistics
+-------------------------------------*/
+bool IAllocator::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    outStats = FreeListStats{0, 0, 0};
+    return false;
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * Allocator
 -----------------------------------------------------------------------------*/
@@ -0,0 +1,857 @@
+/*
+ * File:   AllocatorStats.cpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 2:20 PM
+ */
+
+#include <bit> // std::bit_width
+#include <chrono>
+
+#include "lightsky/utils/AllocatorStats.hpp"
+#include "lightsky/utils/Copy.h"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+namespace
+{
+
+/*-------------------------------------
+ * Monotonic timestamp
+-------------------------------------*/
+inline unsigned long long _timestamp_ns() noexcept
+{
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+/*-------------------------------------
+ * Write a LEB128 varint
+-------------------------------------*/
+inline unsigned char* _write_varint(unsigned char* pOut, unsigned long long value) noexcept
+{
+    while (value >= 0x80ull)
+    {
+        *pOut++ = (unsigned char)(value | 0x80ull);
+        value >>= 7ull;
+    }
+
+    *pOut++ = (unsigned char)value;
+    return pOut;
+}
+
+
+
+/*-------------------------------------
+ * Read a LEB128 varint
+-------------------------------------*/
+inline const unsigned char* _read_varint(const unsigned char* pIn, const unsigned char* pEnd, unsigned long long& outValue) noexcept
+{
+    unsigned long long value = 0;
+
+    for (unsigned shift = 0; pIn < pEnd && shift < 64u; shift += 7u)
+    {
+        const unsigned char byte = *pIn++;
+        value |= (unsigned long long)(byte & 0x7Fu) << shift;
+
+        if (!(byte & 0x80u))
+        {
+            outValue = value;
+            return pIn;
+        }
+    }
+
+    return nullptr;
+}
+
+
+
+constexpr unsigned char binary_magic[4] = {'L', 'S', 'A', 'S'};
+constexpr unsigned char binary_version = 1;
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * AllocatorStatsSnapshot
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Size bucket lookup
+-------------------------------------*/
+AllocatorStatsSnapshot::size_type AllocatorStatsSnapshot::size_bucket(size_type numBytes) noexcept
+{
+    if (numBytes <= 16ull)
+    {
+        return 0;
+    }
+
+    const size_type bucket = (size_type)std::bit_width(numBytes - 1ull) - 4ull;
+    return (bucket < num_size_buckets) ? bucket : (num_size_buckets - 1ull);
+}
+
+
+
+/*-------------------------------------
+ * Fragmentation ratio
+-------------------------------------*/
+double AllocatorStatsSnapshot::fragmentation() const noexcept
+{
+    if (!hasFreeList || !freeList.numFreeBytes || freeList.largestFreeBlock >= freeList.numFreeBytes)
+    {
+        return 0.0;
+    }
+
+    return 1.0 - ((double)freeList.largestFreeBlock / (double)freeList.numFreeBytes);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * StatsMemorySource
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+StatsMemorySource::~StatsMemorySource() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+StatsMemorySource::StatsMemorySource(MemorySource& src) noexcept :
+    MemorySource{},
+    mSource{&src},
+    mNumRefills{0},
+    mNumRefillBytes{0},
+    mRefillTimeNs{0},
+    mNumReleases{0},
+    mNumReleaseBytes{0}
+{}
+
+
+
+/*-------------------------------------
+ * Copy counters into a snapshot
+-------------------------------------*/
+void StatsMemorySource::fill_snapshot(AllocatorStatsSnapshot& outStats) const noexcept
+{
+    outStats.numRefills = mNumRefills.load(std::memory_order_relaxed);
+    outStats.numRefillBytes = mNumRefillBytes.load(std::memory_order_relaxed);
+    outStats.refillTimeNs = mRefillTimeNs.load(std::memory_order_relaxed);
+    outStats.numReleases = mNumReleases.load(std::memory_order_relaxed);
+    outStats.numReleaseBytes = mNumReleaseBytes.load(std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+void* StatsMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    size_type numAllocated = 0;
+    const size_type startTime = _timestamp_ns();
+    void* const p = mSource->allocate(numBytes, &numAllocated);
+    const size_type endTime = _timestamp_ns();
+
+    mRefillTimeNs.fetch_add(endTime - startTime, std::memory_order_relaxed);
+
+    if (p)
+    {
+        mNumRefills.fetch_add(1, std::memory_order_relaxed);
+        mNumRefillBytes.fetch_add(numAllocated, std::memory_order_relaxed);
+    }
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = numAllocated;
+    }
+
+    return p;
+}
+
+
+
+/*-------------------------------------
+ * Allocate (aligned)
+-------------------------------------*/
+void* StatsMemorySource::allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes) noexcept
+{
+    size_type numAllocated = 0;
+    const size_type startTime = _timestamp_ns();
+    void* const p = mSource->allocate_aligned(numBytes, alignment, &numAllocated);
+    const size_type endTime = _timestamp_ns();
+
+    mRefillTimeNs.fetch_add(endTime - startTime, std::memory_order_relaxed);
+
+    if (p)
+    {
+        mNumRefills.fetch_add(1, std::memory_order_relaxed);
+        mNumRefillBytes.fetch_add(numAllocated, std::memory_order_relaxed);
+    }
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = numAllocated;
+    }
+
+    return p;
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void StatsMemorySource::free(void* pData) noexcept
+{
+    if (pData)
+    {
+        mNumReleases.fetch_add(1, std::memory_order_relaxed);
+        mSource->free(pData);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void StatsMemorySource::free(void* pData, size_type numBytes) noexcept
+{
+    if (pData)
+    {
+        mNumReleases.fetch_add(1, std::memory_order_relaxed);
+        mNumReleaseBytes.fetch_add(numBytes, std::memory_order_relaxed);
+        mSource->free(pData, numBytes);
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * StatsAllocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Record a successful allocation
+-------------------------------------*/
+void* StatsAllocator::_track_allocation(void* pRaw, size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    if (mUseSizeHeaders)
+    {
+        *static_cast<size_type*>(pRaw) = numBytes;
+    }
+
+    const size_type bytesInUse = mBytesInUse.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    size_type peak = mPeakBytesInUse.load(std::memory_order_relaxed);
+
+    while (peak < bytesInUse && !mPeakBytesInUse.compare_exchange_weak(peak, bytesInUse, std::memory_order_relaxed))
+    {
+    }
+
+    mNumAllocations.fetch_add(1, std::memory_order_relaxed);
+    mSizeBuckets[AllocatorStatsSnapshot::size_bucket(numBytes)].fetch_add(1, std::memory_order_relaxed);
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = numBytes;
+    }
+
+    return mUseSizeHeaders ? (static_cast<char*>(pRaw) + header_size) : pRaw;
+}
+
+
+
+/*-------------------------------------
+ * Record a free
+-------------------------------------*/
+inline void StatsAllocator::_track_free(size_type numBytes) noexcept
+{
+    mBytesInUse.fetch_sub(numBytes, std::memory_order_relaxed);
+    mNumFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Get the memory source (const)
+-------------------------------------*/
+const MemorySource& StatsAllocator::memory_source() const noexcept
+{
+    return *mAllocator;
+}
+
+
+
+/*-------------------------------------
+ * Get the memory source
+-------------------------------------*/
+MemorySource& StatsAllocator::memory_source() noexcept
+{
+    return *mAllocator;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+StatsAllocator::~StatsAllocator() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+StatsAllocator::StatsAllocator(IAllocator& allocator, StatsMemorySource* pRefillSource, bool useSizeHeaders) noexcept :
+    IAllocator{},
+    mAllocator{&allocator},
+    mRefillSource{pRefillSource},
+    mUseSizeHeaders{useSizeHeaders},
+    mBytesInUse{0},
+    mPeakBytesInUse{0},
+    mNumAllocations{0},
+    mNumFrees{0},
+    mNumFailedAllocations{0},
+    mSizeBuckets{}
+{}
+
+
+
+/*-------------------------------------
+ * Gather statistics
+-------------------------------------*/
+AllocatorStatsSnapshot StatsAllocator::snapshot() const noexcept
+{
+    AllocatorStatsSnapshot stats;
+    fast_memset(&stats, 0, sizeof(AllocatorStatsSnapshot));
+
+    stats.timestampNs = _timestamp_ns();
+    stats.bytesInUse = mBytesInUse.load(std::memory_order_relaxed);
+    stats.peakBytesInUse = mPeakBytesInUse.load(std::memory_order_relaxed);
+    stats.numAllocations = mNumAllocations.load(std::memory_order_relaxed);
+    stats.numFrees = mNumFrees.load(std::memory_order_relaxed);
+    stats.numFailedAllocations = mNumFailedAllocations.load(std::memory_order_relaxed);
+
+    for (size_type i = 0; i < AllocatorStatsSnapshot::num_size_buckets; ++i)
+    {
+        stats.sizeBuckets[i] = mSizeBuckets[i].load(std::memory_order_relaxed);
+    }
+
+    if (mRefillSource)
+    {
+        mRefillSource->fill_snapshot(stats);
+    }
+
+    stats.hasFreeList = mAllocator->free_list_stats(stats.freeList);
+
+    return stats;
+}
+
+
+
+/*-------------------------------------
+ * Reset peak usage
+-------------------------------------*/
+void StatsAllocator::reset_peak() noexcept
+{
+    mPeakBytesInUse.store(mBytesInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+void* StatsAllocator::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    const size_type headerBytes = mUseSizeHeaders ? (size_type)header_size : (size_type)0;
+    void* const pRaw = (numBytes && numBytes <= ~(size_type)0 - headerBytes) ? mAllocator->allocate(numBytes + headerBytes) : nullptr;
+    if (!pRaw)
+    {
+        mNumFailedAllocations.fetch_add(numBytes ? 1 : 0, std::memory_order_relaxed);
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    return _track_allocation(pRaw, numBytes, pOutNumBytes);
+}
+
+
+
+/*-------------------------------------
+ * Allocate and zero-initialize
+-------------------------------------*/
+void* StatsAllocator::allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes) noexcept
+{
+    if (!numElements || !numBytesPerElement || IAllocator::calloc_can_overflow(numElements, numBytesPerElement))
+    {
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    const size_type numBytes = numElements * numBytesPerElement;
+    void* const p = this->allocate(numBytes, pOutNumBytes);
+    if (p)
+    {
+        fast_memset(p, 0, numBytes);
+    }
+
+    return p;
+}
+
+
+
+/*-------------------------------------
+ * Reallocate
+-------------------------------------*/
+void* StatsAllocator::reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes) noexcept
+{
+    // A previous size of 0 is treated as unknown
+    return this->reallocate(p, numNewBytes, 0, pOutNumBytes);
+}
+
+
+
+/*-------------------------------------
+ * Reallocate (sized)
+-------------------------------------*/
+void* StatsAllocator::reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!p)
+    {
+        return this->allocate(numNewBytes, pOutNumBytes);
+    }
+
+    if (!numNewBytes)
+    {
+        this->free(p);
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    void* pNewRaw;
+    size_type numOldBytes;
+
+    if (mUseSizeHeaders)
+    {
+        // Sizes are tracked in the header, which lets the wrapped allocator
+        // preserve the contents even if it can't do so on its own.
+        void* const pRaw = static_cast<char*>(p) - header_size;
+        numOldBytes = *static_cast<size_type*>(pRaw);
+
+        pNewRaw = (numNewBytes <= ~(size_type)0 - header_size)
+            ? mAllocator->reallocate(pRaw, numNewBytes + header_size, numOldBytes + header_size)
+            : nullptr;
+    }
+    else
+    {
+        numOldBytes = numPrevBytes;
+
+        pNewRaw = numPrevBytes
+            ? mAllocator->reallocate(p, numNewBytes, numPrevBytes)
+            : mAllocator->reallocate(p, numNewBytes);
+    }
+
+    if (!pNewRaw)
+    {
+        mNumFailedAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    _track_free(numOldBytes);
+    return _track_allocation(pNewRaw, numNewBytes, pOutNumBytes);
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void StatsAllocator::free(void* p) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+
+    if (!mUseSizeHeaders)
+    {
+        // Counted, but the number of bytes in use can't be updated
+        _track_free(0);
+        mAllocator->free(p);
+        return;
+    }
+
+    void* const pRaw = static_cast<char*>(p) - header_size;
+    const size_type numBytes = *static_cast<size_type*>(pRaw);
+
+    _track_free(numBytes);
+    mAllocator->free(pRaw, numBytes + header_size);
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void StatsAllocator::free(void* p, size_type n) noexcept
+{
+    if (!p || mUseSizeHeaders)
+    {
+        this->free(p);
+        return;
+    }
+
+    _track_free(n);
+    mAllocator->free(p, n);
+}
+
+
+
+/*-------------------------------------
+ * Forward free-list statistics
+-------------------------------------*/
+bool StatsAllocator::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    return mAllocator->free_list_stats(outStats);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * AllocatorStatsHistory
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AllocatorStatsHistory::AllocatorStatsHistory(size_type maxSnapshots, size_type intervalNs) noexcept :
+    mSnapshots{make_unique_array<AllocatorStatsSnapshot>(maxSnapshots ? maxSnapshots : 1ull)},
+    mCapacity{mSnapshots ? (maxSnapshots ? maxSnapshots : 1ull) : 0ull},
+    mCount{0},
+    mNext{0},
+    mIntervalNs{intervalNs},
+    mLastTimestampNs{0}
+{}
+
+
+
+/*-------------------------------------
+ * Periodic snapshots
+-------------------------------------*/
+bool AllocatorStatsHistory::poll(const StatsAllocator& allocator) noexcept
+{
+    const size_type now = _timestamp_ns();
+    if (mCount && (now - mLastTimestampNs) < mIntervalNs)
+    {
+        return false;
+    }
+
+    record(allocator.snapshot());
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Record a snapshot
+-------------------------------------*/
+void AllocatorStatsHistory::record(const AllocatorStatsSnapshot& snapshot) noexcept
+{
+    if (!mCapacity)
+    {
+        return;
+    }
+
+    mSnapshots[mNext] = snapshot;
+    mNext = (mNext + 1ull) % mCapacity;
+    mLastTimestampNs = snapshot.timestampNs;
+
+    if (mCount < mCapacity)
+    {
+        ++mCount;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Number of snapshots
+-------------------------------------*/
+AllocatorStatsHistory::size_type AllocatorStatsHistory::size() const noexcept
+{
+    return mCount;
+}
+
+
+
+/*-------------------------------------
+ * Maximum number of snapshots
+-------------------------------------*/
+AllocatorStatsHistory::size_type AllocatorStatsHistory::capacity() const noexcept
+{
+    return mCapacity;
+}
+
+
+
+/*-------------------------------------
+ * Snapshot lookup
+-------------------------------------*/
+const AllocatorStatsSnapshot& AllocatorStatsHistory::operator[](size_type index) const noexcept
+{
+    const size_type oldest = (mCount < mCapacity) ? 0ull : mNext;
+    return mSnapshots[(oldest + index) % mCapacity];
+}
+
+
+
+/*-------------------------------------
+ * Remove all snapshots
+-------------------------------------*/
+void AllocatorStatsHistory::clear() noexcept
+{
+    mCount = 0;
+    mNext = 0;
+    mLastTimestampNs = 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Serialization
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Binary encoding
+-------------------------------------*/
+unsigned long long allocator_stats_to_binary(const AllocatorStatsSnapshot& stats, unsigned char* pOut, unsigned long long maxBytes) noexcept
+{
+    // Encode into a scratch buffer first so a short output buffer is never
+    // partially written.
+    unsigned char buffer[allocator_stats_max_binary_size()];
+    unsigned char* p = buffer;
+
+    for (unsigned char c : binary_magic)
+    {
+        *p++ = c;
+    }
+
+    *p++ = binary_version;
+    *p++ = stats.hasFreeList ? 1u : 0u;
+
+    p = _write_varint(p, stats.timestampNs);
+    p = _write_varint(p, stats.bytesInUse);
+    p = _write_varint(p, stats.peakBytesInUse);
+    p = _write_varint(p, stats.numAllocations);
+    p = _write_varint(p, stats.numFrees);
+    p = _write_varint(p, stats.numFailedAllocations);
+
+    for (unsigned long long bucket : stats.sizeBuckets)
+    {
+        p = _write_varint(p, bucket);
+    }
+
+    p = _write_varint(p, stats.numRefills);
+    p = _write_varint(p, stats.numRefillBytes);
+    p = _write_varint(p, stats.refillTimeNs);
+    p = _write_varint(p, stats.numReleases);
+    p = _write_varint(p, stats.numReleaseBytes);
+    p = _write_varint(p, stats.freeList.numFreeBlocks);
+    p = _write_varint(p, stats.freeList.numFreeBytes);
+    p = _write_varint(p, stats.freeList.largestFreeBlock);
+
+    const unsigned long long numBytes = (unsigned long long)(p - buffer);
+    if (!pOut || numBytes > maxBytes)
+    {
+        return 0;
+    }
+
+    fast_memcpy(pOut, buffer, numBytes);
+    return numBytes;
+}
+
+
+
+/*-------------------------------------
+ * Binary decoding
+-------------------------------------*/
+unsigned long long allocator_stats_from_binary(const unsigned char* pIn, unsigned long long numBytes, AllocatorStatsSnapshot& outStats) noexcept
+{
+    if (!pIn || numBytes < sizeof(binary_magic) + 2ull)
+    {
+        return 0;
+    }
+
+    for (unsigned i = 0; i < sizeof(binary_magic); ++i)
+    {
+        if (pIn[i] != binary_magic[i])
+        {
+            return 0;
+        }
+    }
+
+    if (pIn[4] != binary_version)
+    {
+        return 0;
+    }
+
+    AllocatorStatsSnapshot stats;
+    stats.hasFreeList = pIn[5] != 0;
+
+    unsigned long long* const pFields[] = {
+        &stats.timestampNs,
+        &stats.bytesInUse,
+        &stats.peakBytesInUse,
+        &stats.numAllocations,
+        &stats.numFrees,
+        &stats.numFailedAllocations
+    };
+
+    unsigned long long* const pTrailingFields[] = {
+        &stats.numRefills,
+        &stats.numRefillBytes,
+        &stats.refillTimeNs,
+        &stats.numReleases,
+        &stats.numReleaseBytes,
+        &stats.freeList.numFreeBlocks,
+        &stats.freeList.numFreeBytes,
+        &stats.freeList.largestFreeBlock
+    };
+
+    const unsigned char* p = pIn + sizeof(binary_magic) + 2u;
+    const unsigned char* const pEnd = pIn + numBytes;
+
+    for (unsigned long long* pField : pFields)
+    {
+        p = p ? _read_varint(p, pEnd, *pField) : nullptr;
+    }
+
+    for (unsigned long long& bucket : stats.sizeBuckets)
+    {
+        p = p ? _read_varint(p, pEnd, bucket) : nullptr;
+    }
+
+    for (unsigned long long* pField : pTrailingFields)
+    {
+        p = p ? _read_varint(p, pEnd, *pField) : nullptr;
+    }
+
+    if (!p)
+    {
+        return 0;
+    }
+
+    outStats = stats;
+    return (unsigned long long)(p - pIn);
+}
+
+
+
+/*-------------------------------------
+ * JSON encoding
+-------------------------------------*/
+std::string allocator_stats_to_json(const AllocatorStatsSnapshot& stats) noexcept
+{
+    std::string json;
+    json.reserve(1024);
+
+    json += "{\"timestamp_ns\":";
+    json += std::to_string(stats.timestampNs);
+    json += ",\"bytes_in_use\":";
+    json += std::to_string(stats.bytesInUse);
+    json += ",\"peak_bytes_in_use\":";
+    json += std::to_string(stats.peakBytesInUse);
+    json += ",\"num_allocations\":";
+    json += std::to_string(stats.numAllocations);
+    json += ",\"num_frees\":";
+    json += std::to_string(stats.numFrees);
+    json += ",\"num_failed_allocations\":";
+    json += std::to_string(stats.numFailedAllocations);
+
+    json += ",\"size_buckets\":[";
+    for (unsigned long long i = 0; i < AllocatorStatsSnapshot::num_size_buckets; ++i)
+    {
+        json += (i ? "," : "");
+        json += std::to_string(stats.sizeBuckets[i]);
+    }
+
+    json += "],\"num_refills\":";
+    json += std::to_string(stats.numRefills);
+    json += ",\"num_refill_bytes\":";
+    json += std::to_string(stats.numRefillBytes);
+    json += ",\"refill_time_ns\":";
+    json += std::to_string(stats.refillTimeNs);
+    json += ",\"num_releases\":";
+    json += std::to_string(stats.numReleases);
+    json += ",\"num_release_bytes\":";
+    json += std::to_string(stats.numReleaseBytes);
+
+    if (stats.hasFreeList)
+    {
+        json += ",\"free_list\":{\"num_free_blocks\":";
+        json += std::to_string(stats.freeList.numFreeBlocks);
+        json += ",\"num_free_bytes\":";
+        json += std::to_string(stats.freeList.numFreeBytes);
+        json += ",\"largest_free_block\":";
+        json += std::to_string(stats.freeList.largestFreeBlock);
+        json += ",\"fragmentation\":";
+        json += std::to_string(stats.fragmentation());
+        json += '}';
+    }
+
+    json += '}';
+    return json;
+}
+
+
+
+/*-------------------------------------
+ * JSON encoding (history)
+-------------------------------------*/
+std::string allocator_stats_to_json(const AllocatorStatsHistory& history) noexcept
+{
+    std::string json{"["};
+
+    for (unsigned long long i = 0; i < history.size(); ++i)
+    {
+        json += (i ? "," : "");
+        json += allocator_stats_to_json(history[i]);
+    }
+
+    json += ']';
+    return json;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -4,10 +4,23 @@
  * Created on November 02, 2025, at 1:49 p.m.
  */
 
+#include <bit> // std::bit_width
+#include <climits> // INT_MAX
+
 #include "lightsky/utils/Barrier.hpp"
+#include "lightsky/utils/Futex.hpp" // LS_UTILS_USE_LINUX_FUTEX
 
 #include "lightsky/setup/CPU.h"
 
+#if LS_UTILS_USE_LINUX_FUTEX
+    extern "C"
+    {
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    }
+#endif
+
 
 
 namespace ls
@@ -15,6 +28,53 @@ namespace ls
 namespace utils
 {
 
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Sleep while a word holds an expected value
+-------------------------------------*/
+inline void _barrier_sleep(std::atomic_uint32_t& word, uint32_t expected) noexcept
+{
+    #if LS_UTILS_USE_LINUX_FUTEX
+        syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+    #else
+        word.wait(expected, std::memory_order_acquire);
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Wake all threads sleeping on a word
+-------------------------------------*/
+inline void _barrier_wake_all(std::atomic_uint32_t& word) noexcept
+{
+    #if LS_UTILS_USE_LINUX_FUTEX
+        syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    #else
+        word.notify_all();
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Wrap-safe episode comparison
+-------------------------------------*/
+inline bool _episode_reached(uint32_t signaled, uint32_t episode) noexcept
+{
+    return (int32_t)(signaled - episode) >= 0;
+}
+
+} // end anonymous namespace
+
+
+
+
 /*-----------------------------------------------------------------------------
  * Common Barrier
 -----------------------------------------------------------------------------*/
@@ -59,6 +119,162 @@ void Barrier::wait() noexcept
 
 
 
+/*-----------------------------------------------------------------------------
+ * Sense-Reversing Barrier
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SenseBarrier::SenseBarrier(uint32_t numThreads, uint32_t spinCount) noexcept :
+    mBarrierCount{numThreads ? numThreads : 1u},
+    mPhase{0},
+    mNumSleepers{0},
+    mThreadCount{numThreads ? numThreads : 1u},
+    mSpinCount{spinCount}
+{}
+
+
+
+/*-------------------------------------
+ * Wait until all required threads have arrived
+-------------------------------------*/
+bool SenseBarrier::wait() noexcept
+{
+    // No thread can leave the current phase until this one arrives
+    const uint32_t phase = mPhase.load(std::memory_order_acquire);
+
+    if (mBarrierCount.fetch_sub(1, std::memory_order_acq_rel) == 1u)
+    {
+        // Re-arm the counter before any thread can see the new phase
+        mBarrierCount.store(mThreadCount, std::memory_order_relaxed);
+        mPhase.store(phase+1u, std::memory_order_seq_cst);
+
+        if (mNumSleepers.load(std::memory_order_seq_cst))
+        {
+            _barrier_wake_all(mPhase);
+        }
+
+        return true;
+    }
+
+    for (uint32_t i = 0; i < mSpinCount; ++i)
+    {
+        if (mPhase.load(std::memory_order_acquire) != phase)
+        {
+            return false;
+        }
+
+        ls::setup::cpu_yield();
+    }
+
+    mNumSleepers.fetch_add(1, std::memory_order_seq_cst);
+
+    while (mPhase.load(std::memory_order_seq_cst) == phase)
+    {
+        _barrier_sleep(mPhase, phase);
+    }
+
+    mNumSleepers.fetch_sub(1, std::memory_order_relaxed);
+
+    return false;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Dissemination Barrier
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+DisseminationBarrier::DisseminationBarrier(uint32_t numThreads, uint32_t spinCount) noexcept :
+    mThreadCount{numThreads},
+    mNumRounds{numThreads > 1u ? (uint32_t)std::bit_width(numThreads-1u) : 0u},
+    mSpinCount{spinCount},
+    mNodes{numThreads ? utils::make_unique_array<Node>(numThreads) : utils::UniqueArray<Node>{nullptr}}
+{
+    for (uint32_t t = 0; mNodes && t < mThreadCount; ++t)
+    {
+        Node& node = mNodes[t];
+
+        for (uint32_t r = 0; r < MAX_ROUNDS; ++r)
+        {
+            node.flags[r].store(0, std::memory_order_relaxed);
+        }
+
+        node.sleeping.store(0, std::memory_order_relaxed);
+        node.episode = 0;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Wait for a partner's signal in one round
+-------------------------------------*/
+void DisseminationBarrier::_wait_for_signal(Node& node, uint32_t round, uint32_t episode) noexcept
+{
+    std::atomic_uint32_t& flag = node.flags[round];
+
+    for (uint32_t i = 0; i < mSpinCount; ++i)
+    {
+        if (_episode_reached(flag.load(std::memory_order_acquire), episode))
+        {
+            return;
+        }
+
+        ls::setup::cpu_yield();
+    }
+
+    // Pairs with the signaling thread storing its flag before checking if
+    // this thread is asleep.
+    node.sleeping.store(1, std::memory_order_seq_cst);
+
+    uint32_t signaled;
+    while (!_episode_reached(signaled = flag.load(std::memory_order_seq_cst), episode))
+    {
+        _barrier_sleep(flag, signaled);
+    }
+
+    node.sleeping.store(0, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Wait until all required threads have arrived
+-------------------------------------*/
+void DisseminationBarrier::wait(uint32_t threadId) noexcept
+{
+    if (threadId >= mThreadCount || !mNodes)
+    {
+        return;
+    }
+
+    Node& node = mNodes[threadId];
+    const uint32_t episode = ++node.episode;
+
+    for (uint32_t round = 0; round < mNumRounds; ++round)
+    {
+        // Each thread is signaled by the same partner in a given round, so
+        // episodes arrive in order.
+        const uint64_t partnerId = ((uint64_t)threadId + (1ull << round)) % (uint64_t)mThreadCount;
+        Node& partner = mNodes[partnerId];
+        std::atomic_uint32_t& partnerFlag = partner.flags[round];
+
+        partnerFlag.store(episode, std::memory_order_seq_cst);
+
+        if (partner.sleeping.load(std::memory_order_seq_cst))
+        {
+            _barrier_wake_all(partnerFlag);
+        }
+
+        _wait_for_signal(node, round, episode);
+    }
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * PThreads R/W Semaphore
 -----------------------------------------------------------------------------*/
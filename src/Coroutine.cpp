@@ -0,0 +1,149 @@
+/*
+ * File:   Coroutine.cpp
+ * Author: miles
+ * Created on October 18, 2026, at 11:05 a.m.
+ */
+
+#include "lightsky/utils/Coroutine.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * AsyncEvent Awaiter
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Add the coroutine to the wait list
+-------------------------------------*/
+bool AsyncEvent::Awaiter::await_suspend(std::coroutine_handle<> h) noexcept
+{
+    mHandle = h;
+
+    mEvent->mLock.lock();
+
+    if (mEvent->mIsSet.load(std::memory_order_acquire))
+    {
+        mEvent->mLock.unlock();
+        return false;
+    }
+
+    mNext = mEvent->mWaiters;
+    mEvent->mWaiters = this;
+    mEvent->mLock.unlock();
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * AsyncEvent
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Set the event and detach all waiters
+-------------------------------------*/
+AsyncEvent::Awaiter* AsyncEvent::_signal() noexcept
+{
+    Awaiter* pWaiters;
+
+    // Blocked threads are woken while holding the lock. wait() acquires the
+    // lock before returning, so nothing touches *this after it's destroyed.
+    mLock.lock();
+    mIsSet.store(1, std::memory_order_release);
+    mIsSet.notify_all();
+    pWaiters = mWaiters;
+    mWaiters = nullptr;
+    mLock.unlock();
+
+    // Waiters are pushed to the front of the list. Reverse it so coroutines
+    // resume in the order they suspended.
+    Awaiter* pOrdered = nullptr;
+    while (pWaiters)
+    {
+        Awaiter* const pNext = pWaiters->mNext;
+        pWaiters->mNext = pOrdered;
+        pOrdered = pWaiters;
+        pWaiters = pNext;
+    }
+
+    return pOrdered;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+AsyncEvent::~AsyncEvent() noexcept
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+AsyncEvent::AsyncEvent(bool initiallySet) noexcept :
+    mLock{},
+    mIsSet{initiallySet ? 1u : 0u},
+    mWaiters{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Set the event
+-------------------------------------*/
+void AsyncEvent::set() noexcept
+{
+    Awaiter* pWaiter = _signal();
+
+    while (pWaiter)
+    {
+        // Resuming a coroutine can destroy its awaiter
+        Awaiter* const pNext = pWaiter->mNext;
+        pWaiter->mHandle.resume();
+        pWaiter = pNext;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Reset the event
+-------------------------------------*/
+void AsyncEvent::reset() noexcept
+{
+    mLock.lock();
+    mIsSet.store(0, std::memory_order_release);
+    mLock.unlock();
+}
+
+
+
+/*-------------------------------------
+ * Block until set
+-------------------------------------*/
+void AsyncEvent::wait() const noexcept
+{
+    uint32_t isSet = mIsSet.load(std::memory_order_acquire);
+
+    while (!isSet)
+    {
+        mIsSet.wait(isSet, std::memory_order_acquire);
+        isSet = mIsSet.load(std::memory_order_acquire);
+    }
+
+    // Synchronize with a concurrent call to set()
+    mLock.lock();
+    mLock.unlock();
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,477 @@
+/*
+ * File:   CpuTopology.cpp
+ * Author: miles
+ * Created on October 19, 2026, at 4:10 p.m.
+ */
+
+#include <algorithm> // std::sort, std::stable_sort
+#include <cstdio> // fopen, fgets
+#include <cstdlib> // strtoul
+#include <string>
+#include <tuple> // std::tie
+
+#include "lightsky/setup/OS.h" // LS_OS_LINUX
+
+#include "lightsky/utils/CpuTopology.hpp"
+#include "lightsky/utils/WorkerThread.hpp" // set_thread_affinity()
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Read the first line of a sysfs file
+-------------------------------------*/
+bool _read_sysfs(const std::string& path, char* pLine, int maxLen) noexcept
+{
+    FILE* const pFile = std::fopen(path.c_str(), "r");
+    if (!pFile)
+    {
+        return false;
+    }
+
+    const bool ret = std::fgets(pLine, maxLen, pFile) != nullptr;
+    std::fclose(pFile);
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+ * Read an integer from a sysfs file
+-------------------------------------*/
+unsigned long _read_sysfs_uint(const std::string& path, unsigned long defaultVal) noexcept
+{
+    char line[64];
+    if (!_read_sysfs(path, line, sizeof(line)))
+    {
+        return defaultVal;
+    }
+
+    char* pEnd = nullptr;
+    const unsigned long ret = std::strtoul(line, &pEnd, 10);
+
+    return pEnd != line ? ret : defaultVal;
+}
+
+
+
+/*-------------------------------------
+ * Parse a CPU list, such as "0-3,8,10-11"
+-------------------------------------*/
+bool _parse_cpu_list(const char* pList, std::vector<unsigned>& outCpus) noexcept
+{
+    outCpus.clear();
+
+    while (*pList && *pList != '\n')
+    {
+        char* pEnd = nullptr;
+        const unsigned long first = std::strtoul(pList, &pEnd, 10);
+        if (pEnd == pList)
+        {
+            return false;
+        }
+
+        unsigned long last = first;
+        pList = pEnd;
+
+        if (*pList == '-')
+        {
+            ++pList;
+            last = std::strtoul(pList, &pEnd, 10);
+            if (pEnd == pList || last < first)
+            {
+                return false;
+            }
+
+            pList = pEnd;
+        }
+
+        for (unsigned long cpu = first; cpu <= last; ++cpu)
+        {
+            outCpus.push_back((unsigned)cpu);
+        }
+
+        if (*pList == ',')
+        {
+            ++pList;
+        }
+    }
+
+    return !outCpus.empty();
+}
+
+
+
+/*-------------------------------------
+ * Map a sparse key to a dense ID
+-------------------------------------*/
+unsigned _dense_id(std::vector<unsigned long long>& keys, unsigned long long key) noexcept
+{
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        if (keys[i] == key)
+        {
+            return (unsigned)i;
+        }
+    }
+
+    keys.push_back(key);
+    return (unsigned)(keys.size() - 1);
+}
+
+
+
+/*-------------------------------------
+ * Apply an affinity from a placement order
+-------------------------------------*/
+bool _place_thread(
+    const CpuTopology& topology,
+    const std::vector<unsigned>& order,
+    std::thread& t,
+    CpuPlacement policy,
+    std::size_t threadIndex,
+    int numaNode) noexcept
+{
+    if (policy == CpuPlacement::NUMA_NODE)
+    {
+        const unsigned numNodes = topology.num_numa_nodes() ? topology.num_numa_nodes() : 1u;
+        const int node = numaNode >= 0 ? numaNode : (int)(threadIndex % numNodes);
+        const std::vector<unsigned> cpus = topology.node_cpus(node);
+
+        return !cpus.empty() && set_thread_affinity(t, cpus.data(), cpus.size());
+    }
+
+    if (order.empty())
+    {
+        return false;
+    }
+
+    // No placement means any CPU
+    if (policy == CpuPlacement::NONE)
+    {
+        return set_thread_affinity(t, order.data(), order.size());
+    }
+
+    return set_thread_affinity(t, &order[threadIndex % order.size()], 1);
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * CpuTopology
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+CpuTopology::CpuTopology() noexcept :
+    mCpus{},
+    mNumCores{0},
+    mNumPackages{0},
+    mNumNodes{0},
+    mNumL2Caches{0},
+    mNumL3Caches{0}
+{}
+
+
+
+/*-------------------------------------
+ * System topology
+-------------------------------------*/
+const CpuTopology& CpuTopology::system() noexcept
+{
+    static const CpuTopology topology = []() noexcept->CpuTopology
+    {
+        CpuTopology ret{};
+        ret.load();
+        return ret;
+    }();
+
+    return topology;
+}
+
+
+
+/*-------------------------------------
+ * Read the topology from sysfs
+-------------------------------------*/
+bool CpuTopology::load(const char* sysfsRoot) noexcept
+{
+    #ifndef LS_OS_LINUX
+        (void)sysfsRoot;
+        load_flat(std::thread::hardware_concurrency());
+        return false;
+
+    #else
+        const std::string root{sysfsRoot};
+        char line[4096];
+        std::vector<unsigned> online;
+
+        if (!_read_sysfs(root + "/cpu/online", line, sizeof(line)) || !_parse_cpu_list(line, online))
+        {
+            load_flat(std::thread::hardware_concurrency());
+            return false;
+        }
+
+        // Memory-only NUMA nodes have no CPUs, so IDs are made dense below
+        std::vector<unsigned> cpuNodes(online.back() + 1u, 0u);
+        std::vector<unsigned> nodeList, nodeCpus;
+
+        if (_read_sysfs(root + "/node/online", line, sizeof(line)) && _parse_cpu_list(line, nodeList))
+        {
+            for (unsigned node : nodeList)
+            {
+                if (!_read_sysfs(root + "/node/node" + std::to_string(node) + "/cpulist", line, sizeof(line))
+                || !_parse_cpu_list(line, nodeCpus))
+                {
+                    continue;
+                }
+
+                for (unsigned cpu : nodeCpus)
+                {
+                    if (cpu < cpuNodes.size())
+                    {
+                        cpuNodes[cpu] = node;
+                    }
+                }
+            }
+        }
+
+        std::vector<unsigned long long> coreKeys, packageKeys, nodeKeys, l2Keys, l3Keys;
+        std::vector<unsigned> sharedCpus;
+
+        mCpus.clear();
+        mCpus.reserve(online.size());
+
+        for (unsigned cpu : online)
+        {
+            const std::string cpuDir = root + "/cpu/cpu" + std::to_string(cpu);
+            const unsigned long packageId = _read_sysfs_uint(cpuDir + "/topology/physical_package_id", 0);
+            const unsigned long coreId = _read_sysfs_uint(cpuDir + "/topology/core_id", cpu);
+            const unsigned long long coreKey = ((unsigned long long)packageId << 32ull) | (unsigned long long)coreId;
+
+            // Without cache information, assume a private L2 per core and a
+            // shared L3 per package. Keys are offset so they can't collide
+            // with the first CPU of a shared_cpu_list.
+            unsigned long long l2Key = (1ull << 62ull) | coreKey;
+            unsigned long long l3Key = (1ull << 63ull) | (unsigned long long)packageId;
+
+            for (unsigned index = 0; ; ++index)
+            {
+                const std::string cacheDir = cpuDir + "/cache/index" + std::to_string(index);
+                const unsigned long level = _read_sysfs_uint(cacheDir + "/level", 0);
+                if (!level)
+                {
+                    break;
+                }
+
+                if (!_read_sysfs(cacheDir + "/type", line, sizeof(line)) || line[0] == 'I')
+                {
+                    continue;
+                }
+
+                if ((level == 2 || level == 3)
+                && _read_sysfs(cacheDir + "/shared_cpu_list", line, sizeof(line))
+                && _parse_cpu_list(line, sharedCpus))
+                {
+                    (level == 2 ? l2Key : l3Key) = sharedCpus.front();
+                }
+            }
+
+            const unsigned core = _dense_id(coreKeys, coreKey);
+            unsigned smtIndex = 0;
+
+            for (const CpuInfo& info : mCpus)
+            {
+                smtIndex += info.core == core;
+            }
+
+            mCpus.push_back(CpuInfo{
+                cpu,
+                core,
+                smtIndex,
+                _dense_id(packageKeys, packageId),
+                _dense_id(nodeKeys, cpuNodes[cpu]),
+                _dense_id(l2Keys, l2Key),
+                _dense_id(l3Keys, l3Key)
+            });
+        }
+
+        mNumCores = (unsigned)coreKeys.size();
+        mNumPackages = (unsigned)packageKeys.size();
+        mNumNodes = (unsigned)nodeKeys.size();
+        mNumL2Caches = (unsigned)l2Keys.size();
+        mNumL3Caches = (unsigned)l3Keys.size();
+
+        return true;
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Flat topology
+-------------------------------------*/
+void CpuTopology::load_flat(unsigned numCpus) noexcept
+{
+    numCpus = numCpus ? numCpus : 1u;
+
+    mCpus.clear();
+    mCpus.reserve(numCpus);
+
+    for (unsigned cpu = 0; cpu < numCpus; ++cpu)
+    {
+        mCpus.push_back(CpuInfo{cpu, cpu, 0, 0, 0, cpu, 0});
+    }
+
+    mNumCores = numCpus;
+    mNumPackages = 1;
+    mNumNodes = 1;
+    mNumL2Caches = numCpus;
+    mNumL3Caches = 1;
+}
+
+
+
+/*-------------------------------------
+ * CPUs within a NUMA node
+-------------------------------------*/
+std::vector<unsigned> CpuTopology::node_cpus(int numaNode) const noexcept
+{
+    std::vector<unsigned> ret;
+
+    for (const CpuInfo& info : mCpus)
+    {
+        if (numaNode < 0 || info.numaNode == (unsigned)numaNode)
+        {
+            ret.push_back(info.id);
+        }
+    }
+
+    return ret;
+}
+
+
+
+/*-------------------------------------
+ * CPU order for a placement policy
+-------------------------------------*/
+std::vector<unsigned> CpuTopology::placement_order(CpuPlacement policy, int numaNode) const noexcept
+{
+    std::vector<CpuInfo> cpus;
+    cpus.reserve(mCpus.size());
+
+    for (const CpuInfo& info : mCpus)
+    {
+        if (numaNode < 0 || info.numaNode == (unsigned)numaNode)
+        {
+            cpus.push_back(info);
+        }
+    }
+
+    // Neighboring CPUs first. Every other policy is a reordering of this.
+    std::sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b)->bool
+    {
+        return std::tie(a.numaNode, a.package, a.l3Cache, a.l2Cache, a.core, a.smtIndex, a.id)
+            < std::tie(b.numaNode, b.package, b.l3Cache, b.l2Cache, b.core, b.smtIndex, b.id);
+    });
+
+    if (policy == CpuPlacement::PHYSICAL_CORES)
+    {
+        // SMT siblings are only used once every core has a thread
+        std::stable_sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b)->bool
+        {
+            return a.smtIndex < b.smtIndex;
+        });
+    }
+    else if (policy == CpuPlacement::SCATTER)
+    {
+        // Rank each core within its L3 cache, and each L3 cache within its
+        // package, then deal CPUs out across packages one rank at a time.
+        std::vector<unsigned> coreRanks(mNumCores, ~0u);
+        std::vector<unsigned> cacheRanks(mNumL3Caches, ~0u);
+        std::vector<unsigned> numCoresInCache(mNumL3Caches, 0);
+        std::vector<unsigned> numCachesInPackage(mNumPackages, 0);
+
+        for (const CpuInfo& info : cpus)
+        {
+            if (coreRanks[info.core] == ~0u)
+            {
+                coreRanks[info.core] = numCoresInCache[info.l3Cache]++;
+            }
+
+            if (cacheRanks[info.l3Cache] == ~0u)
+            {
+                cacheRanks[info.l3Cache] = numCachesInPackage[info.package]++;
+            }
+        }
+
+        std::stable_sort(cpus.begin(), cpus.end(), [&](const CpuInfo& a, const CpuInfo& b)->bool
+        {
+            return std::tie(a.smtIndex, coreRanks[a.core], cacheRanks[a.l3Cache], a.numaNode, a.package)
+                < std::tie(b.smtIndex, coreRanks[b.core], cacheRanks[b.l3Cache], b.numaNode, b.package);
+        });
+    }
+
+    std::vector<unsigned> ret;
+    ret.reserve(cpus.size());
+
+    for (const CpuInfo& info : cpus)
+    {
+        ret.push_back(info.id);
+    }
+
+    return ret;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Thread Placement
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Place a single thread
+-------------------------------------*/
+bool place_thread(std::thread& t, CpuPlacement policy, std::size_t threadIndex, int numaNode) noexcept
+{
+    const CpuTopology& topology = CpuTopology::system();
+    const std::vector<unsigned> order = topology.placement_order(policy, policy == CpuPlacement::NONE ? -1 : numaNode);
+
+    return _place_thread(topology, order, t, policy, threadIndex, numaNode);
+}
+
+
+
+/*-------------------------------------
+ * Place a group of threads
+-------------------------------------*/
+bool place_threads(std::vector<std::thread>& threads, CpuPlacement policy, int numaNode) noexcept
+{
+    const CpuTopology& topology = CpuTopology::system();
+    const std::vector<unsigned> order = topology.placement_order(policy, policy == CpuPlacement::NONE ? -1 : numaNode);
+    bool ret = true;
+
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        ret = _place_thread(topology, order, threads[i], policy, i, numaNode) && ret;
+    }
+
+    return ret;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,392 @@
+/*
+ * File:   EpochDomain.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 6:30 p.m.
+ */
+
+#include <new> // std::nothrow
+#include <thread> // std::this_thread::yield()
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/EpochDomain.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Encode an online epoch
+-------------------------------------*/
+constexpr uint64_t _online_epoch(uint64_t e) noexcept
+{
+    return (e << 1ull) | 1ull;
+}
+
+
+
+/*-------------------------------------
+ * Return retired memory to its allocator
+-------------------------------------*/
+inline void _free_retired(const EpochRetired& retired) noexcept
+{
+    if (retired.destroy)
+    {
+        retired.destroy(retired.pData);
+    }
+
+    if (retired.numBytes)
+    {
+        retired.pAllocator->free(retired.pData, retired.numBytes);
+    }
+    else
+    {
+        retired.pAllocator->free(retired.pData);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free an entire bucket of retired memory
+-------------------------------------*/
+inline std::size_t _free_bucket(std::vector<EpochRetired>& bucket) noexcept
+{
+    const std::size_t numFreed = bucket.size();
+
+    for (const EpochRetired& retired : bucket)
+    {
+        _free_retired(retired);
+    }
+
+    // Keep the capacity around for the next batch
+    bucket.clear();
+
+    return numFreed;
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * EpochDomain
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+EpochDomain::~EpochDomain() noexcept
+{
+    EpochRecord* pRecord = mRecords.exchange(nullptr, std::memory_order_acquire);
+
+    while (pRecord)
+    {
+        EpochRecord* pNext = pRecord->pNext;
+
+        for (std::vector<EpochRetired>& bucket : pRecord->limbo)
+        {
+            _free_bucket(bucket);
+        }
+
+        delete pRecord;
+        pRecord = pNext;
+    }
+
+    _free_bucket(mOrphans);
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+EpochDomain::EpochDomain(std::size_t batchSize) noexcept :
+    mEpoch{0},
+    mRecords{nullptr},
+    mBatchSize{batchSize ? batchSize : 1},
+    mOrphanLock{},
+    mNumOrphans{0},
+    mOrphans{}
+{}
+
+
+
+/*-------------------------------------
+ * Publish the current epoch for a thread
+-------------------------------------*/
+inline void EpochDomain::_announce(EpochRecord* pRecord) noexcept
+{
+    const uint64_t e = _online_epoch(mEpoch.load(std::memory_order_acquire));
+
+    if (pRecord->epoch.load(std::memory_order_relaxed) != e)
+    {
+        pRecord->epoch.store(e, std::memory_order_release);
+
+        // Order the announcement before any following reads of shared
+        // structures. Pairs with the fence in try_advance().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free a thread's retired memory
+-------------------------------------*/
+void EpochDomain::_reclaim(EpochRecord* pRecord) noexcept
+{
+    const uint64_t e = mEpoch.load(std::memory_order_acquire);
+
+    // Memory retired two epochs ago can no longer be reached. Every thread
+    // has since announced an epoch which began after it was unlinked.
+    for (std::vector<EpochRetired>& bucket : pRecord->limbo)
+    {
+        if (!bucket.empty() && bucket.front().epoch+2 <= e)
+        {
+            pRecord->numRetired -= _free_bucket(bucket);
+        }
+    }
+
+    if (mNumOrphans.load(std::memory_order_relaxed))
+    {
+        _reclaim_orphans();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free memory left by unregistered threads
+-------------------------------------*/
+void EpochDomain::_reclaim_orphans() noexcept
+{
+    std::unique_lock<std::mutex> lock{mOrphanLock, std::try_to_lock};
+
+    // Another thread is already reclaiming
+    if (!lock.owns_lock())
+    {
+        return;
+    }
+
+    const uint64_t e = mEpoch.load(std::memory_order_acquire);
+    std::size_t numKept = 0;
+
+    for (const EpochRetired& retired : mOrphans)
+    {
+        if (retired.epoch+2 <= e)
+        {
+            _free_retired(retired);
+        }
+        else
+        {
+            mOrphans[numKept++] = retired;
+        }
+    }
+
+    mOrphans.resize(numKept);
+    mNumOrphans.store(numKept, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Register a thread
+-------------------------------------*/
+EpochRecord* EpochDomain::register_thread() noexcept
+{
+    EpochRecord* pRecord = mRecords.load(std::memory_order_acquire);
+
+    // Re-use a record left by an unregistered thread
+    while (pRecord)
+    {
+        bool expected = false;
+        if (!pRecord->inUse.load(std::memory_order_relaxed) && pRecord->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            break;
+        }
+
+        pRecord = pRecord->pNext;
+    }
+
+    if (!pRecord)
+    {
+        pRecord = new(std::nothrow) EpochRecord{};
+        LS_ASSERT(pRecord != nullptr);
+
+        pRecord->epoch.store(0, std::memory_order_relaxed);
+        pRecord->inUse.store(true, std::memory_order_relaxed);
+        pRecord->numRetired = 0;
+
+        EpochRecord* pHead = mRecords.load(std::memory_order_relaxed);
+        do
+        {
+            pRecord->pNext = pHead;
+        }
+        while (!mRecords.compare_exchange_weak(pHead, pRecord, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    _announce(pRecord);
+
+    return pRecord;
+}
+
+
+
+/*-------------------------------------
+ * Unregister a thread
+-------------------------------------*/
+void EpochDomain::unregister_thread(EpochRecord* pRecord) noexcept
+{
+    offline(pRecord);
+
+    if (pRecord->numRetired)
+    {
+        std::lock_guard<std::mutex> lock{mOrphanLock};
+
+        for (std::vector<EpochRetired>& bucket : pRecord->limbo)
+        {
+            mOrphans.insert(mOrphans.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+
+        mNumOrphans.store(mOrphans.size(), std::memory_order_relaxed);
+        pRecord->numRetired = 0;
+    }
+
+    pRecord->inUse.store(false, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Mark a quiescent state
+-------------------------------------*/
+void EpochDomain::quiescent(EpochRecord* pRecord) noexcept
+{
+    _announce(pRecord);
+
+    // Memory orphaned by unregistered threads is reclaimed by whichever
+    // threads remain, even if they never retire anything themselves.
+    if (pRecord->numRetired || mNumOrphans.load(std::memory_order_relaxed))
+    {
+        // Still quiescent, so the new epoch can be announced immediately
+        if (try_advance())
+        {
+            _announce(pRecord);
+        }
+
+        _reclaim(pRecord);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Stop participating in epochs
+-------------------------------------*/
+void EpochDomain::offline(EpochRecord* pRecord) noexcept
+{
+    pRecord->epoch.store(0, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Resume participating in epochs
+-------------------------------------*/
+void EpochDomain::online(EpochRecord* pRecord) noexcept
+{
+    _announce(pRecord);
+}
+
+
+
+/*-------------------------------------
+ * Advance the global epoch
+-------------------------------------*/
+bool EpochDomain::try_advance() noexcept
+{
+    // Pairs with the fence in _announce(). A thread which has not yet made
+    // its announcement visible is guaranteed to read the current epoch, or
+    // a later one, when it does.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t e = mEpoch.load(std::memory_order_relaxed);
+    const uint64_t current = _online_epoch(e);
+
+    for (EpochRecord* pRecord = mRecords.load(std::memory_order_acquire); pRecord; pRecord = pRecord->pNext)
+    {
+        const uint64_t recordEpoch = pRecord->epoch.load(std::memory_order_acquire);
+
+        // Offline threads hold no references
+        if (recordEpoch && recordEpoch != current)
+        {
+            return false;
+        }
+    }
+
+    return mEpoch.compare_exchange_strong(e, e+1, std::memory_order_acq_rel, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Defer freeing memory
+-------------------------------------*/
+void EpochDomain::_retire(EpochRecord* pRecord, void* pData, IAllocator& allocator, IAllocator::size_type numBytes, void (*destroy)(void*) noexcept) noexcept
+{
+    // Order the caller unlinking "pData" before reading the epoch. Any
+    // thread which announces a later epoch can no longer reach it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const uint64_t e = mEpoch.load(std::memory_order_relaxed);
+    std::vector<EpochRetired>& bucket = pRecord->limbo[e % 3];
+
+    // A bucket from three or more epochs ago is always safe to free
+    if (!bucket.empty() && bucket.front().epoch != e)
+    {
+        pRecord->numRetired -= _free_bucket(bucket);
+    }
+
+    bucket.push_back(EpochRetired{pData, numBytes, &allocator, destroy, e});
+    ++pRecord->numRetired;
+
+    if ((pRecord->numRetired % mBatchSize) == 0)
+    {
+        try_advance();
+        _reclaim(pRecord);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Wait for all retired memory to be freed
+-------------------------------------*/
+void EpochDomain::synchronize(EpochRecord* pRecord) noexcept
+{
+    while (true)
+    {
+        quiescent(pRecord);
+
+        if (!pRecord->numRetired)
+        {
+            break;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
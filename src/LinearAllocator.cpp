@@ -0,0 +1,490 @@
+/*
+ * File:   LinearAllocator.cpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 10:10 AM
+ */
+
+#include <utility> // std::move
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Copy.h"
+#include "lightsky/utils/LinearAllocator.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * LinearAllocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Chain a new block
+-------------------------------------*/
+void* LinearAllocator::_allocate_from_new_block(size_type numBytes) noexcept
+{
+    const size_type n = (numBytes + (alignment-1ull)) & ~(alignment-1ull);
+    if (!numBytes || n < numBytes || n > ~(size_type)0 - sizeof(Block))
+    {
+        return nullptr;
+    }
+
+    if (!mCanGrow && mBlocks)
+    {
+        return nullptr;
+    }
+
+    Block* pBlock = nullptr;
+
+    if (mSpare && (size_type)(mSpare->pEnd - _block_begin(mSpare)) >= n)
+    {
+        pBlock = mSpare;
+        mSpare = nullptr;
+    }
+    else
+    {
+        size_type rawBytes = n + sizeof(Block);
+        if (rawBytes < mBlockSize)
+        {
+            rawBytes = mBlockSize;
+        }
+
+        void* const pRaw = this->memory_source().allocate(rawBytes, &rawBytes);
+        if (!pRaw)
+        {
+            return nullptr;
+        }
+
+        pBlock = static_cast<Block*>(pRaw);
+        pBlock->rawBytes = rawBytes;
+        pBlock->pEnd = _block_begin(pBlock) + ((rawBytes - sizeof(Block)) & ~(alignment-1ull));
+    }
+
+    if (mBlocks)
+    {
+        mBlocks->pUsed = mHead;
+    }
+
+    pBlock->pPrev = mBlocks;
+    pBlock->pUsed = nullptr;
+    mBlocks = pBlock;
+
+    char* const p = _block_begin(pBlock);
+    mHead = p + n;
+    mEnd = pBlock->pEnd;
+    mLastAlloc = p;
+
+    return p;
+}
+
+
+
+/*-------------------------------------
+ * Return a block which is no longer in use
+-------------------------------------*/
+void LinearAllocator::_release_block(Block* pBlock) noexcept
+{
+    if (!mSpare)
+    {
+        mSpare = pBlock;
+        return;
+    }
+
+    // Keep the larger of the two blocks
+    if (mSpare->rawBytes < pBlock->rawBytes)
+    {
+        Block* const pTemp = mSpare;
+        mSpare = pBlock;
+        pBlock = pTemp;
+    }
+
+    this->memory_source().free(pBlock, pBlock->rawBytes);
+}
+
+
+
+/*-------------------------------------
+ * Return all memory to the memory source
+-------------------------------------*/
+void LinearAllocator::_release_all() noexcept
+{
+    while (mBlocks)
+    {
+        Block* const pBlock = mBlocks;
+        mBlocks = pBlock->pPrev;
+        this->memory_source().free(pBlock, pBlock->rawBytes);
+    }
+
+    if (mSpare)
+    {
+        this->memory_source().free(mSpare, mSpare->rawBytes);
+        mSpare = nullptr;
+    }
+
+    mHead = nullptr;
+    mEnd = nullptr;
+    mLastAlloc = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+LinearAllocator::~LinearAllocator() noexcept
+{
+    _release_all();
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+LinearAllocator::LinearAllocator(MemorySource& memorySource, size_type blockSize, bool canGrow) noexcept :
+    Allocator{memorySource},
+    mBlockSize{blockSize},
+    mCanGrow{canGrow},
+    mHead{nullptr},
+    mEnd{nullptr},
+    mLastAlloc{nullptr},
+    mBlocks{nullptr},
+    mSpare{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+LinearAllocator::LinearAllocator(LinearAllocator&& allocator) noexcept :
+    Allocator{std::move(allocator)},
+    mBlockSize{allocator.mBlockSize},
+    mCanGrow{allocator.mCanGrow},
+    mHead{allocator.mHead},
+    mEnd{allocator.mEnd},
+    mLastAlloc{allocator.mLastAlloc},
+    mBlocks{allocator.mBlocks},
+    mSpare{allocator.mSpare}
+{
+    allocator.mHead = nullptr;
+    allocator.mEnd = nullptr;
+    allocator.mLastAlloc = nullptr;
+    allocator.mBlocks = nullptr;
+    allocator.mSpare = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+LinearAllocator& LinearAllocator::operator=(LinearAllocator&& allocator) noexcept
+{
+    if (this == &allocator)
+    {
+        return *this;
+    }
+
+    _release_all();
+
+    Allocator::operator=(std::move(allocator));
+
+    mBlockSize = allocator.mBlockSize;
+    mCanGrow = allocator.mCanGrow;
+
+    mHead = allocator.mHead;
+    allocator.mHead = nullptr;
+
+    mEnd = allocator.mEnd;
+    allocator.mEnd = nullptr;
+
+    mLastAlloc = allocator.mLastAlloc;
+    allocator.mLastAlloc = nullptr;
+
+    mBlocks = allocator.mBlocks;
+    allocator.mBlocks = nullptr;
+
+    mSpare = allocator.mSpare;
+    allocator.mSpare = nullptr;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Rewind to a marker
+-------------------------------------*/
+void LinearAllocator::rewind(const Marker& marker) noexcept
+{
+    Block* const pTarget = static_cast<Block*>(marker.pBlock);
+
+    // Markers taken before the first allocation
+    if (!pTarget)
+    {
+        reset();
+        return;
+    }
+
+    while (mBlocks && mBlocks != pTarget)
+    {
+        Block* const pBlock = mBlocks;
+        mBlocks = pBlock->pPrev;
+        _release_block(pBlock);
+    }
+
+    if (!mBlocks)
+    {
+        runtime_assert(false, ErrorLevel::LS_WARNING, "Attempted to rewind a linear allocator to an invalid marker.");
+        mHead = nullptr;
+        mEnd = nullptr;
+        mLastAlloc = nullptr;
+        return;
+    }
+
+    mHead = marker.pHead;
+    mEnd = mBlocks->pEnd;
+    mLastAlloc = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Release all allocations
+-------------------------------------*/
+void LinearAllocator::reset() noexcept
+{
+    if (!mBlocks)
+    {
+        return;
+    }
+
+    while (mBlocks->pPrev)
+    {
+        Block* const pBlock = mBlocks;
+        mBlocks = pBlock->pPrev;
+        _release_block(pBlock);
+    }
+
+    mHead = _block_begin(mBlocks);
+    mEnd = mBlocks->pEnd;
+    mLastAlloc = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Bytes in use
+-------------------------------------*/
+LinearAllocator::size_type LinearAllocator::bytes_used() const noexcept
+{
+    if (!mBlocks)
+    {
+        return 0;
+    }
+
+    size_type numBytes = (size_type)(mHead - _block_begin(mBlocks));
+
+    for (Block* pBlock = mBlocks->pPrev; pBlock; pBlock = pBlock->pPrev)
+    {
+        numBytes += (size_type)(pBlock->pUsed - _block_begin(pBlock));
+    }
+
+    return numBytes;
+}
+
+
+
+/*-------------------------------------
+ * Bytes retrieved from the memory source
+-------------------------------------*/
+LinearAllocator::size_type LinearAllocator::capacity() const noexcept
+{
+    size_type numBytes = mSpare ? mSpare->rawBytes : 0;
+
+    for (Block* pBlock = mBlocks; pBlock; pBlock = pBlock->pPrev)
+    {
+        numBytes += pBlock->rawBytes;
+    }
+
+    return numBytes;
+}
+
+
+
+/*-------------------------------------
+ * Allocate and zero-initialize
+-------------------------------------*/
+void* LinearAllocator::allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes) noexcept
+{
+    if (IAllocator::calloc_can_overflow(numElements, numBytesPerElement))
+    {
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    const size_type numBytes = numElements * numBytesPerElement;
+    void* const p = allocate(numBytes, pOutNumBytes);
+    if (p)
+    {
+        fast_memset(p, 0, numBytes);
+    }
+
+    return p;
+}
+
+
+
+/*-------------------------------------
+ * Reallocate
+-------------------------------------*/
+void* LinearAllocator::reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!p || p == mLastAlloc)
+    {
+        return reallocate(p, numNewBytes, 0, pOutNumBytes);
+    }
+
+    // Copy at most the remainder of the owning block
+    const char* const pData = static_cast<const char*>(p);
+
+    for (Block* pBlock = mBlocks; pBlock; pBlock = pBlock->pPrev)
+    {
+        const char* const pUsed = (pBlock == mBlocks) ? mHead : pBlock->pUsed;
+        if (pData >= _block_begin(pBlock) && pData < pUsed)
+        {
+            return reallocate(p, numNewBytes, (size_type)(pUsed - pData), pOutNumBytes);
+        }
+    }
+
+    runtime_assert(false, ErrorLevel::LS_WARNING, "Attempted to reallocate a pointer from another allocator.");
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = 0;
+    }
+
+    return nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Reallocate (sized)
+-------------------------------------*/
+void* LinearAllocator::reallocate(void* p, size_type numNewBytes, size_type numPrevBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!p)
+    {
+        return allocate(numNewBytes, pOutNumBytes);
+    }
+
+    if (!numNewBytes)
+    {
+        free(p);
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    if (p == mLastAlloc)
+    {
+        char* const pData = static_cast<char*>(p);
+        const size_type n = (numNewBytes + (alignment-1ull)) & ~(alignment-1ull);
+
+        // Resize the most recent allocation in-place
+        if (n >= numNewBytes && n <= (size_type)(mEnd - pData))
+        {
+            mHead = pData + n;
+            if (pOutNumBytes)
+            {
+                *pOutNumBytes = n;
+            }
+
+            return p;
+        }
+
+        numPrevBytes = (size_type)(mHead - pData);
+    }
+
+    void* const pNewData = allocate(numNewBytes, pOutNumBytes);
+    if (pNewData)
+    {
+        fast_memcpy(pNewData, p, numPrevBytes < numNewBytes ? numPrevBytes : numNewBytes);
+    }
+
+    return pNewData;
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void LinearAllocator::free(void* p) noexcept
+{
+    if (p && p == mLastAlloc)
+    {
+        mHead = mLastAlloc;
+        mLastAlloc = nullptr;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void LinearAllocator::free(void* p, size_type n) noexcept
+{
+    (void)n;
+    this->free(p);
+}
+
+
+
+/*-------------------------------------
+ * Free-list statistics
+-------------------------------------*/
+bool LinearAllocator::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    const size_type numRemaining = (size_type)(mEnd - mHead);
+    outStats = FreeListStats{0, 0, 0};
+
+    if (numRemaining)
+    {
+        outStats.numFreeBlocks = 1;
+        outStats.numFreeBytes = numRemaining;
+        outStats.largestFreeBlock = numRemaining;
+    }
+
+    if (mSpare)
+    {
+        const size_type numSpare = (size_type)(mSpare->pEnd - _block_begin(mSpare));
+        ++outStats.numFreeBlocks;
+        outStats.numFreeBytes += numSpare;
+
+        if (numSpare > outStats.largestFreeBlock)
+        {
+            outStats.largestFreeBlock = numSpare;
+        }
+    }
+
+    return true;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
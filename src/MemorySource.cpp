@@ -17,6 +17,10 @@
         #include <unistd.h> // sysconf(_SC_PAGESIZE)
     }
 
+    #if defined(LS_OS_LINUX)
+        #include <sys/syscall.h> // SYS_mbind
+    #endif
+
 #elif defined(LS_OS_WINDOWS)
     #ifndef WIN32_LEAN_AND_MEAN
         #define WIN32_LEAN_AND_MEAN
@@ -29,7 +33,8 @@
     #include <Windows.h>
 #endif
 
-#include <cstdlib> // malloc, free
+#include <atomic>
+#include <cstdlib> // malloc, posix_memalign, free
 #include <utility> // std::move
 
 #include "lightsky/utils/Assertions.h"
@@ -54,6 +59,24 @@ MemorySource::~MemorySource() noexcept
 
 
 
+/*-------------------------------------
+ * Allocate (aligned)
+-------------------------------------*/
+void* MemorySource::allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes) noexcept
+{
+    (void)numBytes;
+    (void)alignment;
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = 0;
+    }
+
+    return nullptr;
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * Malloc-based Memory Source
 -----------------------------------------------------------------------------*/
@@ -109,6 +132,40 @@ void* MallocMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes)
 
 
 
+/*-------------------------------------
+ * Allocate (aligned)
+-------------------------------------*/
+void* MallocMemorySource::allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes) noexcept
+{
+    void* pResult = nullptr;
+
+    #if defined(LS_OS_UNIX)
+        // Memory from posix_memalign() may be passed to std::free()
+        if (alignment < sizeof(void*))
+        {
+            alignment = sizeof(void*);
+        }
+
+        if (numBytes && posix_memalign(&pResult, (std::size_t)alignment, (std::size_t)numBytes) != 0)
+        {
+            pResult = nullptr;
+        }
+    #else
+        // _aligned_malloc() memory can't be released with std::free()
+        (void)numBytes;
+        (void)alignment;
+    #endif
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = pResult ? numBytes : 0;
+    }
+
+    return pResult;
+}
+
+
+
 /*-------------------------------------
  * Free
 -------------------------------------*/
@@ -250,6 +307,162 @@ SystemMemorySource::size_type SystemMemorySource::page_size() noexcept
 }
 
 
+
+/*-------------------------------------
+ * Get the system's huge page size
+-------------------------------------*/
+SystemMemorySource::size_type SystemMemorySource::huge_page_size() noexcept
+{
+    constexpr size_type defaultHugePageSize = 2ull * 1024ull * 1024ull;
+
+    #if defined(LS_OS_LINUX)
+        // Only raw system calls are used here. This may run inside of a
+        // malloc() replacement, where stdio would allocate and re-enter it.
+        static const size_type hugePageSize = []() noexcept->size_type
+        {
+            const int fd = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                return defaultHugePageSize;
+            }
+
+            char info[8192];
+            size_t numRead = 0;
+            ssize_t n;
+
+            while (numRead < sizeof(info)-1 && (n = read(fd, info+numRead, sizeof(info)-1-numRead)) != 0)
+            {
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                numRead += (size_t)n;
+            }
+
+            close(fd);
+            info[numRead] = '\0';
+
+            const char* pField = strstr(info, "Hugepagesize:");
+            if (!pField)
+            {
+                return defaultHugePageSize;
+            }
+
+            pField += sizeof("Hugepagesize:")-1;
+            while (*pField == ' ' || *pField == '\t')
+            {
+                ++pField;
+            }
+
+            size_type numKb = 0;
+            while (*pField >= '0' && *pField <= '9')
+            {
+                numKb = numKb * 10ull + (size_type)(*pField++ - '0');
+            }
+
+            return numKb ? (numKb * 1024ull) : defaultHugePageSize;
+        }();
+
+        return hugePageSize;
+
+    #elif defined(LS_OS_WINDOWS)
+        const SIZE_T largePageSize = GetLargePageMinimum();
+        return largePageSize ? (size_type)largePageSize : defaultHugePageSize;
+
+    #else
+        return defaultHugePageSize;
+
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Allocation granularity for the current page mode
+-------------------------------------*/
+SystemMemorySource::size_type SystemMemorySource::_page_granularity(SystemPageMode pageMode) noexcept
+{
+    // The huge page size is only needed, and only queried, for huge page
+    // modes.
+    return (pageMode == SystemPageMode::SYSTEM_PAGES_DEFAULT) ? page_size() : huge_page_size();
+}
+
+
+
+#if defined(LS_OS_LINUX)
+namespace
+{
+
+/*-------------------------------------
+ * Bind a range of pages to a NUMA node
+-------------------------------------*/
+void _bind_numa_node(void* p, unsigned long long numBytes, int numaNode) noexcept
+{
+    constexpr int mpolBind = 2; // MPOL_BIND, from <linux/mempolicy.h>
+    constexpr unsigned long numMaskBits = sizeof(unsigned long) * 8ul * 16ul;
+    static std::atomic_bool warned{false};
+
+    if (numaNode < 0 || (unsigned long)numaNode >= numMaskBits)
+    {
+        return;
+    }
+
+    unsigned long nodeMask[16] = {};
+    nodeMask[numaNode / (int)(sizeof(unsigned long) * 8)] = 1ul << (numaNode % (int)(sizeof(unsigned long) * 8));
+
+    // Pages are not faulted in yet, so binding here places every page on the
+    // requested node. On failure the pages fall back to the first-touch
+    // policy, which still places them locally when touched from a thread
+    // pinned to that node.
+    const long err = syscall(SYS_mbind, p, numBytes, mpolBind, nodeMask, numMaskBits + 1ul, 0u);
+    if (err != 0 && !warned.exchange(true, std::memory_order_relaxed))
+    {
+        runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
+    }
+}
+
+
+
+/*-------------------------------------
+ * Map memory aligned to "alignment" bytes
+-------------------------------------*/
+void* _mmap_aligned(unsigned long long numBytes, unsigned long long alignment) noexcept
+{
+    void* const p = mmap(nullptr, numBytes + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    // Trim the unaligned head and tail of the mapping
+    const uintptr_t rawBegin = reinterpret_cast<uintptr_t>(p);
+    const uintptr_t alignedBegin = (rawBegin + (uintptr_t)(alignment-1ull)) & ~(uintptr_t)(alignment-1ull);
+    const uintptr_t headBytes = alignedBegin - rawBegin;
+    const uintptr_t tailBytes = (uintptr_t)alignment - headBytes;
+
+    if (headBytes)
+    {
+        munmap(p, headBytes);
+    }
+
+    if (tailBytes)
+    {
+        munmap(reinterpret_cast<void*>(alignedBegin + (uintptr_t)numBytes), tailBytes);
+    }
+
+    return reinterpret_cast<void*>(alignedBegin);
+}
+
+} // end anonymous namespace
+#endif /* LS_OS_LINUX */
+
+
 /*-------------------------------------
  * Destructor
 -------------------------------------*/
@@ -261,7 +474,24 @@ SystemMemorySource::~SystemMemorySource() noexcept
 /*-------------------------------------
  * Constructor
 -------------------------------------*/
-SystemMemorySource::SystemMemorySource() noexcept
+SystemMemorySource::SystemMemorySource() noexcept :
+    MemorySource{},
+    mPageMode{SystemPageMode::SYSTEM_PAGES_DEFAULT},
+    mNumaNode{-1},
+    mPageGranularity{_page_granularity(SystemPageMode::SYSTEM_PAGES_DEFAULT)}
+{
+}
+
+
+
+/*-------------------------------------
+ * Constructor (page mode and NUMA node)
+-------------------------------------*/
+SystemMemorySource::SystemMemorySource(SystemPageMode pageMode, int numaNode) noexcept :
+    MemorySource{},
+    mPageMode{pageMode},
+    mNumaNode{numaNode},
+    mPageGranularity{_page_granularity(pageMode)}
 {
 }
 
@@ -271,7 +501,10 @@ SystemMemorySource::SystemMemorySource() noexcept
  * Copy Constructor
 -------------------------------------*/
 SystemMemorySource::SystemMemorySource(const SystemMemorySource& src) noexcept :
-    MemorySource{src}
+    MemorySource{src},
+    mPageMode{src.mPageMode},
+    mNumaNode{src.mNumaNode},
+    mPageGranularity{src.mPageGranularity}
 {}
 
 
@@ -280,7 +513,10 @@ SystemMemorySource::SystemMemorySource(const SystemMemorySource& src) noexcept :
  * Move Constructor
 -------------------------------------*/
 SystemMemorySource::SystemMemorySource(SystemMemorySource&& allocator) noexcept :
-    MemorySource{std::move(allocator)}
+    MemorySource{std::move(allocator)},
+    mPageMode{allocator.mPageMode},
+    mNumaNode{allocator.mNumaNode},
+    mPageGranularity{allocator.mPageGranularity}
 {}
 
 
@@ -293,6 +529,9 @@ SystemMemorySource& SystemMemorySource::operator=(const SystemMemorySource& allo
     if (&allocator != this)
     {
         MemorySource::operator=(allocator);
+        mPageMode = allocator.mPageMode;
+        mNumaNode = allocator.mNumaNode;
+        mPageGranularity = allocator.mPageGranularity;
     }
 
     return *this;
@@ -308,6 +547,9 @@ SystemMemorySource& SystemMemorySource::operator=(SystemMemorySource&& allocator
     if (&allocator != this)
     {
         MemorySource::operator=(std::move(allocator));
+        mPageMode = allocator.mPageMode;
+        mNumaNode = allocator.mNumaNode;
+        mPageGranularity = allocator.mPageGranularity;
     }
 
     return *this;
@@ -315,6 +557,26 @@ SystemMemorySource& SystemMemorySource::operator=(SystemMemorySource&& allocator
 
 
 
+/*-------------------------------------
+ * Get the page mode
+-------------------------------------*/
+SystemPageMode SystemMemorySource::page_mode() const noexcept
+{
+    return mPageMode;
+}
+
+
+
+/*-------------------------------------
+ * Get the NUMA node
+-------------------------------------*/
+int SystemMemorySource::numa_node() const noexcept
+{
+    return mNumaNode;
+}
+
+
+
 /*-------------------------------------
  * Allocate (sized)
 -------------------------------------*/
@@ -325,17 +587,36 @@ void* SystemMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes)
         return nullptr;
     }
 
-    static const unsigned long long pageSize = page_size();
+    // Huge page modes are always sized in whole huge pages so free() can
+    // round to the same size, no matter which path backed the allocation.
+    const unsigned long long pageSize = mPageGranularity;
     const unsigned long long rem = numBytes % pageSize;
     numBytes += pageSize - (rem ? rem : pageSize);
     void* p = nullptr;
 
-    #if defined(LS_OS_UNIX)
-        #if 0
-        static const FDZero& fdz = FDZero::instance();
-        if (fdz.file_descriptor() != -1)
+    #if defined(LS_OS_LINUX)
+        if (mPageMode == SystemPageMode::SYSTEM_PAGES_HUGE)
         {
-            p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fdz.file_descriptor(), 0);
+            p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p == MAP_FAILED)
+            {
+                // No huge pages reserved. Let THP handle it instead.
+                p = nullptr;
+            }
+        }
+
+        if (!p && mPageMode != SystemPageMode::SYSTEM_PAGES_DEFAULT)
+        {
+            p = _mmap_aligned(numBytes, pageSize);
+            if (p)
+            {
+                madvise(p, numBytes, MADV_HUGEPAGE);
+            }
+        }
+
+        if (!p)
+        {
+            p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
             if (p == MAP_FAILED)
             {
                 runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
@@ -343,8 +624,12 @@ void* SystemMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes)
             }
         }
 
-        #else
+        if (p && mNumaNode >= 0)
+        {
+            _bind_numa_node(p, numBytes, mNumaNode);
+        }
 
+    #elif defined(LS_OS_UNIX)
         p = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
         if (p == MAP_FAILED)
         {
@@ -352,10 +637,26 @@ void* SystemMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes)
             p = nullptr;
         }
 
-        #endif
-
     #elif defined(LS_OS_WINDOWS)
-        p = VirtualAlloc(nullptr, numBytes, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+        const DWORD largePageFlag = (mPageMode == SystemPageMode::SYSTEM_PAGES_HUGE) ? MEM_LARGE_PAGES : 0;
+
+        if (mNumaNode >= 0)
+        {
+            p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, numBytes, MEM_RESERVE|MEM_COMMIT|largePageFlag, PAGE_READWRITE, (DWORD)mNumaNode);
+            if (!p && largePageFlag)
+            {
+                p = VirtualAllocExNuma(GetCurrentProcess(), nullptr, numBytes, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE, (DWORD)mNumaNode);
+            }
+        }
+        else
+        {
+            p = VirtualAlloc(nullptr, numBytes, MEM_RESERVE|MEM_COMMIT|largePageFlag, PAGE_READWRITE);
+            if (!p && largePageFlag)
+            {
+                // Large pages require SeLockMemoryPrivilege
+                p = VirtualAlloc(nullptr, numBytes, MEM_RESERVE|MEM_COMMIT, PAGE_READWRITE);
+            }
+        }
 
     #else
         p = std::malloc(numBytes);
@@ -372,13 +673,55 @@ void* SystemMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes)
 
 
 
+/*-------------------------------------
+ * Allocate (aligned)
+-------------------------------------*/
+void* SystemMemorySource::allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes) noexcept
+{
+    // Pages are already aligned to their own size
+    const unsigned long long pageSize = mPageGranularity;
+    if (alignment <= pageSize)
+    {
+        return this->allocate(numBytes, pOutNumBytes);
+    }
+
+    void* p = nullptr;
+
+    #if defined(LS_OS_LINUX)
+        if (numBytes && !(alignment & (alignment-1ull)))
+        {
+            const unsigned long long rem = numBytes % pageSize;
+            numBytes += pageSize - (rem ? rem : pageSize);
+
+            p = _mmap_aligned(numBytes, alignment);
+            if (p && mPageMode != SystemPageMode::SYSTEM_PAGES_DEFAULT)
+            {
+                madvise(p, numBytes, MADV_HUGEPAGE);
+            }
+
+            if (p && mNumaNode >= 0)
+            {
+                _bind_numa_node(p, numBytes, mNumaNode);
+            }
+        }
+    #endif
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = p ? numBytes : 0;
+    }
+
+    return p;
+}
+
+
+
 /*-------------------------------------
  * Free
 -------------------------------------*/
 void SystemMemorySource::free(void* pData) noexcept
 {
-    static const unsigned long long pageSize = page_size();
-    this->free(pData, pageSize);
+    this->free(pData, mPageGranularity);
 }
 
 
@@ -394,6 +737,10 @@ void SystemMemorySource::free(void* pData, size_type numBytes) noexcept
     }
 
     #if defined(LS_OS_UNIX)
+        const unsigned long long pageSize = mPageGranularity;
+        const unsigned long long rem = numBytes % pageSize;
+        numBytes += pageSize - (rem ? rem : pageSize);
+
         const int err = munmap(pData, numBytes);
         if (err != 0)
         {
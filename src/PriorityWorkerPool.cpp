@@ -0,0 +1,21 @@
+
+#include "lightsky/utils/PriorityWorkerPool.hpp"
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * PriorityWorkerPool
+-----------------------------------------------------------------------------*/
+LS_DEFINE_CLASS_TYPE(ls::utils::PriorityWorkerPool, void (*)());
+LS_DEFINE_CLASS_TYPE(ls::utils::PriorityWorkerPool, ls::utils::Function<void()>);
+
+
+
+} // end utils namespace
+} // end ls namespace
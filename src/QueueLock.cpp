@@ -0,0 +1,422 @@
+/*
+ * File:   QueueLock.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 4:05 p.m.
+ */
+
+#include <climits> // CHAR_BIT, INT_MAX
+#include <mutex>
+#include <new> // std::nothrow
+
+#include "lightsky/setup/CPU.h"
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Futex.hpp" // LS_UTILS_USE_LINUX_FUTEX
+#include "lightsky/utils/QueueLock.hpp"
+
+#if LS_UTILS_USE_LINUX_FUTEX
+    extern "C"
+    {
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+    }
+#endif
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * ClhLock tail tags
+ *
+ * The tail of a ClhLock packs the node's generation into the bits of its
+ * address which are always zero: the low 6 bits from its 64-byte alignment
+ * and, on 64-bit systems, the high 16 bits of a 48-bit virtual address.
+-------------------------------------*/
+static_assert(alignof(QueueLockNode) >= 64, "Queue lock nodes must leave 6 bits free for tagging.");
+
+constexpr unsigned _TAIL_LOW_TAG_BITS = 6;
+
+constexpr unsigned _TAIL_HIGH_TAG_BITS = (sizeof(uintptr_t) >= 8) ? 16 : 0;
+
+constexpr uintptr_t _TAIL_LOW_TAG_MASK = ((uintptr_t)1 << _TAIL_LOW_TAG_BITS) - 1;
+
+constexpr uintptr_t _TAIL_ADDRESS_MASK = (~(uintptr_t)0 >> _TAIL_HIGH_TAG_BITS) & ~_TAIL_LOW_TAG_MASK;
+
+inline uintptr_t _tag_tail(const QueueLockNode* node) noexcept
+{
+    const uintptr_t generation = (uintptr_t)node->generation;
+    uintptr_t tail = reinterpret_cast<uintptr_t>(node) | (generation & _TAIL_LOW_TAG_MASK);
+
+    if constexpr (_TAIL_HIGH_TAG_BITS != 0)
+    {
+        tail |= (generation >> _TAIL_LOW_TAG_BITS) << (sizeof(uintptr_t)*CHAR_BIT - _TAIL_HIGH_TAG_BITS);
+    }
+
+    return tail;
+}
+
+inline QueueLockNode* _tail_node(uintptr_t tail) noexcept
+{
+    return reinterpret_cast<QueueLockNode*>(tail & _TAIL_ADDRESS_MASK);
+}
+
+
+
+/*-------------------------------------
+ * Nodes released by exiting threads
+-------------------------------------*/
+std::mutex gFreeNodeLock;
+
+QueueLockNode* gFreeNodes = nullptr;
+
+
+
+/*-------------------------------------
+ * Hand a list of nodes to other threads
+-------------------------------------*/
+void _retire_nodes(QueueLockNode* head) noexcept
+{
+    if (!head)
+    {
+        return;
+    }
+
+    // Other threads may still read a node after seeing it in a queue, so
+    // nodes are kept for re-use rather than freed.
+    QueueLockNode* last = head;
+    while (last->nextFree)
+    {
+        last = last->nextFree;
+    }
+
+    std::lock_guard<std::mutex> lock{gFreeNodeLock};
+    last->nextFree = gFreeNodes;
+    gFreeNodes = head;
+}
+
+
+
+/*-------------------------------------
+ * Per-thread node cache
+-------------------------------------*/
+struct QueueLockNodeCache
+{
+    QueueLockNode* head = nullptr;
+
+    ~QueueLockNodeCache() noexcept
+    {
+        _retire_nodes(head);
+    }
+};
+
+thread_local QueueLockNodeCache tNodeCache;
+
+
+
+/*-------------------------------------
+ * Retrieve a node for the calling thread
+-------------------------------------*/
+QueueLockNode* _acquire_node() noexcept
+{
+    QueueLockNode* node = tNodeCache.head;
+
+    if (!node)
+    {
+        {
+            std::lock_guard<std::mutex> lock{gFreeNodeLock};
+            node = gFreeNodes;
+            if (node)
+            {
+                gFreeNodes = node->nextFree;
+            }
+        }
+
+        if (!node)
+        {
+            node = new(std::nothrow) QueueLockNode{};
+            LS_ASSERT(node != nullptr);
+            LS_ASSERT((reinterpret_cast<uintptr_t>(node) & ~_TAIL_ADDRESS_MASK) == 0);
+        }
+    }
+    else
+    {
+        tNodeCache.head = node->nextFree;
+    }
+
+    node->next.store(nullptr, std::memory_order_relaxed);
+    node->state.store(QueueLockNode::NODE_LOCKED, std::memory_order_relaxed);
+    node->nextFree = nullptr;
+    ++node->generation;
+
+    return node;
+}
+
+
+
+/*-------------------------------------
+ * Return a node to the calling thread's cache
+-------------------------------------*/
+inline void _release_node(QueueLockNode* node) noexcept
+{
+    node->nextFree = tNodeCache.head;
+    tNodeCache.head = node;
+}
+
+
+
+/*-------------------------------------
+ * Wait for a node to be released
+-------------------------------------*/
+void _wait_for_release(QueueLockNode* node, uint32_t spinCount) noexcept
+{
+    std::atomic_uint32_t& state = node->state;
+
+    for (uint32_t i = 0; spinCount == McsLock::SPIN_ONLY || i < spinCount; ++i)
+    {
+        if (state.load(std::memory_order_acquire) == QueueLockNode::NODE_RELEASED)
+        {
+            return;
+        }
+
+        ls::setup::cpu_yield();
+    }
+
+    uint32_t expected = QueueLockNode::NODE_LOCKED;
+    if (!state.compare_exchange_strong(expected, QueueLockNode::NODE_SLEEPING, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        // Released while preparing to sleep
+        return;
+    }
+
+    while (state.load(std::memory_order_acquire) != QueueLockNode::NODE_RELEASED)
+    {
+        #if LS_UTILS_USE_LINUX_FUTEX
+            syscall(SYS_futex, &state, FUTEX_WAIT_PRIVATE, (uint32_t)QueueLockNode::NODE_SLEEPING, nullptr, nullptr, 0);
+        #else
+            state.wait(QueueLockNode::NODE_SLEEPING, std::memory_order_acquire);
+        #endif
+    }
+}
+
+
+
+/*-------------------------------------
+ * Release a node, waking its waiter
+-------------------------------------*/
+inline void _release(QueueLockNode* node) noexcept
+{
+    std::atomic_uint32_t& state = node->state;
+
+    // The waiter may recycle the node as soon as it is released. Only its
+    // address is used after this point.
+    if (state.exchange(QueueLockNode::NODE_RELEASED, std::memory_order_acq_rel) == QueueLockNode::NODE_SLEEPING)
+    {
+        #if LS_UTILS_USE_LINUX_FUTEX
+            syscall(SYS_futex, &state, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        #else
+            state.notify_all();
+        #endif
+    }
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * McsLock
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+McsLock::McsLock(uint32_t spinCount) noexcept :
+    mTail{nullptr},
+    mHolder{nullptr},
+    mSpinCount{spinCount}
+{}
+
+
+
+/*-------------------------------------
+ * Mutex Lock
+-------------------------------------*/
+void McsLock::lock() noexcept
+{
+    QueueLockNode* node = _acquire_node();
+    QueueLockNode* pred = mTail.exchange(node, std::memory_order_acq_rel);
+
+    if (pred)
+    {
+        pred->next.store(node, std::memory_order_release);
+        _wait_for_release(node, mSpinCount);
+    }
+
+    mHolder = node;
+}
+
+
+
+/*-------------------------------------
+ * Attempt to lock
+-------------------------------------*/
+bool McsLock::try_lock() noexcept
+{
+    if (mTail.load(std::memory_order_relaxed) != nullptr)
+    {
+        return false;
+    }
+
+    QueueLockNode* node = _acquire_node();
+    QueueLockNode* expected = nullptr;
+
+    if (!mTail.compare_exchange_strong(expected, node, std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+        _release_node(node);
+        return false;
+    }
+
+    mHolder = node;
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Mutex unlock
+-------------------------------------*/
+void McsLock::unlock() noexcept
+{
+    QueueLockNode* node = mHolder;
+    QueueLockNode* succ = node->next.load(std::memory_order_acquire);
+
+    if (!succ)
+    {
+        QueueLockNode* expected = node;
+        if (mTail.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            _release_node(node);
+            return;
+        }
+
+        // A thread swapped itself into the tail but hasn't linked to this
+        // node yet.
+        while (!(succ = node->next.load(std::memory_order_acquire)))
+        {
+            ls::setup::cpu_yield();
+        }
+    }
+
+    _release(succ);
+    _release_node(node);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * ClhLock
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+ClhLock::~ClhLock() noexcept
+{
+    // Locks may outlive the destroying thread's node cache
+    QueueLockNode* node = _tail_node(mTail.exchange(0, std::memory_order_acq_rel));
+    node->nextFree = nullptr;
+    _retire_nodes(node);
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+ClhLock::ClhLock(uint32_t spinCount) noexcept :
+    mTail{0},
+    mHolder{nullptr},
+    mHolderPred{nullptr},
+    mSpinCount{spinCount}
+{
+    QueueLockNode* node = _acquire_node();
+    node->state.store(QueueLockNode::NODE_RELEASED, std::memory_order_relaxed);
+    mTail.store(_tag_tail(node), std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Mutex Lock
+-------------------------------------*/
+void ClhLock::lock() noexcept
+{
+    QueueLockNode* node = _acquire_node();
+    QueueLockNode* pred = _tail_node(mTail.exchange(_tag_tail(node), std::memory_order_acq_rel));
+
+    _wait_for_release(pred, mSpinCount);
+
+    mHolder = node;
+    mHolderPred = pred;
+}
+
+
+
+/*-------------------------------------
+ * Attempt to lock
+-------------------------------------*/
+bool ClhLock::try_lock() noexcept
+{
+    uintptr_t tail = mTail.load(std::memory_order_acquire);
+    QueueLockNode* pred = _tail_node(tail);
+
+    if (pred->state.load(std::memory_order_acquire) != QueueLockNode::NODE_RELEASED)
+    {
+        return false;
+    }
+
+    QueueLockNode* node = _acquire_node();
+
+    // Fails if the tail node was re-used since it was checked, even if the
+    // same node is back at the tail.
+    if (!mTail.compare_exchange_strong(tail, _tag_tail(node), std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+        _release_node(node);
+        return false;
+    }
+
+    // A released node only changes state after leaving the tail, so "pred"
+    // is still released here.
+    mHolder = node;
+    mHolderPred = pred;
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Mutex unlock
+-------------------------------------*/
+void ClhLock::unlock() noexcept
+{
+    QueueLockNode* pred = mHolderPred;
+
+    // The next thread in line takes over this node, and this thread takes
+    // over the node it waited on.
+    _release(mHolder);
+    _release_node(pred);
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
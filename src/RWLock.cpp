@@ -4,6 +4,8 @@
  * Created on July 23, 2025, at 12:11 AM
  */
 
+#include <chrono>
+
 #include "lightsky/utils/RWLock.hpp"
 
 namespace ls
@@ -12,6 +14,67 @@ namespace utils
 {
 
 
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Reader-biased locks held by a thread
+-------------------------------------*/
+struct BiasedReadRecord
+{
+    const BiasedRWLock* pLock;
+    uint32_t count;
+};
+
+std::atomic_uint32_t gNextReaderSlot{0};
+
+// Threads are spread round-robin across reader slots
+thread_local const uint32_t tReaderSlot = gNextReaderSlot.fetch_add(1, std::memory_order_relaxed) & (BiasedRWLock::NUM_READER_SLOTS-1u);
+
+thread_local BiasedReadRecord tBiasedReads[BiasedRWLock::MAX_BIASED_READS] = {};
+
+
+
+/*-------------------------------------
+ * Find a lock's record, or an empty one
+-------------------------------------*/
+inline BiasedReadRecord* _find_biased_read(const BiasedRWLock* pLock, bool allowEmpty) noexcept
+{
+    BiasedReadRecord* pEmpty = nullptr;
+
+    for (BiasedReadRecord& record : tBiasedReads)
+    {
+        if (record.pLock == pLock)
+        {
+            return &record;
+        }
+
+        if (allowEmpty && !pEmpty && !record.pLock)
+        {
+            pEmpty = &record;
+        }
+    }
+
+    return pEmpty;
+}
+
+
+
+/*-------------------------------------
+ * Steady clock, in nanoseconds
+-------------------------------------*/
+inline uint64_t _biased_lock_time() noexcept
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // end anonymous namespace
+
+
 /*-----------------------------------------------------------------------------
  * PThreads R/W Semaphore
 -----------------------------------------------------------------------------*/
@@ -202,5 +265,175 @@ void FairRWLock::lock() noexcept
 
 
 
+/*-----------------------------------------------------------------------------
+ * Reader-Biased R/W Lock
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Reader fast-path
+-------------------------------------*/
+bool BiasedRWLock::_try_lock_biased() noexcept
+{
+    if (!mReaderBias.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    BiasedReadRecord* pRecord = _find_biased_read(this, true);
+    if (!pRecord)
+    {
+        return false;
+    }
+
+    std::atomic_uint32_t& count = mReaderSlots[tReaderSlot].count;
+    count.fetch_add(1, std::memory_order_seq_cst);
+
+    // Pairs with a writer revoking the bias before scanning the slots
+    if (!mReaderBias.load(std::memory_order_seq_cst))
+    {
+        count.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    pRecord->pLock = this;
+    ++pRecord->count;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Re-enable the reader bias
+-------------------------------------*/
+void BiasedRWLock::_restore_bias() noexcept
+{
+    // Called with a shared lock held, so no writer can be revoking the bias
+    if (!mReaderBias.load(std::memory_order_relaxed) && _biased_lock_time() >= mInhibitUntil.load(std::memory_order_relaxed))
+    {
+        mReaderBias.store(true, std::memory_order_release);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Non-Exclusive Lock
+-------------------------------------*/
+void BiasedRWLock::lock_shared() noexcept
+{
+    if (!_try_lock_biased())
+    {
+        mLock.lock_shared();
+        _restore_bias();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Exclusive Lock
+-------------------------------------*/
+void BiasedRWLock::lock() noexcept
+{
+    mLock.lock();
+
+    if (!mReaderBias.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    const uint64_t startTime = _biased_lock_time();
+    mReaderBias.store(false, std::memory_order_seq_cst);
+
+    for (ReaderSlot& slot : mReaderSlots)
+    {
+        while (slot.count.load(std::memory_order_seq_cst))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    const uint64_t endTime = _biased_lock_time();
+    mInhibitUntil.store(endTime + (endTime - startTime) * INHIBIT_MULTIPLIER, std::memory_order_relaxed);
+}
+
+
+
+/*-------------------------------------
+ * Attempt Non-Exclusive Lock
+-------------------------------------*/
+bool BiasedRWLock::try_lock_shared() noexcept
+{
+    if (_try_lock_biased())
+    {
+        return true;
+    }
+
+    if (mLock.try_lock_shared())
+    {
+        _restore_bias();
+        return true;
+    }
+
+    return false;
+}
+
+
+
+/*-------------------------------------
+ * Attempt Exclusive Lock
+-------------------------------------*/
+bool BiasedRWLock::try_lock() noexcept
+{
+    if (!mLock.try_lock())
+    {
+        return false;
+    }
+
+    if (!mReaderBias.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+
+    mReaderBias.store(false, std::memory_order_seq_cst);
+
+    for (ReaderSlot& slot : mReaderSlots)
+    {
+        if (slot.count.load(std::memory_order_seq_cst))
+        {
+            mReaderBias.store(true, std::memory_order_release);
+            mLock.unlock();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Non-Exclusive Unlock
+-------------------------------------*/
+void BiasedRWLock::unlock_shared() noexcept
+{
+    BiasedReadRecord* pRecord = _find_biased_read(this, false);
+
+    if (!pRecord)
+    {
+        mLock.unlock_shared();
+        return;
+    }
+
+    if (--pRecord->count == 0)
+    {
+        pRecord->pLock = nullptr;
+    }
+
+    mReaderSlots[tReaderSlot].count.fetch_sub(1, std::memory_order_release);
+}
+
+
+
 } // end utils namespace
 } // end ls namespace
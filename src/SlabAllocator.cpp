@@ -0,0 +1,735 @@
+/*
+ * File:   SlabAllocator.cpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 9:15 AM
+ */
+
+#include <bit> // std::bit_width
+#include <cstdint> // uintptr_t
+#include <utility> // std::move
+
+#include "lightsky/utils/Copy.h"
+#include "lightsky/utils/SlabAllocator.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * SlabAllocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Size class lookup
+-------------------------------------*/
+inline SlabAllocator::size_type SlabAllocator::_size_class(size_type numBytes) noexcept
+{
+    if (numBytes <= 128ull)
+    {
+        return (numBytes - 1ull) >> 4ull;
+    }
+
+    const size_type n = numBytes - 1ull;
+    const size_type p = (size_type)std::bit_width(n) - 1ull;
+    return 8ull + (p - 7ull) * 4ull + ((n - (1ull << p)) >> (p - 2ull));
+}
+
+
+
+/*-------------------------------------
+ * Bytes per block of a size class
+-------------------------------------*/
+inline SlabAllocator::size_type SlabAllocator::_class_size(size_type sizeClass) noexcept
+{
+    if (sizeClass < 8ull)
+    {
+        return (sizeClass + 1ull) * 16ull;
+    }
+
+    const size_type group = (sizeClass - 8ull) >> 2ull;
+    const size_type step = (sizeClass - 8ull) & 3ull;
+    return (128ull << group) + (step + 1ull) * (32ull << group);
+}
+
+
+
+/*-------------------------------------
+ * Locate the slab containing an allocation
+-------------------------------------*/
+inline SlabAllocator::SlabHeader* SlabAllocator::_slab_of(const void* p) noexcept
+{
+    return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(p) & (uintptr_t)slab_mask);
+}
+
+
+
+/*-------------------------------------
+ * Track a segment with unused slabs
+-------------------------------------*/
+inline void SlabAllocator::_link_avail(Segment* pSegment) noexcept
+{
+    pSegment->pPrevAvail = nullptr;
+    pSegment->pNextAvail = mAvailSegments;
+
+    if (mAvailSegments)
+    {
+        mAvailSegments->pPrevAvail = pSegment;
+    }
+
+    mAvailSegments = pSegment;
+}
+
+
+
+/*-------------------------------------
+ * Stop tracking a segment with unused slabs
+-------------------------------------*/
+inline void SlabAllocator::_unlink_avail(Segment* pSegment) noexcept
+{
+    if (pSegment->pPrevAvail)
+    {
+        pSegment->pPrevAvail->pNextAvail = pSegment->pNextAvail;
+    }
+    else
+    {
+        mAvailSegments = pSegment->pNextAvail;
+    }
+
+    if (pSegment->pNextAvail)
+    {
+        pSegment->pNextAvail->pPrevAvail = pSegment->pPrevAvail;
+    }
+
+    pSegment->pNextAvail = nullptr;
+    pSegment->pPrevAvail = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Track a slab with free blocks
+-------------------------------------*/
+inline void SlabAllocator::_link_partial(SlabHeader* pSlab) noexcept
+{
+    SlabHeader*& pHead = mPartialSlabs[pSlab->sizeClass];
+
+    pSlab->pPrev = nullptr;
+    pSlab->pNext = pHead;
+
+    if (pHead)
+    {
+        pHead->pPrev = pSlab;
+    }
+
+    pHead = pSlab;
+    pSlab->isListed = true;
+}
+
+
+
+/*-------------------------------------
+ * Stop tracking a slab with free blocks
+-------------------------------------*/
+inline void SlabAllocator::_unlink_partial(SlabHeader* pSlab) noexcept
+{
+    if (pSlab->pPrev)
+    {
+        pSlab->pPrev->pNext = pSlab->pNext;
+    }
+    else
+    {
+        mPartialSlabs[pSlab->sizeClass] = pSlab->pNext;
+    }
+
+    if (pSlab->pNext)
+    {
+        pSlab->pNext->pPrev = pSlab->pPrev;
+    }
+
+    pSlab->pNext = nullptr;
+    pSlab->pPrev = nullptr;
+    pSlab->isListed = false;
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a new segment
+-------------------------------------*/
+SlabAllocator::Segment* SlabAllocator::_allocate_segment() noexcept
+{
+    // One extra slab of space leaves room for the segment header and for
+    // aligning the first slab.
+    size_type rawBytes = (slabs_per_segment + 1ull) * slab_size;
+    void* const pRaw = this->memory_source().allocate(rawBytes, &rawBytes);
+    if (!pRaw)
+    {
+        return nullptr;
+    }
+
+    const uintptr_t rawBegin = reinterpret_cast<uintptr_t>(pRaw);
+    const uintptr_t rawEnd = rawBegin + (uintptr_t)rawBytes;
+    const uintptr_t slabsBegin = (rawBegin + sizeof(Segment) + (uintptr_t)(slab_size-1ull)) & (uintptr_t)slab_mask;
+    const size_type numSlabs = (size_type)(rawEnd - slabsBegin) / slab_size;
+
+    Segment* const pSegment = static_cast<Segment*>(pRaw);
+    pSegment->pPrev = nullptr;
+    pSegment->pNext = mSegments;
+    pSegment->pNextAvail = nullptr;
+    pSegment->pPrevAvail = nullptr;
+    pSegment->pRaw = pRaw;
+    pSegment->rawBytes = rawBytes;
+    pSegment->pFreeSlabs = nullptr;
+    pSegment->pNextUnused = reinterpret_cast<char*>(slabsBegin);
+    pSegment->pSlabsEnd = reinterpret_cast<char*>(slabsBegin) + numSlabs * slab_size;
+    pSegment->numSlabs = numSlabs;
+    pSegment->numFreeSlabs = numSlabs;
+
+    if (mSegments)
+    {
+        mSegments->pPrev = pSegment;
+    }
+
+    mSegments = pSegment;
+    _link_avail(pSegment);
+
+    return pSegment;
+}
+
+
+
+/*-------------------------------------
+ * Return a segment to the memory source
+-------------------------------------*/
+void SlabAllocator::_free_segment(Segment* pSegment) noexcept
+{
+    if (pSegment->pNextAvail || pSegment->pPrevAvail || mAvailSegments == pSegment)
+    {
+        _unlink_avail(pSegment);
+    }
+
+    if (pSegment->pPrev)
+    {
+        pSegment->pPrev->pNext = pSegment->pNext;
+    }
+    else
+    {
+        mSegments = pSegment->pNext;
+    }
+
+    if (pSegment->pNext)
+    {
+        pSegment->pNext->pPrev = pSegment->pPrev;
+    }
+
+    this->memory_source().free(pSegment->pRaw, pSegment->rawBytes);
+}
+
+
+
+/*-------------------------------------
+ * Prepare a slab for a size class
+-------------------------------------*/
+SlabAllocator::SlabHeader* SlabAllocator::_acquire_slab(size_type sizeClass) noexcept
+{
+    Segment* pSegment = mAvailSegments;
+    if (!pSegment)
+    {
+        pSegment = _allocate_segment();
+        if (!pSegment)
+        {
+            return nullptr;
+        }
+    }
+
+    SlabHeader* pSlab;
+    if (pSegment->pFreeSlabs)
+    {
+        pSlab = pSegment->pFreeSlabs;
+        pSegment->pFreeSlabs = pSlab->pNext;
+    }
+    else
+    {
+        pSlab = reinterpret_cast<SlabHeader*>(pSegment->pNextUnused);
+        pSegment->pNextUnused += slab_size;
+    }
+
+    if (--pSegment->numFreeSlabs == 0)
+    {
+        _unlink_avail(pSegment);
+    }
+
+    char* const pSlabBytes = reinterpret_cast<char*>(pSlab);
+    pSlab->pNext = nullptr;
+    pSlab->pPrev = nullptr;
+    pSlab->pSegment = pSegment;
+    pSlab->pFreeList = nullptr;
+    pSlab->pBump = pSlabBytes + slab_header_size;
+    pSlab->pEnd = pSlabBytes + slab_size;
+    pSlab->sizeClass = sizeClass;
+    pSlab->numUsed = 0;
+    pSlab->numBytes = _class_size(sizeClass);
+    pSlab->isListed = false;
+
+    _link_partial(pSlab);
+
+    return pSlab;
+}
+
+
+
+/*-------------------------------------
+ * Return an empty slab to its segment
+-------------------------------------*/
+void SlabAllocator::_release_slab(SlabHeader* pSlab) noexcept
+{
+    Segment* const pSegment = pSlab->pSegment;
+
+    if (pSlab->isListed)
+    {
+        _unlink_partial(pSlab);
+    }
+
+    pSlab->pNext = pSegment->pFreeSlabs;
+    pSegment->pFreeSlabs = pSlab;
+
+    if (pSegment->numFreeSlabs++ == 0)
+    {
+        _link_avail(pSegment);
+    }
+
+    if (pSegment->numFreeSlabs == pSegment->numSlabs)
+    {
+        _free_segment(pSegment);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Allocate beyond the largest size class
+-------------------------------------*/
+void* SlabAllocator::_allocate_large(size_type numBytes) noexcept
+{
+    if (numBytes > ~0ull - slab_header_size)
+    {
+        return nullptr;
+    }
+
+    // The header is placed on a slab boundary so _slab_of() works for large
+    // allocations as well.
+    size_type rawBytes = numBytes + slab_header_size;
+    void* pRaw = this->memory_source().allocate_aligned(rawBytes, slab_size, &rawBytes);
+    uintptr_t headerAddr = reinterpret_cast<uintptr_t>(pRaw);
+
+    if (!pRaw)
+    {
+        // Sources which can't align their memory are padded by a slab
+        if (numBytes > ~0ull - slab_header_size - slab_size)
+        {
+            return nullptr;
+        }
+
+        rawBytes = numBytes + slab_header_size + slab_size;
+        pRaw = this->memory_source().allocate(rawBytes, &rawBytes);
+        if (!pRaw)
+        {
+            return nullptr;
+        }
+
+        headerAddr = (reinterpret_cast<uintptr_t>(pRaw) + (uintptr_t)(slab_size-1ull)) & (uintptr_t)slab_mask;
+    }
+
+    // The raw pointer and size are kept in the pBump and numUsed fields.
+    SlabHeader* const pHeader = reinterpret_cast<SlabHeader*>(headerAddr);
+
+    pHeader->pPrev = nullptr;
+    pHeader->pNext = mLargeAllocs;
+    pHeader->pSegment = nullptr;
+    pHeader->pFreeList = nullptr;
+    pHeader->pBump = static_cast<char*>(pRaw);
+    pHeader->pEnd = nullptr;
+    pHeader->sizeClass = large_size_class;
+    pHeader->numUsed = rawBytes;
+    pHeader->numBytes = numBytes;
+    pHeader->isListed = true;
+
+    if (mLargeAllocs)
+    {
+        mLargeAllocs->pPrev = pHeader;
+    }
+
+    mLargeAllocs = pHeader;
+
+    return reinterpret_cast<char*>(pHeader) + slab_header_size;
+}
+
+
+
+/*-------------------------------------
+ * Free an allocation beyond the largest size class
+-------------------------------------*/
+void SlabAllocator::_free_large(SlabHeader* pHeader) noexcept
+{
+    if (pHeader->pPrev)
+    {
+        pHeader->pPrev->pNext = pHeader->pNext;
+    }
+    else
+    {
+        mLargeAllocs = pHeader->pNext;
+    }
+
+    if (pHeader->pNext)
+    {
+        pHeader->pNext->pPrev = pHeader->pPrev;
+    }
+
+    this->memory_source().free(pHeader->pBump, pHeader->numUsed);
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+SlabAllocator::~SlabAllocator() noexcept
+{
+    while (mLargeAllocs)
+    {
+        _free_large(mLargeAllocs);
+    }
+
+    while (mSegments)
+    {
+        _free_segment(mSegments);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+SlabAllocator::SlabAllocator(MemorySource& memorySource) noexcept :
+    Allocator{memorySource},
+    mPartialSlabs{},
+    mSegments{nullptr},
+    mAvailSegments{nullptr},
+    mLargeAllocs{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Move Constructor
+-------------------------------------*/
+SlabAllocator::SlabAllocator(SlabAllocator&& allocator) noexcept :
+    Allocator{std::move(allocator)},
+    mPartialSlabs{},
+    mSegments{allocator.mSegments},
+    mAvailSegments{allocator.mAvailSegments},
+    mLargeAllocs{allocator.mLargeAllocs}
+{
+    for (size_type i = 0; i < num_size_classes; ++i)
+    {
+        mPartialSlabs[i] = allocator.mPartialSlabs[i];
+        allocator.mPartialSlabs[i] = nullptr;
+    }
+
+    allocator.mSegments = nullptr;
+    allocator.mAvailSegments = nullptr;
+    allocator.mLargeAllocs = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Move Operator
+-------------------------------------*/
+SlabAllocator& SlabAllocator::operator=(SlabAllocator&& allocator) noexcept
+{
+    if (this == &allocator)
+    {
+        return *this;
+    }
+
+    while (mLargeAllocs)
+    {
+        _free_large(mLargeAllocs);
+    }
+
+    while (mSegments)
+    {
+        _free_segment(mSegments);
+    }
+
+    Allocator::operator=(std::move(allocator));
+
+    for (size_type i = 0; i < num_size_classes; ++i)
+    {
+        mPartialSlabs[i] = allocator.mPartialSlabs[i];
+        allocator.mPartialSlabs[i] = nullptr;
+    }
+
+    mSegments = allocator.mSegments;
+    allocator.mSegments = nullptr;
+
+    mAvailSegments = allocator.mAvailSegments;
+    allocator.mAvailSegments = nullptr;
+
+    mLargeAllocs = allocator.mLargeAllocs;
+    allocator.mLargeAllocs = nullptr;
+
+    return *this;
+}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+void* SlabAllocator::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    if (LS_UNLIKELY(!numBytes))
+    {
+        return nullptr;
+    }
+
+    if (LS_UNLIKELY(numBytes > max_slab_alloc_size))
+    {
+        void* const pData = _allocate_large(numBytes);
+        if (pData && pOutNumBytes)
+        {
+            *pOutNumBytes = numBytes;
+        }
+
+        return pData;
+    }
+
+    const size_type sizeClass = _size_class(numBytes);
+    SlabHeader* pSlab = mPartialSlabs[sizeClass];
+
+    if (LS_UNLIKELY(!pSlab))
+    {
+        pSlab = _acquire_slab(sizeClass);
+        if (!pSlab)
+        {
+            return nullptr;
+        }
+    }
+
+    const size_type blockSize = pSlab->numBytes;
+    void* pData = pSlab->pFreeList;
+
+    if (pData)
+    {
+        pSlab->pFreeList = *reinterpret_cast<void**>(pData);
+    }
+    else
+    {
+        // Blocks are carved from untouched memory on first use
+        pData = pSlab->pBump;
+        pSlab->pBump += blockSize;
+    }
+
+    ++pSlab->numUsed;
+
+    if (!pSlab->pFreeList && (pSlab->pBump + blockSize) > pSlab->pEnd)
+    {
+        _unlink_partial(pSlab);
+    }
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = blockSize;
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Calloc
+-------------------------------------*/
+void* SlabAllocator::allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes) noexcept
+{
+    if (!numElements || !numBytesPerElement)
+    {
+        return nullptr;
+    }
+
+    if (calloc_can_overflow(numElements, numBytesPerElement))
+    {
+        return nullptr;
+    }
+
+    const size_type numBytes = numElements * numBytesPerElement;
+    void* const pData = this->allocate(numBytes, pOutNumBytes);
+    if (pData)
+    {
+        fast_memset(pData, '\0', numBytes);
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Realloc
+-------------------------------------*/
+void* SlabAllocator::reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!p)
+    {
+        return this->allocate(numNewBytes, pOutNumBytes);
+    }
+
+    if (!numNewBytes)
+    {
+        this->free(p);
+        return nullptr;
+    }
+
+    const SlabHeader* const pSlab = _slab_of(p);
+    const size_type numPrevBytes = pSlab->numBytes;
+
+    // Keep the block if it lands in the same size class (or a large
+    // allocation shrinks by less than half).
+    const bool keepBlock = (pSlab->sizeClass == large_size_class)
+        ? (numNewBytes <= numPrevBytes && numNewBytes > max_slab_alloc_size && numNewBytes >= numPrevBytes/2ull)
+        : (numNewBytes <= numPrevBytes && _size_class(numNewBytes) == pSlab->sizeClass);
+
+    if (keepBlock)
+    {
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = numPrevBytes;
+        }
+
+        return p;
+    }
+
+    void* const pNewData = this->allocate(numNewBytes, pOutNumBytes);
+    if (pNewData)
+    {
+        fast_memcpy(pNewData, p, numNewBytes < numPrevBytes ? numNewBytes : numPrevBytes);
+        this->free(p);
+    }
+
+    return pNewData;
+}
+
+
+
+/*-------------------------------------
+ * Realloc (sized)
+-------------------------------------*/
+void* SlabAllocator::reallocate(void* p, size_type numNewBytes, size_type, size_type* pOutNumBytes) noexcept
+{
+    return this->reallocate(p, numNewBytes, pOutNumBytes);
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void SlabAllocator::free(void* p) noexcept
+{
+    if (LS_UNLIKELY(!p))
+    {
+        return;
+    }
+
+    SlabHeader* const pSlab = _slab_of(p);
+
+    if (LS_UNLIKELY(pSlab->sizeClass == large_size_class))
+    {
+        _free_large(pSlab);
+        return;
+    }
+
+    *reinterpret_cast<void**>(p) = pSlab->pFreeList;
+    pSlab->pFreeList = p;
+
+    if (--pSlab->numUsed == 0)
+    {
+        // Keep one empty slab per size class around to avoid thrashing the
+        // segment on alternating allocate/free calls.
+        if (!pSlab->isListed || pSlab->pNext || pSlab->pPrev)
+        {
+            _release_slab(pSlab);
+            return;
+        }
+    }
+
+    if (!pSlab->isListed)
+    {
+        _link_partial(pSlab);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void SlabAllocator::free(void* p, size_type) noexcept
+{
+    this->free(p);
+}
+
+
+
+/*-------------------------------------
+ * Free-list statistics
+-------------------------------------*/
+bool SlabAllocator::free_list_stats(FreeListStats& outStats) const noexcept
+{
+    constexpr size_type slabCapacity = (size_type)slab_size - (size_type)slab_header_size;
+    outStats = FreeListStats{0, 0, 0};
+
+    for (size_type i = 0; i < num_size_classes; ++i)
+    {
+        for (const SlabHeader* pSlab = mPartialSlabs[i]; pSlab; pSlab = pSlab->pNext)
+        {
+            const size_type numFree = (slabCapacity / pSlab->numBytes) - pSlab->numUsed;
+            if (!numFree)
+            {
+                continue;
+            }
+
+            outStats.numFreeBlocks += numFree;
+            outStats.numFreeBytes += numFree * pSlab->numBytes;
+
+            if (pSlab->numBytes > outStats.largestFreeBlock)
+            {
+                outStats.largestFreeBlock = pSlab->numBytes;
+            }
+        }
+    }
+
+    for (const Segment* pSegment = mSegments; pSegment; pSegment = pSegment->pNext)
+    {
+        outStats.numFreeBlocks += pSegment->numFreeSlabs;
+        outStats.numFreeBytes += pSegment->numFreeSlabs * slabCapacity;
+
+        if (pSegment->numFreeSlabs)
+        {
+            outStats.largestFreeBlock = max_slab_alloc_size;
+        }
+    }
+
+    return true;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,295 @@
+/*
+ * File:   TaskGraph.cpp
+ * Author: miles
+ * Created on October 17, 2026, at 9:45 p.m.
+ */
+
+#include <utility> // std::move
+
+#include "lightsky/utils/TaskGraph.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * TaskGraph
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Execute a node and its released successors
+-------------------------------------*/
+void TaskGraph::_execute(node_id nodeId) noexcept
+{
+    // Successors are handed to the pool in small batches to reduce the
+    // number of times its threads are woken.
+    constexpr std::size_t max_batch_size = 16;
+    node_id released[max_batch_size];
+
+    while (nodeId != INVALID_NODE)
+    {
+        const Node& node = mNodes[nodeId];
+        node_id next = INVALID_NODE;
+        std::size_t numReleased = 0;
+
+        node.task();
+
+        for (node_id successor : node.successors)
+        {
+            if (mPending[successor].fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                continue;
+            }
+
+            if (next == INVALID_NODE)
+            {
+                next = successor;
+                continue;
+            }
+
+            released[numReleased++] = successor;
+            if (numReleased == max_batch_size)
+            {
+                mDispatch(mPool, this, released, numReleased);
+                numReleased = 0;
+            }
+        }
+
+        if (numReleased)
+        {
+            mDispatch(mPool, this, released, numReleased);
+        }
+
+        // The waiting thread may destroy *this as soon as it sees the last
+        // node finish. Only one thread can observe a single remaining node,
+        // so that thread takes the lock before the final decrement, leaving
+        // wait() unable to return until the graph is no longer touched.
+        std::size_t numRemaining = mNumRemaining.load(std::memory_order_acquire);
+        while (numRemaining != 1)
+        {
+            if (mNumRemaining.compare_exchange_weak(numRemaining, numRemaining-1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                break;
+            }
+        }
+
+        if (numRemaining == 1)
+        {
+            std::lock_guard<std::mutex> waitLock{mWaitMtx};
+            mNumRemaining.store(0, std::memory_order_release);
+            mWaitCond.notify_all();
+        }
+
+        nodeId = next;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Reset dependency counters
+-------------------------------------*/
+void TaskGraph::_reset_counters() noexcept
+{
+    const std::size_t numNodes = mNodes.size();
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        mPending[i].store(mNodes[i].numDependencies, std::memory_order_relaxed);
+    }
+
+    mNumRemaining.store(numNodes, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Serial execution
+-------------------------------------*/
+void TaskGraph::_run_serial() noexcept
+{
+    for (node_id nodeId : mOrder)
+    {
+        mNodes[nodeId].task();
+    }
+
+    mNumRemaining.store(0, std::memory_order_release);
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+TaskGraph::~TaskGraph() noexcept
+{
+    if (mIsRunning)
+    {
+        wait();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+TaskGraph::TaskGraph() noexcept :
+    mNodes{},
+    mOrder{},
+    mNumRoots{0},
+    mPending{},
+    mNumRemaining{0},
+    mIsFinalized{false},
+    mIsRunning{false},
+    mPool{nullptr},
+    mDispatch{nullptr},
+    mWaitMtx{},
+    mWaitCond{}
+{}
+
+
+
+/*-------------------------------------
+ * Add a node
+-------------------------------------*/
+TaskGraph::node_id TaskGraph::add(task_type&& task) noexcept
+{
+    if (!task || mIsRunning)
+    {
+        return INVALID_NODE;
+    }
+
+    mNodes.emplace_back(Node{std::move(task), std::vector<node_id>{}, 0});
+    mIsFinalized = false;
+
+    return mNodes.size() - 1u;
+}
+
+
+
+/*-------------------------------------
+ * Add an edge
+-------------------------------------*/
+bool TaskGraph::add_dependency(node_id node, node_id dependsOn) noexcept
+{
+    if (mIsRunning || node >= mNodes.size() || dependsOn >= mNodes.size() || node == dependsOn)
+    {
+        return false;
+    }
+
+    mNodes[dependsOn].successors.push_back(node);
+    mNodes[node].numDependencies++;
+    mIsFinalized = false;
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Remove all nodes
+-------------------------------------*/
+void TaskGraph::clear() noexcept
+{
+    if (mIsRunning)
+    {
+        wait();
+    }
+
+    mNodes.clear();
+    mOrder.clear();
+    mNumRoots = 0;
+    mPending.reset();
+    mIsFinalized = false;
+}
+
+
+
+/*-------------------------------------
+ * Validate the graph
+-------------------------------------*/
+bool TaskGraph::finalize() noexcept
+{
+    if (mIsRunning)
+    {
+        return false;
+    }
+
+    const std::size_t numNodes = mNodes.size();
+
+    mIsFinalized = false;
+    mPending = make_unique_array<std::atomic<uint32_t>>(numNodes);
+    if (numNodes && !mPending)
+    {
+        return false;
+    }
+
+    // Kahn's algorithm, using the pending counters as scratch space. The
+    // order starts with every root so they can be dispatched together.
+    mOrder.clear();
+    mOrder.reserve(numNodes);
+
+    for (std::size_t i = 0; i < numNodes; ++i)
+    {
+        mPending[i].store(mNodes[i].numDependencies, std::memory_order_relaxed);
+        if (!mNodes[i].numDependencies)
+        {
+            mOrder.push_back(i);
+        }
+    }
+
+    mNumRoots = mOrder.size();
+
+    for (std::size_t i = 0; i < mOrder.size(); ++i)
+    {
+        for (node_id successor : mNodes[mOrder[i]].successors)
+        {
+            if (mPending[successor].fetch_sub(1, std::memory_order_relaxed) == 1)
+            {
+                mOrder.push_back(successor);
+            }
+        }
+    }
+
+    // Any node which was never released is part of a cycle
+    if (mOrder.size() != numNodes)
+    {
+        mOrder.clear();
+        mNumRoots = 0;
+        return false;
+    }
+
+    mIsFinalized = true;
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Wait for the graph to finish
+-------------------------------------*/
+void TaskGraph::wait() noexcept
+{
+    if (!mIsRunning)
+    {
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> waitLock{mWaitMtx};
+        mWaitCond.wait(waitLock, [this]()->bool
+        {
+            return mNumRemaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    mIsRunning = false;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,703 @@
+/*
+ * File:   ThreadCachedAllocator.cpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 3:05 PM
+ */
+
+#include "lightsky/setup/OS.h"
+
+#if defined(LS_OS_UNIX)
+    #include <pthread.h>
+#endif
+
+#include <bit> // std::bit_width
+#include <cstdint> // uintptr_t
+#include <mutex> // std::lock_guard
+
+#include "lightsky/utils/Copy.h"
+#include "lightsky/utils/ThreadCachedAllocator.hpp"
+
+
+
+/*-----------------------------------------------------------------------------
+ * Thread-local data
+-----------------------------------------------------------------------------*/
+namespace ls
+{
+namespace utils
+{
+
+/*-------------------------------------
+ * Per-thread cache for a single allocator
+-------------------------------------*/
+struct ThreadCachedAllocator::ThreadCache
+{
+    struct FreeList
+    {
+        void* pHead;
+        size_type count;
+    };
+
+    ThreadCachedAllocator* pOwner;
+    ThreadCache* pPrev;
+    ThreadCache* pNext;
+    FreeList lists[ThreadCachedAllocator::num_size_classes];
+};
+
+} // end utils namespace
+} // end ls namespace
+
+
+
+namespace
+{
+
+namespace utils = ls::utils;
+
+typedef utils::ThreadCachedAllocator::size_type size_type;
+
+/*-------------------------------------
+ * Size class table
+ *
+ * Classes step by 16 bytes up to 128 bytes, then by a quarter of the
+ * previous power-of-two up to 4096 bytes.
+-------------------------------------*/
+constexpr size_type _class_size(size_type sizeClass) noexcept
+{
+    return (sizeClass < 8ull)
+        ? ((sizeClass + 1ull) * 16ull)
+        : ((128ull << ((sizeClass - 8ull) / 4ull)) + (((sizeClass - 8ull) % 4ull) + 1ull) * ((32ull << ((sizeClass - 8ull) / 4ull))));
+}
+
+static_assert(_class_size(0) == 16, "Unexpected minimum size class.");
+static_assert(_class_size(8) == 160, "Unexpected size class step.");
+static_assert(_class_size(utils::ThreadCachedAllocator::num_size_classes-1) == utils::ThreadCachedAllocator::max_cached_size, "Unexpected maximum size class.");
+
+
+
+/*-------------------------------------
+ * All caches held by the current thread
+-------------------------------------*/
+struct ThreadCacheSet
+{
+    utils::ThreadCachedAllocator::ThreadCache caches[LS_UTILS_MAX_THREAD_CACHES];
+    bool registered;
+};
+
+// Trivially constructed and destroyed so a thread cache is safe to use
+// from within malloc() and during thread teardown.
+thread_local ThreadCacheSet tCacheSet;
+
+#if defined(LS_OS_UNIX)
+    pthread_once_t gCacheKeyOnce = PTHREAD_ONCE_INIT;
+    pthread_key_t gCacheKey;
+#endif
+
+} // end anonymous namespace
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * ThreadCachedAllocator
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Size class lookup
+-------------------------------------*/
+inline ThreadCachedAllocator::size_type ThreadCachedAllocator::_size_class(size_type numBytes) noexcept
+{
+    if (numBytes <= 128ull)
+    {
+        return (numBytes - 1ull) >> 4ull;
+    }
+
+    const size_type n = numBytes - 1ull;
+    const size_type p = (size_type)std::bit_width(n) - 1ull;
+    return 8ull + (p - 7ull) * 4ull + ((n - (1ull << p)) >> (p - 2ull));
+}
+
+
+
+/*-------------------------------------
+ * Blocks per refill/flush
+-------------------------------------*/
+inline ThreadCachedAllocator::size_type ThreadCachedAllocator::_batch_size(size_type sizeClass) noexcept
+{
+    const size_type n = 16384ull / _class_size(sizeClass);
+    return n < 4ull ? 4ull : (n > 64ull ? 64ull : n);
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the calling thread's cache
+-------------------------------------*/
+ThreadCachedAllocator::ThreadCache* ThreadCachedAllocator::_thread_cache() noexcept
+{
+    ThreadCacheSet& cacheSet = tCacheSet;
+    ThreadCache* pUnused = nullptr;
+
+    for (ThreadCache& cache : cacheSet.caches)
+    {
+        if (LS_LIKELY(cache.pOwner == this))
+        {
+            return &cache;
+        }
+
+        if (!pUnused && !cache.pOwner)
+        {
+            pUnused = &cache;
+        }
+    }
+
+    if (!pUnused)
+    {
+        return nullptr;
+    }
+
+    if (!cacheSet.registered)
+    {
+        #if defined(LS_OS_UNIX)
+            pthread_once(&gCacheKeyOnce, []()->void
+            {
+                pthread_key_create(&gCacheKey, &ThreadCachedAllocator::_release_thread_caches);
+            });
+            pthread_setspecific(gCacheKey, &cacheSet);
+
+        #else
+            static thread_local struct ThreadCacheReaper
+            {
+                ~ThreadCacheReaper() noexcept
+                {
+                    ThreadCachedAllocator::_release_thread_caches(&tCacheSet);
+                }
+            } reaper;
+            (void)reaper;
+        #endif
+
+        cacheSet.registered = true;
+    }
+
+    pUnused->pOwner = this;
+    pUnused->pPrev = nullptr;
+
+    {
+        std::lock_guard<SpinLock> lock{mLock};
+        pUnused->pNext = mCaches;
+        if (mCaches)
+        {
+            mCaches->pPrev = pUnused;
+        }
+        mCaches = pUnused;
+    }
+
+    return pUnused;
+}
+
+
+
+/*-------------------------------------
+ * Uncached allocation
+-------------------------------------*/
+void* ThreadCachedAllocator::_allocate_central(size_type sizeClass, size_type numBytes) noexcept
+{
+    BlockHeader* pHeader;
+    {
+        std::lock_guard<SpinLock> lock{mLock};
+        pHeader = static_cast<BlockHeader*>(mCentral->allocate(sizeof(BlockHeader) + numBytes));
+    }
+
+    if (LS_UNLIKELY(!pHeader))
+    {
+        return nullptr;
+    }
+
+    pHeader->sizeClass = sizeClass;
+    pHeader->numBytes = numBytes;
+    return pHeader + 1;
+}
+
+
+
+/*-------------------------------------
+ * Pull a batch of blocks from the central heap
+-------------------------------------*/
+bool ThreadCachedAllocator::_refill(ThreadCache& cache, size_type sizeClass) noexcept
+{
+    const size_type batchSize = _batch_size(sizeClass);
+    const size_type classBytes = _class_size(sizeClass);
+    ThreadCache::FreeList& freeList = cache.lists[sizeClass];
+    size_type numBlocks = 0;
+
+    {
+        std::lock_guard<SpinLock> lock{mLock};
+
+        for (; numBlocks < batchSize; ++numBlocks)
+        {
+            BlockHeader* const pHeader = static_cast<BlockHeader*>(mCentral->allocate(sizeof(BlockHeader) + classBytes));
+            if (!pHeader)
+            {
+                break;
+            }
+
+            pHeader->sizeClass = sizeClass;
+            pHeader->numBytes = classBytes;
+
+            void* const pBlock = pHeader + 1;
+            *reinterpret_cast<void**>(pBlock) = freeList.pHead;
+            freeList.pHead = pBlock;
+        }
+    }
+
+    freeList.count += numBlocks;
+    return numBlocks != 0;
+}
+
+
+
+/*-------------------------------------
+ * Return a batch of blocks to the central heap
+-------------------------------------*/
+void ThreadCachedAllocator::_flush(ThreadCache& cache, size_type sizeClass, size_type numBlocks) noexcept
+{
+    ThreadCache::FreeList& freeList = cache.lists[sizeClass];
+    void* pBlocks = freeList.pHead;
+    void* pIter = pBlocks;
+    void* pLast = nullptr;
+    size_type i = 0;
+
+    // Detach the blocks before taking the lock
+    for (; i < numBlocks && pIter; ++i)
+    {
+        pLast = pIter;
+        pIter = *reinterpret_cast<void**>(pIter);
+    }
+
+    if (pLast)
+    {
+        *reinterpret_cast<void**>(pLast) = nullptr;
+    }
+
+    freeList.pHead = pIter;
+    freeList.count -= i;
+
+    std::lock_guard<SpinLock> lock{mLock};
+    while (pBlocks)
+    {
+        void* const pNext = *reinterpret_cast<void**>(pBlocks);
+        mCentral->free(static_cast<BlockHeader*>(pBlocks) - 1);
+        pBlocks = pNext;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Return a cache's contents to the central heap (lock held)
+-------------------------------------*/
+void ThreadCachedAllocator::_release_all(ThreadCache& cache) noexcept
+{
+    for (ThreadCache::FreeList& freeList : cache.lists)
+    {
+        void* pBlocks = freeList.pHead;
+
+        while (pBlocks)
+        {
+            void* const pNext = *reinterpret_cast<void**>(pBlocks);
+            mCentral->free(static_cast<BlockHeader*>(pBlocks) - 1);
+            pBlocks = pNext;
+        }
+
+        freeList.pHead = nullptr;
+        freeList.count = 0;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Detach a cache from *this
+-------------------------------------*/
+void ThreadCachedAllocator::_retire(ThreadCache& cache) noexcept
+{
+    std::lock_guard<SpinLock> lock{mLock};
+
+    _release_all(cache);
+
+    if (cache.pPrev)
+    {
+        cache.pPrev->pNext = cache.pNext;
+    }
+    else
+    {
+        mCaches = cache.pNext;
+    }
+
+    if (cache.pNext)
+    {
+        cache.pNext->pPrev = cache.pPrev;
+    }
+
+    cache.pOwner = nullptr;
+    cache.pPrev = nullptr;
+    cache.pNext = nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Thread exit
+-------------------------------------*/
+void ThreadCachedAllocator::_release_thread_caches(void* pCacheSet) noexcept
+{
+    ThreadCacheSet* const pSet = static_cast<ThreadCacheSet*>(pCacheSet);
+
+    for (ThreadCache& cache : pSet->caches)
+    {
+        if (cache.pOwner)
+        {
+            cache.pOwner->_retire(cache);
+        }
+    }
+
+    // Any allocations made after this point (i.e. by other thread-local
+    // destructors) will register the cache again.
+    pSet->registered = false;
+}
+
+
+
+/*-------------------------------------
+ * Get the central heap
+-------------------------------------*/
+const MemorySource& ThreadCachedAllocator::memory_source() const noexcept
+{
+    return *mCentral;
+}
+
+
+
+/*-------------------------------------
+ * Get the central heap
+-------------------------------------*/
+MemorySource& ThreadCachedAllocator::memory_source() noexcept
+{
+    return *mCentral;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+ThreadCachedAllocator::~ThreadCachedAllocator() noexcept
+{
+    std::lock_guard<SpinLock> lock{mLock};
+
+    while (mCaches)
+    {
+        ThreadCache* const pCache = mCaches;
+        mCaches = pCache->pNext;
+
+        _release_all(*pCache);
+        pCache->pOwner = nullptr;
+        pCache->pPrev = nullptr;
+        pCache->pNext = nullptr;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+ThreadCachedAllocator::ThreadCachedAllocator(IAllocator& centralHeap) noexcept :
+    IAllocator{},
+    mLock{},
+    mCentral{&centralHeap},
+    mCaches{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+void* ThreadCachedAllocator::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    if (LS_UNLIKELY(!numBytes))
+    {
+        return nullptr;
+    }
+
+    if (numBytes > max_cached_size)
+    {
+        void* const pData = _allocate_central(num_size_classes, numBytes);
+        if (pData && pOutNumBytes)
+        {
+            *pOutNumBytes = numBytes;
+        }
+
+        return pData;
+    }
+
+    const size_type sizeClass = _size_class(numBytes);
+    const size_type classBytes = _class_size(sizeClass);
+    ThreadCache* const pCache = _thread_cache();
+    void* pData;
+
+    if (LS_LIKELY(pCache != nullptr))
+    {
+        ThreadCache::FreeList& freeList = pCache->lists[sizeClass];
+        if (!freeList.pHead && !_refill(*pCache, sizeClass))
+        {
+            return nullptr;
+        }
+
+        pData = freeList.pHead;
+        freeList.pHead = *reinterpret_cast<void**>(pData);
+        --freeList.count;
+    }
+    else
+    {
+        pData = _allocate_central(sizeClass, classBytes);
+    }
+
+    if (pData && pOutNumBytes)
+    {
+        *pOutNumBytes = classBytes;
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Calloc
+-------------------------------------*/
+void* ThreadCachedAllocator::allocate_contiguous(size_type numElements, size_type numBytesPerElement, size_type* pOutNumBytes) noexcept
+{
+    if (!numElements || !numBytesPerElement)
+    {
+        return nullptr;
+    }
+
+    if (calloc_can_overflow(numElements, numBytesPerElement))
+    {
+        return nullptr;
+    }
+
+    const size_type numBytes = numElements * numBytesPerElement;
+    void* const pData = this->allocate(numBytes, pOutNumBytes);
+    if (pData)
+    {
+        fast_memset(pData, '\0', numBytes);
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Aligned allocation
+-------------------------------------*/
+void* ThreadCachedAllocator::allocate_aligned(size_type numBytes, size_type alignment, size_type* pOutNumBytes) noexcept
+{
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = 0;
+    }
+
+    if (LS_UNLIKELY(!numBytes || !alignment || (alignment & (alignment - 1ull))))
+    {
+        return nullptr;
+    }
+
+    if (alignment <= alignof(BlockHeader))
+    {
+        return this->allocate(numBytes, pOutNumBytes);
+    }
+
+    // Room for the block's offset, its header, and enough padding to align
+    // the returned pointer.
+    const size_type padding = sizeof(BlockHeader) + alignment;
+    if (LS_UNLIKELY(numBytes > ~size_type{0} - padding - sizeof(BlockHeader)))
+    {
+        return nullptr;
+    }
+
+    unsigned char* pBase;
+    {
+        std::lock_guard<SpinLock> lock{mLock};
+        pBase = static_cast<unsigned char*>(mCentral->allocate(sizeof(BlockHeader) + padding + numBytes));
+    }
+
+    if (LS_UNLIKELY(!pBase))
+    {
+        return nullptr;
+    }
+
+    const uintptr_t dataAddr = (reinterpret_cast<uintptr_t>(pBase) + sizeof(BlockHeader)*2 + (uintptr_t)alignment - 1u) & ~((uintptr_t)alignment - 1u);
+    unsigned char* const pData = reinterpret_cast<unsigned char*>(dataAddr);
+    BlockHeader* const pHeader = reinterpret_cast<BlockHeader*>(pData) - 1;
+
+    pHeader->sizeClass = aligned_size_class;
+    pHeader->numBytes = numBytes;
+    reinterpret_cast<size_type*>(pHeader)[-1] = (size_type)(pData - pBase);
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = numBytes;
+    }
+
+    return pData;
+}
+
+
+
+/*-------------------------------------
+ * Realloc
+-------------------------------------*/
+void* ThreadCachedAllocator::reallocate(void* p, size_type numNewBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!p)
+    {
+        return this->allocate(numNewBytes, pOutNumBytes);
+    }
+
+    if (!numNewBytes)
+    {
+        this->free(p);
+        return nullptr;
+    }
+
+    const BlockHeader* const pHeader = static_cast<const BlockHeader*>(p) - 1;
+    const size_type numPrevBytes = pHeader->numBytes;
+
+    // Keep the current block unless a large allocation shrinks by over half
+    if (numNewBytes <= numPrevBytes && (pHeader->sizeClass < num_size_classes || numNewBytes >= numPrevBytes/2ull))
+    {
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = numPrevBytes;
+        }
+
+        return p;
+    }
+
+    void* const pNewData = this->allocate(numNewBytes, pOutNumBytes);
+    if (pNewData)
+    {
+        fast_memcpy(pNewData, p, numNewBytes < numPrevBytes ? numNewBytes : numPrevBytes);
+        this->free(p);
+    }
+
+    return pNewData;
+}
+
+
+
+/*-------------------------------------
+ * Realloc (sized)
+-------------------------------------*/
+void* ThreadCachedAllocator::reallocate(void* p, size_type numNewBytes, size_type, size_type* pOutNumBytes) noexcept
+{
+    return this->reallocate(p, numNewBytes, pOutNumBytes);
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void ThreadCachedAllocator::free(void* p) noexcept
+{
+    if (LS_UNLIKELY(!p))
+    {
+        return;
+    }
+
+    BlockHeader* const pHeader = static_cast<BlockHeader*>(p) - 1;
+    const size_type sizeClass = pHeader->sizeClass;
+
+    if (LS_LIKELY(sizeClass < num_size_classes))
+    {
+        ThreadCache* const pCache = _thread_cache();
+
+        if (LS_LIKELY(pCache != nullptr))
+        {
+            ThreadCache::FreeList& freeList = pCache->lists[sizeClass];
+            *reinterpret_cast<void**>(p) = freeList.pHead;
+            freeList.pHead = p;
+
+            const size_type batchSize = _batch_size(sizeClass);
+            if (++freeList.count > batchSize * 2ull)
+            {
+                _flush(*pCache, sizeClass, batchSize);
+            }
+
+            return;
+        }
+    }
+
+    void* pBlock = pHeader;
+    if (sizeClass == aligned_size_class)
+    {
+        pBlock = static_cast<unsigned char*>(p) - reinterpret_cast<size_type*>(pHeader)[-1];
+    }
+
+    std::lock_guard<SpinLock> lock{mLock};
+    mCentral->free(pBlock);
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void ThreadCachedAllocator::free(void* p, size_type) noexcept
+{
+    this->free(p);
+}
+
+
+
+/*-------------------------------------
+ * Usable size of an allocation
+-------------------------------------*/
+ThreadCachedAllocator::size_type ThreadCachedAllocator::usable_size(const void* p) const noexcept
+{
+    return p ? (static_cast<const BlockHeader*>(p) - 1)->numBytes : 0;
+}
+
+
+
+/*-------------------------------------
+ * Flush the current thread's cache
+-------------------------------------*/
+void ThreadCachedAllocator::flush_thread_cache() noexcept
+{
+    for (ThreadCache& cache : tCacheSet.caches)
+    {
+        if (cache.pOwner == this)
+        {
+            std::lock_guard<SpinLock> lock{mLock};
+            _release_all(cache);
+            break;
+        }
+    }
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,185 @@
+/*
+ * File:   ThreadCachedMalloc.cpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 4:20 PM
+ */
+
+/*
+ * Drop-in replacement for malloc(), calloc(), realloc(), and free(), built
+ * into the "lsmalloc" shared library. On Unix-like systems the aligned
+ * allocation functions, and malloc_usable_size() on Linux, are replaced as
+ * well so every pointer passed to free() originates from lsmalloc. Do not
+ * add this file to the main LightUtils library.
+ */
+
+#include <cerrno> // EINVAL, ENOMEM
+#include <new> // placement new
+
+#include "lightsky/setup/Api.h"
+#include "lightsky/setup/OS.h"
+
+#include "lightsky/utils/GeneralAllocator.hpp"
+#include "lightsky/utils/ThreadCachedAllocator.hpp"
+
+namespace utils = ls::utils;
+
+#ifdef LS_COMPILER_MSC
+    #define _LSMALLOC_LINKAGE
+    #define _LSMALLOC_API LS_CCALL
+    #undef calloc
+    #undef free
+    #undef malloc
+    #undef realloc
+#else
+    // GCC ignores visibility attributes placed after the return type
+    #define _LSMALLOC_LINKAGE extern "C" LS_API
+    #define _LSMALLOC_API
+#endif
+
+
+
+namespace
+{
+
+constexpr unsigned long long central_cache_size = 4u*1024u*1024u-(sizeof(unsigned long long)*8);
+
+typedef utils::GeneralAllocator<central_cache_size, true> CentralAllocatorType;
+
+
+
+/*-------------------------------------
+ * Process-wide heap
+-------------------------------------*/
+struct MallocHeap
+{
+    utils::SystemMemorySource memSource;
+    CentralAllocatorType centralHeap;
+    utils::ThreadCachedAllocator allocator;
+
+    MallocHeap() noexcept :
+        memSource{},
+        centralHeap{memSource},
+        allocator{centralHeap}
+    {}
+};
+
+
+
+// The heap is never destroyed. Memory may still be freed by other threads
+// or by static destructors after this library's own destructors run.
+alignas(MallocHeap) unsigned char gHeapStorage[sizeof(MallocHeap)];
+
+inline LS_INLINE utils::ThreadCachedAllocator& _get_allocator() noexcept
+{
+    static MallocHeap* const pHeap = new(gHeapStorage) MallocHeap{};
+    return pHeap->allocator;
+}
+
+
+
+// posix_memalign() and aligned_alloc() require a power-of-two alignment
+// which is a multiple of sizeof(void*).
+inline LS_INLINE bool _is_valid_alignment(size_t alignment) noexcept
+{
+    return alignment && !(alignment & (alignment - 1u)) && !(alignment % sizeof(void*));
+}
+
+} // end anonymous namespace
+
+
+
+#ifdef LS_COMPILER_MSC
+    #pragma warning(disable:4273) // previous definition of malloc-based functions
+#endif
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API malloc(size_t size)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate(size);
+}
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API calloc(size_t num, size_t size)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate_contiguous(num, size);
+}
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API realloc(void* ptr, size_t size)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.reallocate(ptr, size);
+}
+
+_LSMALLOC_LINKAGE void _LSMALLOC_API free(void* ptr)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    a.free(ptr);
+}
+
+#if defined(LS_OS_UNIX)
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API aligned_alloc(size_t alignment, size_t size)
+{
+    if (!_is_valid_alignment(alignment))
+    {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate_aligned(size, alignment);
+}
+
+_LSMALLOC_LINKAGE int _LSMALLOC_API posix_memalign(void** memptr, size_t alignment, size_t size)
+{
+    if (!_is_valid_alignment(alignment))
+    {
+        return EINVAL;
+    }
+
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    void* const p = a.allocate_aligned(size, alignment);
+    if (!p && size)
+    {
+        return ENOMEM;
+    }
+
+    *memptr = p;
+    return 0;
+}
+
+#endif /* LS_OS_UNIX */
+
+#if defined(LS_OS_LINUX)
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API memalign(size_t alignment, size_t size)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate_aligned(size, alignment);
+}
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API valloc(size_t size)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate_aligned(size, utils::SystemMemorySource::page_size());
+}
+
+_LSMALLOC_LINKAGE void* _LSMALLOC_API pvalloc(size_t size)
+{
+    const size_t pageSize = (size_t)utils::SystemMemorySource::page_size();
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return a.allocate_aligned((size + pageSize - 1u) & ~(pageSize - 1u), pageSize);
+}
+
+_LSMALLOC_LINKAGE size_t _LSMALLOC_API malloc_usable_size(void* ptr)
+{
+    utils::ThreadCachedAllocator& a = _get_allocator();
+    return (size_t)a.usable_size(ptr);
+}
+
+#endif /* LS_OS_LINUX */
+
+#ifdef LS_COMPILER_MSC
+    #pragma warning(default:4273) // previous definition of malloc-based functions
+#endif
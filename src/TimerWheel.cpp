@@ -0,0 +1,403 @@
+/*
+ * File:   TimerWheel.cpp
+ * Author: miles
+ * Created on October 19, 2026, at 1:45 p.m.
+ */
+
+#include <algorithm> // std::fill
+#include <limits>
+#include <utility> // std::move
+
+#include "lightsky/utils/TimerWheel.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * TimerWheel
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+TimerWheel::TimerWheel(std::chrono::nanoseconds tickLength, clock_type::time_point startTime) noexcept :
+    mLock{},
+    mTickLength{tickLength.count() > 0 ? tickLength : std::chrono::nanoseconds{1}},
+    mStartTime{startTime},
+    mCurrentTick{0},
+    mNumTimers{0},
+    mFreeList{INVALID_INDEX},
+    mNodes{},
+    mSlots{},
+    mLevelCounts{}
+{
+    std::fill(mSlots, mSlots + NUM_LEVELS*NUM_SLOTS, INVALID_INDEX);
+}
+
+
+
+/*-------------------------------------
+ * Convert a duration to ticks (rounded up)
+-------------------------------------*/
+uint64_t TimerWheel::_to_ticks(std::chrono::nanoseconds duration) const noexcept
+{
+    if (duration.count() <= 0)
+    {
+        return 0;
+    }
+
+    const uint64_t ns = (uint64_t)duration.count();
+    const uint64_t tickNs = (uint64_t)mTickLength.count();
+
+    return ns / tickNs + (ns % tickNs != 0);
+}
+
+
+
+/*-------------------------------------
+ * Build a handle from a node index
+-------------------------------------*/
+inline TimerWheel::timer_id TimerWheel::_make_id(uint32_t index) const noexcept
+{
+    // Index 0 with generation 0 would collide with INVALID_TIMER
+    return ((timer_id)mNodes[index].generation << 32) | (timer_id)(index + 1u);
+}
+
+
+
+/*-------------------------------------
+ * Locate a live timer by handle
+-------------------------------------*/
+uint32_t TimerWheel::_find(timer_id id) const noexcept
+{
+    const uint32_t index = (uint32_t)(id & 0xFFFFFFFFull) - 1u;
+    const uint32_t generation = (uint32_t)(id >> 32);
+
+    if (id == INVALID_TIMER || index >= mNodes.size())
+    {
+        return INVALID_INDEX;
+    }
+
+    const TimerNode& node = mNodes[index];
+    if (node.generation != generation || node.slot == INVALID_INDEX)
+    {
+        return INVALID_INDEX;
+    }
+
+    return index;
+}
+
+
+
+/*-------------------------------------
+ * File a timer into the slot for its expiry
+-------------------------------------*/
+void TimerWheel::_link(uint32_t index) noexcept
+{
+    constexpr uint64_t maxDelta = (1ull << (SLOT_BITS*NUM_LEVELS)) - 1ull;
+
+    TimerNode& node = mNodes[index];
+    uint64_t expiry = node.expiry < mCurrentTick ? mCurrentTick : node.expiry;
+    uint64_t delta = expiry - mCurrentTick;
+
+    // Timers beyond the range of the wheel wait in the top level and are
+    // re-filed when their slot comes around.
+    if (delta > maxDelta)
+    {
+        delta = maxDelta;
+        expiry = mCurrentTick + maxDelta;
+    }
+
+    uint32_t level = 0;
+    while (level < NUM_LEVELS-1 && delta >= (1ull << (SLOT_BITS*(level+1u))))
+    {
+        ++level;
+    }
+
+    const uint32_t slot = level*NUM_SLOTS + (uint32_t)((expiry >> (SLOT_BITS*level)) & (NUM_SLOTS-1u));
+
+    node.slot = slot;
+    node.prev = INVALID_INDEX;
+    node.next = mSlots[slot];
+
+    if (node.next != INVALID_INDEX)
+    {
+        mNodes[node.next].prev = index;
+    }
+
+    mSlots[slot] = index;
+    ++mLevelCounts[level];
+}
+
+
+
+/*-------------------------------------
+ * Remove a timer from its slot
+-------------------------------------*/
+void TimerWheel::_unlink(uint32_t index) noexcept
+{
+    TimerNode& node = mNodes[index];
+
+    if (node.prev != INVALID_INDEX)
+    {
+        mNodes[node.prev].next = node.next;
+    }
+    else
+    {
+        mSlots[node.slot] = node.next;
+    }
+
+    if (node.next != INVALID_INDEX)
+    {
+        mNodes[node.next].prev = node.prev;
+    }
+
+    node.prev = INVALID_INDEX;
+    node.next = INVALID_INDEX;
+    --mLevelCounts[node.slot / NUM_SLOTS];
+}
+
+
+
+/*-------------------------------------
+ * Return a node to the free list
+-------------------------------------*/
+void TimerWheel::_release(uint32_t index) noexcept
+{
+    TimerNode& node = mNodes[index];
+
+    node.callback = utils::Function<void()>{};
+    node.slot = INVALID_INDEX;
+    node.generation++;
+    node.next = mFreeList;
+    mFreeList = index;
+
+    --mNumTimers;
+}
+
+
+
+/*-------------------------------------
+ * Move the timers in a slot to lower levels
+-------------------------------------*/
+void TimerWheel::_cascade(uint32_t level, uint32_t slot) noexcept
+{
+    uint32_t index = mSlots[level*NUM_SLOTS + slot];
+    mSlots[level*NUM_SLOTS + slot] = INVALID_INDEX;
+
+    while (index != INVALID_INDEX)
+    {
+        const uint32_t next = mNodes[index].next;
+        --mLevelCounts[level];
+        _link(index);
+        index = next;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Allocate and file a timer
+-------------------------------------*/
+TimerWheel::timer_id TimerWheel::_insert(utils::Function<void()>&& callback, uint64_t delayTicks, uint64_t periodTicks) noexcept
+{
+    if (!callback)
+    {
+        return INVALID_TIMER;
+    }
+
+    std::lock_guard<std::mutex> lock{mLock};
+
+    uint32_t index = mFreeList;
+    if (index != INVALID_INDEX)
+    {
+        mFreeList = mNodes[index].next;
+    }
+    else
+    {
+        index = (uint32_t)mNodes.size();
+        mNodes.push_back(TimerNode{0, 0, INVALID_INDEX, INVALID_INDEX, INVALID_INDEX, 0, utils::Function<void()>{}});
+    }
+
+    TimerNode& node = mNodes[index];
+    node.expiry = (std::numeric_limits<uint64_t>::max() - mCurrentTick < delayTicks) ? std::numeric_limits<uint64_t>::max() : mCurrentTick + delayTicks;
+    node.period = periodTicks;
+    node.callback = std::move(callback);
+
+    _link(index);
+    ++mNumTimers;
+
+    return _make_id(index);
+}
+
+
+
+/*-------------------------------------
+ * Schedule a one-shot timer
+-------------------------------------*/
+TimerWheel::timer_id TimerWheel::schedule(utils::Function<void()>&& callback, std::chrono::nanoseconds delay) noexcept
+{
+    return _insert(std::move(callback), _to_ticks(delay), 0);
+}
+
+
+
+/*-------------------------------------
+ * Schedule a periodic timer
+-------------------------------------*/
+TimerWheel::timer_id TimerWheel::schedule_periodic(utils::Function<void()>&& callback, std::chrono::nanoseconds period, std::chrono::nanoseconds initialDelay) noexcept
+{
+    const uint64_t periodTicks = _to_ticks(period);
+    return _insert(std::move(callback), _to_ticks(initialDelay), periodTicks ? periodTicks : 1u);
+}
+
+
+
+/*-------------------------------------
+ * Cancel a timer
+-------------------------------------*/
+bool TimerWheel::cancel(timer_id id) noexcept
+{
+    std::lock_guard<std::mutex> lock{mLock};
+
+    const uint32_t index = _find(id);
+    if (index == INVALID_INDEX)
+    {
+        return false;
+    }
+
+    _unlink(index);
+    _release(index);
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Check if a timer is scheduled
+-------------------------------------*/
+bool TimerWheel::pending(timer_id id) const noexcept
+{
+    std::lock_guard<std::mutex> lock{mLock};
+    return _find(id) != INVALID_INDEX;
+}
+
+
+
+/*-------------------------------------
+ * Cancel all timers
+-------------------------------------*/
+void TimerWheel::clear() noexcept
+{
+    std::lock_guard<std::mutex> lock{mLock};
+
+    for (uint32_t i = 0; i < (uint32_t)mNodes.size(); ++i)
+    {
+        if (mNodes[i].slot != INVALID_INDEX)
+        {
+            _release(i);
+        }
+    }
+
+    std::fill(mSlots, mSlots + NUM_LEVELS*NUM_SLOTS, INVALID_INDEX);
+    std::fill(mLevelCounts, mLevelCounts + NUM_LEVELS, 0);
+}
+
+
+
+/*-------------------------------------
+ * Turn the wheel and collect expired timers
+-------------------------------------*/
+std::size_t TimerWheel::expire(clock_type::time_point now, std::vector<utils::Function<void()>>& outCallbacks) noexcept
+{
+    if (now < mStartTime)
+    {
+        return 0;
+    }
+
+    const uint64_t elapsedNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now - mStartTime).count();
+    const uint64_t targetTick = elapsedNs / (uint64_t)mTickLength.count();
+    const std::size_t numCallbacks = outCallbacks.size();
+
+    std::lock_guard<std::mutex> lock{mLock};
+
+    while (mCurrentTick <= targetTick)
+    {
+        uint32_t lowestLevel = 0;
+        while (lowestLevel < NUM_LEVELS && !mLevelCounts[lowestLevel])
+        {
+            ++lowestLevel;
+        }
+
+        // Nothing can expire in an empty wheel, skip ahead.
+        if (lowestLevel == NUM_LEVELS)
+        {
+            mCurrentTick = targetTick + 1u;
+            break;
+        }
+
+        // With the lower levels empty, nothing happens until the next slot
+        // of the lowest occupied level is cascaded.
+        if (lowestLevel > 0)
+        {
+            const uint64_t mask = (1ull << (SLOT_BITS*lowestLevel)) - 1ull;
+            const uint64_t nextCascade = (mCurrentTick + mask) & ~mask;
+
+            if (nextCascade > targetTick)
+            {
+                mCurrentTick = targetTick + 1u;
+                break;
+            }
+
+            mCurrentTick = nextCascade;
+        }
+
+        // Each time a level wraps, pull the next slot of the level above
+        // down into it.
+        uint32_t slot = (uint32_t)(mCurrentTick & (NUM_SLOTS-1u));
+        for (uint32_t level = 1; slot == 0 && level < NUM_LEVELS; ++level)
+        {
+            slot = (uint32_t)((mCurrentTick >> (SLOT_BITS*level)) & (NUM_SLOTS-1u));
+            _cascade(level, slot);
+        }
+
+        uint32_t index = mSlots[mCurrentTick & (NUM_SLOTS-1u)];
+        mSlots[mCurrentTick & (NUM_SLOTS-1u)] = INVALID_INDEX;
+
+        // Periodic timers re-filed below land in a later slot, so this list
+        // is never modified while walking it.
+        while (index != INVALID_INDEX)
+        {
+            TimerNode& node = mNodes[index];
+            const uint32_t next = node.next;
+            --mLevelCounts[0];
+
+            if (node.period)
+            {
+                outCallbacks.push_back(node.callback);
+                node.expiry = mCurrentTick + node.period;
+                _link(index);
+            }
+            else
+            {
+                outCallbacks.push_back(std::move(node.callback));
+                _release(index);
+            }
+
+            index = next;
+        }
+
+        ++mCurrentTick;
+    }
+
+    return outCallbacks.size() - numCallbacks;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
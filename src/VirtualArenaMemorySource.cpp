@@ -0,0 +1,675 @@
+/*
+ * File:   VirtualArenaMemorySource.cpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 3:05 PM
+ */
+
+#include "lightsky/setup/OS.h"
+
+#if defined(LS_OS_UNIX)
+    extern "C"
+    {
+        #include <errno.h>
+        #include <string.h> // strerror()
+        #include <sys/mman.h> // mmap, mprotect, madvise
+    }
+
+#elif defined(LS_OS_WINDOWS)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif /* WIN32_LEAN_AND_MEAN */
+
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif /* NOMINMAX */
+
+    #include <Windows.h>
+#endif
+
+#include <cstdlib> // malloc, free
+#include <mutex> // std::lock_guard
+
+#include "lightsky/setup/Macros.h"
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Copy.h"
+#include "lightsky/utils/VirtualArenaMemorySource.hpp"
+
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Virtual Arena Memory Source
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Number of pages needed for an allocation
+-------------------------------------*/
+inline VirtualArenaMemorySource::size_type VirtualArenaMemorySource::_num_pages_for(size_type numBytes) const noexcept
+{
+    return (numBytes + mPageSize - 1ull) / mPageSize;
+}
+
+
+
+/*-------------------------------------
+ * Page index of an allocation
+-------------------------------------*/
+inline uint32_t VirtualArenaMemorySource::_page_index(const void* p) const noexcept
+{
+    return (uint32_t)((size_type)(static_cast<const char*>(p) - mData) / mPageSize);
+}
+
+
+
+/*-------------------------------------
+ * Commit pages up to a new high-water mark
+-------------------------------------*/
+bool VirtualArenaMemorySource::_commit_top(uint32_t newTopPage) noexcept
+{
+    if (newTopPage <= mCommittedPages)
+    {
+        return true;
+    }
+
+    // Commit in larger steps to avoid a syscall on every allocation
+    const size_type pagesPerCommit = (commit_granularity > mPageSize) ? (commit_granularity / mPageSize) : 1ull;
+    size_type numPages = ((size_type)newTopPage + pagesPerCommit - 1ull) / pagesPerCommit * pagesPerCommit;
+    if (numPages > mNumPages)
+    {
+        numPages = mNumPages;
+    }
+
+    // The page map is committed alongside the pages it describes
+    const size_type mapBegin = ((size_type)mCommittedPages * sizeof(PageInfo)) / mPageSize * mPageSize;
+    const size_type mapEnd = (numPages * sizeof(PageInfo) + mPageSize - 1ull) / mPageSize * mPageSize;
+
+    #if defined(LS_OS_UNIX)
+        char* const pData = mData + (size_type)mCommittedPages * mPageSize;
+        const size_type dataBytes = (numPages - (size_type)mCommittedPages) * mPageSize;
+
+        if (0 != mprotect(mReservation + mapBegin, mapEnd - mapBegin, PROT_READ | PROT_WRITE)
+        || 0 != mprotect(pData, dataBytes, PROT_READ | PROT_WRITE))
+        {
+            runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
+            return false;
+        }
+
+    #elif defined(LS_OS_WINDOWS)
+        // Data pages are committed per-allocation on Windows
+        if (!VirtualAlloc(mReservation + mapBegin, mapEnd - mapBegin, MEM_COMMIT, PAGE_READWRITE))
+        {
+            return false;
+        }
+
+    #else
+        (void)mapBegin;
+        (void)mapEnd;
+
+    #endif
+
+    mCommittedPages = (uint32_t)numPages;
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Commit a range of data pages
+-------------------------------------*/
+inline bool VirtualArenaMemorySource::_commit_range(uint32_t page, uint32_t numPages) noexcept
+{
+    #if defined(LS_OS_WINDOWS)
+        return nullptr != VirtualAlloc(mData + (size_type)page * mPageSize, (size_type)numPages * mPageSize, MEM_COMMIT, PAGE_READWRITE);
+
+    #else
+        // Pages below the high-water mark stay committed. madvise() only
+        // drops their physical backing.
+        (void)page;
+        (void)numPages;
+        return true;
+
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Release the physical pages of a range
+-------------------------------------*/
+void VirtualArenaMemorySource::_release_range(uint32_t page, uint32_t numPages) noexcept
+{
+    char* const p = mData + (size_type)page * mPageSize;
+    const size_type numBytes = (size_type)numPages * mPageSize;
+
+    #if defined(LS_OS_UNIX)
+        #if defined(MADV_FREE)
+            if (mReleaseMode == VirtualArenaReleaseMode::VIRTUAL_ARENA_RELEASE_LAZY)
+            {
+                // Falls through if unsupported by the running kernel
+                if (0 == madvise(p, numBytes, MADV_FREE))
+                {
+                    return;
+                }
+            }
+        #endif
+
+        if (0 != madvise(p, numBytes, MADV_DONTNEED))
+        {
+            runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
+        }
+
+    #elif defined(LS_OS_WINDOWS)
+        if (mReleaseMode == VirtualArenaReleaseMode::VIRTUAL_ARENA_RELEASE_LAZY)
+        {
+            VirtualAlloc(p, numBytes, MEM_RESET, PAGE_READWRITE);
+        }
+        else
+        {
+            VirtualFree(p, numBytes, MEM_DECOMMIT);
+        }
+
+    #else
+        (void)p;
+        (void)numBytes;
+
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Write the boundary tags of a range
+-------------------------------------*/
+inline void VirtualArenaMemorySource::_mark_range(uint32_t page, uint32_t numPages, PageState state) noexcept
+{
+    PageInfo& first = mPageMap[page];
+    PageInfo& last = mPageMap[page + numPages - 1u];
+
+    first.numPages = numPages;
+    first.state = state;
+    last.numPages = numPages;
+    last.state = state;
+}
+
+
+
+/*-------------------------------------
+ * Push a free range onto the free list
+-------------------------------------*/
+inline void VirtualArenaMemorySource::_link_free(uint32_t page) noexcept
+{
+    PageInfo& info = mPageMap[page];
+    info.prevFree = invalid_page;
+    info.nextFree = mFreeRanges;
+
+    if (mFreeRanges != invalid_page)
+    {
+        mPageMap[mFreeRanges].prevFree = page;
+    }
+
+    mFreeRanges = page;
+}
+
+
+
+/*-------------------------------------
+ * Remove a free range from the free list
+-------------------------------------*/
+inline void VirtualArenaMemorySource::_unlink_free(uint32_t page) noexcept
+{
+    const PageInfo& info = mPageMap[page];
+
+    if (info.prevFree != invalid_page)
+    {
+        mPageMap[info.prevFree].nextFree = info.nextFree;
+    }
+    else
+    {
+        mFreeRanges = info.nextFree;
+    }
+
+    if (info.nextFree != invalid_page)
+    {
+        mPageMap[info.nextFree].prevFree = info.prevFree;
+    }
+}
+
+
+
+/*-------------------------------------
+ * Free and coalesce a range
+-------------------------------------*/
+void VirtualArenaMemorySource::_free_range(uint32_t page, uint32_t numPages) noexcept
+{
+    // Merge with the preceding range
+    if (page > 0u)
+    {
+        const PageInfo& prev = mPageMap[page - 1u];
+        if (prev.state == PAGE_STATE_FREE)
+        {
+            const uint32_t prevPage = page - prev.numPages;
+            numPages += prev.numPages;
+            page = prevPage;
+            _unlink_free(prevPage);
+        }
+    }
+
+    const uint32_t nextPage = page + numPages;
+
+    // Ranges at the end of the arena simply lower the high-water mark
+    if (nextPage == mTopPage)
+    {
+        mTopPage = page;
+        return;
+    }
+
+    // Merge with the following range
+    const PageInfo& next = mPageMap[nextPage];
+    if (next.state == PAGE_STATE_FREE)
+    {
+        numPages += next.numPages;
+        _unlink_free(nextPage);
+    }
+
+    _mark_range(page, numPages, PAGE_STATE_FREE);
+    _link_free(page);
+}
+
+
+
+/*-------------------------------------
+ * Find a free range
+-------------------------------------*/
+uint32_t VirtualArenaMemorySource::_claim_range(uint32_t numPages) noexcept
+{
+    // First-fit. The free list only holds coalesced ranges, so it stays
+    // short in practice.
+    for (uint32_t page = mFreeRanges; page != invalid_page; page = mPageMap[page].nextFree)
+    {
+        const uint32_t rangePages = mPageMap[page].numPages;
+        if (rangePages < numPages)
+        {
+            continue;
+        }
+
+        _unlink_free(page);
+
+        if (rangePages > numPages)
+        {
+            _mark_range(page + numPages, rangePages - numPages, PAGE_STATE_FREE);
+            _link_free(page + numPages);
+        }
+
+        _mark_range(page, numPages, PAGE_STATE_USED);
+        return page;
+    }
+
+    if ((size_type)mTopPage + numPages > mNumPages || !_commit_top(mTopPage + numPages))
+    {
+        return invalid_page;
+    }
+
+    const uint32_t page = mTopPage;
+    mTopPage += numPages;
+    _mark_range(page, numPages, PAGE_STATE_USED);
+
+    return page;
+}
+
+
+
+/*-------------------------------------
+ * Destructor
+-------------------------------------*/
+VirtualArenaMemorySource::~VirtualArenaMemorySource() noexcept
+{
+    if (!mReservation)
+    {
+        return;
+    }
+
+    #if defined(LS_OS_UNIX)
+        if (0 != munmap(mReservation, mReservedBytes))
+        {
+            runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
+        }
+
+    #elif defined(LS_OS_WINDOWS)
+        VirtualFree(mReservation, 0, MEM_RELEASE);
+
+    #else
+        std::free(mReservation);
+
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+VirtualArenaMemorySource::VirtualArenaMemorySource(size_type reserveBytes, VirtualArenaReleaseMode releaseMode) noexcept :
+    MemorySource{},
+    mLock{},
+    mReleaseMode{releaseMode},
+    mPageSize{SystemMemorySource::page_size()},
+    mReservation{nullptr},
+    mReservedBytes{0},
+    mPageMap{nullptr},
+    mData{nullptr},
+    mNumPages{0},
+    mTopPage{0},
+    mCommittedPages{0},
+    mFreeRanges{invalid_page}
+{
+    size_type numPages = _num_pages_for(reserveBytes);
+    if (numPages >= (size_type)invalid_page)
+    {
+        numPages = (size_type)invalid_page - 1ull;
+    }
+
+    if (!numPages)
+    {
+        return;
+    }
+
+    const size_type mapBytes = _num_pages_for(numPages * sizeof(PageInfo)) * mPageSize;
+    const size_type totalBytes = mapBytes + numPages * mPageSize;
+    void* pReservation = nullptr;
+
+    #if defined(LS_OS_UNIX)
+        #if defined(MAP_NORESERVE)
+            constexpr int reserveFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+        #else
+            constexpr int reserveFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+        #endif
+
+        pReservation = mmap(nullptr, totalBytes, PROT_NONE, reserveFlags, -1, 0);
+        if (pReservation == MAP_FAILED)
+        {
+            runtime_assert(false, ErrorLevel::LS_WARNING, strerror(errno));
+            return;
+        }
+
+    #elif defined(LS_OS_WINDOWS)
+        pReservation = VirtualAlloc(nullptr, totalBytes, MEM_RESERVE, PAGE_NOACCESS);
+
+    #else
+        pReservation = std::malloc(totalBytes);
+
+    #endif
+
+    if (!pReservation)
+    {
+        return;
+    }
+
+    mReservation = static_cast<char*>(pReservation);
+    mReservedBytes = totalBytes;
+    mPageMap = reinterpret_cast<PageInfo*>(mReservation);
+    mData = mReservation + mapBytes;
+    mNumPages = (uint32_t)numPages;
+}
+
+
+
+/*-------------------------------------
+ * Check if the arena was reserved
+-------------------------------------*/
+bool VirtualArenaMemorySource::valid() const noexcept
+{
+    return mReservation != nullptr;
+}
+
+
+
+/*-------------------------------------
+ * Number of allocatable bytes
+-------------------------------------*/
+VirtualArenaMemorySource::size_type VirtualArenaMemorySource::reserved_bytes() const noexcept
+{
+    return (size_type)mNumPages * mPageSize;
+}
+
+
+
+/*-------------------------------------
+ * Number of committed bytes
+-------------------------------------*/
+VirtualArenaMemorySource::size_type VirtualArenaMemorySource::committed_bytes() const noexcept
+{
+    std::lock_guard<SpinLock> guard{mLock};
+    return (size_type)mCommittedPages * mPageSize;
+}
+
+
+
+/*-------------------------------------
+ * Check if a pointer belongs to *this
+-------------------------------------*/
+bool VirtualArenaMemorySource::contains(const void* p) const noexcept
+{
+    const char* const pData = static_cast<const char*>(p);
+    return pData >= mData && pData < mData + (size_type)mNumPages * mPageSize;
+}
+
+
+
+/*-------------------------------------
+ * Allocate
+-------------------------------------*/
+void* VirtualArenaMemorySource::allocate(size_type numBytes, size_type* pOutNumBytes) noexcept
+{
+    const size_type numPages = _num_pages_for(numBytes);
+    uint32_t page = invalid_page;
+
+    if (LS_LIKELY(numPages && numPages <= mNumPages))
+    {
+        std::lock_guard<SpinLock> guard{mLock};
+        page = _claim_range((uint32_t)numPages);
+    }
+
+    if (LS_UNLIKELY(page == invalid_page || !_commit_range(page, (uint32_t)numPages)))
+    {
+        if (page != invalid_page)
+        {
+            std::lock_guard<SpinLock> guard{mLock};
+            _free_range(page, (uint32_t)numPages);
+        }
+
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    if (pOutNumBytes)
+    {
+        *pOutNumBytes = numPages * mPageSize;
+    }
+
+    return mData + (size_type)page * mPageSize;
+}
+
+
+
+/*-------------------------------------
+ * Reallocate
+-------------------------------------*/
+void* VirtualArenaMemorySource::reallocate(void* pData, size_type numNewBytes, size_type* pOutNumBytes) noexcept
+{
+    if (!pData)
+    {
+        return allocate(numNewBytes, pOutNumBytes);
+    }
+
+    if (!numNewBytes)
+    {
+        free(pData);
+        if (pOutNumBytes)
+        {
+            *pOutNumBytes = 0;
+        }
+
+        return nullptr;
+    }
+
+    if (!contains(pData))
+    {
+        runtime_assert(false, ErrorLevel::LS_WARNING, "Attempted to reallocate a pointer from another memory source.");
+        return nullptr;
+    }
+
+    const size_type newPages = _num_pages_for(numNewBytes);
+    const uint32_t page = _page_index(pData);
+    uint32_t numPages;
+
+    if (newPages <= mNumPages)
+    {
+        std::lock_guard<SpinLock> guard{mLock};
+        numPages = mPageMap[page].numPages;
+
+        // Shrink in-place, releasing the trailing pages
+        if (newPages <= numPages)
+        {
+            const uint32_t numTrailing = numPages - (uint32_t)newPages;
+            if (numTrailing)
+            {
+                _mark_range(page, (uint32_t)newPages, PAGE_STATE_USED);
+                _release_range(page + (uint32_t)newPages, numTrailing);
+                _free_range(page + (uint32_t)newPages, numTrailing);
+            }
+
+            if (pOutNumBytes)
+            {
+                *pOutNumBytes = newPages * mPageSize;
+            }
+
+            return pData;
+        }
+
+        const uint32_t nextPage = page + numPages;
+        const uint32_t numExtra = (uint32_t)newPages - numPages;
+        bool grown = false;
+
+        // Grow into the unused top of the arena
+        if (nextPage == mTopPage)
+        {
+            if ((size_type)mTopPage + numExtra <= mNumPages && _commit_top(mTopPage + numExtra))
+            {
+                mTopPage += numExtra;
+                grown = true;
+            }
+        }
+        else if (mPageMap[nextPage].state == PAGE_STATE_FREE && mPageMap[nextPage].numPages >= numExtra)
+        {
+            // Grow into the following free range
+            const uint32_t freePages = mPageMap[nextPage].numPages;
+            _unlink_free(nextPage);
+
+            if (freePages > numExtra)
+            {
+                _mark_range(nextPage + numExtra, freePages - numExtra, PAGE_STATE_FREE);
+                _link_free(nextPage + numExtra);
+            }
+
+            grown = true;
+        }
+
+        if (grown)
+        {
+            _mark_range(page, (uint32_t)newPages, PAGE_STATE_USED);
+        }
+
+        if (grown && !_commit_range(nextPage, numExtra))
+        {
+            _mark_range(page, numPages, PAGE_STATE_USED);
+            _free_range(nextPage, numExtra);
+            grown = false;
+        }
+
+        if (grown)
+        {
+            if (pOutNumBytes)
+            {
+                *pOutNumBytes = newPages * mPageSize;
+            }
+
+            return pData;
+        }
+    }
+    else
+    {
+        std::lock_guard<SpinLock> guard{mLock};
+        numPages = mPageMap[page].numPages;
+    }
+
+    // No room to grow. Move the data instead.
+    void* const pNewData = allocate(numNewBytes, pOutNumBytes);
+    if (pNewData)
+    {
+        fast_memcpy(pNewData, pData, (size_type)numPages * mPageSize);
+        free(pData);
+    }
+
+    return pNewData;
+}
+
+
+
+/*-------------------------------------
+ * Free
+-------------------------------------*/
+void VirtualArenaMemorySource::free(void* pData) noexcept
+{
+    if (!pData)
+    {
+        return;
+    }
+
+    if (!contains(pData))
+    {
+        runtime_assert(false, ErrorLevel::LS_WARNING, "Attempted to free a pointer from another memory source.");
+        return;
+    }
+
+    const uint32_t page = _page_index(pData);
+    uint32_t numPages;
+
+    {
+        std::lock_guard<SpinLock> guard{mLock};
+        numPages = mPageMap[page].numPages;
+    }
+
+    // The range is still owned by the caller, so its pages can be released
+    // without holding the lock.
+    _release_range(page, numPages);
+
+    std::lock_guard<SpinLock> guard{mLock};
+    _free_range(page, numPages);
+}
+
+
+
+/*-------------------------------------
+ * Free (sized)
+-------------------------------------*/
+void VirtualArenaMemorySource::free(void* pData, size_type numBytes) noexcept
+{
+    (void)numBytes;
+    this->free(pData);
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
@@ -0,0 +1,20 @@
+#include "lightsky/utils/WorkStealingPool.hpp"
+
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkStealingPool
+-----------------------------------------------------------------------------*/
+LS_DEFINE_CLASS_TYPE(ls::utils::WorkStealingPool, void (*)());
+LS_DEFINE_CLASS_TYPE(ls::utils::WorkStealingPool, ls::utils::Function<void()>);
+
+
+
+} // end utils namespace
+} // end ls namespace
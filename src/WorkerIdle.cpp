@@ -0,0 +1,161 @@
+/*
+ * File:   WorkerIdle.cpp
+ * Author: miles
+ * Created on October 18, 2026, at 2:40 p.m.
+ */
+
+#include <chrono>
+#include <thread> // std::this_thread::yield()
+
+#include "lightsky/setup/CPU.h" // cpu_yield()
+
+#include "lightsky/utils/WorkerIdle.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+inline uint64_t _idle_time_ns() noexcept
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerWakeSignal
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+WorkerWakeSignal::WorkerWakeSignal() noexcept :
+    mSequence{0},
+    mNumParked{0}
+{}
+
+
+
+/*-------------------------------------
+ * Wake parked threads
+-------------------------------------*/
+void WorkerWakeSignal::notify() noexcept
+{
+    mSequence.fetch_add(1, std::memory_order_acq_rel);
+
+    // Pairs with the fence in park(). Either we see the parked thread, or
+    // it sees the new sequence before sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (mNumParked.load(std::memory_order_relaxed))
+    {
+        mSequence.notify_all();
+    }
+}
+
+
+
+/*-------------------------------------
+ * Sleep until notified
+-------------------------------------*/
+void WorkerWakeSignal::park(uint32_t seq) noexcept
+{
+    mNumParked.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    mSequence.wait(seq, std::memory_order_acquire);
+
+    mNumParked.fetch_sub(1, std::memory_order_release);
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerIdleStrategy
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+WorkerIdleStrategy::WorkerIdleStrategy() noexcept :
+    mAvgIdleNs{MAX_SPIN_NS},
+    mSpinNs{MIN_SPIN_NS}
+{}
+
+
+
+/*-------------------------------------
+ * Spin, yield, then park
+-------------------------------------*/
+bool WorkerIdleStrategy::wait(WorkerWakeSignal& signal, uint32_t seq) noexcept
+{
+    // Check the clock every few spins, reading it is far slower than a
+    // pause instruction.
+    constexpr unsigned spins_per_clock_check = 32;
+
+    const uint64_t startTime = _idle_time_ns();
+    const uint64_t spinDeadline = startTime + mSpinNs;
+    bool woken = false;
+
+    while (!woken)
+    {
+        for (unsigned i = 0; i < spins_per_clock_check; ++i)
+        {
+            if (signal.sequence() != seq)
+            {
+                woken = true;
+                break;
+            }
+
+            ls::setup::cpu_yield();
+        }
+
+        if (_idle_time_ns() >= spinDeadline)
+        {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; !woken && i < MAX_YIELDS; ++i)
+    {
+        std::this_thread::yield();
+        woken = signal.sequence() != seq;
+    }
+
+    const bool parked = !woken;
+    if (parked)
+    {
+        signal.park(seq);
+    }
+
+    // Spin long enough to cover the recent gaps between tasks, unless those
+    // gaps are too long for spinning to pay off.
+    const uint64_t idleNs = _idle_time_ns() - startTime;
+    mAvgIdleNs = (mAvgIdleNs * 7ull + idleNs) / 8ull;
+
+    if (mAvgIdleNs > MAX_SPIN_NS)
+    {
+        mSpinNs = MIN_SPIN_NS;
+    }
+    else
+    {
+        const uint64_t spinNs = mAvgIdleNs + (mAvgIdleNs >> 1ull);
+        mSpinNs = spinNs < MIN_SPIN_NS ? MIN_SPIN_NS : (spinNs > MAX_SPIN_NS ? MAX_SPIN_NS : spinNs);
+    }
+
+    return parked;
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
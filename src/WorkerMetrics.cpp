@@ -0,0 +1,422 @@
+/*
+ * File:   WorkerMetrics.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 10:40 a.m.
+ */
+
+#include <bit> // std::bit_width
+#include <chrono>
+
+#include "lightsky/utils/WorkerMetrics.hpp"
+
+namespace ls
+{
+namespace utils
+{
+
+
+
+/*-----------------------------------------------------------------------------
+ * Anonymous helper functions
+-----------------------------------------------------------------------------*/
+namespace
+{
+
+/*-------------------------------------
+ * Add a duration to a single-writer histogram
+-------------------------------------*/
+inline void _record_duration(std::atomic<uint64_t>* pBuckets, std::atomic<uint64_t>& maxNs, uint64_t ns) noexcept
+{
+    pBuckets[WorkerHistogram::bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    // Only the owning thread raises the maximum
+    if (ns > maxNs.load(std::memory_order_relaxed))
+    {
+        maxNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Merge per-thread buckets into a histogram
+-------------------------------------*/
+inline void _merge_histogram(WorkerHistogram& outHist, const std::atomic<uint64_t>* pBuckets, uint64_t maxNs) noexcept
+{
+    for (uint32_t i = 0; i < WorkerHistogram::num_buckets; ++i)
+    {
+        const uint64_t n = pBuckets[i].load(std::memory_order_relaxed);
+        outHist.buckets[i] += n;
+        outHist.count += n;
+    }
+
+    if (maxNs > outHist.maxNs)
+    {
+        outHist.maxNs = maxNs;
+    }
+}
+
+} // end anonymous namespace
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerHistogram
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Bucket for a duration
+-------------------------------------*/
+uint32_t WorkerHistogram::bucket(uint64_t ns) noexcept
+{
+    const uint32_t b = ns ? (uint32_t)std::bit_width(ns) - 1u : 0u;
+    return b < (uint32_t)num_buckets ? b : (uint32_t)num_buckets - 1u;
+}
+
+
+
+/*-------------------------------------
+ * Average duration
+-------------------------------------*/
+uint64_t WorkerHistogram::mean() const noexcept
+{
+    return count ? (totalNs / count) : 0;
+}
+
+
+
+/*-------------------------------------
+ * Estimate a percentile
+-------------------------------------*/
+uint64_t WorkerHistogram::percentile(double p) const noexcept
+{
+    if (!count)
+    {
+        return 0;
+    }
+
+    p = p < 0.0 ? 0.0 : (p > 1.0 ? 1.0 : p);
+
+    uint64_t rank = (uint64_t)(p * (double)count + 0.5);
+    rank = rank ? rank : 1;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < (uint32_t)num_buckets-1u; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            const uint64_t upperBound = (2ull << i) - 1ull;
+            return upperBound < maxNs ? upperBound : maxNs;
+        }
+    }
+
+    return maxNs;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerThreadStats
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Busy fraction
+-------------------------------------*/
+double WorkerThreadStats::utilization() const noexcept
+{
+    const uint64_t totalNs = busyNs + idleNs;
+    return totalNs ? ((double)busyNs / (double)totalNs) : 0.0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerPoolStats
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Sum of all threads
+-------------------------------------*/
+WorkerThreadStats WorkerPoolStats::total() const noexcept
+{
+    WorkerThreadStats sum{0, 0, 0, 0, 0};
+
+    for (const WorkerThreadStats& t : threads)
+    {
+        sum.tasksRun += t.tasksRun;
+        sum.busyNs += t.busyNs;
+        sum.idleNs += t.idleNs;
+        sum.numParks += t.numParks;
+        sum.numSteals += t.numSteals;
+    }
+
+    return sum;
+}
+
+
+
+/*-------------------------------------
+ * Busy fraction of all threads
+-------------------------------------*/
+double WorkerPoolStats::utilization() const noexcept
+{
+    return total().utilization();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * WorkerMetrics
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Constructor
+-------------------------------------*/
+WorkerMetrics::WorkerMetrics() noexcept :
+    mEnabled{false},
+    mTasksQueued{0},
+    mMaxQueueDepth{0},
+    mThreadLock{},
+    mNumThreads{0},
+    mThreads{nullptr}
+{}
+
+
+
+/*-------------------------------------
+ * Clock
+-------------------------------------*/
+uint64_t WorkerMetrics::now_ns() noexcept
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+/*-------------------------------------
+ * Timestamp queued tasks
+-------------------------------------*/
+void WorkerMetrics::push_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize, std::size_t numTasks) noexcept
+{
+    // A cleared ring buffer can't grow on its own
+    if (!enqueueTimes.capacity())
+    {
+        enqueueTimes.reserve(2);
+    }
+
+    // Fill in for any tasks queued while metrics were disabled
+    while ((std::size_t)enqueueTimes.size()+numTasks < queueSize)
+    {
+        enqueueTimes.push(0);
+    }
+
+    const uint64_t timestamp = now_ns();
+    for (std::size_t i = 0; i < numTasks; ++i)
+    {
+        enqueueTimes.push(timestamp);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Retrieve a queued task's timestamp
+-------------------------------------*/
+uint64_t WorkerMetrics::pop_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize) noexcept
+{
+    // Tasks were removed from the queue without their timestamps
+    if ((std::size_t)enqueueTimes.size() > queueSize)
+    {
+        enqueueTimes.clear();
+    }
+
+    return enqueueTimes.empty() ? 0 : enqueueTimes.pop_unchecked();
+}
+
+
+
+/*-------------------------------------
+ * Retrieve the newest queued task's timestamp
+-------------------------------------*/
+uint64_t WorkerMetrics::pop_back_enqueue_time(utils::RingBuffer<uint64_t>& enqueueTimes, std::size_t queueSize) noexcept
+{
+    if ((std::size_t)enqueueTimes.size() > queueSize)
+    {
+        enqueueTimes.clear();
+    }
+
+    return enqueueTimes.empty() ? 0 : enqueueTimes.pop_back_unchecked();
+}
+
+
+
+/*-------------------------------------
+ * Resize the per-thread counters
+-------------------------------------*/
+void WorkerMetrics::resize(std::size_t numThreads) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{mThreadLock};
+
+        if (numThreads != mNumThreads)
+        {
+            mThreads = numThreads ? utils::make_unique_array<ThreadCounters>(numThreads) : utils::UniqueArray<ThreadCounters>{nullptr};
+            mNumThreads = mThreads ? numThreads : 0;
+        }
+    }
+
+    reset();
+}
+
+
+
+/*-------------------------------------
+ * Reset all counters
+-------------------------------------*/
+void WorkerMetrics::reset() noexcept
+{
+    mTasksQueued.store(0, std::memory_order_relaxed);
+    mMaxQueueDepth.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock{mThreadLock};
+
+    for (std::size_t t = 0; t < mNumThreads; ++t)
+    {
+        ThreadCounters& c = mThreads[t];
+
+        c.tasksRun.store(0, std::memory_order_relaxed);
+        c.busyNs.store(0, std::memory_order_relaxed);
+        c.idleNs.store(0, std::memory_order_relaxed);
+        c.numParks.store(0, std::memory_order_relaxed);
+        c.numSteals.store(0, std::memory_order_relaxed);
+        c.latencyTotalNs.store(0, std::memory_order_relaxed);
+        c.latencyMaxNs.store(0, std::memory_order_relaxed);
+        c.runMaxNs.store(0, std::memory_order_relaxed);
+
+        for (uint32_t i = 0; i < WorkerHistogram::num_buckets; ++i)
+        {
+            c.latencyBuckets[i].store(0, std::memory_order_relaxed);
+            c.runBuckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record queued tasks
+-------------------------------------*/
+void WorkerMetrics::record_push(std::size_t queueDepth, std::size_t numTasks) noexcept
+{
+    mTasksQueued.fetch_add(numTasks, std::memory_order_relaxed);
+
+    uint64_t maxDepth = mMaxQueueDepth.load(std::memory_order_relaxed);
+    while (queueDepth > maxDepth && !mMaxQueueDepth.compare_exchange_weak(maxDepth, queueDepth, std::memory_order_relaxed))
+    {
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record a completed task
+-------------------------------------*/
+void WorkerMetrics::record_task(std::size_t threadId, uint64_t enqueueNs, uint64_t startNs, uint64_t endNs) noexcept
+{
+    if (threadId >= mNumThreads)
+    {
+        return;
+    }
+
+    ThreadCounters& c = mThreads[threadId];
+    const uint64_t runNs = endNs > startNs ? (endNs - startNs) : 0;
+
+    c.tasksRun.fetch_add(1, std::memory_order_relaxed);
+    c.busyNs.fetch_add(runNs, std::memory_order_relaxed);
+    _record_duration(c.runBuckets, c.runMaxNs, runNs);
+
+    // Tasks queued while metrics were disabled have no timestamp
+    if (enqueueNs)
+    {
+        const uint64_t waitNs = startNs > enqueueNs ? (startNs - enqueueNs) : 0;
+        c.latencyTotalNs.fetch_add(waitNs, std::memory_order_relaxed);
+        _record_duration(c.latencyBuckets, c.latencyMaxNs, waitNs);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record time spent idle
+-------------------------------------*/
+void WorkerMetrics::record_idle(std::size_t threadId, uint64_t idleNs) noexcept
+{
+    if (threadId < mNumThreads)
+    {
+        mThreads[threadId].idleNs.fetch_add(idleNs, std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record a thread sleeping
+-------------------------------------*/
+void WorkerMetrics::record_park(std::size_t threadId) noexcept
+{
+    if (threadId < mNumThreads)
+    {
+        mThreads[threadId].numParks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Record a stolen task
+-------------------------------------*/
+void WorkerMetrics::record_steal(std::size_t threadId) noexcept
+{
+    if (threadId < mNumThreads)
+    {
+        mThreads[threadId].numSteals.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+
+/*-------------------------------------
+ * Merge all counters
+-------------------------------------*/
+void WorkerMetrics::snapshot(WorkerPoolStats& outStats) const noexcept
+{
+    outStats.timestampNs = now_ns();
+    outStats.tasksQueued = mTasksQueued.load(std::memory_order_relaxed);
+    outStats.maxQueueDepth = mMaxQueueDepth.load(std::memory_order_relaxed);
+    outStats.queueLatency = WorkerHistogram{};
+    outStats.runTime = WorkerHistogram{};
+
+    std::lock_guard<std::mutex> lock{mThreadLock};
+
+    outStats.threads.resize(mNumThreads);
+
+    for (std::size_t t = 0; t < mNumThreads; ++t)
+    {
+        const ThreadCounters& c = mThreads[t];
+        WorkerThreadStats& outThread = outStats.threads[t];
+
+        outThread.tasksRun = c.tasksRun.load(std::memory_order_relaxed);
+        outThread.busyNs = c.busyNs.load(std::memory_order_relaxed);
+        outThread.idleNs = c.idleNs.load(std::memory_order_relaxed);
+        outThread.numParks = c.numParks.load(std::memory_order_relaxed);
+        outThread.numSteals = c.numSteals.load(std::memory_order_relaxed);
+
+        outStats.queueLatency.totalNs += c.latencyTotalNs.load(std::memory_order_relaxed);
+        _merge_histogram(outStats.queueLatency, c.latencyBuckets, c.latencyMaxNs.load(std::memory_order_relaxed));
+
+        outStats.runTime.totalNs += outThread.busyNs;
+        _merge_histogram(outStats.runTime, c.runBuckets, c.runMaxNs.load(std::memory_order_relaxed));
+    }
+}
+
+
+
+} // end utils namespace
+} // end ls namespace
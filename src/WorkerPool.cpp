@@ -13,6 +13,7 @@ namespace utils
  * WorkerThread
 -----------------------------------------------------------------------------*/
 LS_DEFINE_CLASS_TYPE(ls::utils::WorkerPool, void (*)());
+LS_DEFINE_CLASS_TYPE(ls::utils::WorkerPool, ls::utils::Function<void()>);
 
 
 
@@ -86,7 +86,62 @@ bool ls::utils::set_thread_affinity(std::thread& t, unsigned affinity) noexcept
 
 
 
+bool ls::utils::set_thread_affinity(size_t threadId, const unsigned* pCpus, size_t numCpus) noexcept
+{
+    // CPU sets are only supported on Linux. OSX has no hard affinity and
+    // Windows limits masks to a single processor group.
+    #ifndef LS_OS_LINUX
+        (void)threadId;
+        (void)pCpus;
+        (void)numCpus;
+        return false;
+
+    #else
+        if (!numCpus)
+        {
+            return false;
+        }
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+
+        for (size_t i = 0; i < numCpus; ++i)
+        {
+            if (pCpus[i] >= CPU_SETSIZE)
+            {
+                LS_LOG_ERR("Requested CPU affinity is out of range for expected values (", pCpus[i], " vs. 0 - ", CPU_SETSIZE, ").");
+                return false;
+            }
+
+            CPU_SET(pCpus[i], &cpuSet);
+        }
+
+        pthread_t t = (pthread_t)threadId;
+        #ifdef LS_OS_ANDROID
+        if (sched_setaffinity((pid_t)t, sizeof(cpu_set_t), &cpuSet))
+        #else
+        if (pthread_setaffinity_np(t, sizeof(cpu_set_t), &cpuSet))
+        #endif
+        {
+            LS_LOG_ERR("Unable to set CPU affinity.");
+            return false;
+        }
+
+        return true;
+    #endif
+}
+
+
+
+bool ls::utils::set_thread_affinity(std::thread& t, const unsigned* pCpus, size_t numCpus) noexcept
+{
+    return set_thread_affinity((size_t)t.native_handle(), pCpus, numCpus);
+}
+
+
+
 /*-----------------------------------------------------------------------------
  * WorkerThread
 -----------------------------------------------------------------------------*/
 LS_DEFINE_CLASS_TYPE(ls::utils::WorkerThread, void (*)());
+LS_DEFINE_CLASS_TYPE(ls::utils::WorkerThread, ls::utils::Function<void()>);
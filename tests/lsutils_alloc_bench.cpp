@@ -0,0 +1,873 @@
+/*
+ * File:   lsutils_alloc_bench.cpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 4:30 PM
+ */
+
+/*
+ * Allocator benchmarks. Every IAllocator implementation is run through the
+ * same workloads, next to glibc's malloc(), and the results are written as
+ * CSV with one row per (workload, allocator) pair:
+ *
+ *     workload,allocator,threads,operations,seconds,ops_per_sec,rss_bytes,peak_rss_bytes
+ *
+ * Workloads:
+ *     trace:        Replay of a recorded allocation trace (--trace), or of a
+ *                   built-in synthetic trace if none is given.
+ *     larson:       Threads replace random objects in a shared table, so most
+ *                   frees happen on a different thread than the allocation.
+ *     dist-<name>:  Batches of allocations drawn from size distributions
+ *                   taken from real workloads, freed in random order.
+ *
+ * Trace files are plain text with one operation per line:
+ *     a <id> <size>    allocate "size" bytes into slot "id"
+ *     r <id> <size>    reallocate slot "id" to "size" bytes
+ *     f <id>           free slot "id"
+ *
+ * RSS figures are read from /proc/self/status and are only available on
+ * Linux. Peak RSS is reset before each run via /proc/self/clear_refs.
+ *
+ * On Linux, each (workload, allocator) pair runs in its own forked process
+ * so no row includes memory left behind by an earlier allocator. Every row
+ * still includes the same baseline: the benchmark itself and its trace.
+ * Elsewhere, all pairs share one process and the RSS columns accumulate,
+ * so they can't be compared across rows.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "lightsky/setup/OS.h"
+
+#if defined(LS_OS_LINUX)
+    extern "C"
+    {
+        #include <sys/wait.h> // waitpid()
+        #include <unistd.h> // fork(), pipe()
+    }
+#endif
+
+#include "lightsky/utils/Allocator.hpp"
+#include "lightsky/utils/AllocatorStats.hpp"
+#include "lightsky/utils/ArgParser.hpp"
+#include "lightsky/utils/Argument.hpp"
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/GeneralAllocator.hpp"
+#include "lightsky/utils/LinearAllocator.hpp"
+#include "lightsky/utils/MemorySource.hpp"
+#include "lightsky/utils/SlabAllocator.hpp"
+#include "lightsky/utils/ThreadCachedAllocator.hpp"
+#include "lightsky/utils/Time.hpp"
+#include "lightsky/utils/VirtualArenaMemorySource.hpp"
+
+namespace utils = ls::utils;
+namespace argparse = ls::utils::argparse;
+
+typedef utils::IAllocator::size_type size_type;
+typedef utils::Clock<double, std::ratio<1, 1>> BenchClock;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Utilities
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Deterministic random numbers
+-------------------------------------*/
+struct XorShift
+{
+    unsigned long long state;
+
+    unsigned long long operator()() noexcept
+    {
+        state ^= state << 13ull;
+        state ^= state >> 7ull;
+        state ^= state << 17ull;
+        return state;
+    }
+};
+
+
+
+/*-------------------------------------
+ * Read a field (in kB) from /proc/self/status
+-------------------------------------*/
+size_type read_proc_status(const char* pField)
+{
+    #if defined(LS_OS_LINUX)
+        std::ifstream status{"/proc/self/status"};
+        const size_t fieldLen = std::strlen(pField);
+        std::string line;
+
+        while (std::getline(status, line))
+        {
+            if (line.compare(0, fieldLen, pField) == 0)
+            {
+                return std::stoull(line.substr(fieldLen + 1)) * 1024ull;
+            }
+        }
+    #else
+        (void)pField;
+    #endif
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+ * Reset the peak RSS counter
+-------------------------------------*/
+void reset_peak_rss()
+{
+    #if defined(LS_OS_LINUX)
+        std::ofstream clearRefs{"/proc/self/clear_refs"};
+        clearRefs << "5";
+    #endif
+}
+
+
+
+/*-------------------------------------
+ * Write to an allocation so its pages are committed
+-------------------------------------*/
+inline void touch(void* p, size_type numBytes) noexcept
+{
+    unsigned char* const pBytes = static_cast<unsigned char*>(p);
+    pBytes[0] = 0xA5;
+    pBytes[numBytes-1] = 0x5A;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Allocators under test
+-----------------------------------------------------------------------------*/
+enum BenchAllocatorType : unsigned
+{
+    BENCH_ALLOC_GLIBC,
+    BENCH_ALLOC_GENERAL,
+    BENCH_ALLOC_SLAB,
+    BENCH_ALLOC_SLAB_ARENA,
+    BENCH_ALLOC_THREAD_CACHED,
+    BENCH_ALLOC_STATS_SLAB,
+    BENCH_ALLOC_LINEAR,
+
+    BENCH_ALLOC_COUNT
+};
+
+constexpr const char* bench_alloc_names[BENCH_ALLOC_COUNT] = {
+    "glibc",
+    "general",
+    "slab",
+    "slab+arena",
+    "thread_cached",
+    "stats+slab",
+    "linear"
+};
+
+// Allocators which can't free individual allocations only run batch
+// workloads, and are reset after each batch.
+constexpr bool bench_alloc_can_free[BENCH_ALLOC_COUNT] = {
+    true,
+    true,
+    true,
+    true,
+    true,
+    true,
+    false
+};
+
+
+
+/*-------------------------------------
+ * Construct an allocator and pass it to a workload. Allocators which are not
+ * thread-safe are wrapped in an AtomicAllocator for threaded workloads.
+-------------------------------------*/
+template <typename WorkloadType>
+void with_allocator(BenchAllocatorType type, bool threaded, WorkloadType&& workload)
+{
+    utils::MallocMemorySource mallocSrc;
+
+    switch (type)
+    {
+        case BENCH_ALLOC_GLIBC:
+        {
+            utils::MallocAllocator allocator{mallocSrc};
+            workload(allocator, nullptr);
+            break;
+        }
+
+        case BENCH_ALLOC_GENERAL:
+        {
+            utils::GeneralAllocator<> allocator{mallocSrc};
+            utils::AtomicAllocator lockedAllocator{allocator};
+            workload(threaded ? static_cast<utils::IAllocator&>(lockedAllocator) : allocator, nullptr);
+            break;
+        }
+
+        case BENCH_ALLOC_SLAB:
+        {
+            utils::SlabAllocator allocator{mallocSrc};
+            utils::AtomicAllocator lockedAllocator{allocator};
+            workload(threaded ? static_cast<utils::IAllocator&>(lockedAllocator) : allocator, nullptr);
+            break;
+        }
+
+        case BENCH_ALLOC_SLAB_ARENA:
+        {
+            utils::VirtualArenaMemorySource arenaSrc;
+            utils::SlabAllocator allocator{arenaSrc};
+            utils::AtomicAllocator lockedAllocator{allocator};
+            workload(threaded ? static_cast<utils::IAllocator&>(lockedAllocator) : allocator, nullptr);
+            break;
+        }
+
+        case BENCH_ALLOC_THREAD_CACHED:
+        {
+            utils::GeneralAllocator<> centralHeap{mallocSrc};
+            utils::ThreadCachedAllocator allocator{centralHeap};
+            workload(allocator, nullptr);
+            allocator.flush_thread_cache();
+            break;
+        }
+
+        case BENCH_ALLOC_STATS_SLAB:
+        {
+            utils::SlabAllocator slabAllocator{mallocSrc};
+            utils::AtomicAllocator lockedAllocator{slabAllocator};
+            utils::StatsAllocator allocator{threaded ? static_cast<utils::IAllocator&>(lockedAllocator) : slabAllocator};
+            workload(allocator, nullptr);
+            break;
+        }
+
+        case BENCH_ALLOC_LINEAR:
+        {
+            utils::LinearAllocator allocator{mallocSrc};
+            workload(allocator, [&allocator]()->void {allocator.reset();});
+            break;
+        }
+
+        default:
+            LS_ASSERT(false);
+    }
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Results
+-----------------------------------------------------------------------------*/
+struct BenchResult
+{
+    const char* pWorkload;
+    const char* pAllocator;
+    unsigned numThreads;
+    size_type numOperations;
+    double seconds;
+    size_type rssBytes;
+    size_type peakRssBytes;
+};
+
+
+
+/*-------------------------------------
+ * CSV Output
+-------------------------------------*/
+void write_csv_header(std::ostream& out)
+{
+    out << "workload,allocator,threads,operations,seconds,ops_per_sec,rss_bytes,peak_rss_bytes" << std::endl;
+}
+
+
+
+void write_csv_row(std::ostream& out, const BenchResult& result)
+{
+    const double opsPerSec = result.seconds > 0.0 ? ((double)result.numOperations / result.seconds) : 0.0;
+
+    out << result.pWorkload << ','
+        << result.pAllocator << ','
+        << result.numThreads << ','
+        << result.numOperations << ','
+        << result.seconds << ','
+        << (unsigned long long)opsPerSec << ','
+        << result.rssBytes << ','
+        << result.peakRssBytes
+        << std::endl;
+}
+
+
+
+/*-------------------------------------
+ * Run a benchmark in a child process so its RSS figures start from a clean
+ * heap, then write its results.
+-------------------------------------*/
+template <typename BenchFunc>
+bool run_isolated(std::ostream& out, const char* pAllocator, BenchFunc&& benchFunc)
+{
+    BenchResult result;
+
+    #if defined(LS_OS_LINUX)
+        int fds[2];
+        const pid_t pid = (pipe(fds) == 0) ? fork() : -1;
+
+        if (pid == 0)
+        {
+            close(fds[0]);
+            result = benchFunc();
+
+            // Results fit in a single atomic pipe write. The names point to
+            // static strings, which are valid in the parent as well.
+            const bool written = write(fds[1], &result, sizeof(BenchResult)) == (ssize_t)sizeof(BenchResult);
+            _exit(written ? 0 : 1);
+        }
+
+        if (pid > 0)
+        {
+            close(fds[1]);
+            const bool received = read(fds[0], &result, sizeof(BenchResult)) == (ssize_t)sizeof(BenchResult);
+            close(fds[0]);
+
+            int status = 0;
+            if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0 || !received)
+            {
+                std::cerr << "Benchmark of " << pAllocator << " failed in a child process." << std::endl;
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "Unable to fork, RSS figures include earlier runs." << std::endl;
+            result = benchFunc();
+        }
+    #else
+        result = benchFunc();
+    #endif
+
+    result.pAllocator = pAllocator;
+    write_csv_row(out, result);
+
+    return true;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Trace Replay
+-----------------------------------------------------------------------------*/
+struct TraceOp
+{
+    char op;
+    unsigned id;
+    size_type numBytes;
+};
+
+
+
+/*-------------------------------------
+ * Load a trace file
+-------------------------------------*/
+bool load_trace(const std::string& path, std::vector<TraceOp>& outTrace, unsigned& outNumSlots)
+{
+    std::ifstream fin{path};
+    if (!fin.good())
+    {
+        std::cerr << "Unable to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    outNumSlots = 0;
+
+    while (std::getline(fin, line))
+    {
+        std::istringstream lineStream{line};
+        TraceOp traceOp{'\0', 0, 0};
+
+        if (!(lineStream >> traceOp.op >> traceOp.id))
+        {
+            continue;
+        }
+
+        if (traceOp.op != 'f' && !(lineStream >> traceOp.numBytes))
+        {
+            std::cerr << "Invalid trace entry: " << line << std::endl;
+            return false;
+        }
+
+        if (traceOp.op != 'a' && traceOp.op != 'r' && traceOp.op != 'f')
+        {
+            std::cerr << "Invalid trace entry: " << line << std::endl;
+            return false;
+        }
+
+        outNumSlots = traceOp.id >= outNumSlots ? (traceOp.id + 1u) : outNumSlots;
+        outTrace.push_back(traceOp);
+    }
+
+    return true;
+}
+
+
+
+/*-------------------------------------
+ * Synthesize a trace resembling a document parser: many short-lived small
+ * nodes and strings, a few long-lived growing buffers.
+-------------------------------------*/
+void generate_trace(size_type numOps, std::vector<TraceOp>& outTrace, unsigned& outNumSlots)
+{
+    constexpr unsigned num_slots = 4096;
+    std::vector<bool> live(num_slots, false);
+    std::vector<size_type> sizes(num_slots, 0);
+    XorShift rng{0x9E3779B97F4A7C15ull};
+
+    outNumSlots = num_slots;
+    outTrace.reserve(numOps + num_slots);
+
+    for (size_type i = 0; i < numOps; ++i)
+    {
+        const unsigned long long r = rng();
+        const unsigned id = (unsigned)(r % num_slots);
+
+        if (!live[id])
+        {
+            // 70% small nodes, 25% strings, 5% buffers
+            const unsigned category = (unsigned)((r >> 32ull) % 100ull);
+            size_type numBytes = 16u + (size_type)((r >> 40ull) % 48ull);
+
+            if (category >= 95u)
+            {
+                numBytes = 1024u + (size_type)((r >> 40ull) % 16384ull);
+            }
+            else if (category >= 70u)
+            {
+                numBytes = 8u + (size_type)((r >> 40ull) % 248ull);
+            }
+
+            outTrace.push_back(TraceOp{'a', id, numBytes});
+            live[id] = true;
+            sizes[id] = numBytes;
+        }
+        else if (sizes[id] >= 1024u && ((r >> 32ull) & 3ull) == 0ull && sizes[id] < 1024u * 1024u)
+        {
+            sizes[id] *= 2u;
+            outTrace.push_back(TraceOp{'r', id, sizes[id]});
+        }
+        else
+        {
+            outTrace.push_back(TraceOp{'f', id, 0});
+            live[id] = false;
+        }
+    }
+
+    for (unsigned id = 0; id < num_slots; ++id)
+    {
+        if (live[id])
+        {
+            outTrace.push_back(TraceOp{'f', id, 0});
+        }
+    }
+}
+
+
+
+/*-------------------------------------
+ * Replay a trace
+-------------------------------------*/
+BenchResult bench_trace(utils::IAllocator& allocator, const std::vector<TraceOp>& trace, unsigned numSlots, unsigned numPasses)
+{
+    std::vector<void*> slots(numSlots, nullptr);
+    std::vector<size_type> sizes(numSlots, 0);
+    BenchClock ticks;
+
+    reset_peak_rss();
+    ticks.start();
+
+    for (unsigned pass = 0; pass < numPasses; ++pass)
+    {
+        for (const TraceOp& traceOp : trace)
+        {
+            void*& p = slots[traceOp.id];
+
+            switch (traceOp.op)
+            {
+                case 'a':
+                    allocator.free(p, sizes[traceOp.id]);
+                    p = allocator.allocate(traceOp.numBytes);
+                    LS_ASSERT(p != nullptr);
+                    touch(p, traceOp.numBytes);
+                    sizes[traceOp.id] = traceOp.numBytes;
+                    break;
+
+                case 'r':
+                    p = allocator.reallocate(p, traceOp.numBytes, sizes[traceOp.id]);
+                    LS_ASSERT(p != nullptr);
+                    touch(p, traceOp.numBytes);
+                    sizes[traceOp.id] = traceOp.numBytes;
+                    break;
+
+                default:
+                    allocator.free(p, sizes[traceOp.id]);
+                    p = nullptr;
+                    break;
+            }
+        }
+    }
+
+    ticks.tick();
+
+    const size_type rss = read_proc_status("VmRSS:");
+    const size_type peakRss = read_proc_status("VmHWM:");
+
+    for (unsigned id = 0; id < numSlots; ++id)
+    {
+        allocator.free(slots[id], sizes[id]);
+    }
+
+    return BenchResult{"trace", nullptr, 1, (size_type)trace.size() * numPasses, ticks.tick_time().count(), rss, peakRss};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Larson-style producer/consumer frees
+-----------------------------------------------------------------------------*/
+BenchResult bench_larson(utils::IAllocator& allocator, unsigned numThreads, size_type numOpsPerThread)
+{
+    constexpr unsigned num_slots = 8192;
+    constexpr size_type min_size = 8;
+    constexpr size_type max_size = 512;
+
+    // each slot stores its size in the first word of the allocation
+    std::vector<std::atomic<void*>> slots(num_slots);
+    std::vector<std::thread> threads;
+    std::atomic_bool start{false};
+    BenchClock ticks;
+
+    for (std::atomic<void*>& slot : slots)
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]()->void
+        {
+            XorShift rng{0x2545F4914F6CDD1Dull * (t + 1ull)};
+
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            for (size_type i = 0; i < numOpsPerThread; ++i)
+            {
+                const unsigned long long r = rng();
+                const size_type numBytes = min_size + (size_type)((r >> 32ull) % (max_size - min_size));
+
+                void* const p = allocator.allocate(numBytes);
+                LS_ASSERT(p != nullptr);
+                *static_cast<size_type*>(p) = numBytes;
+
+                // objects released here were most likely made by another thread
+                void* const pPrev = slots[r % num_slots].exchange(p, std::memory_order_acq_rel);
+                if (pPrev)
+                {
+                    allocator.free(pPrev, *static_cast<size_type*>(pPrev));
+                }
+            }
+        });
+    }
+
+    reset_peak_rss();
+    ticks.start();
+    start.store(true, std::memory_order_release);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    ticks.tick();
+
+    const size_type rss = read_proc_status("VmRSS:");
+    const size_type peakRss = read_proc_status("VmHWM:");
+
+    for (std::atomic<void*>& slot : slots)
+    {
+        void* const p = slot.load(std::memory_order_relaxed);
+        if (p)
+        {
+            allocator.free(p, *static_cast<size_type*>(p));
+        }
+    }
+
+    return BenchResult{"larson", nullptr, numThreads, numOpsPerThread * numThreads, ticks.tick_time().count(), rss, peakRss};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Size distributions
+-----------------------------------------------------------------------------*/
+struct SizeRange
+{
+    size_type minBytes;
+    size_type maxBytes;
+    unsigned weight; // percent
+};
+
+struct SizeDistribution
+{
+    const char* pName;
+    SizeRange ranges[5];
+};
+
+// Approximations of published allocation size histograms. Most programs
+// allocate overwhelmingly small objects, with a long tail of large buffers.
+constexpr SizeDistribution size_distributions[] = {
+    // key/value server: small keys and values, few large payloads
+    {"dist-kvstore",  {{8, 32, 45}, {33, 128, 35}, {129, 1024, 15}, {1025, 16384, 5}, {0, 0, 0}}},
+
+    // compiler/interpreter: tiny AST nodes and strings
+    {"dist-compiler", {{8, 24, 55}, {25, 64, 30}, {65, 256, 12}, {257, 4096, 3}, {0, 0, 0}}},
+
+    // web browser: mixed DOM nodes, strings, and image/layout buffers
+    {"dist-browser",  {{16, 64, 40}, {65, 512, 30}, {513, 4096, 20}, {4097, 65536, 9}, {65537, 262144, 1}}}
+};
+
+
+
+/*-------------------------------------
+ * Sample a size from a distribution
+-------------------------------------*/
+inline size_type sample_size(const SizeDistribution& dist, XorShift& rng) noexcept
+{
+    const unsigned long long r = rng();
+    unsigned pick = (unsigned)(r % 100ull);
+
+    for (const SizeRange& range : dist.ranges)
+    {
+        if (pick < range.weight)
+        {
+            return range.minBytes + (size_type)((r >> 32ull) % (range.maxBytes - range.minBytes + 1ull));
+        }
+
+        pick -= range.weight;
+    }
+
+    return dist.ranges[0].minBytes;
+}
+
+
+
+/*-------------------------------------
+ * Allocate batches, then free them in random order
+-------------------------------------*/
+template <typename ResetFunc>
+BenchResult bench_distribution(utils::IAllocator& allocator, ResetFunc&& resetFunc, const SizeDistribution& dist, unsigned numBatches)
+{
+    constexpr unsigned batch_size = 4096;
+    std::vector<void*> allocations(batch_size, nullptr);
+    std::vector<size_type> sizes(batch_size, 0);
+    std::vector<unsigned> order(batch_size);
+    XorShift rng{0xD1B54A32D192ED03ull};
+    BenchClock ticks;
+
+    // free order is precomputed so shuffling isn't measured
+    for (unsigned i = 0; i < batch_size; ++i)
+    {
+        order[i] = i;
+    }
+
+    for (unsigned i = batch_size - 1u; i > 0; --i)
+    {
+        const unsigned j = (unsigned)(rng() % (i + 1u));
+        const unsigned temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+
+    reset_peak_rss();
+    ticks.start();
+
+    for (unsigned b = 0; b < numBatches; ++b)
+    {
+        for (unsigned i = 0; i < batch_size; ++i)
+        {
+            sizes[i] = sample_size(dist, rng);
+            allocations[i] = allocator.allocate(sizes[i]);
+            LS_ASSERT(allocations[i] != nullptr);
+            touch(allocations[i], sizes[i]);
+        }
+
+        for (unsigned i = 0; i < batch_size; ++i)
+        {
+            allocator.free(allocations[order[i]], sizes[order[i]]);
+        }
+
+        resetFunc();
+    }
+
+    ticks.tick();
+
+    const size_type rss = read_proc_status("VmRSS:");
+    const size_type peakRss = read_proc_status("VmHWM:");
+
+    return BenchResult{dist.pName, nullptr, 1, (size_type)numBatches * batch_size * 2ull, ticks.tick_time().count(), rss, peakRss};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Main
+-----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+    argparse::ArgParser parser;
+
+    parser.set_argument("help", 'h')
+        .num_required(argparse::ArgCount::ZERO)
+        .description("Help")
+        .help_text("Print this help and exit.");
+
+    parser.set_argument("trace", 't')
+        .num_required(argparse::ArgCount::ONE)
+        .type(argparse::ArgType::STRING)
+        .description("Trace File")
+        .help_text("Replay an allocation trace instead of the built-in one.");
+
+    parser.set_argument("csv", 'o')
+        .num_required(argparse::ArgCount::ONE)
+        .type(argparse::ArgType::STRING)
+        .description("CSV File")
+        .help_text("Write results to a file instead of stdout.");
+
+    parser.set_argument("threads", 'j')
+        .num_required(argparse::ArgCount::ONE)
+        .type(argparse::ArgType::INTEGRAL)
+        .description("Thread Count")
+        .help_text("Number of threads used by threaded workloads.");
+
+    parser.set_argument("scale", 's')
+        .num_required(argparse::ArgCount::ONE)
+        .type(argparse::ArgType::INTEGRAL)
+        .description("Workload Scale")
+        .help_text("Multiplier for the amount of work done in each workload.");
+
+    if (!parser.parse(argc, argv))
+    {
+        return -1;
+    }
+
+    if (parser.value_exists("help"))
+    {
+        std::cout
+            << "Usage: " << argv[0] << " [--trace FILE] [--csv FILE] [--threads N] [--scale N]\n"
+            << "Trace lines are \"a <id> <size>\", \"r <id> <size>\", or \"f <id>\"."
+            << std::endl;
+        return 0;
+    }
+
+    const unsigned numThreads = parser.value_exists("threads") ? (unsigned)parser.value_as_int("threads") : 4u;
+    const unsigned scale = parser.value_exists("scale") ? (unsigned)parser.value_as_int("scale") : 1u;
+
+    std::vector<TraceOp> trace;
+    unsigned numTraceSlots = 0;
+
+    if (parser.value_exists("trace"))
+    {
+        if (!load_trace(parser.value_as_string("trace"), trace, numTraceSlots))
+        {
+            return -2;
+        }
+    }
+    else
+    {
+        generate_trace(200000, trace, numTraceSlots);
+    }
+
+    std::ofstream csvFile;
+    if (parser.value_exists("csv"))
+    {
+        csvFile.open(parser.value_as_string("csv"));
+        if (!csvFile.good())
+        {
+            std::cerr << "Unable to open CSV file: " << parser.value_as_string("csv") << std::endl;
+            return -3;
+        }
+    }
+
+    std::ostream& out = csvFile.is_open() ? static_cast<std::ostream&>(csvFile) : std::cout;
+    write_csv_header(out);
+
+    for (unsigned a = 0; a < BENCH_ALLOC_COUNT; ++a)
+    {
+        const BenchAllocatorType type = (BenchAllocatorType)a;
+        std::cerr << "Benchmarking " << bench_alloc_names[a] << "..." << std::endl;
+
+        bool passed = true;
+
+        if (bench_alloc_can_free[a])
+        {
+            passed = passed && run_isolated(out, bench_alloc_names[a], [&]()->BenchResult
+            {
+                BenchResult result;
+                with_allocator(type, false, [&](utils::IAllocator& allocator, auto)->void
+                {
+                    result = bench_trace(allocator, trace, numTraceSlots, scale);
+                });
+
+                return result;
+            });
+
+            passed = passed && run_isolated(out, bench_alloc_names[a], [&]()->BenchResult
+            {
+                BenchResult result;
+                with_allocator(type, numThreads > 1u, [&](utils::IAllocator& allocator, auto)->void
+                {
+                    result = bench_larson(allocator, numThreads, 100000ull * scale);
+                });
+
+                return result;
+            });
+        }
+
+        for (const SizeDistribution& dist : size_distributions)
+        {
+            passed = passed && run_isolated(out, bench_alloc_names[a], [&]()->BenchResult
+            {
+                BenchResult result;
+                with_allocator(type, false, [&](utils::IAllocator& allocator, auto resetFunc)->void
+                {
+                    if constexpr (std::is_same_v<decltype(resetFunc), std::nullptr_t>)
+                    {
+                        result = bench_distribution(allocator, []()->void {}, dist, 25u * scale);
+                    }
+                    else
+                    {
+                        result = bench_distribution(allocator, resetFunc, dist, 25u * scale);
+                    }
+                });
+
+                return result;
+            });
+        }
+
+        if (!passed)
+        {
+            return -4;
+        }
+    }
+
+    return 0;
+}
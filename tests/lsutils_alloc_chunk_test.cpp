@@ -1,10 +1,102 @@
 
 #include <iostream>
+#include <thread>
+#include <vector>
 
+#include "lightsky/utils/Assertions.h"
 #include "lightsky/utils/ChunkAllocator.hpp"
 
 
 
+/*-----------------------------------------------------------------------------
+ * Concurrent allocations, with and without thread caches
+-----------------------------------------------------------------------------*/
+int test_lock_free_chunks()
+{
+    constexpr unsigned num_threads = 4;
+    constexpr unsigned num_iterations = 2000;
+    constexpr unsigned max_allocations = 64;
+    constexpr unsigned block_size = 64;
+    constexpr unsigned cache_size = 32;
+
+    // leave room for every thread to fill its cache as well
+    constexpr unsigned max_chunks = num_threads * (max_allocations + cache_size);
+
+    typedef ls::utils::LockFreeChunkAllocator<block_size, block_size * max_chunks, cache_size> AllocatorType;
+
+    AllocatorType allocator;
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&allocator, t]()->void
+        {
+            AllocatorType::ThreadCache cache{allocator};
+            const bool useCache = (t & 1u) != 0;
+            unsigned* allocations[max_allocations];
+
+            for (unsigned i = 0; i < num_iterations; ++i)
+            {
+                const unsigned numAllocs = 1u + ((i * 2654435761u + t) % max_allocations);
+
+                for (unsigned j = 0; j < numAllocs; ++j)
+                {
+                    unsigned* const p = static_cast<unsigned*>(useCache ? cache.allocate() : allocator.allocate());
+                    LS_ASSERT(p != nullptr);
+
+                    p[0] = t;
+                    p[block_size/sizeof(unsigned) - 1] = i;
+                    allocations[j] = p;
+                }
+
+                // a chunk handed to two threads at once would be overwritten
+                for (unsigned j = 0; j < numAllocs; ++j)
+                {
+                    unsigned* const p = allocations[j];
+                    LS_ASSERT(p[0] == t && p[block_size/sizeof(unsigned) - 1] == i);
+
+                    // alternate between the cache and the shared free list,
+                    // independent of which one the chunk came from
+                    if ((i + j) & 1u)
+                    {
+                        cache.free(p);
+                    }
+                    else
+                    {
+                        allocator.free(p);
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    // all caches were flushed on thread exit
+    std::vector<void*> allocations;
+    for (void* p = allocator.allocate(); p != nullptr; p = allocator.allocate())
+    {
+        allocations.push_back(p);
+    }
+
+    LS_ASSERT(allocations.size() == max_chunks);
+
+    for (void* p : allocations)
+    {
+        allocator.free(p);
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
 int main()
 {
     constexpr unsigned alloc_table_size = 1024*1024;
@@ -84,5 +176,5 @@ int main()
 
     delete [] allocations;
 
-    return 0;
+    return test_lock_free_chunks();
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 
+#include <atomic>
+#include <cstdint> // uintptr_t
 #include <cstring>
 #include <iostream>
 #include <memory> // std::nothrow
@@ -7,6 +9,7 @@
 
 #include "lightsky/utils/GeneralAllocator.hpp"
 #include "lightsky/utils/SpinLock.hpp"
+#include "lightsky/utils/ThreadCachedAllocator.hpp"
 #include "lightsky/utils/Time.hpp"
 
 namespace utils = ls::utils;
@@ -377,6 +380,113 @@ int test_threaded_allocations()
 
 
 
+int test_thread_cached_allocations()
+{
+    constexpr unsigned num_threads = 4;
+    constexpr unsigned max_allocations = 1024u*8u;
+
+    utils::MallocMemorySource memSrc{};
+    utils::GeneralAllocator<4096-(sizeof(unsigned long long)*4), true> centralHeap{memSrc};
+    utils::ThreadCachedAllocator allocator{centralHeap};
+
+    std::vector<void*> allocations[num_threads];
+    std::atomic_int ret{0};
+
+    auto allocFunc = [&](unsigned threadId)->void
+    {
+        std::vector<void*>& ptrs = allocations[threadId];
+        ptrs.resize(max_allocations, nullptr);
+
+        for (unsigned i = 0; i < max_allocations; ++i)
+        {
+            const unsigned long long numBytes = 1ull + ((i * 2654435761u + threadId) % 6144u);
+            unsigned char* const p = static_cast<unsigned char*>(allocator.allocate(numBytes));
+            if (!p)
+            {
+                std::cerr << "Error: thread-cached allocation #" << i << " failed." << std::endl;
+                ret = -1;
+                return;
+            }
+
+            p[0] = (unsigned char)threadId;
+            p[numBytes-1] = (unsigned char)threadId;
+            ptrs[i] = p;
+
+            // Exercise local reuse
+            if (i % 3 == 0)
+            {
+                ptrs[i] = allocator.reallocate(p, numBytes * 2);
+                LS_ASSERT(static_cast<unsigned char*>(ptrs[i])[0] == (unsigned char)threadId);
+            }
+        }
+    };
+
+    // Free memory allocated by another thread
+    auto freeFunc = [&](unsigned threadId)->void
+    {
+        std::vector<void*>& ptrs = allocations[(threadId + 1) % num_threads];
+
+        for (void* p : ptrs)
+        {
+            LS_ASSERT(static_cast<unsigned char*>(p)[0] == (unsigned char)((threadId + 1) % num_threads));
+            allocator.free(p);
+        }
+
+        ptrs.clear();
+    };
+
+    for (unsigned testRuns = 0; testRuns < 4; ++testRuns)
+    {
+        std::vector<std::thread> threads;
+
+        for (unsigned t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back(allocFunc, t);
+        }
+
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+
+        threads.clear();
+
+        if (ret.load() != 0)
+        {
+            return ret.load();
+        }
+
+        for (unsigned t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back(freeFunc, t);
+        }
+
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+    }
+
+    // Over-aligned blocks bypass the thread cache
+    for (unsigned long long alignment = 8ull; alignment <= 1024ull; alignment *= 2ull)
+    {
+        void* const p = allocator.allocate_aligned(alignment + 7ull, alignment);
+        if (!p || (reinterpret_cast<uintptr_t>(p) % alignment) != 0 || allocator.usable_size(p) < alignment + 7ull)
+        {
+            std::cerr << "Error: unable to allocate " << alignment << "-byte aligned memory." << std::endl;
+            return -2;
+        }
+
+        allocator.free(p);
+    }
+
+    allocator.flush_thread_cache();
+
+    return ret.load();
+}
+
+
+
 int main()
 {
     int ret = 0;
@@ -405,6 +515,14 @@ int main()
         ret = test_threaded_allocations();
     #endif
 
+    #if 1
+        ret = test_thread_cached_allocations();
+        if (ret != 0)
+        {
+            return ret;
+        }
+    #endif
+
     ticks.tick();
     std::cout << "\tDone." << std::endl;
 
@@ -0,0 +1,161 @@
+/*
+ * File:   lsutils_alloc_linear_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 11:25 AM
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/LinearAllocator.hpp"
+#include "lightsky/utils/MemorySource.hpp"
+#include "lightsky/utils/Time.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Bump allocation, markers, and scopes
+-----------------------------------------------------------------------------*/
+int test_linear_basics(utils::MemorySource& memSource)
+{
+    utils::LinearAllocator allocator{memSource, 4096};
+    utils::LinearAllocator::size_type numBytes = 0;
+
+    LS_ASSERT(allocator.allocate(0) == nullptr);
+    LS_ASSERT(allocator.capacity() == 0);
+
+    char* const a = static_cast<char*>(allocator.allocate(1, &numBytes));
+    char* const b = static_cast<char*>(allocator.allocate(24));
+    LS_ASSERT(a != nullptr && numBytes == utils::LinearAllocator::alignment);
+    LS_ASSERT(b == a + utils::LinearAllocator::alignment);
+    LS_ASSERT((reinterpret_cast<uintptr_t>(b) % utils::LinearAllocator::alignment) == 0);
+    LS_ASSERT(allocator.bytes_used() == 48);
+
+    // the most recent allocation can be resized and freed
+    void* p = allocator.reallocate(b, 100);
+    LS_ASSERT(p == b);
+    allocator.free(b);
+    LS_ASSERT(allocator.bytes_used() == 16);
+
+    // freeing anything else is a no-op
+    allocator.free(a);
+    LS_ASSERT(allocator.bytes_used() == 16);
+
+    const utils::LinearAllocator::Marker marker = allocator.mark();
+    {
+        utils::LinearAllocator::Scope scope{allocator};
+
+        // spill into several growth blocks
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            unsigned char* const pData = static_cast<unsigned char*>(allocator.allocate(1000));
+            LS_ASSERT(pData != nullptr);
+            std::memset(pData, (int)i, 1000);
+        }
+
+        // oversized allocations get their own block
+        p = allocator.allocate(1024 * 64);
+        LS_ASSERT(p != nullptr);
+        std::memset(p, 0, 1024 * 64);
+    }
+
+    LS_ASSERT(allocator.bytes_used() == 16);
+    LS_ASSERT(allocator.mark().pBlock == marker.pBlock && allocator.mark().pHead == marker.pHead);
+
+    // a rewind keeps one spare block around
+    const utils::LinearAllocator::size_type capacity = allocator.capacity();
+    LS_ASSERT(capacity > 4096);
+    p = allocator.allocate(4000);
+    LS_ASSERT(allocator.capacity() == capacity);
+
+    // moved allocations keep their contents
+    std::memset(a, 0x5A, 16);
+    p = allocator.reallocate(a, 64);
+    LS_ASSERT(p != a && static_cast<char*>(p)[15] == 0x5A);
+
+    unsigned* const pArray = static_cast<unsigned*>(allocator.allocate_contiguous(100, sizeof(unsigned)));
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        LS_ASSERT(pArray[i] == 0);
+    }
+
+    allocator.reset();
+    LS_ASSERT(allocator.bytes_used() == 0);
+    LS_ASSERT(allocator.allocate(1) == a);
+
+    // fixed-size arenas fail instead of growing
+    utils::LinearAllocator fixedAllocator{memSource, 1024, false};
+    LS_ASSERT(fixedAllocator.allocate(512) != nullptr);
+    LS_ASSERT(fixedAllocator.allocate(1024) == nullptr);
+
+    utils::LinearAllocator movedAllocator{std::move(fixedAllocator)};
+    LS_ASSERT(movedAllocator.bytes_used() == 512);
+    LS_ASSERT(fixedAllocator.capacity() == 0);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Per-frame scratch allocations
+-----------------------------------------------------------------------------*/
+int test_linear_frames(utils::MemorySource& memSource)
+{
+    constexpr unsigned num_frames = 1000;
+    constexpr unsigned max_allocations = 4096;
+
+    utils::LinearAllocator allocator{memSource};
+    unsigned long long checksum = 0;
+
+    for (unsigned frame = 0; frame < num_frames; ++frame)
+    {
+        utils::LinearAllocator::Scope scope{allocator};
+
+        for (unsigned i = 0; i < max_allocations; ++i)
+        {
+            const unsigned numBytes = 1u + ((i * 2654435761u + frame) % 256u);
+            unsigned char* const p = static_cast<unsigned char*>(allocator.allocate(numBytes));
+            p[0] = (unsigned char)i;
+            p[numBytes-1] = (unsigned char)frame;
+            checksum += p[0];
+        }
+    }
+
+    LS_ASSERT(allocator.bytes_used() == 0);
+    return checksum ? 0 : -1;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = 0;
+    utils::MallocMemorySource mallocSrc{};
+    ls::utils::Clock<unsigned long long, std::ratio<1, 1000>> ticks;
+
+    std::cout << "Running linear allocator tests..." << std::endl;
+    ticks.start();
+
+    ret = test_linear_basics(mallocSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_linear_frames(mallocSrc);
+
+    ticks.tick();
+    std::cout << "\tDone." << std::endl;
+    std::cout << "Allocator time: " << ticks.tick_time().count() << "ms" << std::endl;
+
+    return ret;
+}
@@ -0,0 +1,230 @@
+/*
+ * File:   lsutils_alloc_slab_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 11:40 AM
+ */
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "lightsky/utils/AllocatorStats.hpp"
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/MemorySource.hpp"
+#include "lightsky/utils/SlabAllocator.hpp"
+#include "lightsky/utils/Time.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Size classes, reuse, and large allocations
+-----------------------------------------------------------------------------*/
+int test_slab_basics(utils::MemorySource& memSource)
+{
+    utils::SlabAllocator allocator{memSource};
+    utils::SlabAllocator::size_type numBytes = 0;
+
+    void* p = allocator.allocate(1, &numBytes);
+    LS_ASSERT(p != nullptr && numBytes == 16);
+    allocator.free(p);
+
+    // freed blocks are reused immediately
+    void* q = allocator.allocate(16);
+    LS_ASSERT(q == p);
+    allocator.free(q);
+
+    // 1.25x size class steps above 128 bytes
+    p = allocator.allocate(129, &numBytes);
+    LS_ASSERT(numBytes == 160);
+    allocator.free(p);
+
+    p = allocator.allocate(1025, &numBytes);
+    LS_ASSERT(numBytes == 1280);
+
+    // realloc within a size class keeps the block
+    std::memset(p, 0x7F, 1025);
+    q = allocator.reallocate(p, 1200);
+    LS_ASSERT(q == p);
+
+    // realloc to a larger class must preserve the contents
+    q = allocator.reallocate(p, 4000);
+    LS_ASSERT(q != nullptr);
+    LS_ASSERT(static_cast<unsigned char*>(q)[0] == 0x7F && static_cast<unsigned char*>(q)[1024] == 0x7F);
+
+    // large allocations bypass the slabs
+    p = allocator.reallocate(q, 1024*1024);
+    LS_ASSERT(p != nullptr);
+    LS_ASSERT(static_cast<unsigned char*>(p)[1024] == 0x7F);
+    std::memset(p, 0, 1024*1024);
+    allocator.free(p);
+
+    unsigned* const pArray = static_cast<unsigned*>(allocator.allocate_contiguous(100, sizeof(unsigned)));
+    LS_ASSERT(pArray != nullptr);
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        LS_ASSERT(pArray[i] == 0);
+    }
+    allocator.free(pArray);
+
+    LS_ASSERT(allocator.allocate(0) == nullptr);
+    allocator.free(nullptr);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Large allocations only request what they need from aligned sources
+-----------------------------------------------------------------------------*/
+int test_slab_large(utils::MemorySource& memSource)
+{
+    constexpr utils::SlabAllocator::size_type numBytes = 10000;
+
+    utils::StatsMemorySource statsSrc{memSource};
+    utils::SlabAllocator allocator{statsSrc};
+    utils::AllocatorStatsSnapshot stats{};
+
+    unsigned char* const p = static_cast<unsigned char*>(allocator.allocate(numBytes));
+    LS_ASSERT(p != nullptr);
+    std::memset(p, 0x7F, numBytes);
+
+    statsSrc.fill_snapshot(stats);
+    LS_ASSERT(stats.numRefills == 1);
+    LS_ASSERT(stats.numRefillBytes >= numBytes);
+    LS_ASSERT(stats.numRefillBytes < numBytes + utils::SlabAllocator::slab_size);
+
+    allocator.free(p);
+
+    statsSrc.fill_snapshot(stats);
+    LS_ASSERT(stats.numReleases == 1);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Fill and drain many slabs of every size class
+-----------------------------------------------------------------------------*/
+int test_slab_churn(utils::MemorySource& memSource)
+{
+    constexpr unsigned max_allocations = 1024u*256u;
+
+    utils::SlabAllocator allocator{memSource};
+    std::vector<unsigned char*> allocations;
+    allocations.resize(max_allocations, nullptr);
+
+    for (unsigned testRuns = 0; testRuns < 4; ++testRuns)
+    {
+        for (unsigned i = 0; i < max_allocations; ++i)
+        {
+            const unsigned numBytes = 1u + ((i * 2654435761u) % (testRuns & 1 ? 8192u : 512u));
+            unsigned char* const p = static_cast<unsigned char*>(allocator.allocate(numBytes));
+            if (!p)
+            {
+                std::cerr << "Error: ran out of memory at allocation #" << i << std::endl;
+                return -1;
+            }
+
+            p[0] = (unsigned char)i;
+            p[numBytes-1] = (unsigned char)i;
+            allocations[i] = p;
+        }
+
+        // free every other allocation, then the rest, to fragment the slabs
+        for (unsigned i = 0; i < max_allocations; i += 2)
+        {
+            LS_ASSERT(allocations[i][0] == (unsigned char)i);
+            allocator.free(allocations[i]);
+        }
+
+        for (unsigned i = 1; i < max_allocations; i += 2)
+        {
+            LS_ASSERT(allocations[i][0] == (unsigned char)i);
+            allocator.free(allocations[i]);
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = 0;
+    utils::MallocMemorySource mallocSrc{};
+    utils::SystemMemorySource systemSrc{};
+    utils::SystemMemorySource thpSrc{utils::SystemPageMode::SYSTEM_PAGES_TRANSPARENT_HUGE};
+    utils::SystemMemorySource hugeNumaSrc{utils::SystemPageMode::SYSTEM_PAGES_HUGE, 0};
+    ls::utils::Clock<unsigned long long, std::ratio<1, 1000>> ticks;
+
+    std::cout << "Running slab allocator tests..." << std::endl;
+    ticks.start();
+
+    ret = test_slab_basics(mallocSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_basics(systemSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    const unsigned long long hugePageSize = utils::SystemMemorySource::huge_page_size();
+    if (!hugePageSize || (hugePageSize % utils::SystemMemorySource::page_size()) != 0)
+    {
+        std::cerr << "Error: invalid huge page size: " << hugePageSize << std::endl;
+        return -2;
+    }
+
+    // Falls back to transparent huge pages, or regular pages, if none are
+    // reserved on this system
+    ret = test_slab_basics(thpSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_basics(hugeNumaSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_large(mallocSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_large(systemSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_churn(mallocSrc);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_slab_churn(systemSrc);
+
+    ticks.tick();
+    std::cout << "\tDone." << std::endl;
+    std::cout << "Allocator time: " << ticks.tick_time().count() << "ms" << std::endl;
+
+    return ret;
+}
@@ -0,0 +1,272 @@
+/*
+ * File:   lsutils_alloc_stats_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 17, 2026 at 3:05 PM
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include "lightsky/utils/AllocatorStats.hpp"
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/GeneralAllocator.hpp"
+#include "lightsky/utils/MemorySource.hpp"
+#include "lightsky/utils/SlabAllocator.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Usage counters, refills, and free-list statistics
+-----------------------------------------------------------------------------*/
+int test_stats_counters()
+{
+    utils::MallocMemorySource mallocSrc;
+    utils::StatsMemorySource statsSrc{mallocSrc};
+    utils::GeneralAllocator<> generalAllocator{statsSrc};
+    utils::StatsAllocator allocator{generalAllocator, &statsSrc};
+
+    utils::AllocatorStatsSnapshot stats = allocator.snapshot();
+    LS_ASSERT(stats.bytesInUse == 0 && stats.numAllocations == 0);
+    LS_ASSERT(stats.hasFreeList);
+
+    void* a = allocator.allocate(10);
+    void* b = allocator.allocate(100);
+    void* c = allocator.allocate(1000);
+    LS_ASSERT(a && b && c);
+    LS_ASSERT(allocator.allocate(0) == nullptr);
+
+    stats = allocator.snapshot();
+    LS_ASSERT(stats.bytesInUse == 1110);
+    LS_ASSERT(stats.peakBytesInUse == 1110);
+    LS_ASSERT(stats.numAllocations == 3);
+    LS_ASSERT(stats.sizeBuckets[utils::AllocatorStatsSnapshot::size_bucket(10)] == 1);
+    LS_ASSERT(stats.sizeBuckets[utils::AllocatorStatsSnapshot::size_bucket(100)] == 1);
+    LS_ASSERT(stats.sizeBuckets[utils::AllocatorStatsSnapshot::size_bucket(1000)] == 1);
+    LS_ASSERT(stats.numRefills >= 1 && stats.numRefillBytes >= 1110);
+
+    // reallocation keeps data intact and updates usage
+    std::memset(b, 0x3C, 100);
+    b = allocator.reallocate(b, 4000, 100);
+    LS_ASSERT(b != nullptr && static_cast<unsigned char*>(b)[99] == 0x3C);
+
+    allocator.free(a, 10);
+    allocator.free(c, 1000);
+
+    stats = allocator.snapshot();
+    LS_ASSERT(stats.bytesInUse == 4000);
+    LS_ASSERT(stats.peakBytesInUse == 5010);
+    LS_ASSERT(stats.numAllocations == 4 && stats.numFrees == 3);
+    LS_ASSERT(stats.hasFreeList && stats.freeList.numFreeBlocks > 0);
+    LS_ASSERT(stats.freeList.largestFreeBlock <= stats.freeList.numFreeBytes);
+    LS_ASSERT(stats.fragmentation() >= 0.0 && stats.fragmentation() <= 1.0);
+
+    allocator.reset_peak();
+    LS_ASSERT(allocator.snapshot().peakBytesInUse == 4000);
+
+    allocator.free(b, 4000);
+    LS_ASSERT(allocator.snapshot().bytesInUse == 0);
+
+    // zero-initialized allocations
+    unsigned* const pData = static_cast<unsigned*>(allocator.allocate_contiguous(64, sizeof(unsigned)));
+    LS_ASSERT(pData != nullptr && pData[0] == 0 && pData[63] == 0);
+    allocator.free(pData, 64 * sizeof(unsigned));
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Requests reach the wrapped allocator unchanged unless headers are enabled
+-----------------------------------------------------------------------------*/
+int test_stats_headers()
+{
+    utils::MallocMemorySource mallocSrc;
+    utils::MallocAllocator mallocAllocator{mallocSrc};
+
+    // The inner allocator sees exactly what the outer one requests
+    utils::StatsAllocator wrapped{mallocAllocator};
+    utils::StatsAllocator allocator{static_cast<utils::IAllocator&>(wrapped)};
+
+    void* p = allocator.allocate(48);
+    LS_ASSERT(p != nullptr);
+
+    utils::AllocatorStatsSnapshot stats = wrapped.snapshot();
+    if (stats.bytesInUse != 48 || stats.sizeBuckets[utils::AllocatorStatsSnapshot::size_bucket(48)] != 1)
+    {
+        std::cerr << "Error: a 48-byte request reached the wrapped allocator as " << stats.bytesInUse << " bytes." << std::endl;
+        return -1;
+    }
+
+    allocator.free(p, 48);
+    if (allocator.snapshot().bytesInUse != 0 || wrapped.snapshot().bytesInUse != 0)
+    {
+        std::cerr << "Error: a sized free was not tracked." << std::endl;
+        return -2;
+    }
+
+    // Unsized frees are counted, but can't update the bytes in use
+    p = allocator.allocate(8);
+    allocator.free(p);
+    stats = allocator.snapshot();
+    LS_ASSERT(stats.numFrees == 2 && stats.bytesInUse == 8);
+
+    // Size headers track unsized frees, at the cost of larger requests
+    utils::StatsAllocator headerWrapped{mallocAllocator};
+    utils::StatsAllocator headerAllocator{static_cast<utils::IAllocator&>(headerWrapped), nullptr, true};
+
+    p = headerAllocator.allocate(48);
+    LS_ASSERT(p != nullptr);
+    p = headerAllocator.reallocate(p, 96);
+    LS_ASSERT(p != nullptr);
+
+    if (headerWrapped.snapshot().bytesInUse != 96 + 16 || headerAllocator.snapshot().bytesInUse != 96)
+    {
+        std::cerr << "Error: size headers were not tracked through an unsized reallocation." << std::endl;
+        return -3;
+    }
+
+    headerAllocator.free(p);
+    if (headerAllocator.snapshot().bytesInUse != 0 || headerWrapped.snapshot().bytesInUse != 0)
+    {
+        std::cerr << "Error: size headers were not tracked through an unsized free." << std::endl;
+        return -4;
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Binary and JSON export
+-----------------------------------------------------------------------------*/
+int test_stats_export()
+{
+    utils::MallocMemorySource mallocSrc;
+    utils::SlabAllocator slabAllocator{mallocSrc};
+    utils::StatsAllocator allocator{slabAllocator};
+
+    void* allocations[64];
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        allocations[i] = allocator.allocate(1u + i * 97u);
+        LS_ASSERT(allocations[i] != nullptr);
+    }
+
+    for (unsigned i = 0; i < 64; i += 2)
+    {
+        allocator.free(allocations[i], 1u + i * 97u);
+    }
+
+    const utils::AllocatorStatsSnapshot stats = allocator.snapshot();
+
+    unsigned char buffer[utils::allocator_stats_max_binary_size()];
+    const unsigned long long numBytes = utils::allocator_stats_to_binary(stats, buffer, sizeof(buffer));
+    LS_ASSERT(numBytes > 0 && numBytes < sizeof(buffer));
+    LS_ASSERT(utils::allocator_stats_to_binary(stats, buffer, 8) == 0);
+
+    utils::AllocatorStatsSnapshot decoded;
+    LS_ASSERT(utils::allocator_stats_from_binary(buffer, numBytes, decoded) == numBytes);
+    LS_ASSERT(decoded.timestampNs == stats.timestampNs);
+    LS_ASSERT(decoded.bytesInUse == stats.bytesInUse);
+    LS_ASSERT(decoded.numFrees == stats.numFrees);
+    LS_ASSERT(0 == std::memcmp(decoded.sizeBuckets, stats.sizeBuckets, sizeof(stats.sizeBuckets)));
+    LS_ASSERT(decoded.hasFreeList == stats.hasFreeList);
+    LS_ASSERT(decoded.freeList.numFreeBytes == stats.freeList.numFreeBytes);
+
+    // truncated or corrupt data is rejected
+    LS_ASSERT(utils::allocator_stats_from_binary(buffer, numBytes-1, decoded) == 0);
+    buffer[0] = 'X';
+    LS_ASSERT(utils::allocator_stats_from_binary(buffer, numBytes, decoded) == 0);
+
+    const std::string json = utils::allocator_stats_to_json(stats);
+    std::cout << json << std::endl;
+    LS_ASSERT(json.front() == '{' && json.back() == '}');
+    LS_ASSERT(json.find("\"bytes_in_use\":") != std::string::npos);
+    LS_ASSERT(json.find("\"size_buckets\":[") != std::string::npos);
+    LS_ASSERT(json.find("\"free_list\":{") != std::string::npos);
+
+    for (unsigned i = 1; i < 64; i += 2)
+    {
+        allocator.free(allocations[i], 1u + i * 97u);
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Periodic snapshots
+-----------------------------------------------------------------------------*/
+int test_stats_history()
+{
+    utils::MallocMemorySource mallocSrc;
+    utils::SlabAllocator slabAllocator{mallocSrc};
+    utils::StatsAllocator allocator{slabAllocator};
+
+    // an interval of 0 records every poll
+    utils::AllocatorStatsHistory history{4, 0};
+    void* allocations[6];
+
+    for (unsigned i = 0; i < 6; ++i)
+    {
+        allocations[i] = allocator.allocate(32);
+        LS_ASSERT(history.poll(allocator));
+    }
+
+    LS_ASSERT(history.size() == 4 && history.capacity() == 4);
+    LS_ASSERT(history[0].numAllocations == 3);
+    LS_ASSERT(history[3].numAllocations == 6);
+
+    const std::string json = utils::allocator_stats_to_json(history);
+    LS_ASSERT(json.front() == '[' && json.back() == ']');
+
+    // a long interval skips polls after the first
+    utils::AllocatorStatsHistory slowHistory{4, 1000ull * 1000ull * 1000ull * 60ull};
+    LS_ASSERT(slowHistory.poll(allocator));
+    LS_ASSERT(!slowHistory.poll(allocator));
+    LS_ASSERT(slowHistory.size() == 1);
+
+    history.clear();
+    LS_ASSERT(history.size() == 0);
+
+    for (void* p : allocations)
+    {
+        allocator.free(p, 32);
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_stats_counters();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_stats_headers();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_stats_export();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return test_stats_history();
+}
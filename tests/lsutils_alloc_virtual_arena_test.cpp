@@ -0,0 +1,216 @@
+/*
+ * File:   lsutils_alloc_virtual_arena_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 16, 2026 at 4:30 PM
+ */
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/GeneralAllocator.hpp"
+#include "lightsky/utils/Time.hpp"
+#include "lightsky/utils/VirtualArenaMemorySource.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Allocation, coalescing, and in-place reallocation
+-----------------------------------------------------------------------------*/
+int test_arena_basics(utils::VirtualArenaReleaseMode releaseMode)
+{
+    const utils::VirtualArenaMemorySource::size_type pageSize = utils::SystemMemorySource::page_size();
+    utils::VirtualArenaMemorySource arena{256ull * 1024ull * 1024ull, releaseMode};
+    utils::VirtualArenaMemorySource::size_type numBytes = 0;
+
+    LS_ASSERT(arena.valid());
+    LS_ASSERT(arena.committed_bytes() == 0);
+
+    char* const a = static_cast<char*>(arena.allocate(1, &numBytes));
+    LS_ASSERT(a != nullptr && numBytes == pageSize);
+    LS_ASSERT(arena.contains(a));
+
+    char* const b = static_cast<char*>(arena.allocate(pageSize * 3));
+    char* const c = static_cast<char*>(arena.allocate(pageSize));
+    LS_ASSERT(b == a + pageSize);
+    LS_ASSERT(c == b + pageSize * 3);
+    std::memset(a, 'a', pageSize);
+    std::memset(b, 'b', pageSize * 3);
+    std::memset(c, 'c', pageSize);
+
+    // allocations at the top of the arena grow in place
+    char* p = static_cast<char*>(arena.reallocate(c, 64ull * 1024ull * 1024ull, &numBytes));
+    LS_ASSERT(p == c && numBytes == 64ull * 1024ull * 1024ull);
+    LS_ASSERT(p[pageSize-1] == 'c');
+    std::memset(p, 'c', numBytes);
+
+    // freed neighbors are coalesced and reused
+    arena.free(a);
+    arena.free(b);
+    char* const d = static_cast<char*>(arena.allocate(pageSize * 4));
+    LS_ASSERT(d == a);
+
+    // shrinking releases trailing pages which can then be grown back into
+    p = static_cast<char*>(arena.reallocate(d, pageSize));
+    LS_ASSERT(p == d);
+    p = static_cast<char*>(arena.reallocate(d, pageSize * 2));
+    LS_ASSERT(p == d);
+    std::memset(d, 'd', pageSize * 2);
+
+    // allocations with no room to grow are moved
+    p = static_cast<char*>(arena.reallocate(d, pageSize * 8));
+    LS_ASSERT(p != nullptr && p != d);
+    LS_ASSERT(p[0] == 'd' && p[pageSize * 2 - 1] == 'd');
+
+    // allocations larger than the reservation fail gracefully
+    LS_ASSERT(arena.allocate(arena.reserved_bytes() * 2ull) == nullptr);
+    LS_ASSERT(arena.allocate(0) == nullptr);
+
+    arena.free(p);
+    arena.free(c);
+    arena.free(nullptr);
+
+    // everything was returned, so the arena starts over from its base
+    p = static_cast<char*>(arena.allocate(pageSize));
+    LS_ASSERT(p == a);
+    arena.free(p);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * A single allocation may use the entire reservation
+-----------------------------------------------------------------------------*/
+int test_arena_full()
+{
+    const utils::VirtualArenaMemorySource::size_type pageSize = utils::SystemMemorySource::page_size();
+    utils::VirtualArenaMemorySource arena{pageSize * 16ull};
+    utils::VirtualArenaMemorySource::size_type numBytes = 0;
+
+    LS_ASSERT(arena.valid());
+    const utils::VirtualArenaMemorySource::size_type reservedBytes = arena.reserved_bytes();
+
+    char* p = static_cast<char*>(arena.allocate(reservedBytes, &numBytes));
+    LS_ASSERT(p != nullptr && numBytes == reservedBytes);
+    std::memset(p, 'p', reservedBytes);
+    LS_ASSERT(arena.allocate(1) == nullptr);
+    arena.free(p);
+
+    // reallocations may grow to fill the reservation as well
+    p = static_cast<char*>(arena.allocate(pageSize));
+    LS_ASSERT(p != nullptr);
+    p[0] = 'q';
+
+    char* const q = static_cast<char*>(arena.reallocate(p, reservedBytes, &numBytes));
+    LS_ASSERT(q == p && numBytes == reservedBytes);
+    LS_ASSERT(q[0] == 'q');
+    std::memset(q, 'q', reservedBytes);
+
+    LS_ASSERT(arena.reallocate(q, reservedBytes + 1ull) == nullptr);
+    arena.free(q);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Back a general-purpose allocator with the arena from multiple threads
+-----------------------------------------------------------------------------*/
+int test_arena_threads()
+{
+    constexpr unsigned num_threads = 4;
+    constexpr unsigned max_allocations = 1024u * 2u;
+
+    utils::VirtualArenaMemorySource arena{1024ull * 1024ull * 1024ull};
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&arena, t]()->void
+        {
+            std::vector<void*> allocations(max_allocations, nullptr);
+
+            for (unsigned i = 0; i < max_allocations; ++i)
+            {
+                const unsigned long long numBytes = 1ull + ((i * 2654435761u + t) % (32u * 1024u));
+                unsigned char* const p = static_cast<unsigned char*>(arena.allocate(numBytes));
+                LS_ASSERT(p != nullptr);
+
+                p[0] = (unsigned char)i;
+                p[numBytes-1] = (unsigned char)i;
+                allocations[i] = p;
+
+                if (i & 1u)
+                {
+                    allocations[i-1] = arena.reallocate(allocations[i-1], numBytes * 2ull);
+                    LS_ASSERT(static_cast<unsigned char*>(allocations[i-1])[0] == (unsigned char)(i-1u));
+                }
+            }
+
+            for (void* p : allocations)
+            {
+                arena.free(p);
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    utils::GeneralAllocator<1024ull * 1024ull, true> allocator{arena};
+    void* p = allocator.allocate(1024ull * 1024ull * 3ull);
+    LS_ASSERT(p != nullptr && arena.contains(p));
+    allocator.free(p);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = 0;
+    ls::utils::Clock<unsigned long long, std::ratio<1, 1000>> ticks;
+
+    std::cout << "Running virtual arena tests..." << std::endl;
+    ticks.start();
+
+    ret = test_arena_basics(utils::VirtualArenaReleaseMode::VIRTUAL_ARENA_RELEASE_EAGER);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_arena_basics(utils::VirtualArenaReleaseMode::VIRTUAL_ARENA_RELEASE_LAZY);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_arena_full();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_arena_threads();
+
+    ticks.tick();
+    std::cout << "\tDone." << std::endl;
+    std::cout << "Arena time: " << ticks.tick_time().count() << "ms" << std::endl;
+
+    return ret;
+}
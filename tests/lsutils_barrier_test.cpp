@@ -0,0 +1,173 @@
+/*
+ * File:   lsutils_barrier_test.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 3:15 p.m.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Barrier.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Shared test routine
+ *
+ * Every thread writes its slot of the current phase, then reads all slots of
+ * the same phase after the barrier. Any thread leaving the barrier early
+ * sees a stale value.
+-----------------------------------------------------------------------------*/
+template <class WaitFunc>
+bool run_phases(unsigned numThreads, unsigned numPhases, WaitFunc wait_func)
+{
+    std::vector<unsigned> slots(numThreads, 0);
+    std::atomic_bool passed{true};
+    std::vector<std::thread> threads;
+
+    auto thread_func = [&](unsigned threadId)->void
+    {
+        for (unsigned phase = 1; phase <= numPhases; ++phase)
+        {
+            slots[threadId] = phase;
+            wait_func(threadId);
+
+            for (unsigned t = 0; t < numThreads; ++t)
+            {
+                if (slots[t] != phase)
+                {
+                    passed.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            // Keep the next phase's writes away from this phase's reads
+            wait_func(threadId);
+        }
+    };
+
+    for (unsigned t = 1; t < numThreads; ++t)
+    {
+        threads.emplace_back(thread_func, t);
+    }
+
+    thread_func(0);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    return passed.load();
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tests
+-----------------------------------------------------------------------------*/
+int test_sense_barrier()
+{
+    for (unsigned spinCount : {0u, (unsigned)utils::SenseBarrier::DEFAULT_SPIN_COUNT})
+    {
+        for (unsigned numThreads : {1u, 2u, 5u, 8u})
+        {
+            utils::SenseBarrier barrier{numThreads, spinCount};
+            std::atomic<unsigned> numSerial{0};
+
+            LS_ASSERT(barrier.num_required_threads() == numThreads);
+            LS_ASSERT(barrier.num_waiting_threads() == 0);
+
+            const bool passed = run_phases(numThreads, 200, [&](unsigned)->void
+            {
+                if (barrier.wait())
+                {
+                    numSerial.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            if (!passed)
+            {
+                std::cerr << "Error: a thread left a SenseBarrier of " << numThreads << " threads early." << std::endl;
+                return -1;
+            }
+
+            // One thread per phase is told it arrived last
+            if (barrier.phase() != 400 || numSerial.load() != 400)
+            {
+                std::cerr << "Error: a SenseBarrier of " << numThreads << " threads completed " << numSerial.load() << " of 400 phases." << std::endl;
+                return -2;
+            }
+
+            LS_ASSERT(barrier.num_waiting_threads() == 0);
+        }
+    }
+
+    return 0;
+}
+
+
+
+int test_dissemination_barrier()
+{
+    {
+        utils::DisseminationBarrier barrier{1};
+        LS_ASSERT(barrier.num_rounds() == 0);
+        barrier.wait(0);
+        barrier.wait(1); // out of range
+    }
+
+    LS_ASSERT(utils::DisseminationBarrier{2}.num_rounds() == 1);
+    LS_ASSERT(utils::DisseminationBarrier{5}.num_rounds() == 3);
+    LS_ASSERT(utils::DisseminationBarrier{8}.num_rounds() == 3);
+    LS_ASSERT(utils::DisseminationBarrier{64}.num_rounds() == 6);
+
+    for (unsigned spinCount : {0u, (unsigned)utils::DisseminationBarrier::DEFAULT_SPIN_COUNT})
+    {
+        for (unsigned numThreads : {2u, 3u, 5u, 8u, 13u})
+        {
+            utils::DisseminationBarrier barrier{numThreads, spinCount};
+            LS_ASSERT(barrier.num_required_threads() == numThreads);
+
+            const bool passed = run_phases(numThreads, 200, [&](unsigned threadId)->void
+            {
+                barrier.wait(threadId);
+            });
+
+            if (!passed)
+            {
+                std::cerr << "Error: a thread left a DisseminationBarrier of " << numThreads << " threads early." << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_sense_barrier();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_dissemination_barrier();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All barrier tests passed." << std::endl;
+    return 0;
+}
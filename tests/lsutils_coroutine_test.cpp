@@ -0,0 +1,293 @@
+/*
+ * File:   lsutils_coroutine_test.cpp
+ * Author: miles
+ * Created on October 18, 2026, at 11:30 a.m.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Coroutine.hpp"
+#include "lightsky/utils/WorkerPool.hpp"
+#include "lightsky/utils/WorkerThread.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Coroutines used by the tests
+-----------------------------------------------------------------------------*/
+const std::thread::id gMainThreadId = std::this_thread::get_id();
+
+
+
+utils::Task<int> add_on_pool(utils::FunctionWorkerPool& pool, int a, int b)
+{
+    co_await utils::schedule(pool);
+    LS_ASSERT(std::this_thread::get_id() != gMainThreadId);
+
+    co_return a + b;
+}
+
+
+
+utils::Task<int> sum_nested(utils::FunctionWorkerPool& pool)
+{
+    int x = co_await add_on_pool(pool, 1, 2);
+    int y = co_await add_on_pool(pool, x, 3);
+    co_return y;
+}
+
+
+
+utils::Task<void> record_thread(utils::FunctionWorkerThread& worker, std::thread::id& outId)
+{
+    co_await utils::schedule(worker);
+    outId = std::this_thread::get_id();
+}
+
+
+
+utils::Task<unsigned> request(utils::FunctionWorkerPool& pool, utils::AsyncEvent& ioComplete, unsigned id)
+{
+    co_await utils::schedule(pool);
+
+    // Suspended requests hold no thread while waiting
+    co_await ioComplete;
+
+    co_return id;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tests
+-----------------------------------------------------------------------------*/
+int test_tasks(utils::FunctionWorkerPool& pool)
+{
+    utils::Task<int> task = add_on_pool(pool, 20, 22);
+    LS_ASSERT(task.valid());
+    LS_ASSERT(!task.done());
+    if (utils::sync_wait(task) != 42 || !task.done())
+    {
+        std::cerr << "Error: a Task scheduled on a pool returned the wrong result." << std::endl;
+        return -1;
+    }
+
+    utils::Task<int> nested = sum_nested(pool);
+    if (utils::sync_wait(nested) != 6)
+    {
+        std::cerr << "Error: nested Tasks returned the wrong result." << std::endl;
+        return -2;
+    }
+
+    return 0;
+}
+
+
+
+int test_worker_thread()
+{
+    utils::FunctionWorkerThread worker{};
+    std::thread::id workerId;
+
+    utils::Task<void> task = record_thread(worker, workerId);
+    utils::sync_wait(task);
+
+    if (workerId == std::thread::id{} || workerId == std::this_thread::get_id())
+    {
+        std::cerr << "Error: a Task scheduled on a worker thread did not run on it." << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+
+int test_when_all(utils::FunctionWorkerPool& pool)
+{
+    // Mixed result types
+    utils::Task<int> a = add_on_pool(pool, 1, 1);
+    utils::Task<int> b = add_on_pool(pool, 2, 2);
+    std::thread::id workerId;
+    utils::FunctionWorkerThread worker{};
+    utils::Task<void> c = record_thread(worker, workerId);
+
+    utils::Task<int> joined = [](utils::Task<int>& a, utils::Task<int>& b, utils::Task<void>& c)->utils::Task<int>
+    {
+        co_await utils::when_all(a, b, c);
+        co_return a.result() + b.result();
+    }(a, b, c);
+
+    if (utils::sync_wait(joined) != 6 || workerId == std::this_thread::get_id())
+    {
+        std::cerr << "Error: when_all() over mixed Task types returned the wrong result." << std::endl;
+        return -1;
+    }
+
+    // Many in-flight requests sharing a few threads
+    constexpr unsigned numRequests = 4000;
+    utils::AsyncEvent ioComplete;
+    std::vector<utils::Task<unsigned>> requests;
+    requests.reserve(numRequests);
+
+    for (unsigned i = 0; i < numRequests; ++i)
+    {
+        requests.emplace_back(request(pool, ioComplete, i));
+    }
+
+    utils::Task<unsigned long long> total = [](std::vector<utils::Task<unsigned>>& tasks)->utils::Task<unsigned long long>
+    {
+        co_await utils::when_all(tasks.data(), tasks.size());
+
+        unsigned long long sum = 0;
+        for (utils::Task<unsigned>& t : tasks)
+        {
+            sum += t.result();
+        }
+
+        co_return sum;
+    }(requests);
+
+    std::thread io{[&]()->void
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        ioComplete.set(pool);
+    }};
+
+    const unsigned long long sum = utils::sync_wait(total);
+    io.join();
+
+    if (sum != (unsigned long long)numRequests * (numRequests - 1u) / 2u)
+    {
+        std::cerr << "Error: when_all() over " << numRequests << " suspended requests returned " << sum << '.' << std::endl;
+        return -2;
+    }
+
+    // An empty set completes immediately
+    utils::Task<int> empty = [](utils::Task<int>* pTasks)->utils::Task<int>
+    {
+        co_await utils::when_all(pTasks, 0);
+        co_return 1;
+    }(nullptr);
+
+    if (utils::sync_wait(empty) != 1)
+    {
+        std::cerr << "Error: when_all() over an empty set did not complete." << std::endl;
+        return -3;
+    }
+
+    return 0;
+}
+
+
+
+int test_events()
+{
+    utils::AsyncEvent event;
+    LS_ASSERT(!event.is_set());
+
+    std::atomic<unsigned> numWoken{0};
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]()->void
+        {
+            event.wait();
+            numWoken.fetch_add(1);
+        });
+    }
+
+    // Coroutines awaiting the event are resumed on the setting thread
+    bool resumed = false;
+    utils::Task<void> waiter = [](utils::AsyncEvent& e, bool& outResumed)->utils::Task<void>
+    {
+        co_await e;
+        outResumed = true;
+    }(event, resumed);
+
+    utils::AsyncEvent waiterDone;
+    waiter.handle().promise().continue_with(std::coroutine_handle<>{}, nullptr, &waiterDone);
+    waiter.handle().resume();
+    LS_ASSERT(!resumed);
+
+    event.set();
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    if (!resumed || !waiterDone.is_set())
+    {
+        std::cerr << "Error: setting an AsyncEvent did not resume its coroutine." << std::endl;
+        return -1;
+    }
+
+    if (numWoken != 4)
+    {
+        std::cerr << "Error: setting an AsyncEvent woke " << numWoken << " of 4 threads." << std::endl;
+        return -2;
+    }
+
+    // Already-set events don't suspend
+    utils::Task<int> ready = [](utils::AsyncEvent& e)->utils::Task<int>
+    {
+        co_await e;
+        co_return 7;
+    }(event);
+
+    if (utils::sync_wait(ready) != 7)
+    {
+        std::cerr << "Error: awaiting a set AsyncEvent returned the wrong result." << std::endl;
+        return -3;
+    }
+
+    event.reset();
+    LS_ASSERT(!event.is_set());
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    utils::FunctionWorkerPool pool{3};
+
+    int ret = test_tasks(pool);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_worker_thread();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_when_all(pool);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_events();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All coroutine tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,255 @@
+/*
+ * File:   lsutils_cpu_topology_test.cpp
+ * Author: miles
+ * Created on October 19, 2026, at 5:30 p.m.
+ */
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lightsky/setup/OS.h" // LS_OS_LINUX
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/CpuTopology.hpp"
+#include "lightsky/utils/WorkerPool.hpp"
+#include "lightsky/utils/WorkerThread.hpp"
+
+namespace fs = std::filesystem;
+namespace utils = ls::utils;
+
+using utils::CpuPlacement;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Fake sysfs tree
+-----------------------------------------------------------------------------*/
+void write_file(const fs::path& path, const std::string& data)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream fout{path};
+    fout << data << '\n';
+}
+
+
+
+/*-------------------------------------
+ * Two packages, each with two SMT-2 cores sharing an L3 and a NUMA node.
+ * CPUs are numbered the way Linux enumerates Intel parts: the first
+ * sibling of every core, then the second.
+ *
+ * cpu:     0 1 2 3 4 5 6 7
+ * package: 0 0 1 1 0 0 1 1
+ * core:    0 1 0 1 0 1 0 1
+-------------------------------------*/
+fs::path make_sysfs()
+{
+    const fs::path root = fs::temp_directory_path() / "lsutils_cpu_topology_test";
+    fs::remove_all(root);
+
+    write_file(root / "cpu/online", "0-7");
+    write_file(root / "node/online", "0-1");
+    write_file(root / "node/node0/cpulist", "0-1,4-5");
+    write_file(root / "node/node1/cpulist", "2-3,6-7");
+
+    for (unsigned cpu = 0; cpu < 8; ++cpu)
+    {
+        const unsigned package = (cpu / 2u) % 2u;
+        const unsigned core = cpu % 2u;
+        const unsigned sibling = cpu < 4 ? cpu + 4u : cpu - 4u;
+        const unsigned first = cpu < sibling ? cpu : sibling;
+        const fs::path cpuDir = root / ("cpu/cpu" + std::to_string(cpu));
+
+        write_file(cpuDir / "topology/physical_package_id", std::to_string(package));
+        write_file(cpuDir / "topology/core_id", std::to_string(core));
+
+        write_file(cpuDir / "cache/index0/level", "1");
+        write_file(cpuDir / "cache/index0/type", "Data");
+        write_file(cpuDir / "cache/index0/shared_cpu_list", std::to_string(first) + ',' + std::to_string(first+4u));
+
+        write_file(cpuDir / "cache/index1/level", "1");
+        write_file(cpuDir / "cache/index1/type", "Instruction");
+        write_file(cpuDir / "cache/index1/shared_cpu_list", std::to_string(first) + ',' + std::to_string(first+4u));
+
+        write_file(cpuDir / "cache/index2/level", "2");
+        write_file(cpuDir / "cache/index2/type", "Unified");
+        write_file(cpuDir / "cache/index2/shared_cpu_list", std::to_string(first) + ',' + std::to_string(first+4u));
+
+        write_file(cpuDir / "cache/index3/level", "3");
+        write_file(cpuDir / "cache/index3/type", "Unified");
+        write_file(cpuDir / "cache/index3/shared_cpu_list", package ? "2-3,6-7" : "0-1,4-5");
+    }
+
+    return root;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tests
+-----------------------------------------------------------------------------*/
+int check_discovery(const fs::path& root)
+{
+    utils::CpuTopology topology;
+
+    if (!topology.load(root.string().c_str()))
+    {
+        std::cerr << "Error: unable to load the CPU topology from " << root << '.' << std::endl;
+        return -1;
+    }
+
+    if (topology.num_cpus() != 8
+        || topology.num_cores() != 4
+        || topology.num_packages() != 2
+        || topology.num_numa_nodes() != 2
+        || topology.num_l2_caches() != 4
+        || topology.num_l3_caches() != 2)
+    {
+        std::cerr << "Error: incorrect CPU, core, package, or cache counts." << std::endl;
+        return -2;
+    }
+
+    const utils::CpuInfo& cpu6 = topology.cpus()[6];
+    if (cpu6.id != 6
+        || cpu6.smtIndex != 1
+        || cpu6.core != topology.cpus()[2].core
+        || cpu6.l3Cache != topology.cpus()[3].l3Cache
+        || cpu6.numaNode != 1)
+    {
+        std::cerr << "Error: incorrect sibling, cache, or NUMA node for CPU 6." << std::endl;
+        return -3;
+    }
+
+    if (topology.node_cpus(1) != std::vector<unsigned>{2, 3, 6, 7})
+    {
+        std::cerr << "Error: incorrect CPUs for NUMA node 1." << std::endl;
+        return -4;
+    }
+
+    // Siblings, then the next core on the same cache
+    if (topology.placement_order(CpuPlacement::COMPACT) != std::vector<unsigned>{0, 4, 1, 5, 2, 6, 3, 7})
+    {
+        std::cerr << "Error: incorrect compact placement order." << std::endl;
+        return -5;
+    }
+
+    // Alternate packages, SMT siblings last
+    if (topology.placement_order(CpuPlacement::SCATTER) != std::vector<unsigned>{0, 2, 1, 3, 4, 6, 5, 7})
+    {
+        std::cerr << "Error: incorrect scatter placement order." << std::endl;
+        return -6;
+    }
+
+    // Every core once before any siblings
+    if (topology.placement_order(CpuPlacement::PHYSICAL_CORES) != std::vector<unsigned>{0, 1, 2, 3, 4, 5, 6, 7}
+        || topology.placement_order(CpuPlacement::PHYSICAL_CORES, 1) != std::vector<unsigned>{2, 3, 6, 7})
+    {
+        std::cerr << "Error: incorrect physical-core placement order." << std::endl;
+        return -7;
+    }
+
+    // Missing sysfs falls back to a flat topology
+    if (topology.load((root / "missing").string().c_str())
+        || topology.num_cpus() < 1
+        || topology.num_cores() != topology.num_cpus()
+        || topology.num_numa_nodes() != 1)
+    {
+        std::cerr << "Error: a missing sysfs did not fall back to a flat topology." << std::endl;
+        return -8;
+    }
+
+    return 0;
+}
+
+
+
+int test_discovery()
+{
+    const fs::path root = make_sysfs();
+    const int ret = check_discovery(root);
+
+    fs::remove_all(root);
+
+    return ret;
+}
+
+
+
+int test_placement()
+{
+    const utils::CpuTopology& topology = utils::CpuTopology::system();
+    LS_ASSERT(topology.num_cpus() >= 1);
+    LS_ASSERT(topology.placement_order(CpuPlacement::SCATTER).size() == topology.num_cpus());
+
+    std::cout
+        << "System topology:"
+        << "\n\tCPUs:       " << topology.num_cpus()
+        << "\n\tCores:      " << topology.num_cores()
+        << "\n\tPackages:   " << topology.num_packages()
+        << "\n\tNUMA Nodes: " << topology.num_numa_nodes()
+        << "\n\tL3 Caches:  " << topology.num_l3_caches()
+        << std::endl;
+
+    std::atomic<unsigned> counter{0};
+    utils::FunctionWorkerPool pool{4, CpuPlacement::PHYSICAL_CORES};
+    LS_ASSERT(pool.placement() == CpuPlacement::PHYSICAL_CORES);
+
+    // Placement survives resizing the pool
+    pool.concurrency(2);
+    LS_ASSERT(pool.placement() == CpuPlacement::PHYSICAL_CORES);
+
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        pool.emplace([&counter]()->void {counter.fetch_add(1, std::memory_order_relaxed);});
+    }
+
+    pool.flush();
+    pool.wait();
+    if (counter.load() != 64)
+    {
+        std::cerr << "Error: a placed pool ran " << counter.load() << " of 64 tasks." << std::endl;
+        return -1;
+    }
+
+    utils::FunctionWorkerThread worker{};
+
+    #ifdef LS_OS_LINUX
+        if (!pool.placement(CpuPlacement::SCATTER)
+            || !pool.placement(CpuPlacement::NUMA_NODE, 0)
+            || !pool.placement(CpuPlacement::NONE)
+            || !worker.placement(CpuPlacement::COMPACT, 1))
+        {
+            std::cerr << "Error: unable to re-place running worker threads." << std::endl;
+            return -2;
+        }
+    #endif
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_discovery();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_placement();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All CPU topology tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,345 @@
+/*
+ * File:   lsutils_epoch_domain_test.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 6:30 p.m.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <new> // placement new
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Allocator.hpp"
+#include "lightsky/utils/AllocatorStats.hpp"
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/EpochDomain.hpp"
+#include "lightsky/utils/MemorySource.hpp"
+
+namespace utils = ls::utils;
+
+constexpr unsigned NUM_UPDATES = 20000;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Test data, poisoned on destruction so use-after-free is detectable
+-----------------------------------------------------------------------------*/
+std::atomic_uint gNumDestroyed{0};
+
+struct Node
+{
+    unsigned long long id;
+    unsigned long long checksum;
+
+    ~Node() noexcept
+    {
+        id = ~0ull;
+        checksum = 0;
+        gNumDestroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+inline Node* make_node(utils::IAllocator& allocator, unsigned long long id) noexcept
+{
+    void* p = allocator.allocate(sizeof(Node));
+    LS_ASSERT(p != nullptr);
+    return new(p) Node{id, id * 31ull + 7ull};
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Single-threaded retirement
+-----------------------------------------------------------------------------*/
+int test_epoch_retire()
+{
+    std::cout << "Testing utils::EpochDomain retirement..." << std::endl;
+
+    utils::MallocMemorySource mallocSrc;
+    utils::MallocAllocator mallocAllocator{mallocSrc};
+    utils::StatsAllocator allocator{mallocAllocator};
+
+    gNumDestroyed.store(0);
+
+    {
+        utils::EpochDomain domain{4};
+        LS_ASSERT(domain.epoch() == 0);
+        LS_ASSERT(domain.batch_size() == 4);
+
+        utils::EpochRecord* pRecord = domain.register_thread();
+        LS_ASSERT(pRecord != nullptr);
+
+        // Nothing is freed until two epochs have passed
+        domain.retire_object(pRecord, make_node(allocator, 1), allocator);
+        domain.retire(pRecord, allocator.allocate(32), allocator, 32);
+        LS_ASSERT(domain.num_pending(pRecord) == 2);
+        LS_ASSERT(allocator.snapshot().numFrees == 0);
+
+        domain.quiescent(pRecord);
+        LS_ASSERT(domain.epoch() == 1);
+        LS_ASSERT(domain.num_pending(pRecord) == 2);
+
+        domain.quiescent(pRecord);
+        LS_ASSERT(domain.epoch() == 2);
+        if (domain.num_pending(pRecord) != 0 || allocator.snapshot().numFrees != 2 || gNumDestroyed.load() != 1)
+        {
+            std::cerr << "Error: retired memory was not freed after two epochs." << std::endl;
+            return -1;
+        }
+
+        // An online thread which hasn't announced the current epoch holds
+        // back reclamation
+        utils::EpochRecord* pOther = domain.register_thread();
+        LS_ASSERT(pOther != pRecord);
+
+        domain.retire(pRecord, allocator.allocate(16), allocator, 16);
+        LS_ASSERT(domain.try_advance());
+        LS_ASSERT(!domain.try_advance());
+        domain.quiescent(pRecord);
+        LS_ASSERT(domain.num_pending(pRecord) == 1);
+
+        domain.offline(pOther);
+        domain.synchronize(pRecord);
+        LS_ASSERT(domain.num_pending(pRecord) == 0);
+
+        // Filling a batch attempts to advance the epoch
+        const uint64_t epoch = domain.epoch();
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            domain.retire_object(pRecord, make_node(allocator, i), allocator);
+        }
+        LS_ASSERT(domain.epoch() == epoch+1);
+        LS_ASSERT(domain.num_pending(pRecord) == 4);
+
+        for (unsigned i = 4; i < 64; ++i)
+        {
+            domain.retire_object(pRecord, make_node(allocator, i), allocator);
+            domain.quiescent(pRecord);
+        }
+        LS_ASSERT(domain.num_pending(pRecord) <= 2);
+
+        // Records are re-used, and pending memory outlives unregistering
+        domain.unregister_thread(pRecord);
+        LS_ASSERT(domain.register_thread() == pRecord);
+        LS_ASSERT(domain.num_pending(pRecord) == 0);
+
+        domain.online(pOther);
+        domain.unregister_thread(pOther);
+        domain.unregister_thread(pRecord);
+    }
+
+    // The destructor frees anything left over
+    const utils::AllocatorStatsSnapshot stats = allocator.snapshot();
+    if (stats.numFrees != stats.numAllocations || stats.bytesInUse != 0)
+    {
+        std::cerr << "Error: leaked " << stats.bytesInUse << " bytes of retired memory." << std::endl;
+        return -2;
+    }
+
+    if (gNumDestroyed.load() != 65)
+    {
+        std::cerr << "Error: destroyed " << gNumDestroyed.load() << " of 65 retired objects." << std::endl;
+        return -3;
+    }
+
+    std::cout << "\tDone." << std::endl;
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Memory left by unregistered threads
+-----------------------------------------------------------------------------*/
+int test_epoch_orphans()
+{
+    std::cout << "Testing utils::EpochDomain orphan reclamation..." << std::endl;
+
+    utils::MallocMemorySource mallocSrc;
+    utils::MallocAllocator mallocAllocator{mallocSrc};
+    utils::StatsAllocator allocator{mallocAllocator};
+
+    gNumDestroyed.store(0);
+
+    {
+        utils::EpochDomain domain;
+        utils::EpochRecord* pRecord = domain.register_thread();
+
+        // Retiring threads exit before their memory becomes safe to free
+        std::thread retirer{[&]()->void
+        {
+            utils::EpochRecord* pRetirer = domain.register_thread();
+
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                domain.retire_object(pRetirer, make_node(allocator, i), allocator);
+            }
+
+            domain.unregister_thread(pRetirer);
+        }};
+
+        retirer.join();
+        LS_ASSERT(allocator.snapshot().numFrees == 0);
+
+        // A thread with nothing of its own to free still reclaims orphans
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            domain.quiescent(pRecord);
+        }
+
+        LS_ASSERT(domain.num_pending(pRecord) == 0);
+
+        if (allocator.snapshot().numFrees != 16 || gNumDestroyed.load() != 16)
+        {
+            std::cerr << "Error: reclaimed " << allocator.snapshot().numFrees << " of 16 orphaned allocations." << std::endl;
+            return -1;
+        }
+
+        domain.unregister_thread(pRecord);
+    }
+
+    std::cout << "\tDone." << std::endl;
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Readers traversing memory which is concurrently replaced and retired
+-----------------------------------------------------------------------------*/
+int test_epoch_readers()
+{
+    std::cout << "Testing utils::EpochDomain with concurrent readers..." << std::endl;
+
+    utils::MallocMemorySource mallocSrc;
+    utils::MallocAllocator mallocAllocator{mallocSrc};
+    utils::StatsAllocator allocator{mallocAllocator};
+
+    gNumDestroyed.store(0);
+
+    {
+        utils::EpochDomain domain;
+        std::atomic<Node*> pShared{make_node(allocator, 0)};
+
+        const unsigned numReaders = std::thread::hardware_concurrency() > 2 ? (std::thread::hardware_concurrency() - 1) : 2;
+        std::atomic_bool writing{true};
+        std::atomic_bool passed{true};
+        std::vector<std::thread> threads;
+
+        for (unsigned i = 0; i < numReaders; ++i)
+        {
+            threads.emplace_back([&, i]()->void
+            {
+                utils::EpochRecord* pRecord = domain.register_thread();
+                unsigned long long lastId = 0;
+                unsigned numReads = 0;
+
+                while (writing.load(std::memory_order_relaxed))
+                {
+                    const Node* pNode = pShared.load(std::memory_order_acquire);
+
+                    // Reads are never of freed memory, and never go back in time
+                    if (pNode->checksum != pNode->id * 31ull + 7ull || pNode->id < lastId)
+                    {
+                        passed.store(false, std::memory_order_relaxed);
+                    }
+
+                    lastId = pNode->id;
+
+                    if ((++numReads % 16) == 0)
+                    {
+                        domain.quiescent(pRecord);
+                    }
+
+                    // Some readers come and go
+                    if ((i & 1) && (numReads % 1024) == 0)
+                    {
+                        domain.offline(pRecord);
+                        std::this_thread::yield();
+                        domain.online(pRecord);
+                    }
+                }
+
+                domain.unregister_thread(pRecord);
+            });
+        }
+
+        utils::EpochRecord* pRecord = domain.register_thread();
+
+        for (unsigned long long id = 1; id <= NUM_UPDATES; ++id)
+        {
+            Node* pOld = pShared.exchange(make_node(allocator, id), std::memory_order_acq_rel);
+            domain.retire_object(pRecord, pOld, allocator);
+            domain.quiescent(pRecord);
+        }
+
+        writing.store(false, std::memory_order_relaxed);
+
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+
+        domain.synchronize(pRecord);
+        LS_ASSERT(domain.num_pending(pRecord) == 0);
+
+        if (!passed.load())
+        {
+            std::cerr << "Error: a reader observed freed or out-of-order data." << std::endl;
+            return -1;
+        }
+
+        if (gNumDestroyed.load() != NUM_UPDATES)
+        {
+            std::cerr << "Error: destroyed " << gNumDestroyed.load() << " of " << NUM_UPDATES << " retired nodes." << std::endl;
+            return -2;
+        }
+
+        Node* pLast = pShared.load();
+        LS_ASSERT(pLast->id == NUM_UPDATES);
+        pLast->~Node();
+        allocator.free(pLast, sizeof(Node));
+
+        domain.unregister_thread(pRecord);
+    }
+
+    const utils::AllocatorStatsSnapshot stats = allocator.snapshot();
+    if (stats.numFrees != stats.numAllocations || stats.bytesInUse != 0)
+    {
+        std::cerr << "Error: leaked " << stats.bytesInUse << " bytes of retired memory." << std::endl;
+        return -3;
+    }
+
+    std::cout << "\tDone." << std::endl;
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_epoch_retire();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_epoch_orphans();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_epoch_readers();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All EpochDomain tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,233 @@
+/*
+ * File:   lsutils_lock_free_ring_buffer_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 15, 2026 at 2:25 PM
+ */
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/LockFreeRingBuffer.hpp"
+#include "lightsky/utils/RingBuffer.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+#include "lightsky/utils/Time.hpp"
+
+namespace utils = ls::utils;
+
+constexpr unsigned long long NUM_TEST_MESSAGES = 1024ull * 1024ull * 4ull;
+constexpr unsigned long long TEST_QUEUE_CAPACITY = 1024ull;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Locked RingBuffer, as used by WorkerThread and WorkerPool
+-----------------------------------------------------------------------------*/
+template <typename T>
+class LockedRingBuffer
+{
+  private:
+    utils::SpinLock mLock;
+    utils::RingBuffer<T> mBuffer;
+
+  public:
+    LockedRingBuffer(unsigned long long capacity) noexcept :
+        mLock{},
+        mBuffer{}
+    {
+        mBuffer.reserve(capacity);
+    }
+
+    bool push(const T& val) noexcept
+    {
+        std::lock_guard<utils::SpinLock> lock{mLock};
+        if (mBuffer.full())
+        {
+            return false;
+        }
+
+        mBuffer.push_unchecked(val);
+        return true;
+    }
+
+    bool pop(T& result) noexcept
+    {
+        std::lock_guard<utils::SpinLock> lock{mLock};
+        return mBuffer.pop(result);
+    }
+};
+
+
+
+/*-----------------------------------------------------------------------------
+ * Single-threaded sanity checks
+-----------------------------------------------------------------------------*/
+template <typename BufferType>
+void test_buffer_basics() noexcept
+{
+    BufferType buffer{3};
+    LS_ASSERT(buffer.capacity() == 4);
+    LS_ASSERT(buffer.empty());
+    LS_ASSERT(!buffer.full());
+
+    unsigned val = 0;
+    LS_ASSERT(!buffer.pop(val));
+
+    LS_ASSERT(buffer.push(0u));
+    LS_ASSERT(buffer.emplace(1u));
+    LS_ASSERT(buffer.push(2u));
+    LS_ASSERT(buffer.push(3u));
+    LS_ASSERT(buffer.full());
+    LS_ASSERT(!buffer.push(4u));
+    LS_ASSERT(buffer.size() == 4);
+
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        LS_ASSERT(buffer.pop(val));
+        LS_ASSERT(val == i);
+    }
+
+    LS_ASSERT(buffer.empty());
+    LS_ASSERT(!buffer.pop(val));
+
+    // wrap around several times
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        LS_ASSERT(buffer.push(i));
+        LS_ASSERT(buffer.push(i+1u));
+        LS_ASSERT(buffer.pop(val) && val == i);
+        LS_ASSERT(buffer.pop(val) && val == i+1u);
+    }
+
+    BufferType empty{0};
+    LS_ASSERT(empty.capacity() == 0);
+    LS_ASSERT(!empty.push(0u));
+    LS_ASSERT(!empty.pop(val));
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Throughput benchmark
+-----------------------------------------------------------------------------*/
+template <typename BufferType>
+unsigned long long benchmark_buffer(const char* testName, unsigned numProducers, unsigned numConsumers) noexcept
+{
+    BufferType buffer{TEST_QUEUE_CAPACITY};
+    std::atomic_ullong checksum{0};
+    std::atomic_uint numReady{0};
+    std::vector<std::thread> threads;
+
+    const unsigned long long messagesPerProducer = NUM_TEST_MESSAGES / numProducers;
+    const unsigned long long totalMessages = messagesPerProducer * numProducers;
+    const unsigned long long messagesPerConsumer = totalMessages / numConsumers;
+    const unsigned numThreads = numProducers + numConsumers;
+
+    std::cout << "Running " << testName << " (" << numProducers << 'P' << numConsumers << "C)..." << std::endl;
+
+    utils::Clock<unsigned long long, std::ratio<1, 1000>> ticks;
+    ticks.start();
+
+    for (unsigned p = 0; p < numProducers; ++p)
+    {
+        threads.emplace_back([&]() noexcept->void
+        {
+            numReady.fetch_add(1);
+            while (numReady.load() < numThreads)
+            {
+            }
+
+            for (unsigned long long i = 1; i <= messagesPerProducer; ++i)
+            {
+                while (!buffer.push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (unsigned c = 0; c < numConsumers; ++c)
+    {
+        // The last consumer picks up any remainder
+        const unsigned long long count = (c == numConsumers-1)
+            ? (totalMessages - messagesPerConsumer * (numConsumers-1))
+            : messagesPerConsumer;
+
+        threads.emplace_back([&, count]() noexcept->void
+        {
+            numReady.fetch_add(1);
+            while (numReady.load() < numThreads)
+            {
+            }
+
+            unsigned long long sum = 0;
+            unsigned long long val = 0;
+
+            for (unsigned long long i = 0; i < count; ++i)
+            {
+                while (!buffer.pop(val))
+                {
+                    std::this_thread::yield();
+                }
+
+                sum += val;
+            }
+
+            checksum.fetch_add(sum);
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    ticks.tick();
+
+    const unsigned long long expected = numProducers * (messagesPerProducer * (messagesPerProducer + 1ull) / 2ull);
+    LS_ASSERT(checksum.load() == expected);
+
+    const unsigned long long ms = ticks.tick_time().count();
+    std::cout
+        << "\tDone in " << ms << "ms ("
+        << (unsigned long long)((long double)totalMessages / ((long double)(ms ? ms : 1ull) * 0.001l))
+        << " msgs/sec)." << std::endl;
+
+    return ms;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    test_buffer_basics<utils::SpscRingBuffer<unsigned>>();
+    test_buffer_basics<utils::MpmcRingBuffer<unsigned>>();
+
+    const unsigned concurrency = (unsigned)std::thread::hardware_concurrency();
+    const unsigned numMpmcThreads = (concurrency > 4) ? (concurrency / 2) : 2;
+
+    const unsigned long long lockedSpsc = benchmark_buffer<LockedRingBuffer<unsigned long long>>("Locked RingBuffer", 1, 1);
+    const unsigned long long spsc = benchmark_buffer<utils::SpscRingBuffer<unsigned long long>>("SpscRingBuffer", 1, 1);
+    const unsigned long long mpmcSpsc = benchmark_buffer<utils::MpmcRingBuffer<unsigned long long>>("MpmcRingBuffer", 1, 1);
+    const unsigned long long lockedMpmc = benchmark_buffer<LockedRingBuffer<unsigned long long>>("Locked RingBuffer", numMpmcThreads, numMpmcThreads);
+    const unsigned long long mpmc = benchmark_buffer<utils::MpmcRingBuffer<unsigned long long>>("MpmcRingBuffer", numMpmcThreads, numMpmcThreads);
+
+    std::cout
+        << "Results (" << NUM_TEST_MESSAGES << " messages):"
+        << "\n\t1P1C Locked RingBuffer: " << lockedSpsc << "ms"
+        << "\n\t1P1C SpscRingBuffer:    " << spsc << "ms"
+        << "\n\t1P1C MpmcRingBuffer:    " << mpmcSpsc << "ms"
+        << "\n\tNPNC Locked RingBuffer: " << lockedMpmc << "ms"
+        << "\n\tNPNC MpmcRingBuffer:    " << mpmc << "ms"
+        << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,384 @@
+/*
+ * File:   lsutils_malloc_preload_test.cpp
+ * Author: hammy
+ *
+ * Created on Oct 22, 2026 at 9:10 AM
+ */
+
+/*
+ * Smoke test for the lsmalloc library. The test re-runs itself, and a
+ * system utility, with lsmalloc in LD_PRELOAD so every allocation made by
+ * the C runtime, the C++ runtime, and stdio goes through the replacement.
+ * Programs which hang or crash are reported as failures.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory> // std::unique_ptr
+#include <thread>
+#include <vector>
+
+#include "lightsky/setup/OS.h"
+
+#if defined(LS_OS_LINUX)
+    extern "C"
+    {
+        #include <dlfcn.h> // dladdr()
+        #include <malloc.h> // memalign(), valloc(), malloc_usable_size()
+        #include <sys/wait.h> // waitpid()
+        #include <unistd.h> // fork(), execv(), alarm()
+    }
+#endif
+
+#ifndef LS_MALLOC_LIBRARY
+    #define LS_MALLOC_LIBRARY "liblsmalloc.so"
+#endif
+
+namespace
+{
+
+// Seconds a preloaded program may run before it's considered hung
+constexpr unsigned preload_timeout = 30;
+
+constexpr const char* preload_child_var = "LS_MALLOC_PRELOAD_CHILD";
+
+} // end anonymous namespace
+
+
+
+#if defined(LS_OS_LINUX)
+
+/*-----------------------------------------------------------------------------
+ * Tests run with lsmalloc preloaded
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * malloc() and friends
+-------------------------------------*/
+int test_malloc()
+{
+    // Make sure the replacement is actually in use
+    Dl_info info;
+    if (!dladdr(reinterpret_cast<void*>(&malloc), &info) || !info.dli_fname || !std::strstr(info.dli_fname, "lsmalloc"))
+    {
+        std::cerr << "Error: malloc() was not replaced by " << LS_MALLOC_LIBRARY << '.' << std::endl;
+        return -1;
+    }
+
+    std::vector<void*> allocations;
+
+    for (unsigned i = 1; i < 4096; i += 7)
+    {
+        unsigned char* const p = static_cast<unsigned char*>(std::malloc(i));
+        if (!p)
+        {
+            std::cerr << "Error: unable to allocate " << i << " bytes." << std::endl;
+            return -2;
+        }
+
+        std::memset(p, 0x5A, i);
+        allocations.push_back(p);
+    }
+
+    unsigned* pZeroed = static_cast<unsigned*>(std::calloc(1024, sizeof(unsigned)));
+    if (!pZeroed || pZeroed[0] != 0 || pZeroed[1023] != 0)
+    {
+        std::cerr << "Error: calloc() returned uninitialized memory." << std::endl;
+        return -3;
+    }
+
+    pZeroed[1023] = 42;
+    pZeroed = static_cast<unsigned*>(std::realloc(pZeroed, 64 * 1024 * sizeof(unsigned)));
+    if (!pZeroed || pZeroed[1023] != 42)
+    {
+        std::cerr << "Error: realloc() did not preserve its contents." << std::endl;
+        return -4;
+    }
+
+    std::free(pZeroed);
+
+    for (void* p : allocations)
+    {
+        std::free(p);
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+ * Aligned allocations
+-------------------------------------*/
+bool is_aligned(const void* p, std::size_t alignment)
+{
+    return p && (reinterpret_cast<std::uintptr_t>(p) % alignment) == 0;
+}
+
+struct alignas(256) OverAligned
+{
+    unsigned char data[300];
+};
+
+int test_aligned()
+{
+    Dl_info info;
+    if (!dladdr(reinterpret_cast<void*>(&aligned_alloc), &info) || !info.dli_fname || !std::strstr(info.dli_fname, "lsmalloc"))
+    {
+        std::cerr << "Error: aligned_alloc() was not replaced by " << LS_MALLOC_LIBRARY << '.' << std::endl;
+        return -1;
+    }
+
+    const std::size_t pageSize = (std::size_t)sysconf(_SC_PAGESIZE);
+    std::vector<void*> allocations;
+
+    for (std::size_t alignment = 8; alignment <= 8192; alignment *= 2)
+    {
+        void* const pAligned = aligned_alloc(alignment, alignment * 3);
+        void* pPosix = nullptr;
+        const int posixErr = posix_memalign(&pPosix, alignment, 100);
+        void* const pMemalign = memalign(alignment, 1000);
+
+        if (!is_aligned(pAligned, alignment) || posixErr != 0 || !is_aligned(pPosix, alignment) || !is_aligned(pMemalign, alignment))
+        {
+            std::cerr << "Error: unable to allocate memory aligned to " << alignment << " bytes." << std::endl;
+            return -2;
+        }
+
+        if (malloc_usable_size(pAligned) < alignment * 3 || malloc_usable_size(pPosix) < 100 || malloc_usable_size(pMemalign) < 1000)
+        {
+            std::cerr << "Error: malloc_usable_size() is smaller than an aligned allocation." << std::endl;
+            return -3;
+        }
+
+        std::memset(pAligned, 0x5A, alignment * 3);
+        std::memset(pPosix, 0x5A, 100);
+        std::memset(pMemalign, 0x5A, 1000);
+
+        allocations.push_back(pAligned);
+        allocations.push_back(pPosix);
+        allocations.push_back(pMemalign);
+    }
+
+    void* pInvalid = nullptr;
+    if (posix_memalign(&pInvalid, 3, 16) == 0)
+    {
+        std::cerr << "Error: posix_memalign() accepted an invalid alignment." << std::endl;
+        return -4;
+    }
+
+    void* const pPage = valloc(pageSize + 1);
+    if (!is_aligned(pPage, pageSize))
+    {
+        std::cerr << "Error: valloc() did not return page-aligned memory." << std::endl;
+        return -5;
+    }
+
+    allocations.push_back(pPage);
+
+    // Reallocating an aligned block must release it through lsmalloc
+    allocations.back() = std::realloc(pPage, pageSize * 4);
+    if (!allocations.back())
+    {
+        std::cerr << "Error: unable to reallocate an aligned block." << std::endl;
+        return -6;
+    }
+
+    for (void* p : allocations)
+    {
+        std::free(p);
+    }
+
+    // C++17 aligned new/delete
+    std::unique_ptr<OverAligned[]> pObjects{new OverAligned[17]};
+    for (unsigned i = 0; i < 17; ++i)
+    {
+        if (!is_aligned(&pObjects[i], alignof(OverAligned)))
+        {
+            std::cerr << "Error: aligned new returned misaligned memory." << std::endl;
+            return -7;
+        }
+    }
+
+    std::unique_ptr<OverAligned> pObject{new OverAligned{}};
+    if (!is_aligned(pObject.get(), alignof(OverAligned)) || pObject->data[299] != 0)
+    {
+        std::cerr << "Error: aligned new returned invalid memory." << std::endl;
+        return -8;
+    }
+
+    return 0;
+}
+
+
+
+/*-------------------------------------
+ * stdio and the C++ runtime allocate internally
+-------------------------------------*/
+int test_runtime()
+{
+    FILE* const pInfo = std::fopen("/proc/self/status", "r");
+    if (!pInfo)
+    {
+        std::cerr << "Error: unable to open /proc/self/status." << std::endl;
+        return -1;
+    }
+
+    char line[256];
+    unsigned numLines = 0;
+    while (std::fgets(line, sizeof(line), pInfo))
+    {
+        ++numLines;
+    }
+
+    std::fclose(pInfo);
+
+    std::vector<std::thread> threads;
+    std::vector<unsigned> results(4, 0);
+
+    for (unsigned t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&results, t]()->void
+        {
+            std::vector<std::vector<unsigned>> blocks;
+
+            for (unsigned i = 0; i < 1000; ++i)
+            {
+                blocks.emplace_back(1u + (i * 31u + t) % 257u, i);
+            }
+
+            for (unsigned i = 0; i < 1000; ++i)
+            {
+                results[t] += (blocks[i].back() == i) ? 1u : 0u;
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    for (unsigned result : results)
+    {
+        if (result != 1000)
+        {
+            std::cerr << "Error: memory was corrupted across threads." << std::endl;
+            return -2;
+        }
+    }
+
+    return numLines ? 0 : -3;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Test driver
+-----------------------------------------------------------------------------*/
+/*-------------------------------------
+ * Run a program with lsmalloc preloaded
+-------------------------------------*/
+int run_preloaded(const char* pPath, char* const argv[])
+{
+    const pid_t pid = fork();
+    if (pid < 0)
+    {
+        std::cerr << "Error: unable to fork." << std::endl;
+        return -1;
+    }
+
+    if (pid == 0)
+    {
+        // Pending alarms survive exec(), and terminate the program if it
+        // hangs.
+        setenv("LD_PRELOAD", LS_MALLOC_LIBRARY, 1);
+        setenv(preload_child_var, "1", 1);
+        alarm(preload_timeout);
+
+        execv(pPath, argv);
+        _exit(127);
+    }
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid)
+    {
+        std::cerr << "Error: unable to wait for " << argv[0] << '.' << std::endl;
+        return -2;
+    }
+
+    if (WIFSIGNALED(status))
+    {
+        std::cerr << "Error: " << argv[0] << " was killed by signal " << WTERMSIG(status) << (WTERMSIG(status) == SIGALRM ? " (hung)." : ".") << std::endl;
+        return -3;
+    }
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        std::cerr << "Error: " << argv[0] << " exited with status " << WEXITSTATUS(status) << '.' << std::endl;
+        return -4;
+    }
+
+    return 0;
+}
+
+#endif /* LS_OS_LINUX */
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+    (void)argc;
+
+    #if !defined(LS_OS_LINUX)
+        (void)argv;
+        std::cout << "LD_PRELOAD is not supported on this platform, skipping." << std::endl;
+        return 0;
+
+    #else
+        int ret = 0;
+
+        if (std::getenv(preload_child_var))
+        {
+            ret = test_malloc();
+            if (ret != 0)
+            {
+                return ret;
+            }
+
+            ret = test_aligned();
+            if (ret != 0)
+            {
+                return ret;
+            }
+
+            return test_runtime();
+        }
+
+        std::cout << "Running " << argv[0] << " with " << LS_MALLOC_LIBRARY << " preloaded..." << std::endl;
+        ret = run_preloaded("/proc/self/exe", argv);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        char truePath[] = "/bin/true";
+        char* const trueArgs[] = {truePath, nullptr};
+
+        std::cout << "Running " << truePath << " with " << LS_MALLOC_LIBRARY << " preloaded..." << std::endl;
+        ret = run_preloaded(truePath, trueArgs);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        std::cout << "All malloc preload tests passed." << std::endl;
+        return 0;
+
+    #endif
+}
@@ -0,0 +1,218 @@
+/*
+ * File:   lsutils_parallel_test.cpp
+ * Author: miles
+ * Created on October 17, 2026, at 8:30 p.m.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Parallel.hpp"
+#include "lightsky/utils/Time.hpp"
+#include "lightsky/utils/WorkerPool.hpp"
+#include "lightsky/utils/WorkStealingPool.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Loops, reductions, and scans over a pool
+-----------------------------------------------------------------------------*/
+template <class PoolType>
+int test_parallel_algorithms(PoolType& pool)
+{
+    constexpr std::size_t count = 1000003; // not a multiple of any grain
+    std::vector<unsigned> data(count, 0);
+
+    // every index is visited exactly once
+    utils::parallel_for(pool, (std::size_t)0, count, 0, [&](std::size_t first, std::size_t last)->void
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            data[i] += (unsigned)(i & 0xFFu) + 1u;
+        }
+    });
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        LS_ASSERT(data[i] == (unsigned)(i & 0xFFu) + 1u);
+    }
+
+    // explicit grain sizes, including one larger than the range
+    for (std::size_t grain : {1ull, 7ull, 4096ull, count * 2ull})
+    {
+        std::atomic<std::size_t> numVisited{0};
+        utils::parallel_for(pool, 0ll, 5000ll, grain, [&](long long first, long long last)->void
+        {
+            LS_ASSERT(first < last && (std::size_t)(last - first) <= grain);
+            numVisited.fetch_add((std::size_t)(last - first), std::memory_order_relaxed);
+        });
+
+        LS_ASSERT(numVisited.load() == 5000u);
+    }
+
+    // empty ranges are a no-op
+    utils::parallel_for(pool, 10, 10, 0, [](int, int)->void {LS_ASSERT(false);});
+
+    const unsigned long long sum = utils::parallel_reduce(
+        pool, (std::size_t)0, count, 0, 0ull,
+        [&](std::size_t first, std::size_t last, unsigned long long init)->unsigned long long
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                init += data[i];
+            }
+            return init;
+        },
+        [](unsigned long long a, unsigned long long b)->unsigned long long
+        {
+            return a + b;
+        }
+    );
+
+    unsigned long long expectedSum = 0;
+    for (unsigned x : data)
+    {
+        expectedSum += x;
+    }
+
+    LS_ASSERT(sum == expectedSum);
+
+    // partial results are combined in order, so this matches a serial sum
+    const double floatSum = utils::parallel_reduce(
+        pool, 0, 100000, 1000, 0.0,
+        [](int first, int last, double init)->double
+        {
+            for (int i = first; i < last; ++i)
+            {
+                init += 1.0 / (1.0 + i);
+            }
+            return init;
+        },
+        [](double a, double b)->double {return a + b;}
+    );
+
+    double expectedFloatSum = 0.0;
+    for (int chunk = 0; chunk < 100000; chunk += 1000)
+    {
+        double partial = 0.0;
+        for (int i = chunk; i < chunk + 1000; ++i)
+        {
+            partial += 1.0 / (1.0 + i);
+        }
+        expectedFloatSum += partial;
+    }
+
+    LS_ASSERT(floatSum == expectedFloatSum);
+
+    // in-place inclusive scan
+    std::vector<unsigned long long> scanned(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        scanned[i] = data[i];
+    }
+
+    utils::parallel_scan(pool, scanned.data(), scanned.data(), count, 0, 0ull, [](unsigned long long a, unsigned long long b)->unsigned long long
+    {
+        return a + b;
+    });
+
+    unsigned long long runningSum = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        runningSum += data[i];
+        LS_ASSERT(scanned[i] == runningSum);
+    }
+
+    // nested calls from within the pool's own threads
+    std::atomic<std::size_t> numNested{0};
+    utils::parallel_for(pool, 0, 64, 1, [&](int, int)->void
+    {
+        utils::parallel_for(pool, 0, 1000, 10, [&](int first, int last)->void
+        {
+            numNested.fetch_add((std::size_t)(last - first), std::memory_order_relaxed);
+        });
+    });
+
+    LS_ASSERT(numNested.load() == 64000u);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Scaling
+-----------------------------------------------------------------------------*/
+void bench_parallel_for(std::size_t numThreads)
+{
+    constexpr std::size_t count = 1u << 22u;
+    std::vector<float> data(count, 1.f);
+    utils::FunctionWorkerPool pool{numThreads};
+    utils::Clock<unsigned long long, std::ratio<1, 1000>> ticks;
+
+    ticks.start();
+
+    for (unsigned iter = 0; iter < 16; ++iter)
+    {
+        utils::parallel_for(pool, (std::size_t)0, count, 0, [&](std::size_t first, std::size_t last)->void
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                data[i] = std::sqrt(data[i] * 1.0001f + 0.5f);
+            }
+        });
+    }
+
+    ticks.tick();
+
+    std::cout << "\tparallel_for with " << numThreads << " helper threads: " << ticks.tick_time().count() << "ms" << std::endl;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    {
+        utils::FunctionWorkerPool pool{3};
+        int ret = test_parallel_algorithms(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    {
+        utils::FunctionWorkStealingPool pool{3};
+        int ret = test_parallel_algorithms(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    {
+        // no helper threads, everything runs on the caller
+        utils::FunctionWorkerPool pool{0};
+        int ret = test_parallel_algorithms(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    const std::size_t maxThreads = std::thread::hardware_concurrency();
+    for (std::size_t numThreads = 0; numThreads < maxThreads; numThreads = numThreads ? (numThreads * 2u) : 1u)
+    {
+        bench_parallel_for(numThreads);
+    }
+
+    return 0;
+}
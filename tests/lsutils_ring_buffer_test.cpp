@@ -98,5 +98,36 @@ int main()
     LS_ASSERT(!buffer.full());
     LS_ASSERT(buffer.empty());
 
+    // Ranges grow the buffer once, preserving wrapped elements
+    const unsigned range[] = {3u, 4u, 5u, 6u, 7u};
+
+    buffer.reserve(3);
+    buffer.push(0u);
+    buffer.push(1u);
+    buffer.pop_unchecked();
+    buffer.push(2u);
+    buffer.push(3u);
+
+    LS_ASSERT(buffer.push_range(range+1, range+5) == 4);
+    LS_ASSERT(buffer.size() == 7);
+    LS_ASSERT(buffer.capacity() == 7);
+
+    for (unsigned i = 1; i < 8; ++i)
+    {
+        LS_ASSERT(buffer.pop_unchecked() == i);
+    }
+
+    LS_ASSERT(buffer.push_range(range, range) == 0);
+    LS_ASSERT(buffer.empty());
+
+    // Popping from the back, across the wrap-around point
+    buffer.push(0u);
+    buffer.push(1u);
+    LS_ASSERT(buffer.pop_back_unchecked() == 1u);
+    buffer.push(2u);
+    LS_ASSERT(buffer.pop_unchecked() == 0u);
+    LS_ASSERT(buffer.pop_back_unchecked() == 2u);
+    LS_ASSERT(buffer.empty());
+
     return 0;
 }
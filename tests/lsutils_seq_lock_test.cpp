@@ -0,0 +1,181 @@
+/*
+ * File:   lsutils_seq_lock_test.cpp
+ * Author: miles
+ * Created on October 20, 2026, at 5:45 p.m.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Futex.hpp"
+#include "lightsky/utils/QueueLock.hpp"
+#include "lightsky/utils/SeqLock.hpp"
+#include "lightsky/utils/SpinLock.hpp"
+
+namespace utils = ls::utils;
+
+constexpr unsigned NUM_WRITES = 20000;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Test data, larger than a single word so torn reads are detectable
+-----------------------------------------------------------------------------*/
+struct Snapshot
+{
+    unsigned long long id;
+    double value;
+    unsigned short tag;
+    unsigned long long checksum;
+};
+
+inline unsigned long long snapshot_checksum(const Snapshot& s) noexcept
+{
+    return s.id * 31ull + (unsigned long long)s.value + s.tag;
+}
+
+inline Snapshot make_snapshot(unsigned long long id) noexcept
+{
+    Snapshot s{id, (double)(id * 2ull), (unsigned short)(id & 0xFFFFu), 0};
+    s.checksum = snapshot_checksum(s);
+    return s;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tests
+-----------------------------------------------------------------------------*/
+template <class WriterLockType>
+int test_seq_lock(const char* testName)
+{
+    std::cout << "Testing utils::SeqLock with " << testName << "..." << std::endl;
+
+    utils::SeqLock<Snapshot, WriterLockType> seqLock{make_snapshot(0)};
+    LS_ASSERT(seqLock.sequence() == 0);
+    LS_ASSERT(seqLock.load().checksum == snapshot_checksum(make_snapshot(0)));
+
+    Snapshot s;
+    LS_ASSERT(seqLock.try_load(s));
+    LS_ASSERT(s.id == 0);
+
+    const unsigned numReaders = std::thread::hardware_concurrency() > 2 ? (std::thread::hardware_concurrency() - 1) : 2;
+    std::atomic_bool writing{true};
+    std::atomic_bool passed{true};
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < numReaders; ++i)
+    {
+        threads.emplace_back([&]()->void
+        {
+            unsigned long long lastId = 0;
+
+            while (writing.load(std::memory_order_relaxed))
+            {
+                const Snapshot current = seqLock.load();
+
+                // Reads are consistent and never go back in time
+                if (current.checksum != snapshot_checksum(current) || current.id < lastId)
+                {
+                    passed.store(false, std::memory_order_relaxed);
+                }
+
+                lastId = current.id;
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    // Two writers contend on the writer lock
+    std::thread writer{[&]()->void
+    {
+        for (unsigned i = 0; i < NUM_WRITES; ++i)
+        {
+            seqLock.update([](Snapshot& data)->void
+            {
+                data = make_snapshot(data.id + 1ull);
+            });
+        }
+    }};
+
+    for (unsigned i = 0; i < NUM_WRITES; ++i)
+    {
+        seqLock.update([](Snapshot& data)->void
+        {
+            data = make_snapshot(data.id + 1ull);
+        });
+    }
+
+    writer.join();
+    writing.store(false, std::memory_order_relaxed);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    if (!passed.load())
+    {
+        std::cerr << "Error: a reader observed a torn or out-of-order snapshot." << std::endl;
+        return -1;
+    }
+
+    if (seqLock.load().id != NUM_WRITES * 2ull)
+    {
+        std::cerr << "Error: lost an update to the snapshot." << std::endl;
+        return -2;
+    }
+
+    if (seqLock.sequence() != NUM_WRITES * 4ull)
+    {
+        std::cerr << "Error: unexpected sequence number " << seqLock.sequence() << '.' << std::endl;
+        return -3;
+    }
+
+    seqLock.store(make_snapshot(42));
+    LS_ASSERT(seqLock.try_load(s));
+    LS_ASSERT(s.id == 42 && s.checksum == snapshot_checksum(s));
+    LS_ASSERT((seqLock.sequence() & 1ull) == 0);
+
+    std::cout << "\tDone." << std::endl;
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_seq_lock<utils::SpinLock>("utils::SpinLock");
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_seq_lock<utils::Futex>("utils::Futex");
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_seq_lock<utils::McsLock>("utils::McsLock");
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_seq_lock<std::mutex>("std::mutex");
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All SeqLock tests passed." << std::endl;
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include "lightsky/utils/Assertions.h"
 #include "lightsky/utils/Barrier.hpp"
 #include "lightsky/utils/Futex.hpp"
+#include "lightsky/utils/QueueLock.hpp"
 #include "lightsky/utils/RWLock.hpp"
 #include "lightsky/utils/SpinLock.hpp"
 
@@ -309,6 +310,156 @@ system_duration run_rw_test(const char* testName, unsigned numTests)
 
 
 
+// ----------------------------------------------------------------------------
+// Verify mutual exclusion of a queue lock, with and without sleeping
+// ----------------------------------------------------------------------------
+template <typename QueueLockType>
+void run_queue_lock_test(const char* testName, uint32_t spinCount)
+{
+    std::cout << "Verifying " << testName << " with a spin count of " << spinCount << "..." << std::endl;
+
+    const unsigned concurrency = num_test_threads() * 2u;
+    QueueLockType queueLock{spinCount};
+    std::vector<std::thread> threads;
+    unsigned long long counter = 0;
+
+    LS_ASSERT(queueLock.spin_count() == spinCount);
+
+    for (unsigned i = 0; i < concurrency; ++i)
+    {
+        threads.emplace_back([&]()->void
+        {
+            for (unsigned j = 0; j < LOCK_CONTENTION_COUNT; ++j)
+            {
+                std::lock_guard<QueueLockType> lock{queueLock};
+                ++counter;
+            }
+
+            for (unsigned j = 0; j < LOCK_CONTENTION_COUNT; ++j)
+            {
+                while (!queueLock.try_lock())
+                {
+                    std::this_thread::yield();
+                }
+
+                ++counter;
+                queueLock.unlock();
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    LS_ASSERT(counter == (unsigned long long)concurrency * LOCK_CONTENTION_COUNT * 2ull);
+
+    // try_lock() fails rather than waiting for a holder
+    queueLock.lock();
+    std::thread{[&]()->void
+    {
+        LS_ASSERT(!queueLock.try_lock());
+    }}.join();
+    queueLock.unlock();
+
+    // std::scoped_lock relies on try_lock() never waiting to avoid deadlocks
+    QueueLockType otherLock{spinCount};
+    threads.clear();
+    counter = 0;
+
+    for (unsigned i = 0; i < concurrency; ++i)
+    {
+        threads.emplace_back([&, i]()->void
+        {
+            for (unsigned j = 0; j < LOCK_CONTENTION_COUNT; ++j)
+            {
+                if (i & 1u)
+                {
+                    std::scoped_lock<QueueLockType, QueueLockType> lock{queueLock, otherLock};
+                    ++counter;
+                }
+                else
+                {
+                    std::scoped_lock<QueueLockType, QueueLockType> lock{otherLock, queueLock};
+                    ++counter;
+                }
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    LS_ASSERT(counter == (unsigned long long)concurrency * LOCK_CONTENTION_COUNT);
+    std::cout << "\tDone." << std::endl;
+}
+
+
+
+// ----------------------------------------------------------------------------
+// Verify readers never observe a partial write through the reader bias
+// ----------------------------------------------------------------------------
+void run_biased_rwlock_test()
+{
+    std::cout << "Verifying utils::BiasedRWLock..." << std::endl;
+
+    utils::BiasedRWLock rwLock;
+    LS_ASSERT(rwLock.reader_biased());
+
+    // Writers revoke the bias, and a reader restores it after a while
+    rwLock.lock();
+    LS_ASSERT(!rwLock.reader_biased());
+    LS_ASSERT(!rwLock.try_lock_shared());
+    rwLock.unlock();
+
+    while (!rwLock.reader_biased())
+    {
+        utils::LockGuardShared<utils::BiasedRWLock> lock{rwLock};
+        std::this_thread::yield();
+    }
+
+    const unsigned concurrency = num_test_threads() * 2u;
+    std::vector<std::thread> threads;
+    unsigned long long values[2] = {0, 0};
+
+    for (unsigned i = 0; i < concurrency; ++i)
+    {
+        threads.emplace_back([&, i]()->void
+        {
+            for (unsigned j = 0; j < LOCK_CONTENTION_COUNT; ++j)
+            {
+                if (i == 0 && (j % 16u) == 0)
+                {
+                    utils::LockGuardExclusive<utils::BiasedRWLock> lock{rwLock};
+                    ++values[0];
+                    std::this_thread::yield();
+                    ++values[1];
+                }
+                else
+                {
+                    utils::LockGuardShared<utils::BiasedRWLock> lock{rwLock};
+                    LS_ASSERT(values[0] == values[1]);
+                    LS_ASSERT(!rwLock.try_lock());
+                }
+            }
+        });
+    }
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    LS_ASSERT(values[0] == LOCK_CONTENTION_COUNT / 16u);
+    LS_ASSERT(values[1] == values[0]);
+    std::cout << "\tDone." << std::endl;
+}
+
+
+
 // ----------------------------------------------------------------------------
 int main()
 {
@@ -322,6 +473,12 @@ int main()
         << "\n\tWrite Threads: " << (concurrency/2)
         << std::endl;
 
+    run_queue_lock_test<utils::McsLock>("utils::McsLock", 0);
+    run_queue_lock_test<utils::McsLock>("utils::McsLock", utils::McsLock::SPIN_ONLY);
+    run_queue_lock_test<utils::ClhLock>("utils::ClhLock", 0);
+    run_queue_lock_test<utils::ClhLock>("utils::ClhLock", utils::ClhLock::SPIN_ONLY);
+    run_biased_rwlock_test();
+
     /*
      * Exclusive-lock benchmarks
      */
@@ -329,12 +486,15 @@ int main()
     const system_duration&& futexRunTime = run_mtx_test<utils::Futex>("utils::Futex", numTests);
     const system_duration&& lnxFutexRunTime = run_mtx_test<utils::SystemFutexLinux>("utils::SystemFutexLinux", numTests);
     const system_duration&& pthFutexRunTime = run_mtx_test<utils::SystemFutexPThread>("utils::SystemFutexPThread", numTests);
-    const system_duration&& winFutexRunTime = run_mtx_test<utils::SystemFutexWin32>("utils::SystemFutexWin32", numTests);
+    const system_duration&& winFutexRunTime = run_mtx_test<utils::SystemFutexWindows>("utils::SystemFutexWindows", numTests);
     const system_duration&& spinlockRunTime = run_mtx_test<utils::SpinLock>("utils::SpinLock", numTests);
+    const system_duration&& mcsLockRunTime = run_mtx_test<utils::McsLock>("utils::McsLock", numTests);
+    const system_duration&& clhLockRunTime = run_mtx_test<utils::ClhLock>("utils::ClhLock", numTests);
     const system_duration&& swRunTime = run_mtx_test<utils::RWLock>("utils::SRWLock (W)", numTests);
     const system_duration&& swPThreadRunTime = run_mtx_test<utils::SystemRWLockPThread>("utils::SystemRWLockPThread (W)", numTests);
     const system_duration&& swWindowsRunTime = run_mtx_test<utils::SystemRWLockWindows>("utils::SystemRWLockWindows (W)", numTests);
     const system_duration&& fairWFutexRunTime = run_mtx_test<utils::FairRWLock>("utils::FairRWLock (W)", numTests);
+    const system_duration&& biasedWRunTime = run_mtx_test<utils::BiasedRWLock>("utils::BiasedRWLock (W)", numTests);
 
     /*
      * Shared-lock benchmarks
@@ -343,6 +503,7 @@ int main()
     const system_duration&& srwPThreadRunTime = run_rw_test<utils::SystemRWLockPThread>("utils::SystemRWLockPThread (R/W)", numTests);
     const system_duration&& srwWindowsRunTime = run_rw_test<utils::SystemRWLockWindows>("utils::SystemRWLockWindows (R/W)", numTests);
     const system_duration&& fairRWFutexRunTime = run_rw_test<utils::FairRWLock>("utils::FairRWLock (R/W)", numTests);
+    const system_duration&& biasedRWRunTime = run_rw_test<utils::BiasedRWLock>("utils::BiasedRWLock (R/W)", numTests);
 
     std::cout
         << "Results:"
@@ -352,15 +513,19 @@ int main()
         << "\n\tSystemFutexPThread Time (W): " << pthFutexRunTime.count() << "ms"
         << "\n\tSystemFutexWin32 Time (W):   " << winFutexRunTime.count() << "ms"
         << "\n\tSpinLock Time (W):           " << spinlockRunTime.count() << "ms"
+        << "\n\tMcsLock Time (W):            " << mcsLockRunTime.count() << "ms"
+        << "\n\tClhLock Time (W):            " << clhLockRunTime.count() << "ms"
         << "\n\tRWLock Time (W):             " << swRunTime.count() << "ms"
         << "\n\tPThread RWLock Time (W):     " << swPThreadRunTime.count() << "ms"
         << "\n\tWindows RWLock Time (W):     " << swWindowsRunTime.count() << "ms"
         << "\n\tFairWLock Time (W):          " << fairWFutexRunTime.count() << "ms"
+        << "\n\tBiasedRWLock Time (W):       " << biasedWRunTime.count() << "ms"
         << '\n'
         << "\n\tRWLock Time (RW):            " << srwMutexRunTime.count() << "ms"
         << "\n\tPThread RWLock Time (RW):    " << srwPThreadRunTime.count() << "ms"
         << "\n\tWindows RWLock Time (RW):    " << srwWindowsRunTime.count() << "ms"
         << "\n\tFairRWLock Time (RW):        " << fairRWFutexRunTime.count() << "ms"
+        << "\n\tBiasedRWLock Time (RW):      " << biasedRWRunTime.count() << "ms"
         << std::endl;
 
     return 0;
@@ -128,11 +128,27 @@ int main(void)
         ls::utils::sort_merge_iterative<int, decltype(cmp)>(items, MERGE_SORT_TEMP_BUFFER.get(), count, numThreads, threadId,  sortPhases, cmp);
     };
 
+    void (*bitonic_sort_barrier)(int* const, long long, long long, long long, std::atomic_llong*, ls::utils::IsLess<int>) =
+    [](int* const items, long long count, long long numThreads, long long threadId, std::atomic_llong*, ls::utils::IsLess<int> cmp)
+    {
+        static ls::utils::DisseminationBarrier barrier{MAX_THREADS};
+        ls::utils::sort_bitonic<int>(items, count, numThreads, threadId, &barrier, cmp);
+    };
+
+    void (*odd_even_sort_barrier)(int* const, long long, long long, long long, std::atomic_llong*, ls::utils::IsLess<int>) =
+    [](int* const items, long long count, long long numThreads, long long threadId, std::atomic_llong*, ls::utils::IsLess<int> cmp)
+    {
+        static ls::utils::SenseBarrier barrier{MAX_THREADS};
+        ls::utils::sort_odd_even<int>(items, count, numThreads, threadId, &barrier, cmp);
+    };
+
     void (*pThreadedSorts[])(int* const, long long, long long, long long, std::atomic_llong*, ls::utils::IsLess<int>) = {
         &ls::utils::sort_sheared<int>,
         &ls::utils::sort_bitonic<int>,
         &ls::utils::sort_odd_even<int>,
-        merge_sort_parallel
+        merge_sort_parallel,
+        bitonic_sort_barrier,
+        odd_even_sort_barrier
     };
 
     const char* sortNames[] = {
@@ -154,7 +170,9 @@ int main(void)
         "Shear Sort (Parallel)",
         "Bitonic Sort (Parallel)",
         "Odd-Even Merge Sort (Parallel)",
-        "Merge Sort (Parallel, prebuffered, iterative)"
+        "Merge Sort (Parallel, prebuffered, iterative)",
+        "Bitonic Sort (Parallel, dissemination barrier)",
+        "Odd-Even Merge Sort (Parallel, sense barrier)"
     };
 
     ls::utils::Clock<double> ticks;    
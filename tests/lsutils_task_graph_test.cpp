@@ -0,0 +1,302 @@
+/*
+ * File:   lsutils_task_graph_test.cpp
+ * Author: miles
+ * Created on October 17, 2026, at 10:05 p.m.
+ */
+
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/TaskGraph.hpp"
+#include "lightsky/utils/WorkerPool.hpp"
+#include "lightsky/utils/WorkStealingPool.hpp"
+
+namespace utils = ls::utils;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Pipeline: decode -> (transform x N) -> sort -> encode
+-----------------------------------------------------------------------------*/
+template <class PoolType>
+int test_pipeline(PoolType& pool)
+{
+    constexpr unsigned numTransforms = 40; // enough to dispatch in batches
+    constexpr unsigned numRuns = 50;
+
+    std::atomic<unsigned> sequence{0};
+    std::vector<unsigned> order(numTransforms + 3, 0);
+    utils::TaskGraph graph;
+
+    const utils::TaskGraph::node_id decode = graph.add([&]()->void
+    {
+        order[0] = sequence.fetch_add(1);
+    });
+
+    const utils::TaskGraph::node_id sort = graph.add([&]()->void
+    {
+        order[numTransforms + 1] = sequence.fetch_add(1);
+    });
+
+    const utils::TaskGraph::node_id encode = graph.add([&]()->void
+    {
+        order[numTransforms + 2] = sequence.fetch_add(1);
+    });
+
+    for (unsigned i = 0; i < numTransforms; ++i)
+    {
+        const utils::TaskGraph::node_id transform = graph.add([&, i]()->void
+        {
+            order[i + 1] = sequence.fetch_add(1);
+        });
+
+        LS_ASSERT(graph.add_dependency(transform, decode));
+        LS_ASSERT(graph.add_dependency(sort, transform));
+    }
+
+    LS_ASSERT(graph.add_dependency(encode, sort));
+
+    if (graph.add_dependency(encode, encode) || graph.add_dependency(encode, graph.size()))
+    {
+        std::cerr << "Error: a TaskGraph accepted an invalid dependency." << std::endl;
+        return -1;
+    }
+
+    // A graph must be finalized before it can run
+    if (graph.run(pool) || !graph.finalize())
+    {
+        std::cerr << "Error: a TaskGraph ran before being finalized." << std::endl;
+        return -2;
+    }
+
+    // The same graph is reused for every run
+    for (unsigned run = 0; run < numRuns; ++run)
+    {
+        sequence = 0;
+
+        if (!graph.run(pool) || sequence != numTransforms + 3)
+        {
+            std::cerr << "Error: a TaskGraph ran " << sequence << " of " << (numTransforms + 3) << " tasks." << std::endl;
+            return -3;
+        }
+
+        bool inOrder = order[0] == 0 && order[numTransforms + 2] == numTransforms + 2;
+        for (unsigned i = 0; i < numTransforms; ++i)
+        {
+            inOrder = inOrder && order[i + 1] > order[0] && order[i + 1] < order[numTransforms + 1];
+        }
+
+        if (!inOrder)
+        {
+            std::cerr << "Error: a TaskGraph ran a task before its dependencies." << std::endl;
+            return -4;
+        }
+    }
+
+    // Start, then wait separately
+    sequence = 0;
+
+    if (!graph.start(pool) || graph.start(pool))
+    {
+        std::cerr << "Error: a TaskGraph was started while already running." << std::endl;
+        graph.wait();
+        return -5;
+    }
+
+    graph.wait();
+
+    if (sequence != numTransforms + 3)
+    {
+        std::cerr << "Error: a started TaskGraph ran " << sequence << " of " << (numTransforms + 3) << " tasks." << std::endl;
+        return -6;
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Independent chains finish without waiting on each other
+-----------------------------------------------------------------------------*/
+template <class PoolType>
+int test_chains(PoolType& pool)
+{
+    constexpr unsigned numChains = 8;
+    constexpr unsigned chainLength = 64;
+
+    std::vector<unsigned> counters(numChains, 0);
+    std::atomic_bool inOrder{true};
+    utils::TaskGraph graph;
+
+    for (unsigned c = 0; c < numChains; ++c)
+    {
+        utils::TaskGraph::node_id prev = utils::TaskGraph::INVALID_NODE;
+
+        for (unsigned i = 0; i < chainLength; ++i)
+        {
+            // Each link checks that its predecessor ran first
+            const utils::TaskGraph::node_id link = graph.add([&, c, i]()->void
+            {
+                if (counters[c] != i)
+                {
+                    inOrder.store(false, std::memory_order_relaxed);
+                }
+
+                counters[c] = i + 1;
+            });
+
+            if (prev != utils::TaskGraph::INVALID_NODE)
+            {
+                LS_ASSERT(graph.add_dependency(link, prev));
+            }
+
+            prev = link;
+        }
+    }
+
+    LS_ASSERT(graph.finalize());
+
+    for (unsigned run = 0; run < 10; ++run)
+    {
+        for (unsigned& count : counters)
+        {
+            count = 0;
+        }
+
+        if (!graph.run(pool))
+        {
+            std::cerr << "Error: unable to run a TaskGraph of independent chains." << std::endl;
+            return -1;
+        }
+
+        for (unsigned count : counters)
+        {
+            if (count != chainLength)
+            {
+                std::cerr << "Error: a chain ran " << count << " of " << chainLength << " links." << std::endl;
+                return -2;
+            }
+        }
+    }
+
+    if (!inOrder.load())
+    {
+        std::cerr << "Error: a chain link ran before its predecessor." << std::endl;
+        return -3;
+    }
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ * Graph validation
+-----------------------------------------------------------------------------*/
+int test_cycles()
+{
+    utils::FunctionWorkerPool pool{1};
+    utils::TaskGraph graph;
+
+    if (graph.add(utils::TaskGraph::task_type{}) != utils::TaskGraph::INVALID_NODE)
+    {
+        std::cerr << "Error: a TaskGraph accepted an empty task." << std::endl;
+        return -1;
+    }
+
+    // An empty graph is trivially valid
+    if (!graph.finalize() || !graph.run(pool))
+    {
+        std::cerr << "Error: unable to run an empty TaskGraph." << std::endl;
+        return -2;
+    }
+
+    const utils::TaskGraph::node_id a = graph.add([]()->void {});
+    const utils::TaskGraph::node_id b = graph.add([]()->void {});
+    const utils::TaskGraph::node_id c = graph.add([]()->void {});
+
+    LS_ASSERT(graph.add_dependency(b, a));
+    LS_ASSERT(graph.add_dependency(c, b));
+    LS_ASSERT(graph.finalize());
+
+    LS_ASSERT(graph.add_dependency(a, c));
+    LS_ASSERT(!graph.finalized());
+
+    if (graph.finalize() || graph.run(pool))
+    {
+        std::cerr << "Error: a TaskGraph containing a cycle was finalized." << std::endl;
+        return -3;
+    }
+
+    graph.clear();
+    LS_ASSERT(graph.size() == 0);
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_cycles();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    {
+        utils::FunctionWorkerPool pool{4};
+        ret = test_pipeline(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        ret = test_chains(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    {
+        utils::FunctionWorkStealingPool pool{4};
+        ret = test_pipeline(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        ret = test_chains(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    {
+        // no worker threads, the graph runs on the caller
+        utils::FunctionWorkerPool pool{0};
+        ret = test_pipeline(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+
+        ret = test_chains(pool);
+        if (ret != 0)
+        {
+            return ret;
+        }
+    }
+
+    std::cout << "All task graph tests passed." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*
+ * File:   lsutils_timer_wheel_test.cpp
+ * Author: miles
+ * Created on October 19, 2026, at 2:30 p.m.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/TimerWheel.hpp"
+#include "lightsky/utils/WorkerPool.hpp"
+
+namespace utils = ls::utils;
+
+typedef utils::TimerWheel::clock_type clock_type;
+
+using std::chrono::hours;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+
+
+/*-----------------------------------------------------------------------------
+ * Tests
+-----------------------------------------------------------------------------*/
+int test_expiry()
+{
+    const clock_type::time_point start = clock_type::now();
+    utils::TimerWheel wheel{milliseconds{1}, start};
+    std::vector<int> fired;
+    std::vector<utils::Function<void()>> callbacks;
+
+    auto run_until = [&](clock_type::duration elapsed)->std::size_t
+    {
+        callbacks.clear();
+        const std::size_t numExpired = wheel.expire(start + elapsed, callbacks);
+
+        for (utils::Function<void()>& callback : callbacks)
+        {
+            callback();
+        }
+
+        return numExpired;
+    };
+
+    // One timer in each level, plus one beyond the range of the wheel
+    wheel.schedule([&]()->void {fired.push_back(1);}, milliseconds{5});
+    wheel.schedule([&]()->void {fired.push_back(2);}, milliseconds{300});
+    wheel.schedule([&]()->void {fired.push_back(3);}, seconds{70});
+    wheel.schedule([&]()->void {fired.push_back(4);}, hours{24*5});
+    wheel.schedule([&]()->void {fired.push_back(5);}, hours{24*60});
+    const utils::TimerWheel::timer_id cancelled = wheel.schedule([&]()->void {fired.push_back(-1);}, milliseconds{6});
+    LS_ASSERT(wheel.size() == 6);
+
+    LS_ASSERT(wheel.pending(cancelled));
+
+    if (!wheel.cancel(cancelled) || wheel.cancel(cancelled) || wheel.pending(cancelled))
+    {
+        std::cerr << "Error: unable to cancel a pending timer exactly once." << std::endl;
+        return -1;
+    }
+
+    const struct
+    {
+        clock_type::duration elapsed;
+        std::size_t numExpired;
+    } steps[] = {
+        {milliseconds{4},                     0},
+        {milliseconds{5},                     1},
+        {milliseconds{299},                   0},
+        {milliseconds{300},                   1},
+        {seconds{69},                         0},
+        {seconds{70},                         1},
+        {hours{24*5} - milliseconds{1},       0},
+        {hours{24*5},                         1},
+        {hours{24*60} - milliseconds{1},      0},
+        {hours{24*60},                        1}
+    };
+
+    for (const auto& step : steps)
+    {
+        const std::size_t numExpired = run_until(step.elapsed);
+        if (numExpired != step.numExpired)
+        {
+            std::cerr << "Error: " << numExpired << " timers expired after " << std::chrono::duration_cast<milliseconds>(step.elapsed).count() << "ms, expected " << step.numExpired << '.' << std::endl;
+            return -2;
+        }
+    }
+
+    if (fired != std::vector<int>{1, 2, 3, 4, 5} || !wheel.empty())
+    {
+        std::cerr << "Error: timers fired out of order." << std::endl;
+        return -3;
+    }
+
+    // Stale handles don't cancel newer timers using the same slot
+    const utils::TimerWheel::timer_id reused = wheel.schedule([&]()->void {fired.push_back(6);}, milliseconds{1});
+    if (reused == cancelled || wheel.cancel(cancelled) || !wheel.pending(reused))
+    {
+        std::cerr << "Error: a stale timer handle cancelled a newer timer." << std::endl;
+        return -4;
+    }
+
+    wheel.clear();
+    LS_ASSERT(wheel.empty());
+    LS_ASSERT(!wheel.pending(reused));
+
+    return 0;
+}
+
+
+
+int test_periodic()
+{
+    const clock_type::time_point start = clock_type::now();
+    utils::TimerWheel wheel{milliseconds{1}, start};
+    std::vector<utils::Function<void()>> callbacks;
+    unsigned numRuns = 0;
+
+    const utils::TimerWheel::timer_id timer = wheel.schedule_periodic([&]()->void {++numRuns;}, milliseconds{10});
+
+    // Late calls dispatch every missed period in one batch
+    if (wheel.expire(start + milliseconds{9}, callbacks) != 0
+        || wheel.expire(start + milliseconds{10}, callbacks) != 1
+        || wheel.expire(start + milliseconds{1000}, callbacks) != 99)
+    {
+        std::cerr << "Error: a periodic timer did not dispatch every missed period." << std::endl;
+        return -1;
+    }
+
+    for (utils::Function<void()>& callback : callbacks)
+    {
+        callback();
+    }
+
+    if (numRuns != 100 || !wheel.pending(timer))
+    {
+        std::cerr << "Error: a periodic timer ran " << numRuns << " of 100 times." << std::endl;
+        return -2;
+    }
+    LS_ASSERT(wheel.cancel(timer));
+    LS_ASSERT(wheel.empty());
+
+    return 0;
+}
+
+
+
+int test_pool_dispatch()
+{
+    constexpr unsigned numTimers = 100000;
+
+    const clock_type::time_point start = clock_type::now();
+    utils::TimerWheel wheel{milliseconds{1}, start};
+    utils::FunctionWorkerPool pool{2};
+    std::atomic<unsigned> numFired{0};
+    std::vector<utils::TimerWheel::timer_id> timers;
+    timers.reserve(numTimers);
+
+    // Network-style timeouts, most of which are cancelled before firing
+    for (unsigned i = 0; i < numTimers; ++i)
+    {
+        timers.push_back(wheel.schedule([&numFired]()->void {numFired.fetch_add(1, std::memory_order_relaxed);}, milliseconds{1 + i % 30000}));
+    }
+
+    unsigned numCancelled = 0;
+    for (unsigned i = 0; i < numTimers; i += 4)
+    {
+        numCancelled += wheel.cancel(timers[i]);
+    }
+
+    if (numCancelled != numTimers / 4 || wheel.size() != numTimers - numCancelled)
+    {
+        std::cerr << "Error: cancelled " << numCancelled << " of " << (numTimers / 4) << " timers." << std::endl;
+        return -1;
+    }
+
+    std::size_t numDispatched = 0;
+    for (unsigned ms = 0; ms <= 30000; ms += 250)
+    {
+        numDispatched += wheel.advance(pool, start + milliseconds{ms});
+    }
+
+    pool.wait();
+
+    if (numDispatched != numTimers - numCancelled || numFired.load() != numTimers - numCancelled)
+    {
+        std::cerr << "Error: a pool ran " << numFired.load() << " of " << (numTimers - numCancelled) << " timers." << std::endl;
+        return -2;
+    }
+
+    LS_ASSERT(wheel.empty());
+
+    return 0;
+}
+
+
+
+/*-----------------------------------------------------------------------------
+ *
+-----------------------------------------------------------------------------*/
+int main()
+{
+    int ret = test_expiry();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_periodic();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    ret = test_pool_dispatch();
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    std::cout << "All timer wheel tests passed." << std::endl;
+    return 0;
+}
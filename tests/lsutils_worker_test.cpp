@@ -1,15 +1,26 @@
 
+#include <atomic>
 #include <cassert>
 #include <chrono> // std::seconds
 #include <cstddef> // ptrdiff_t
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "lightsky/utils/Assertions.h"
+#include "lightsky/utils/Future.hpp"
+#include "lightsky/utils/PriorityWorkerPool.hpp"
 #include "lightsky/utils/WorkerPool.hpp"
 #include "lightsky/utils/WorkerThread.hpp"
+#include "lightsky/utils/WorkStealingPool.hpp"
 
+using ls::utils::Future;
+using ls::utils::Promise;
+using ls::utils::WorkerPriority;
 using ls::utils::WorkerPool;
 using ls::utils::WorkerThread;
+using ls::utils::WorkStealingPool;
 
 
 
@@ -114,6 +125,462 @@ void test_pooled_worker()
 
 
 
+struct StealingTask
+{
+    WorkStealingPool<StealingTask>* pPool = nullptr;
+    std::atomic_uint* pCounter = nullptr;
+    unsigned depth = 0;
+
+    void operator()() noexcept
+    {
+        pCounter->fetch_add(1, std::memory_order_relaxed);
+
+        // Spawn child tasks into the local queue so idle workers must steal
+        if (depth)
+        {
+            pPool->emplace(StealingTask{pPool, pCounter, depth-1});
+            pPool->emplace(StealingTask{pPool, pCounter, depth-1});
+        }
+    }
+};
+
+
+
+void test_stealing_worker()
+{
+    std::cout << "Testing a work-stealing pool" << std::endl;
+
+    constexpr unsigned numRoots = 8;
+    constexpr unsigned depth = 10;
+    constexpr unsigned tasksPerRoot = (1u << (depth+1u)) - 1u;
+
+    std::atomic_uint counter{0};
+    WorkStealingPool<StealingTask> pool{4};
+
+    for (unsigned i = 0; i < numRoots; ++i)
+    {
+        pool.emplace(StealingTask{&pool, &counter, depth});
+    }
+
+    pool.flush();
+    pool.wait();
+
+    std::cout << "\tTasks executed: " << counter.load() << '/' << numRoots*tasksPerRoot << std::endl;
+    LS_ASSERT(counter.load() == numRoots*tasksPerRoot);
+    LS_ASSERT(!pool.have_pending());
+
+    // Re-run with busy waiting and after resizing the pool
+    counter = 0;
+    pool.busy_waiting(true);
+    pool.concurrency(3);
+
+    for (unsigned i = 0; i < numRoots; ++i)
+    {
+        pool.emplace(StealingTask{&pool, &counter, depth});
+    }
+
+    pool.flush();
+    pool.wait();
+
+    std::cout << "\tTasks executed: " << counter.load() << '/' << numRoots*tasksPerRoot << std::endl;
+    LS_ASSERT(counter.load() == numRoots*tasksPerRoot);
+
+    WorkStealingPool<StealingTask> pool2{0};
+    pool2 = std::move(pool);
+    pool2.flush();
+    pool2.wait();
+
+    std::cout << "Done. Thread ready state: " << pool2.ready() << std::endl;
+}
+
+
+
+void test_futures()
+{
+    std::cout << "Testing futures and continuations" << std::endl;
+
+    ls::utils::FunctionWorkerPool pool{3};
+    std::atomic_uint numSideEffects{0};
+
+    Future<int> a = pool.submit([]()->int {return 21;});
+    Future<void> b = pool.submit([&numSideEffects]()->void {numSideEffects.fetch_add(1);});
+
+    // chain dependent stages without waiting on the whole pool
+    Future<std::string> c = a.then([](int x)->int {return x * 2;}).then([](int x)->std::string
+    {
+        return std::to_string(x);
+    });
+    Future<unsigned> d = b.then([&numSideEffects]()->unsigned {return numSideEffects.fetch_add(1) + 1u;});
+
+    LS_ASSERT(!a.valid() && !b.valid());
+    LS_ASSERT(c.valid() && d.valid());
+
+    pool.flush();
+
+    LS_ASSERT(c.get() == "42");
+    LS_ASSERT(d.get() == 2u);
+    LS_ASSERT(c.ready() && c.has_value());
+
+    // continuations attached after completion run immediately
+    Future<int> e = pool.submit([]()->int {return 7;});
+    pool.flush();
+    e.wait();
+
+    Future<int> f = e.then([](int x)->int {return x + 1;});
+    LS_ASSERT(f.ready() && f.get() == 8);
+
+    // every promise dropped without a value
+    Future<int> broken;
+    {
+        Promise<int> promise;
+        Promise<int> promiseCopy = promise;
+        broken = promise.get_future();
+    }
+
+    LS_ASSERT(broken.ready() && !broken.has_value());
+
+    Future<int> brokenChain = broken.then([](int x)->int {return x;});
+    LS_ASSERT(brokenChain.ready() && !brokenChain.has_value());
+
+    // only the first value takes effect
+    Promise<int> promise;
+    Future<int> g = promise.get_future();
+    LS_ASSERT(promise.set_value(1));
+    LS_ASSERT(!promise.set_value(2));
+    LS_ASSERT(g.get() == 1);
+
+    // many concurrent submissions
+    std::atomic_uint sum{0};
+    Future<void> futures[256];
+
+    for (unsigned i = 0; i < 256; ++i)
+    {
+        futures[i] = pool.submit([i]()->unsigned {return i;}).then([&sum](unsigned x)->void {sum.fetch_add(x);});
+    }
+
+    pool.flush();
+
+    for (Future<void>& future : futures)
+    {
+        future.wait();
+        LS_ASSERT(future.has_value());
+    }
+
+    LS_ASSERT(sum.load() == (255u * 256u) / 2u);
+    pool.wait();
+
+    std::cout << "Done." << std::endl;
+}
+
+
+
+template <class PoolType>
+void run_adaptive_batches(PoolType& pool)
+{
+    constexpr unsigned numBatches = 200;
+    constexpr unsigned tasksPerBatch = 16;
+
+    std::atomic_uint counter{0};
+    pool.adaptive_waiting(true);
+    LS_ASSERT(pool.adaptive_waiting());
+
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        for (unsigned j = 0; j < tasksPerBatch; ++j)
+        {
+            pool.emplace([&counter]()->void {counter.fetch_add(1, std::memory_order_relaxed);});
+        }
+
+        pool.flush();
+        pool.wait();
+
+        // Leave gaps between some batches so idle threads have to park
+        if ((i % 50u) == 49u)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        }
+    }
+
+    LS_ASSERT(counter.load() == numBatches*tasksPerBatch);
+
+    pool.adaptive_waiting(false);
+    LS_ASSERT(!pool.adaptive_waiting());
+}
+
+
+
+void test_adaptive_waiting()
+{
+    std::cout << "Testing adaptive idle waiting" << std::endl;
+
+    ls::utils::FunctionWorkerThread thread{};
+    run_adaptive_batches(thread);
+
+    ls::utils::FunctionWorkerPool pool{3};
+    run_adaptive_batches(pool);
+
+    ls::utils::FunctionWorkStealingPool stealingPool{3};
+    run_adaptive_batches(stealingPool);
+
+    std::cout << "Done." << std::endl;
+}
+
+
+
+void test_priority_worker()
+{
+    std::cout << "Testing a priority pool" << std::endl;
+
+    typedef ls::utils::FunctionPriorityWorkerPool::clock_type clock_type;
+
+    ls::utils::FunctionPriorityWorkerPool pool{1};
+    std::mutex orderLock;
+    std::vector<int> order;
+
+    auto record = [&](int id)->void
+    {
+        pool.emplace([&order, &orderLock, id]()->void
+        {
+            std::lock_guard<std::mutex> lock{orderLock};
+            order.push_back(id);
+        }, (WorkerPriority)(id / 10));
+    };
+
+    // Keep the lanes from aging while the order is checked
+    pool.lane_max_wait(WorkerPriority::HIGH, std::chrono::hours{1});
+    pool.lane_max_wait(WorkerPriority::NORMAL, std::chrono::hours{1});
+    pool.lane_max_wait(WorkerPriority::LOW, std::chrono::hours{1});
+
+    record(20);
+    record(10);
+    record(21);
+    record(0);
+    record(11);
+    record(1);
+    LS_ASSERT(pool.num_pending() == 6);
+    LS_ASSERT(pool.num_pending(WorkerPriority::LOW) == 2);
+
+    pool.flush();
+    pool.wait();
+    LS_ASSERT((order == std::vector<int>{0, 1, 10, 11, 20, 21}));
+
+    // Earliest deadline first within a lane
+    order.clear();
+    const clock_type::time_point now = clock_type::now();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        pool.emplace_deadline([&order, i]()->void {order.push_back(i);}, now + std::chrono::hours{4-i}, WorkerPriority::NORMAL);
+    }
+
+    pool.flush();
+    pool.wait();
+    LS_ASSERT((order == std::vector<int>{3, 2, 1, 0}));
+
+    // Overdue background tasks aren't starved by high-priority ones
+    order.clear();
+    pool.lane_max_wait(WorkerPriority::LOW, std::chrono::nanoseconds{0});
+    record(0);
+    record(1);
+    record(20);
+    record(2);
+
+    pool.flush();
+    pool.wait();
+    LS_ASSERT((order == std::vector<int>{20, 0, 1, 2}));
+
+    // Lane concurrency limits
+    constexpr unsigned numTasks = 64;
+    std::atomic_uint numRunning{0};
+    std::atomic_uint maxRunning{0};
+    std::atomic_uint numDone{0};
+
+    pool.concurrency(4);
+    pool.lane_concurrency(WorkerPriority::LOW, 1);
+    LS_ASSERT(pool.lane_concurrency(WorkerPriority::LOW) == 1);
+
+    // Out-of-range priorities refer to the LOW lane, as with push()
+    LS_ASSERT(pool.lane_concurrency(WorkerPriority::COUNT) == 1);
+
+    for (unsigned i = 0; i < numTasks; ++i)
+    {
+        pool.emplace([&]()->void
+        {
+            const unsigned running = numRunning.fetch_add(1) + 1;
+            unsigned prevMax = maxRunning.load();
+            while (prevMax < running && !maxRunning.compare_exchange_weak(prevMax, running))
+            {
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds{50});
+            numRunning.fetch_sub(1);
+            numDone.fetch_add(1);
+        }, WorkerPriority::LOW);
+    }
+
+    Future<int> interactive = pool.submit([]()->int {return 42;}, WorkerPriority::HIGH);
+
+    pool.flush();
+    LS_ASSERT(interactive.get() == 42);
+    pool.wait();
+
+    LS_ASSERT(numDone.load() == numTasks);
+    LS_ASSERT(maxRunning.load() == 1);
+    LS_ASSERT(!pool.have_pending());
+
+    std::cout << "Done." << std::endl;
+}
+
+
+
+template <class PoolType>
+void run_bulk_batches(PoolType& pool)
+{
+    typedef typename PoolType::value_type task_type;
+
+    constexpr unsigned numTasks = 10000;
+
+    std::atomic_uint counter{0};
+    std::vector<task_type> tasks;
+    tasks.reserve(numTasks);
+
+    for (unsigned i = 0; i < numTasks; ++i)
+    {
+        tasks.emplace_back([&counter]()->void {counter.fetch_add(1, std::memory_order_relaxed);});
+    }
+
+    pool.push_range(tasks.begin(), tasks.begin() + numTasks/2);
+    LS_ASSERT(pool.num_pending() == numTasks/2);
+
+    pool.emplace_bulk(tasks.begin() + numTasks/2, tasks.end());
+    LS_ASSERT(pool.num_pending() == numTasks);
+
+    pool.flush();
+    pool.wait();
+    LS_ASSERT(counter.load() == numTasks);
+
+    // Copied tasks can be queued again
+    pool.push_range(tasks.begin(), tasks.begin() + 3);
+    pool.push_range(tasks.begin(), tasks.begin());
+    pool.flush();
+    pool.wait();
+    LS_ASSERT(counter.load() == numTasks + 3);
+}
+
+
+
+void test_bulk_enqueue()
+{
+    std::cout << "Testing bulk task submission" << std::endl;
+
+    ls::utils::FunctionWorkerThread thread{};
+    run_bulk_batches(thread);
+
+    ls::utils::FunctionWorkerPool pool{3};
+    run_bulk_batches(pool);
+
+    ls::utils::FunctionWorkStealingPool stealingPool{3};
+    run_bulk_batches(stealingPool);
+
+    // Bulk submissions from within a task stay on the worker's queue, and
+    // metrics count every task in a batch.
+    std::atomic_uint counter{0};
+    std::vector<ls::utils::Function<void()>> children(64, ls::utils::Function<void()>{[&counter]()->void {counter.fetch_add(1);}});
+
+    stealingPool.collect_metrics(true);
+    stealingPool.emplace([&]()->void {stealingPool.push_range(children.begin(), children.end());});
+    stealingPool.flush();
+    stealingPool.wait();
+
+    LS_ASSERT(counter.load() == 64);
+    LS_ASSERT(stealingPool.metrics().tasksQueued == 65);
+
+    std::cout << "Done." << std::endl;
+}
+
+
+
+template <class PoolType>
+void run_metrics_batches(PoolType& pool)
+{
+    constexpr unsigned numBatches = 20;
+    constexpr unsigned tasksPerBatch = 32;
+
+    LS_ASSERT(!pool.collect_metrics());
+
+    // Tasks queued before metrics are enabled have no queue latency
+    pool.emplace([]()->void {});
+    pool.collect_metrics(true);
+    LS_ASSERT(pool.collect_metrics());
+
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        for (unsigned j = 0; j < tasksPerBatch; ++j)
+        {
+            pool.emplace([]()->void {std::this_thread::sleep_for(std::chrono::microseconds{20});});
+        }
+
+        pool.flush();
+        pool.wait();
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+    }
+
+    const ls::utils::WorkerPoolStats stats = pool.metrics();
+    const ls::utils::WorkerThreadStats total = stats.total();
+
+    LS_ASSERT(stats.threads.size() == pool.concurrency());
+    LS_ASSERT(stats.tasksQueued == numBatches*tasksPerBatch);
+    LS_ASSERT(stats.maxQueueDepth >= tasksPerBatch);
+    LS_ASSERT(total.tasksRun == numBatches*tasksPerBatch + 1);
+    LS_ASSERT(stats.runTime.count == total.tasksRun);
+    LS_ASSERT(stats.queueLatency.count == numBatches*tasksPerBatch);
+    LS_ASSERT(stats.runTime.percentile(0.5) >= 10000);
+    LS_ASSERT(stats.runTime.percentile(1.0) == stats.runTime.maxNs);
+    LS_ASSERT(total.busyNs >= stats.runTime.mean());
+    LS_ASSERT(total.idleNs > 0);
+    LS_ASSERT(stats.utilization() > 0.0 && stats.utilization() <= 1.0);
+
+    std::cout
+        << "\tTasks run:     " << total.tasksRun
+        << "\n\tMax depth:     " << stats.maxQueueDepth
+        << "\n\tLatency p50:   " << stats.queueLatency.percentile(0.5) << "ns"
+        << "\n\tLatency p99:   " << stats.queueLatency.percentile(0.99) << "ns"
+        << "\n\tRun time p50:  " << stats.runTime.percentile(0.5) << "ns"
+        << "\n\tUtilization:   " << stats.utilization()
+        << "\n\tParks:         " << total.numParks
+        << "\n\tSteals:        " << total.numSteals
+        << std::endl;
+
+    // Resizing the pool starts a new set of counters
+    pool.reset_metrics();
+    pool.concurrency(pool.concurrency() + 1);
+    LS_ASSERT(pool.metrics().threads.size() == pool.concurrency());
+    LS_ASSERT(pool.metrics().total().tasksRun == 0);
+
+    pool.collect_metrics(false);
+    pool.emplace([]()->void {});
+    pool.flush();
+    pool.wait();
+    LS_ASSERT(pool.metrics().tasksQueued == 0);
+}
+
+
+
+void test_metrics()
+{
+    std::cout << "Testing worker pool metrics" << std::endl;
+
+    ls::utils::FunctionWorkerPool pool{2};
+    run_metrics_batches(pool);
+
+    ls::utils::FunctionWorkStealingPool stealingPool{2};
+    run_metrics_batches(stealingPool);
+
+    std::cout << "Done." << std::endl;
+}
+
+
+
 int main()
 {
     srand(time(nullptr));
@@ -123,10 +590,17 @@ int main()
         << "\n\tSpinLock:    " << sizeof(ls::utils::SpinLock)
         << "\n\tWorker (ST): " << sizeof(ls::utils::DefaultWorkerThread)
         << "\n\tWorker (MT): " << sizeof(ls::utils::DefaultWorkerPool)
+        << "\n\tWorker (WS): " << sizeof(ls::utils::DefaultWorkStealingPool)
         << std::endl;
 
     //test_single_worker();
     test_pooled_worker();
+    test_stealing_worker();
+    test_futures();
+    test_adaptive_waiting();
+    test_priority_worker();
+    test_bulk_enqueue();
+    test_metrics();
 
     return 0;
 }